@@ -0,0 +1,99 @@
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Goknar/Core.h"
+#include "Goknar/Engine.h"
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Managers/ResourceManager.h"
+#include "Goknar/Materials/Material.h"
+#include "Goknar/Model/MeshUnit.h"
+
+// Acquires a mesh the way a streamed cell acquires the meshes of its scene, releases it under a texture budget of 0
+// and checks that the images its material got from the model loader are evicted with it and restored when it is acquired again
+// Runs on a headless engine, its images release their decoded pixels instead of the storage of their textures
+// Usage: ContentEvictionCheck [mesh path relative to the content directory]
+
+static int failedCheckCount = 0;
+
+static void Check(bool condition, const char* description, const std::string& path)
+{
+	if (!condition)
+	{
+		++failedCheckCount;
+		std::printf("FAILED: %s: %s\n", description, path.c_str());
+	}
+}
+
+static void WaitForContentLoads(ResourceManager* resourceManager)
+{
+	do
+	{
+		resourceManager->ProcessContentLoads();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	} while (0 < resourceManager->GetPendingContentLoadCount());
+}
+
+int main(int argc, char** argv)
+{
+	const std::string meshPath = 1 < argc ? argv[1] : "Meshes/SM_Arrow.fbx";
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* checkEngine = new Engine(true);
+	ResourceManager* resourceManager = checkEngine->GetResourceManager();
+
+	ContentLoadRequest* request = resourceManager->AcquireContent(meshPath);
+	WaitForContentLoads(resourceManager);
+
+	MeshUnit* mesh = request->GetContent<MeshUnit>();
+	Material* material = mesh ? mesh->GetMaterial() : nullptr;
+	if (!material || material->GetTextureImages()->empty())
+	{
+		std::printf("FAILED: mesh could not be loaded or its material has no images: %s\n", meshPath.c_str());
+		return 1;
+	}
+
+	// Paths are relative to the content directory like the paths a cell acquires
+	std::vector<std::pair<std::string, const Image*>> images;
+	for (const Image* image : *material->GetTextureImages())
+	{
+		images.push_back(std::make_pair(image->GetPath().substr(ContentDir.size()), image));
+	}
+
+	for (const std::pair<std::string, const Image*>& image : images)
+	{
+		Check(resourceManager->GetContentReferenceCount(image.first) == 1, "image is not acquired with its mesh", image.first);
+		Check(0 < resourceManager->GetResidentContentByteCount(image.first), "image of the acquired mesh is not resident", image.first);
+	}
+
+	resourceManager->SetContentMemoryBudget(ContentMemoryCategory::Texture, 0);
+	resourceManager->ReleaseContent(meshPath);
+	resourceManager->ProcessContentLoads();
+
+	for (const std::pair<std::string, const Image*>& image : images)
+	{
+		Check(resourceManager->GetContentReferenceCount(image.first) == 0, "image is not released with its mesh", image.first);
+		Check(resourceManager->GetResidentContentByteCount(image.first) == 0, "image of the released mesh is still resident", image.first);
+		Check(image.second->GetIsEvicted(), "image of the released mesh is not evicted", image.first);
+	}
+
+	resourceManager->SetContentMemoryBudget(ContentMemoryCategory::Texture, ULLONG_MAX);
+	resourceManager->AcquireContent(meshPath);
+	WaitForContentLoads(resourceManager);
+
+	for (const std::pair<std::string, const Image*>& image : images)
+	{
+		Check(!image.second->GetIsEvicted(), "image of the acquired mesh is not restored", image.first);
+		Check(0 < resourceManager->GetResidentContentByteCount(image.first), "restored image is not resident", image.first);
+	}
+
+	resourceManager->ReleaseContent(meshPath);
+
+	std::printf("%d image(s) of %s checked, %d check(s) failed\n", (int)images.size(), meshPath.c_str(), failedCheckCount);
+
+	// Engine is not shut down since the window and the renderer were never initialized
+	return failedCheckCount == 0 ? 0 : 1;
+}
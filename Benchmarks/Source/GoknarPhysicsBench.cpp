@@ -0,0 +1,454 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(GOKNAR_PLATFORM_WINDOWS)
+	#include <Windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+#include "LinearMath/btAlignedAllocator.h"
+
+#include "Goknar/Engine.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Managers/MemoryManager.h"
+#include "Goknar/Model/MeshUnit.h"
+#include "Goknar/Physics/Character.h"
+#include "Goknar/Physics/PhysicsShapeCache.h"
+#include "Goknar/Physics/PhysicsStats.h"
+#include "Goknar/Physics/PhysicsWorld.h"
+#include "Goknar/Physics/RigidBody.h"
+#include "Goknar/Physics/Components/BoxCollisionComponent.h"
+#include "Goknar/Physics/Components/CapsuleCollisionComponent.h"
+#include "Goknar/Physics/Components/NonMovingTriangleMeshCollisionComponent.h"
+#include "Goknar/Physics/Components/PhysicsMovementComponent.h"
+#include "Goknar/Physics/Components/SphereCollisionComponent.h"
+
+// Replays scripted physics scenarios on a headless engine and reports step time percentiles and memory
+// Every scenario uses a fixed seed, so the same build simulates the same steps on every run
+// Usage: GoknarPhysicsBench [--threads <count>] [--csv <directory>]
+
+constexpr float STEP_DELTA_TIME = 1.f / 60.f;
+constexpr int STEP_COUNT = 600;
+
+// Size of every Bullet allocation is kept in front of it, 16 bytes keep the alignment malloc gives
+constexpr std::size_t BULLET_ALLOCATION_HEADER_SIZE = 16;
+
+static std::atomic<std::size_t> bulletLiveBytes{ 0 };
+static std::atomic<std::size_t> bulletPeakBytes{ 0 };
+
+static void* AllocateBulletMemory(size_t size)
+{
+	unsigned char* block = (unsigned char*)std::malloc(size + BULLET_ALLOCATION_HEADER_SIZE);
+	*(std::size_t*)block = size;
+
+	const std::size_t liveBytes = bulletLiveBytes += size;
+	std::size_t peakBytes = bulletPeakBytes.load();
+	while (peakBytes < liveBytes && !bulletPeakBytes.compare_exchange_weak(peakBytes, liveBytes))
+	{
+	}
+
+	return block + BULLET_ALLOCATION_HEADER_SIZE;
+}
+
+static void FreeBulletMemory(void* pointer)
+{
+	if (!pointer)
+	{
+		return;
+	}
+
+	unsigned char* block = (unsigned char*)pointer - BULLET_ALLOCATION_HEADER_SIZE;
+	bulletLiveBytes -= *(std::size_t*)block;
+	std::free(block);
+}
+
+static std::size_t GetPeakResidentBytes()
+{
+#if defined(GOKNAR_PLATFORM_WINDOWS)
+	PROCESS_MEMORY_COUNTERS memoryCounters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+	{
+		return memoryCounters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage resourceUsage;
+	getrusage(RUSAGE_SELF, &resourceUsage);
+	#if defined(__APPLE__)
+	return (std::size_t)resourceUsage.ru_maxrss;
+	#else
+	return (std::size_t)resourceUsage.ru_maxrss * 1024;
+	#endif
+#endif
+}
+
+static std::size_t GetEngineLiveBytes()
+{
+	const MemoryManager* memoryManager = MemoryManager::GetInstance();
+	return
+		memoryManager->GetAllocationStatistics(AllocationCategory::ObjectBase).liveBytes +
+		memoryManager->GetAllocationStatistics(AllocationCategory::Component).liveBytes;
+}
+
+class BenchBox : public RigidBody
+{
+public:
+	BenchBox(const Vector3& halfSize, float mass) : RigidBody()
+	{
+		BoxCollisionComponent* boxCollisionComponent = AddSubComponent<BoxCollisionComponent>();
+		boxCollisionComponent->SetHalfSize(halfSize);
+
+		SetMass(mass);
+		SetCollisionGroup(0.f < mass ? CollisionGroup::WorldDynamicBlock : CollisionGroup::WorldStaticBlock);
+		SetCollisionMask(CollisionMask::BlockAll);
+	}
+};
+
+class BenchSphere : public RigidBody
+{
+public:
+	BenchSphere(float radius, float mass) : RigidBody()
+	{
+		SphereCollisionComponent* sphereCollisionComponent = AddSubComponent<SphereCollisionComponent>();
+		sphereCollisionComponent->SetRadius(radius);
+
+		SetMass(mass);
+		SetCollisionGroup(CollisionGroup::WorldDynamicBlock);
+		SetCollisionMask(CollisionMask::BlockAll);
+	}
+};
+
+class BenchTerrain : public RigidBody
+{
+public:
+	BenchTerrain(const MeshUnit* terrainMesh) : RigidBody()
+	{
+		NonMovingTriangleMeshCollisionComponent* terrainCollisionComponent = AddSubComponent<NonMovingTriangleMeshCollisionComponent>();
+		terrainCollisionComponent->SetMesh(terrainMesh);
+
+		SetMass(0.f);
+		SetCollisionGroup(CollisionGroup::WorldStaticBlock);
+		SetCollisionMask(CollisionMask::BlockAll);
+	}
+};
+
+struct BenchScenario
+{
+	std::vector<ObjectBase*> objects;
+	std::vector<Character*> characters;
+	MeshUnit* terrainMesh{ nullptr };
+};
+
+template<class T>
+static T* SpawnObject(BenchScenario& scenario, T* object, const Vector3& worldPosition)
+{
+	object->SetWorldPosition(worldPosition);
+	scenario.objects.push_back(object);
+	return object;
+}
+
+// Cannon balls are shot into rows of brick walls
+static void CreateBrickWallScenario(BenchScenario& scenario)
+{
+	constexpr int WALL_COUNT = 8;
+	constexpr int WALL_WIDTH = 12;
+	constexpr int WALL_HEIGHT = 12;
+
+	SpawnObject(scenario, new BenchBox(Vector3{ 200.f, 200.f, 1.f }, 0.f), Vector3{ 0.f, 0.f, -1.f });
+
+	for (int wallIndex = 0; wallIndex < WALL_COUNT; ++wallIndex)
+	{
+		const float wallY = -20.f + wallIndex * 5.f;
+		for (int row = 0; row < WALL_HEIGHT; ++row)
+		{
+			// Every other row is shifted by half a brick
+			const float rowOffset = (row % 2) * 0.5f;
+			for (int column = 0; column < WALL_WIDTH; ++column)
+			{
+				SpawnObject(scenario, new BenchBox(Vector3{ 0.5f, 0.25f, 0.25f }, 1.f), Vector3{ -6.f + column * 1.f + rowOffset, wallY, 0.25f + row * 0.5f });
+			}
+		}
+	}
+
+	std::mt19937 randomEngine(1);
+	std::uniform_real_distribution<float> horizontalDistribution(-5.f, 5.f);
+	std::uniform_real_distribution<float> verticalDistribution(1.f, 5.f);
+	for (int cannonBallIndex = 0; cannonBallIndex < 16; ++cannonBallIndex)
+	{
+		BenchSphere* cannonBall = SpawnObject(scenario, new BenchSphere(0.5f, 50.f),
+			Vector3{ horizontalDistribution(randomEngine), -30.f - cannonBallIndex * 2.f, verticalDistribution(randomEngine) });
+		cannonBall->SetLinearVelocity(Vector3{ 0.f, 40.f, 2.f });
+	}
+}
+
+static void CreateFallingSpheresScenario(BenchScenario& scenario)
+{
+	constexpr int SPHERE_COUNT = 10000;
+	constexpr int SPHERES_PER_LAYER = 50 * 50;
+
+	SpawnObject(scenario, new BenchBox(Vector3{ 200.f, 200.f, 1.f }, 0.f), Vector3{ 0.f, 0.f, -1.f });
+
+	std::mt19937 randomEngine(2);
+	std::uniform_real_distribution<float> jitterDistribution(-0.2f, 0.2f);
+	for (int sphereIndex = 0; sphereIndex < SPHERE_COUNT; ++sphereIndex)
+	{
+		const int layer = sphereIndex / SPHERES_PER_LAYER;
+		const int layerIndex = sphereIndex % SPHERES_PER_LAYER;
+
+		SpawnObject(scenario, new BenchSphere(0.4f, 1.f), Vector3{
+			-25.f + (layerIndex % 50) * 1.f + jitterDistribution(randomEngine),
+			-25.f + (layerIndex / 50) * 1.f + jitterDistribution(randomEngine),
+			5.f + layer * 1.5f });
+	}
+}
+
+// Bodies roll down a bumpy triangle mesh slope
+static void CreateTerrainScenario(BenchScenario& scenario)
+{
+	constexpr int TERRAIN_RESOLUTION = 128;
+	constexpr float TERRAIN_CELL_SIZE = 2.f;
+	constexpr int ROLLING_BODY_COUNT = 2000;
+
+	std::mt19937 randomEngine(3);
+	std::uniform_real_distribution<float> bumpDistribution(-0.3f, 0.3f);
+
+	MeshUnit* terrainMesh = new MeshUnit();
+	for (int y = 0; y <= TERRAIN_RESOLUTION; ++y)
+	{
+		for (int x = 0; x <= TERRAIN_RESOLUTION; ++x)
+		{
+			const float positionX = (x - TERRAIN_RESOLUTION * 0.5f) * TERRAIN_CELL_SIZE;
+			const float positionY = (y - TERRAIN_RESOLUTION * 0.5f) * TERRAIN_CELL_SIZE;
+			const float height = -0.25f * positionX + 2.f * std::sin(positionX * 0.1f) * std::cos(positionY * 0.1f) + bumpDistribution(randomEngine);
+			terrainMesh->AddVertex(Vector3{ positionX, positionY, height });
+		}
+	}
+
+	for (int y = 0; y < TERRAIN_RESOLUTION; ++y)
+	{
+		for (int x = 0; x < TERRAIN_RESOLUTION; ++x)
+		{
+			const int vertexIndex = y * (TERRAIN_RESOLUTION + 1) + x;
+			terrainMesh->AddFace(Face(vertexIndex, vertexIndex + 1, vertexIndex + TERRAIN_RESOLUTION + 2));
+			terrainMesh->AddFace(Face(vertexIndex, vertexIndex + TERRAIN_RESOLUTION + 2, vertexIndex + TERRAIN_RESOLUTION + 1));
+		}
+	}
+	terrainMesh->PreInit();
+	scenario.terrainMesh = terrainMesh;
+
+	SpawnObject(scenario, new BenchTerrain(terrainMesh), Vector3::ZeroVector);
+
+	std::uniform_real_distribution<float> positionDistribution(-20.f, 20.f);
+	std::uniform_real_distribution<float> radiusDistribution(0.3f, 0.8f);
+	for (int bodyIndex = 0; bodyIndex < ROLLING_BODY_COUNT; ++bodyIndex)
+	{
+		const Vector3 position{ -100.f + positionDistribution(randomEngine), positionDistribution(randomEngine) * 4.f, 40.f + positionDistribution(randomEngine) };
+		if (bodyIndex % 4 == 0)
+		{
+			SpawnObject(scenario, new BenchBox(Vector3{ 0.4f }, 2.f), position);
+		}
+		else
+		{
+			SpawnObject(scenario, new BenchSphere(radiusDistribution(randomEngine), 1.f), position);
+		}
+	}
+}
+
+static void CreateCharacters(BenchScenario& scenario, bool isInCrowd)
+{
+	constexpr int CHARACTER_COUNT = 200;
+
+	SpawnObject(scenario, new BenchBox(Vector3{ 200.f, 200.f, 1.f }, 0.f), Vector3{ 0.f, 0.f, -1.f });
+
+	std::mt19937 randomEngine(4);
+	std::uniform_real_distribution<float> positionDistribution(-40.f, 40.f);
+
+	// Obstacles for the characters to slide along
+	for (int obstacleIndex = 0; obstacleIndex < 100; ++obstacleIndex)
+	{
+		SpawnObject(scenario, new BenchBox(Vector3{ 1.f, 1.f, 1.f }, 0.f), Vector3{ positionDistribution(randomEngine), positionDistribution(randomEngine), 1.f });
+	}
+
+	for (int characterIndex = 0; characterIndex < CHARACTER_COUNT; ++characterIndex)
+	{
+		Character* character = SpawnObject(scenario, new Character(), Vector3{ positionDistribution(randomEngine), positionDistribution(randomEngine), 3.f });
+		character->GetCapsuleCollisionComponent()->SetRadius(0.4f);
+		character->GetCapsuleCollisionComponent()->SetHeight(1.f);
+		character->GetMovementComponent()->SetIsInCrowd(isInCrowd);
+		scenario.characters.push_back(character);
+	}
+}
+
+static void CreateCharactersScenario(BenchScenario& scenario)
+{
+	CreateCharacters(scenario, false);
+}
+
+// Same characters moved by the CharacterCrowd instead of Bullet's kinematic character controllers
+static void CreateCrowdCharactersScenario(BenchScenario& scenario)
+{
+	CreateCharacters(scenario, true);
+}
+
+// Characters pick a new walking direction every second
+static void UpdateCharactersScenario(BenchScenario& scenario, int stepIndex)
+{
+	if (stepIndex % 60 != 0)
+	{
+		return;
+	}
+
+	std::mt19937 randomEngine(5 + stepIndex);
+	std::uniform_real_distribution<float> angleDistribution(0.f, 2.f * PI);
+
+	for (Character* character : scenario.characters)
+	{
+		const float angle = angleDistribution(randomEngine);
+		character->GetMovementComponent()->SetMovementDirection(Vector3{ std::cos(angle), std::sin(angle), 0.f });
+	}
+}
+
+static void DestroyScenario(BenchScenario& scenario)
+{
+	for (ObjectBase* object : scenario.objects)
+	{
+		object->Destroy();
+	}
+	scenario.objects.clear();
+	scenario.characters.clear();
+
+	// Pending objects are destroyed at the end of the frame, a frame without time does not step the simulation
+	engine->RunHeadlessFrame(0.f);
+
+	delete scenario.terrainMesh;
+	scenario.terrainMesh = nullptr;
+}
+
+static float GetPercentile(const std::vector<float>& sortedValues, float percentile)
+{
+	return sortedValues[std::min((int)(sortedValues.size() * percentile), (int)sortedValues.size() - 1)];
+}
+
+static void RunScenario(const char* name, void (*createScenario)(BenchScenario&), void (*updateScenario)(BenchScenario&, int), const std::string& csvDirectory)
+{
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	PhysicsStats* physicsStats = physicsWorld->GetStats();
+
+	bulletPeakBytes = bulletLiveBytes.load();
+
+	BenchScenario scenario;
+	createScenario(scenario);
+
+	// Objects are initialized on the first frame, simulation starts on the following one
+	engine->RunHeadlessFrame(0.f);
+
+	physicsStats->Clear();
+
+	const unsigned long long firstStepIndex = physicsWorld->GetTotalStepCount();
+	while (physicsWorld->GetTotalStepCount() - firstStepIndex < STEP_COUNT)
+	{
+		if (updateScenario)
+		{
+			updateScenario(scenario, (int)(physicsWorld->GetTotalStepCount() - firstStepIndex));
+		}
+
+		engine->RunHeadlessFrame(STEP_DELTA_TIME);
+	}
+
+	const int sampleCount = physicsStats->GetSampleCount();
+	std::vector<float> stepDurations(sampleCount);
+	PhysicsStepStats averageStepStats;
+	for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+	{
+		const PhysicsStepStats& stepStats = physicsStats->GetSample(sampleIndex);
+		stepDurations[sampleIndex] = stepStats.stepDuration;
+
+		averageStepStats.broadphaseDuration += stepStats.broadphaseDuration / sampleCount;
+		averageStepStats.narrowphaseDuration += stepStats.narrowphaseDuration / sampleCount;
+		averageStepStats.solverDuration += stepStats.solverDuration / sampleCount;
+		averageStepStats.integrateDuration += stepStats.integrateDuration / sampleCount;
+		averageStepStats.syncDuration += stepStats.syncDuration / sampleCount;
+	}
+	std::sort(stepDurations.begin(), stepDurations.end());
+
+	const PhysicsStepStats& lastStepStats = physicsStats->GetLatestSample();
+
+	std::printf("%s: %d bodies, %d steps\n", name, lastStepStats.rigidBodyCount, sampleCount);
+	std::printf("\tstep p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+		GetPercentile(stepDurations, 0.5f), GetPercentile(stepDurations, 0.9f), GetPercentile(stepDurations, 0.99f), stepDurations.back());
+	std::printf("\taverage broadphase %.3f ms, narrowphase %.3f ms, solver %.3f ms, integrate %.3f ms, sync %.3f ms\n",
+		averageStepStats.broadphaseDuration, averageStepStats.narrowphaseDuration, averageStepStats.solverDuration,
+		averageStepStats.integrateDuration, averageStepStats.syncDuration);
+	std::printf("\tlast step: %d active bodies, %d islands, %d overlapping pairs, %d manifolds, %d contact points\n",
+		lastStepStats.activeRigidBodyCount, lastStepStats.islandCount, lastStepStats.overlappingPairCount,
+		lastStepStats.manifoldCount, lastStepStats.contactPointCount);
+	std::printf("\tmemory: Bullet live %.2f MB, Bullet peak %.2f MB, engine objects %.2f MB, process peak %.2f MB\n",
+		bulletLiveBytes / (1024.f * 1024.f), bulletPeakBytes / (1024.f * 1024.f),
+		GetEngineLiveBytes() / (1024.f * 1024.f), GetPeakResidentBytes() / (1024.f * 1024.f));
+
+	if (!csvDirectory.empty())
+	{
+		physicsStats->SaveToCSV(csvDirectory + "/" + name + ".csv");
+	}
+
+	DestroyScenario(scenario);
+}
+
+int main(int argc, char** argv)
+{
+	int threadCount = 1;
+	std::string csvDirectory;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		if (!std::strcmp(argv[argumentIndex], "--threads") && argumentIndex + 1 < argc)
+		{
+			threadCount = std::max(1, std::atoi(argv[++argumentIndex]));
+		}
+		else if (!std::strcmp(argv[argumentIndex], "--csv") && argumentIndex + 1 < argc)
+		{
+			csvDirectory = argv[++argumentIndex];
+		}
+	}
+
+	// Has to be set before Bullet allocates anything
+	btAlignedAllocSetCustom(AllocateBulletMemory, FreeBulletMemory);
+
+	Engine* benchmarkEngine = new Engine(true);
+	benchmarkEngine->GetJobManager()->SetWorkerThreadCount(threadCount - 1);
+
+	PhysicsWorld* physicsWorld = benchmarkEngine->GetPhysicsWorld();
+	physicsWorld->SetIsMultithreaded(1 < threadCount);
+	physicsWorld->SetThreadCount(threadCount);
+	physicsWorld->SetIsFixedTimeStepEnabled(true);
+	physicsWorld->SetFixedTimeStep(STEP_DELTA_TIME);
+	physicsWorld->GetStats()->SetCapacity(STEP_COUNT);
+	physicsWorld->GetStats()->SetIsEnabled(true);
+
+	// Runs must not depend on the shape cache files of earlier runs
+	physicsWorld->GetShapeCache()->SetIsSerializationEnabled(false);
+
+	benchmarkEngine->PreInit();
+	benchmarkEngine->Init();
+	benchmarkEngine->PostInit();
+
+	std::printf("%d thread(s), %d steps of %.4f s per scenario\n", physicsWorld->GetThreadCount(), STEP_COUNT, STEP_DELTA_TIME);
+
+	RunScenario("BrickWall", CreateBrickWallScenario, nullptr, csvDirectory);
+	RunScenario("FallingSpheres", CreateFallingSpheresScenario, nullptr, csvDirectory);
+	RunScenario("Terrain", CreateTerrainScenario, nullptr, csvDirectory);
+	RunScenario("Characters", CreateCharactersScenario, UpdateCharactersScenario, csvDirectory);
+	RunScenario("CrowdCharacters", CreateCrowdCharactersScenario, UpdateCharactersScenario, csvDirectory);
+
+	delete benchmarkEngine;
+
+	return 0;
+}
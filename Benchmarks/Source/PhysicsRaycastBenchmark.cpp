@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "btBulletDynamicsCommon.h"
+
+#include "Goknar/Engine.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Physics/PhysicsWorld.h"
+
+// Measures raycast throughput of the single query API against the batched API on 1 thread and on all worker threads
+
+constexpr int OBSTACLE_GRID_SIZE = 100;
+constexpr float OBSTACLE_SPACING = 4.f;
+constexpr int RAYCAST_COUNT = 200000;
+constexpr int REPEAT_COUNT = 5;
+
+static float MeasureRaysPerMillisecond(const std::function<int()>& runRaycasts, int& outHitCount)
+{
+	float bestDuration = 1e9f;
+	for (int repeatIndex = 0; repeatIndex < REPEAT_COUNT; ++repeatIndex)
+	{
+		const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+		outHitCount = runRaycasts();
+		const float duration = std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(std::chrono::steady_clock::now() - startTimePoint).count();
+
+		if (duration < bestDuration)
+		{
+			bestDuration = duration;
+		}
+	}
+
+	return RAYCAST_COUNT / bestDuration;
+}
+
+int main(int argc, char** argv)
+{
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* benchmarkEngine = new Engine(true);
+
+	const int workerThreadCount = (int)std::thread::hardware_concurrency() - 1;
+
+	PhysicsWorld* physicsWorld = benchmarkEngine->GetPhysicsWorld();
+	physicsWorld->PreInit();
+
+	btDiscreteDynamicsWorld* dynamicsWorld = physicsWorld->GetBulletPhysicsWorld();
+
+	// Static ground and a grid of static boxes and spheres
+	std::vector<btCollisionShape*> collisionShapes;
+	std::vector<btCollisionObject*> collisionObjects;
+
+	btCollisionShape* groundShape = new btBoxShape(btVector3(500.f, 500.f, 1.f));
+	btCollisionShape* boxShape = new btBoxShape(btVector3(1.f, 1.f, 2.f));
+	btCollisionShape* sphereShape = new btSphereShape(1.5f);
+	collisionShapes = { groundShape, boxShape, sphereShape };
+
+	const float gridOffset = -0.5f * OBSTACLE_GRID_SIZE * OBSTACLE_SPACING;
+	for (int obstacleIndex = -1; obstacleIndex < OBSTACLE_GRID_SIZE * OBSTACLE_GRID_SIZE; ++obstacleIndex)
+	{
+		btTransform transform;
+		transform.setIdentity();
+
+		btCollisionObject* collisionObject = new btCollisionObject();
+		if (obstacleIndex < 0)
+		{
+			transform.setOrigin(btVector3(0.f, 0.f, -1.f));
+			collisionObject->setCollisionShape(groundShape);
+		}
+		else
+		{
+			const int x = obstacleIndex % OBSTACLE_GRID_SIZE;
+			const int y = obstacleIndex / OBSTACLE_GRID_SIZE;
+			transform.setOrigin(btVector3(gridOffset + x * OBSTACLE_SPACING, gridOffset + y * OBSTACLE_SPACING, 2.f));
+			collisionObject->setCollisionShape((x + y) % 2 == 0 ? boxShape : sphereShape);
+		}
+		collisionObject->setWorldTransform(transform);
+
+		dynamicsWorld->addCollisionObject(collisionObject);
+		collisionObjects.push_back(collisionObject);
+	}
+	dynamicsWorld->updateAabbs();
+
+	// Mix of downward rays and horizontal line of sight rays
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> positionDistribution(gridOffset, -gridOffset);
+
+	std::vector<RaycastData> raycastData(RAYCAST_COUNT);
+	for (int raycastIndex = 0; raycastIndex < RAYCAST_COUNT; ++raycastIndex)
+	{
+		const Vector3 from{ positionDistribution(randomEngine), positionDistribution(randomEngine), raycastIndex % 2 == 0 ? 100.f : 1.f };
+		const Vector3 to = raycastIndex % 2 == 0 ?
+			Vector3{ from.x, from.y, -100.f } :
+			Vector3{ positionDistribution(randomEngine), positionDistribution(randomEngine), 1.f };
+
+		raycastData[raycastIndex].from = from;
+		raycastData[raycastIndex].to = to;
+	}
+
+	std::vector<RaycastSingleResult> raycastResults(RAYCAST_COUNT);
+
+	std::printf("%d obstacles, %d raycasts\n", OBSTACLE_GRID_SIZE * OBSTACLE_GRID_SIZE, RAYCAST_COUNT);
+
+	int hitCount = 0;
+	float raysPerMillisecond = MeasureRaysPerMillisecond(
+		[&]()
+		{
+			int singleHitCount = 0;
+			for (int raycastIndex = 0; raycastIndex < RAYCAST_COUNT; ++raycastIndex)
+			{
+				if (physicsWorld->RaycastClosest(raycastData[raycastIndex], raycastResults[raycastIndex]))
+				{
+					++singleHitCount;
+				}
+			}
+			return singleHitCount;
+		}, hitCount);
+	std::printf("Single queries: %.1f rays/ms, %d hits\n", raysPerMillisecond, hitCount);
+
+	for (int batchWorkerThreadCount : { 0, workerThreadCount })
+	{
+		benchmarkEngine->GetJobManager()->SetWorkerThreadCount(batchWorkerThreadCount);
+
+		raysPerMillisecond = MeasureRaysPerMillisecond(
+			[&]()
+			{
+				return physicsWorld->RaycastClosestBatch(raycastData.data(), RAYCAST_COUNT, raycastResults.data());
+			}, hitCount);
+		std::printf("Batched queries on %d thread(s): %.1f rays/ms, %d hits\n", batchWorkerThreadCount + 1, raysPerMillisecond, hitCount);
+	}
+
+	for (btCollisionObject* collisionObject : collisionObjects)
+	{
+		dynamicsWorld->removeCollisionObject(collisionObject);
+		delete collisionObject;
+	}
+
+	for (btCollisionShape* collisionShape : collisionShapes)
+	{
+		delete collisionShape;
+	}
+
+	// Engine is not shut down since the window and the renderer were never initialized
+	return 0;
+}
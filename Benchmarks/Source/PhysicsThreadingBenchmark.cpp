@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "btBulletDynamicsCommon.h"
+
+#include "Goknar/Engine.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Physics/PhysicsWorld.h"
+
+// Steps a box stacking and debris scene on the multithreaded physics world with 1, 2, 4 and 8 threads
+
+constexpr int WALL_COUNT = 8;
+constexpr int WALL_WIDTH = 12;
+constexpr int WALL_HEIGHT = 12;
+constexpr int DEBRIS_COUNT = 1500;
+constexpr int STEP_COUNT = 600;
+constexpr float STEP_DELTA_TIME = 1.f / 60.f;
+
+struct BenchmarkScene
+{
+	std::vector<btCollisionShape*> collisionShapes;
+	std::vector<btRigidBody*> rigidBodies;
+};
+
+static btRigidBody* CreateRigidBody(btDiscreteDynamicsWorld* dynamicsWorld, BenchmarkScene& scene, btCollisionShape* collisionShape, float mass, const btVector3& position)
+{
+	btVector3 localInertia(0.f, 0.f, 0.f);
+	if (0.f < mass)
+	{
+		collisionShape->calculateLocalInertia(mass, localInertia);
+	}
+
+	btTransform transform;
+	transform.setIdentity();
+	transform.setOrigin(position);
+
+	btRigidBody::btRigidBodyConstructionInfo constructionInfo(mass, new btDefaultMotionState(transform), collisionShape, localInertia);
+	btRigidBody* rigidBody = new btRigidBody(constructionInfo);
+	dynamicsWorld->addRigidBody(rigidBody);
+
+	scene.rigidBodies.push_back(rigidBody);
+	return rigidBody;
+}
+
+static void CreateScene(btDiscreteDynamicsWorld* dynamicsWorld, BenchmarkScene& scene)
+{
+	btCollisionShape* groundShape = new btBoxShape(btVector3(200.f, 200.f, 1.f));
+	btCollisionShape* brickShape = new btBoxShape(btVector3(0.5f, 0.25f, 0.25f));
+	btCollisionShape* debrisShape = new btSphereShape(0.2f);
+	scene.collisionShapes = { groundShape, brickShape, debrisShape };
+
+	CreateRigidBody(dynamicsWorld, scene, groundShape, 0.f, btVector3(0.f, 0.f, -1.f));
+
+	for (int wallIndex = 0; wallIndex < WALL_COUNT; ++wallIndex)
+	{
+		const float wallY = -20.f + wallIndex * 5.f;
+		for (int row = 0; row < WALL_HEIGHT; ++row)
+		{
+			// Every other row is shifted by half a brick
+			const float rowOffset = (row % 2) * 0.5f;
+			for (int column = 0; column < WALL_WIDTH; ++column)
+			{
+				CreateRigidBody(dynamicsWorld, scene, brickShape, 1.f, btVector3(-6.f + column * 1.f + rowOffset, wallY, 0.25f + row * 0.5f));
+			}
+		}
+	}
+
+	// Fixed seed so every thread count simulates the same scene
+	std::mt19937 randomEngine(42);
+	std::uniform_real_distribution<float> horizontalDistribution(-8.f, 8.f);
+	std::uniform_real_distribution<float> verticalDistribution(10.f, 40.f);
+	for (int debrisIndex = 0; debrisIndex < DEBRIS_COUNT; ++debrisIndex)
+	{
+		CreateRigidBody(dynamicsWorld, scene, debrisShape, 0.2f,
+			btVector3(horizontalDistribution(randomEngine), -22.f + horizontalDistribution(randomEngine) * 2.5f, verticalDistribution(randomEngine)));
+	}
+}
+
+static void DestroyScene(btDiscreteDynamicsWorld* dynamicsWorld, BenchmarkScene& scene)
+{
+	for (btRigidBody* rigidBody : scene.rigidBodies)
+	{
+		dynamicsWorld->removeRigidBody(rigidBody);
+		delete rigidBody->getMotionState();
+		delete rigidBody;
+	}
+	scene.rigidBodies.clear();
+
+	for (btCollisionShape* collisionShape : scene.collisionShapes)
+	{
+		delete collisionShape;
+	}
+	scene.collisionShapes.clear();
+}
+
+int main(int argc, char** argv)
+{
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* benchmarkEngine = new Engine(true);
+	benchmarkEngine->GetJobManager()->SetWorkerThreadCount(7);
+
+	PhysicsWorld* physicsWorld = benchmarkEngine->GetPhysicsWorld();
+	physicsWorld->SetIsMultithreaded(true);
+	physicsWorld->PreInit();
+
+	btDiscreteDynamicsWorld* dynamicsWorld = physicsWorld->GetBulletPhysicsWorld();
+
+	std::printf("%d bricks, %d debris spheres, %d steps of %.4f s\n", WALL_COUNT * WALL_WIDTH * WALL_HEIGHT, DEBRIS_COUNT, STEP_COUNT, STEP_DELTA_TIME);
+
+	float singleThreadAverageStepTime = 0.f;
+	for (int threadCount : { 1, 2, 4, 8 })
+	{
+		physicsWorld->SetThreadCount(threadCount);
+
+		BenchmarkScene scene;
+		CreateScene(dynamicsWorld, scene);
+
+		std::vector<float> stepTimes(STEP_COUNT);
+		for (int stepIndex = 0; stepIndex < STEP_COUNT; ++stepIndex)
+		{
+			const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+			physicsWorld->PhysicsTick(STEP_DELTA_TIME);
+			stepTimes[stepIndex] = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+		}
+
+		DestroyScene(dynamicsWorld, scene);
+
+		float totalStepTime = 0.f;
+		for (float stepTime : stepTimes)
+		{
+			totalStepTime += stepTime;
+		}
+		const float averageStepTime = totalStepTime / STEP_COUNT;
+
+		std::sort(stepTimes.begin(), stepTimes.end());
+		const float p95StepTime = stepTimes[(int)(STEP_COUNT * 0.95f)];
+
+		if (threadCount == 1)
+		{
+			singleThreadAverageStepTime = averageStepTime;
+		}
+
+		std::printf("%d thread(s) [%d used]: average %.3f ms, p95 %.3f ms, max %.3f ms, speedup %.2fx\n",
+			threadCount, physicsWorld->GetThreadCount(),
+			averageStepTime * 1000.f, p95StepTime * 1000.f, stepTimes.back() * 1000.f,
+			singleThreadAverageStepTime / averageStepTime);
+	}
+
+	// Engine is not shut down since the window and the renderer were never initialized
+	return 0;
+}
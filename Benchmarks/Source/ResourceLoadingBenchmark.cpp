@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Goknar/Core.h"
+#include "Goknar/Engine.h"
+#include "Goknar/Contents/Content.h"
+#include "Goknar/Managers/ResourceManager.h"
+
+// Loads every image and model in the game project's content directory
+// synchronously with GetContent or asynchronously with RequestContentAsync and reports the longest main thread stall
+// Usage: ResourceLoadingBenchmark [sync|async] [mips]
+// Modes run in separate processes since loaded contents stay cached in the resource manager
+// mips precomputes the mip chains of the images while decoding them
+
+static std::vector<std::string> CollectContentPaths()
+{
+	std::vector<std::string> contentPaths;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(ContentDir))
+	{
+		if (!entry.is_regular_file())
+		{
+			continue;
+		}
+
+		const std::string path = entry.path().generic_string();
+		const ResourceType resourceType = ResourceManagerUtils::GetResourceType(path);
+		if (resourceType == ResourceType::Image || resourceType == ResourceType::Model)
+		{
+			contentPaths.push_back(std::filesystem::relative(entry.path(), ContentDir).generic_string());
+		}
+	}
+
+	std::sort(contentPaths.begin(), contentPaths.end());
+	return contentPaths;
+}
+
+static float GetElapsedTime(const std::chrono::steady_clock::time_point& startTimePoint)
+{
+	return std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+}
+
+int main(int argc, char** argv)
+{
+	const bool isAsync = argc < 2 || std::string(argv[1]) != "sync";
+	const bool isPrecomputingImageMipmaps = 2 < argc && std::string(argv[2]) == "mips";
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* benchmarkEngine = new Engine(true);
+	ResourceManager* resourceManager = benchmarkEngine->GetResourceManager();
+	resourceManager->SetIsPrecomputingImageMipmaps(isPrecomputingImageMipmaps);
+
+	const std::vector<std::string> contentPaths = CollectContentPaths();
+	std::printf("%d contents in %s, %s loading\n", (int)contentPaths.size(), ContentDir.c_str(), isAsync ? "async" : "sync");
+
+	int loadedContentCount = 0;
+	int frameCount = 0;
+	float longestStallTime = 0.f;
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+	if (isAsync)
+	{
+		const std::chrono::steady_clock::time_point requestTimePoint = std::chrono::steady_clock::now();
+		for (const std::string& contentPath : contentPaths)
+		{
+			resourceManager->RequestContentAsync(contentPath,
+				[&loadedContentCount](Content* content)
+				{
+					if (content)
+					{
+						++loadedContentCount;
+					}
+				});
+		}
+		longestStallTime = GetElapsedTime(requestTimePoint);
+
+		while (0 < resourceManager->GetPendingContentLoadCount())
+		{
+			const std::chrono::steady_clock::time_point frameTimePoint = std::chrono::steady_clock::now();
+			resourceManager->ProcessContentLoads();
+			longestStallTime = std::max(longestStallTime, GetElapsedTime(frameTimePoint));
+			++frameCount;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	else
+	{
+		for (const std::string& contentPath : contentPaths)
+		{
+			const std::chrono::steady_clock::time_point loadTimePoint = std::chrono::steady_clock::now();
+			if (resourceManager->GetContent<Content>(contentPath))
+			{
+				++loadedContentCount;
+			}
+			longestStallTime = std::max(longestStallTime, GetElapsedTime(loadTimePoint));
+		}
+	}
+	const float totalTime = GetElapsedTime(startTimePoint);
+
+	std::printf("%d loaded, total %.3f ms, longest main thread stall %.3f ms, %d frame(s)\n",
+		loadedContentCount, totalTime * 1000.f, longestStallTime * 1000.f, frameCount);
+
+	// Per thread rate is measured over the decoding times, total rate over the wall time of the whole load
+	const float decodedImageMegabytes = resourceManager->GetDecodedImageByteCount() / 1000000.f;
+	std::printf("%.2f MB of images decoded%s, %.2f MB/s per thread, %.2f MB/s total\n",
+		decodedImageMegabytes, isPrecomputingImageMipmaps ? " with mips" : "",
+		resourceManager->GetImageDecodeRate(), decodedImageMegabytes / totalTime);
+
+	// Engine is not shut down since the window and the renderer were never initialized
+	return 0;
+}
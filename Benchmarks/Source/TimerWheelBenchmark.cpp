@@ -0,0 +1,137 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Goknar/Engine.h"
+#include "Goknar/TimeDependentObject.h"
+#include "Goknar/Timer.h"
+#include "Goknar/Managers/TimerManager.h"
+
+// Compares 100k timers on the timer wheel against the same timers polled every frame
+
+constexpr int TIMER_COUNT = 100000;
+constexpr int FRAME_COUNT = 3600;
+constexpr float FRAME_DELTA_TIME = 1.f / 60.f;
+
+static int firedTimerCount = 0;
+
+static void OnTimerFired()
+{
+	++firedTimerCount;
+}
+
+// Behaves like the timers before the timer wheel, checks its elapsed time every frame
+class PolledTimer : public TimeDependentObject
+{
+public:
+	PolledTimer(float timeToTick) :
+		TimeDependentObject(),
+		timeToTick_(timeToTick)
+	{
+	}
+
+	virtual void Tick(float deltaSecond) override
+	{
+		elapsedTime_ += deltaSecond;
+		if (timeToTick_ < elapsedTime_)
+		{
+			elapsedTime_ -= timeToTick_;
+			OnTimerFired();
+		}
+	}
+
+private:
+	float timeToTick_;
+	float elapsedTime_{ 0.f };
+};
+
+static float GetSecondsSince(const std::chrono::steady_clock::time_point& timePoint)
+{
+	return std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - timePoint).count();
+}
+
+int main(int argc, char** argv)
+{
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* benchmarkEngine = new Engine(true);
+	TimerManager* timerManager = benchmarkEngine->GetTimerManager();
+
+	std::mt19937 randomEngine(1234);
+	std::uniform_real_distribution<float> timeToTickDistribution(0.5f, 10.f);
+
+	std::vector<float> timesToTick(TIMER_COUNT);
+	for (float& timeToTick : timesToTick)
+	{
+		timeToTick = timeToTickDistribution(randomEngine);
+	}
+
+	// Timer wheel
+	std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	std::vector<Timer*> timers(TIMER_COUNT);
+	for (int timerIndex = 0; timerIndex < TIMER_COUNT; ++timerIndex)
+	{
+		Timer* timer = new Timer();
+		timer->SetTimeToTick(timesToTick[timerIndex]);
+		timer->CallOnTick(Delegate<void()>::Create<&OnTimerFired>());
+		timers[timerIndex] = timer;
+	}
+
+	const float timerScheduleDuration = GetSecondsSince(startTimePoint);
+
+	firedTimerCount = 0;
+	startTimePoint = std::chrono::steady_clock::now();
+	for (int frameIndex = 0; frameIndex < FRAME_COUNT; ++frameIndex)
+	{
+		timerManager->Tick(FRAME_DELTA_TIME);
+	}
+	const float timerWheelTickDuration = GetSecondsSince(startTimePoint);
+	const int timerWheelFiredTimerCount = firedTimerCount;
+
+	startTimePoint = std::chrono::steady_clock::now();
+	for (Timer* timer : timers)
+	{
+		timer->SetIsActive(false);
+	}
+	const float timerCancelDuration = GetSecondsSince(startTimePoint);
+
+	for (Timer* timer : timers)
+	{
+		delete timer;
+	}
+	timers.clear();
+
+	// Polling every frame
+	std::vector<PolledTimer*> polledTimers(TIMER_COUNT);
+	for (int timerIndex = 0; timerIndex < TIMER_COUNT; ++timerIndex)
+	{
+		polledTimers[timerIndex] = new PolledTimer(timesToTick[timerIndex]);
+	}
+
+	firedTimerCount = 0;
+	startTimePoint = std::chrono::steady_clock::now();
+	for (int frameIndex = 0; frameIndex < FRAME_COUNT; ++frameIndex)
+	{
+		timerManager->Tick(FRAME_DELTA_TIME);
+	}
+	const float pollingTickDuration = GetSecondsSince(startTimePoint);
+	const int pollingFiredTimerCount = firedTimerCount;
+
+	startTimePoint = std::chrono::steady_clock::now();
+	for (PolledTimer* polledTimer : polledTimers)
+	{
+		delete polledTimer;
+	}
+	const float polledTimerRemoveDuration = GetSecondsSince(startTimePoint);
+	polledTimers.clear();
+
+	std::printf("%d timers, %d frames of %.4f s\n", TIMER_COUNT, FRAME_COUNT, FRAME_DELTA_TIME);
+	std::printf("Timer wheel: schedule %.3f ms, cancel %.3f ms, %.4f ms/frame, %d fires\n",
+		timerScheduleDuration * 1000.f, timerCancelDuration * 1000.f, timerWheelTickDuration * 1000.f / FRAME_COUNT, timerWheelFiredTimerCount);
+	std::printf("Polling:     remove %.3f ms, %.4f ms/frame, %d fires\n",
+		polledTimerRemoveDuration * 1000.f, pollingTickDuration * 1000.f / FRAME_COUNT, pollingFiredTimerCount);
+
+	// Engine is not shut down since the window and the renderer were never initialized
+	return 0;
+}
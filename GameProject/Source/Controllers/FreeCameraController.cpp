@@ -16,6 +16,7 @@
 #include "Goknar/Materials/MaterialBase.h"
 #include "Goknar/Model/MeshUnit.h"
 #include "Goknar/Model/IMeshInstance.h"
+#include "Goknar/Physics/PhysicsStats.h"
 #include "Goknar/Physics/PhysicsWorld.h"
 #include "Goknar/Physics/RigidBody.h"
 #include "Goknar/Physics/Components/BoxCollisionComponent.h"
@@ -69,6 +70,13 @@ FreeCameraController::FreeCameraController(FreeCameraObject* freeCameraObject) :
 
 	toggleTimeScaleDelegate_ = []() { engine->SetTimeScale(0.f < engine->GetTimeScale() ? 0.f : 1.f); };
 
+	dumpPhysicsStatsDelegate_ = []()
+		{
+			const PhysicsStats* physicsStats = engine->GetPhysicsWorld()->GetStats();
+			physicsStats->SaveToCSV(ContentDir + "PhysicsStats.csv");
+			physicsStats->SaveToJSON(ContentDir + "PhysicsStats.json");
+		};
+
 	toggleDebugObjectsDelegate_ = []()
 		{
 			Game* game = dynamic_cast<Game*>(engine->GetApplication());
@@ -259,6 +267,8 @@ void FreeCameraController::BindInputDelegates()
 
 	inputManager->AddKeyboardInputDelegate(KEY_MAP::F5, INPUT_ACTION::G_PRESS, toggleDebugObjectsDelegate_);
 
+	inputManager->AddKeyboardInputDelegate(KEY_MAP::F9, INPUT_ACTION::G_PRESS, dumpPhysicsStatsDelegate_);
+
 	inputManager->AddCursorDelegate(onCursorMoveDelegate_);
 	inputManager->AddScrollDelegate(onScrollMoveDelegate_);
 }
@@ -288,6 +298,8 @@ void FreeCameraController::UnbindInputDelegates()
 
 	inputManager->RemoveKeyboardInputDelegate(KEY_MAP::F5, INPUT_ACTION::G_PRESS, toggleDebugObjectsDelegate_);
 
+	inputManager->RemoveKeyboardInputDelegate(KEY_MAP::F9, INPUT_ACTION::G_PRESS, dumpPhysicsStatsDelegate_);
+
 	inputManager->RemoveCursorDelegate(onScrollMoveDelegate_);
 	inputManager->RemoveScrollDelegate(onCursorMoveDelegate_);
 }
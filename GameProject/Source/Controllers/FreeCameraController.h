@@ -100,6 +100,8 @@ private:
 
 	Delegate<void()> toggleDebugObjectsDelegate_;
 
+	Delegate<void()> dumpPhysicsStatsDelegate_;
+
 	Delegate<void(double, double)> onScrollMoveDelegate_;
 	Delegate<void(double, double)> onCursorMoveDelegate_;
 
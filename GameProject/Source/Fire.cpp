@@ -11,6 +11,7 @@ Fire::Fire() :
 	ObjectBase()
 {
 	SetIsTickable(true);
+	SetIsTickLODEnabled(true);
 
 	fireLight_ = new PointLight();
 	fireLight_->SetColor(Vector3{ 0.7605246901512146f, 0.09758714586496353f, 0.015996338799595833f });
@@ -11,6 +11,8 @@
 #include "Goknar/Camera.h"
 #include "Goknar/Managers/CameraManager.h"
 #include "Goknar/Managers/WindowManager.h"
+#include "Goknar/Physics/PhysicsStats.h"
+#include "Goknar/Physics/PhysicsWorld.h"
 
 #include "Archer.h"
 #include "ArcherCharacter.h"
@@ -33,6 +35,9 @@ Game::Game() : Application()
 	engine->SetApplication(this);
 
 	engine->GetRenderer()->SetMainRenderType(RenderPassType::Deferred);
+	engine->SetTickLODLevels({ { 50.f, 1.f / 30.f }, { 100.f, 0.1f }, { 200.f, 0.25f } });
+	engine->GetPhysicsWorld()->SetIsFixedTimeStepEnabled(true);
+	engine->GetPhysicsWorld()->GetStats()->SetIsEnabled(true);
 
 	std::chrono::steady_clock::time_point lastFrameTimePoint = std::chrono::steady_clock::now();
 	mainScene_->ReadSceneData("Scenes/Scene.xml");
@@ -4,6 +4,7 @@
 
 #include "Goknar/Engine.h"
 #include "Goknar/Components/StaticMeshComponent.h"
+#include "Goknar/Factories/SpawnBatch.h"
 #include "Goknar/Managers/ResourceManager.h"
 #include "Goknar/Model/StaticMesh.h"
 #include "Goknar/Materials/MaterialBase.h"
@@ -46,35 +47,54 @@ void RandomGrassSpawner::BeginGame()
 	std::uniform_real_distribution<float> rotationDist(0.f, 1.f);
 	std::uniform_real_distribution<float> scalingDist(0.f, 1.f);
 
+	// Grass instances are constructed over multiple frames by the engine
+	SpawnBatch* grassSpawnBatch = new SpawnBatch(
+		[grassStaticMesh]() -> ObjectBase*
+		{
+			ObjectBase* grass = new ObjectBase();
+			StaticMeshComponent* grassComponent = grass->AddSubComponent<StaticMeshComponent>();
+			grassComponent->SetMesh(grassStaticMesh);
+			grassComponent->GetMeshInstance()->SetIsCastingShadow(false);
+			return grass;
+		});
+	constexpr int grassCount = 64 * 64;
+	grassSpawnBatch->Reserve(grassCount);
+
+	std::vector<RaycastData> raycastData(grassCount);
+	std::vector<RaycastSingleResult> raycastResults(grassCount);
+	std::vector<Quaternion> randomRotations(grassCount);
+	std::vector<Vector3> randomScalings(grassCount);
+
 	for (int y = 0; y < 64; ++y)
 	{
 		for (int x = 0; x < 64; ++x)
 		{
+			const int grassIndex = y * 64 + x;
+
 			float randomPositionX = GoknarMath::Lerp(minPositionDifferenceX, maxPositionDifferenceX, positionDistX(rd));
 			float randomPositionY = GoknarMath::Lerp(minPositionDifferenceY, maxPositionDifferenceY, positionDistY(rd));
-			Quaternion randomRotationOnZ = Quaternion::FromEulerRadians(Vector3{ 0.f, 0.f, GoknarMath::Lerp(minRotationOnZ, maxRotationOnZ, rotationDist(rd)) });
-			Vector3 randomScaling = Vector3{ GoknarMath::Lerp(minScale, maxScale, scalingDist(rd)) };
+			randomRotations[grassIndex] = Quaternion::FromEulerRadians(Vector3{ 0.f, 0.f, GoknarMath::Lerp(minRotationOnZ, maxRotationOnZ, rotationDist(rd)) });
+			randomScalings[grassIndex] = Vector3{ GoknarMath::Lerp(minScale, maxScale, scalingDist(rd)) };
 
 			Vector3 randomPosition = initialPosition + Vector3{ x * xDiff + randomPositionX, y * yDiff + randomPositionY, 0.f };
 
-			RaycastData raycastData;
-			raycastData.from = randomPosition + Vector3{ 0.f, 0.f, 1000.f };
-			raycastData.to = randomPosition - Vector3{ 0.f, 0.f, 1000.f };
-
-			RaycastSingleResult raycastResult;
-
-			if (engine->GetPhysicsWorld()->RaycastClosest(raycastData, raycastResult))
-			{
-				ObjectBase* grass = new ObjectBase();
-				StaticMeshComponent* grassComponent = grass->AddSubComponent<StaticMeshComponent>();
-				grassComponent->SetMesh(grassStaticMesh);
-				grassComponent->GetMeshInstance()->SetIsCastingShadow(false);
-				grass->SetWorldPosition(raycastResult.hitPosition);
-				grass->SetWorldRotation(randomRotationOnZ);
-				grass->SetWorldScaling(randomScaling);
-			}
+			raycastData[grassIndex].from = randomPosition + Vector3{ 0.f, 0.f, 1000.f };
+			raycastData[grassIndex].to = randomPosition - Vector3{ 0.f, 0.f, 1000.f };
+		}
+	}
+
+	// Ground heights are found in one parallel batch
+	engine->GetPhysicsWorld()->RaycastClosestBatch(raycastData.data(), grassCount, raycastResults.data());
+
+	for (int grassIndex = 0; grassIndex < grassCount; ++grassIndex)
+	{
+		if (raycastResults[grassIndex].hitObject)
+		{
+			grassSpawnBatch->AddInstance(raycastResults[grassIndex].hitPosition, randomRotations[grassIndex], randomScalings[grassIndex]);
 		}
 	}
+
+	engine->AddSpawnBatch(grassSpawnBatch);
 }
 
 void RandomGrassSpawner::Tick(float deltaTime)
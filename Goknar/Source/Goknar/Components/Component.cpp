@@ -11,7 +11,8 @@ Component::Component(Component* parent) :
 	isTickable_(false),
 	isTickEnabled_(true),
 	isInitialized_(false),
-	isPendingDestroy_(false)
+	isPendingDestroy_(false),
+	isTickThreadSafe_(false)
 {
 	engine->RegisterComponent(this);
 	GUID_ = ObjectIDManager::GetInstance()->GetAndIncreaseComponentID();
@@ -88,6 +89,74 @@ void Component::SetIsTickable(bool isTickable)
 	}
 }
 
+void Component::SetIsTickEnabled(bool isTickEnabled)
+{
+	isTickEnabled_ = isTickEnabled;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void Component::SetTickGroup(TickGroup tickGroup)
+{
+	tickGroup_ = tickGroup;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void Component::SetIsTickThreadSafe(bool isTickThreadSafe)
+{
+	isTickThreadSafe_ = isTickThreadSafe;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void Component::AddTickPrerequisite(Component* prerequisite)
+{
+	if (!prerequisite || prerequisite == this)
+	{
+		return;
+	}
+
+	tickPrerequisites_.push_back(prerequisite);
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void Component::RemoveTickPrerequisite(Component* prerequisite)
+{
+	std::vector<Component*>::iterator tickPrerequisitesIterator = tickPrerequisites_.begin();
+	for (; tickPrerequisitesIterator != tickPrerequisites_.end(); ++tickPrerequisitesIterator)
+	{
+		if ((*tickPrerequisitesIterator) == prerequisite)
+		{
+			tickPrerequisites_.erase(tickPrerequisitesIterator);
+			break;
+		}
+	}
+
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void Component::SetIsActive(bool isActive)
+{
+	isActive_ = isActive;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
 void Component::PreInit()
 {
 }
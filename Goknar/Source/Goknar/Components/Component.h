@@ -2,6 +2,8 @@
 #define __COMPONENT_H__
 
 #include "Goknar/Core.h"
+#include "Goknar/TickTypes.h"
+#include "Goknar/Managers/MemoryManager.h"
 #include "Goknar/Math/Matrix.h"
 
 class Engine;
@@ -18,6 +20,8 @@ public:
 
 	}
 
+	GOKNAR_POOLED_ALLOCATION(AllocationCategory::Component)
+
 	virtual void PreInit();
 	virtual void Init();
 	virtual void PostInit();
@@ -121,9 +125,70 @@ public:
 		return isTickEnabled_;
 	}
 
-	void SetIsTickEnabled(bool isTickEnabled)
+	void SetIsTickEnabled(bool isTickEnabled);
+
+	TickGroup GetTickGroup() const
+	{
+		return tickGroup_;
+	}
+
+	void SetTickGroup(TickGroup tickGroup);
+
+	float GetTickInterval() const
+	{
+		return tickInterval_;
+	}
+
+	// Component ticks at most once per tickInterval seconds with the delta time accumulated since its last tick
+	// 0 ticks every frame
+	void SetTickInterval(float tickInterval)
+	{
+		tickInterval_ = tickInterval;
+	}
+
+	bool GetIsTickLODEnabled() const
+	{
+		return isTickLODEnabled_;
+	}
+
+	// Tick interval is increased by the engine's tick LOD levels according to the distance to the active camera
+	void SetIsTickLODEnabled(bool isTickLODEnabled)
+	{
+		isTickLODEnabled_ = isTickLODEnabled;
+		if (!isTickLODEnabled)
+		{
+			tickLODInterval_ = 0.f;
+		}
+	}
+
+	void SetTickLODInterval(float tickLODInterval)
+	{
+		tickLODInterval_ = tickLODInterval;
+	}
+
+	// Returns true and the delta time to tick with if the component should tick this frame
+	bool ConsumeTickDeltaTime(float deltaTime, float& outDeltaTime)
+	{
+		return tickThrottle_.Advance(tickInterval_ < tickLODInterval_ ? tickLODInterval_ : tickInterval_, deltaTime, outDeltaTime);
+	}
+
+	// Thread-safe components are ticked in parallel with the other thread-safe components of their tick group
+	// Their TickComponent must only modify the component itself and must not create or destroy objects/components
+	bool GetIsTickThreadSafe() const
 	{
-		isTickEnabled_ = isTickEnabled;
+		return isTickThreadSafe_;
+	}
+
+	void SetIsTickThreadSafe(bool isTickThreadSafe);
+
+	// Component is ticked after the prerequisite component in the same frame
+	// Prerequisites in a later tick group than this component are ignored
+	void AddTickPrerequisite(Component* prerequisite);
+	void RemoveTickPrerequisite(Component* prerequisite);
+
+	const std::vector<Component*>& GetTickPrerequisites() const
+	{
+		return tickPrerequisites_;
 	}
 
 	virtual void Destroy();
@@ -152,10 +217,7 @@ public:
 		return owner_;
 	}
 
-	virtual void SetIsActive(bool isActive)
-	{
-		isActive_ = isActive;
-	}
+	virtual void SetIsActive(bool isActive);
 
 	bool GetIsActive() const
 	{
@@ -224,17 +286,25 @@ protected:
 	Vector3 worldScaling_{ Vector3(1.f) };
 
 	std::vector<Component*> children_;
+	std::vector<Component*> tickPrerequisites_;
 
 	ObjectBase* owner_{ nullptr };
 	Component* parent_{ nullptr };
 
 	unsigned int GUID_{ 0 };
 
+	TickGroup tickGroup_{ TickGroup::PostPhysics };
+	TickThrottle tickThrottle_{};
+	float tickInterval_{ 0.f };
+	float tickLODInterval_{ 0.f };
+	bool isTickLODEnabled_{ false };
+
 	unsigned char isActive_ : 1;
 	unsigned char isTickable_ : 1;
 	unsigned char isTickEnabled_ : 1;
 	unsigned char isInitialized_ : 1;
 	unsigned char isPendingDestroy_ : 1;
+	unsigned char isTickThreadSafe_ : 1;
 private:
 };
 #endif
\ No newline at end of file
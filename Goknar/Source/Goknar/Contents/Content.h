@@ -5,6 +5,69 @@
 
 #include <string>
 
+enum class GOKNAR_API ContentMemoryCategory : unsigned char
+{
+	Texture = 0,
+	Mesh,
+	Animation,
+	Count
+};
+
+// Bytes a content keeps in CPU and GPU memory per category
+struct GOKNAR_API ContentMemoryUsage
+{
+	unsigned long long GetByteCount(ContentMemoryCategory category) const
+	{
+		return cpuByteCounts[(int)category] + gpuByteCounts[(int)category];
+	}
+
+	unsigned long long GetCPUByteCount() const
+	{
+		unsigned long long cpuByteCount = 0;
+		for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+		{
+			cpuByteCount += cpuByteCounts[categoryIndex];
+		}
+		return cpuByteCount;
+	}
+
+	unsigned long long GetGPUByteCount() const
+	{
+		unsigned long long gpuByteCount = 0;
+		for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+		{
+			gpuByteCount += gpuByteCounts[categoryIndex];
+		}
+		return gpuByteCount;
+	}
+
+	unsigned long long GetTotalByteCount() const
+	{
+		return GetCPUByteCount() + GetGPUByteCount();
+	}
+
+	void Add(const ContentMemoryUsage& other)
+	{
+		for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+		{
+			cpuByteCounts[categoryIndex] += other.cpuByteCounts[categoryIndex];
+			gpuByteCounts[categoryIndex] += other.gpuByteCounts[categoryIndex];
+		}
+	}
+
+	void Subtract(const ContentMemoryUsage& other)
+	{
+		for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+		{
+			cpuByteCounts[categoryIndex] -= other.cpuByteCounts[categoryIndex];
+			gpuByteCounts[categoryIndex] -= other.gpuByteCounts[categoryIndex];
+		}
+	}
+
+	unsigned long long cpuByteCounts[(int)ContentMemoryCategory::Count]{};
+	unsigned long long gpuByteCounts[(int)ContentMemoryCategory::Count]{};
+};
+
 class GOKNAR_API Content
 {
 public:
@@ -26,6 +89,9 @@ public:
 	virtual void Init() {}
 	virtual void PostInit() {}
 
+	// Adds the bytes the content currently keeps in memory, contents without a category add nothing
+	virtual void GetMemoryUsage(ContentMemoryUsage& memoryUsage) const {}
+
 	const std::string& GetPath() const
 	{
 		return path_;
@@ -6,6 +6,12 @@
 #include "Goknar/Engine.h"
 #include "Goknar/Scene.h"
 #include "Renderer/Texture.h"
+#include "Renderer/TextureCompression.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GOKNAR_IMAGE_USE_SSE2
+#endif
 
 Image::Image() :
 	Content(),
@@ -41,12 +47,229 @@ Image::Image(const std::string& path, int width, int height, int channels, unsig
 {
 }
 
+Image::~Image()
+{
+	// Mip levels are owned by the generated texture once it is created
+	for (unsigned char* mipmapBuffer : mipmapBuffers_)
+	{
+		delete[] mipmapBuffer;
+	}
+}
+
+// Sums the two source rows into 16 bit sums
+static void SumRows(const unsigned char* firstRow, const unsigned char* secondRow, int byteCount, unsigned short* rowSums)
+{
+	int byteIndex = 0;
+
+#ifdef GOKNAR_IMAGE_USE_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; byteIndex + 16 <= byteCount; byteIndex += 16)
+	{
+		const __m128i firstBytes = _mm_loadu_si128((const __m128i*)(firstRow + byteIndex));
+		const __m128i secondBytes = _mm_loadu_si128((const __m128i*)(secondRow + byteIndex));
+
+		const __m128i lowSums = _mm_add_epi16(_mm_unpacklo_epi8(firstBytes, zero), _mm_unpacklo_epi8(secondBytes, zero));
+		const __m128i highSums = _mm_add_epi16(_mm_unpackhi_epi8(firstBytes, zero), _mm_unpackhi_epi8(secondBytes, zero));
+
+		_mm_storeu_si128((__m128i*)(rowSums + byteIndex), lowSums);
+		_mm_storeu_si128((__m128i*)(rowSums + byteIndex + 8), highSums);
+	}
+#endif
+
+	for (; byteIndex < byteCount; ++byteIndex)
+	{
+		rowSums[byteIndex] = (unsigned short)(firstRow[byteIndex] + secondRow[byteIndex]);
+	}
+}
+
+// 2x2 box filter, edges are clamped for the dimensions of size 1 and the last row or column of odd sizes is dropped
+static void DownsampleBox(const unsigned char* source, int sourceWidth, int sourceHeight, int channels, unsigned char* destination, std::vector<unsigned short>& rowSums)
+{
+	const int destinationWidth = 1 < sourceWidth ? sourceWidth / 2 : 1;
+	const int destinationHeight = 1 < sourceHeight ? sourceHeight / 2 : 1;
+	const int sourceRowSize = sourceWidth * channels;
+
+	rowSums.resize(sourceRowSize);
+
+	for (int destinationY = 0; destinationY < destinationHeight; ++destinationY)
+	{
+		const unsigned char* firstRow = source + (1 < sourceHeight ? 2 * destinationY : 0) * sourceRowSize;
+		const unsigned char* secondRow = 1 < sourceHeight ? firstRow + sourceRowSize : firstRow;
+		SumRows(firstRow, secondRow, sourceRowSize, rowSums.data());
+
+		unsigned char* destinationRow = destination + destinationY * destinationWidth * channels;
+		for (int destinationX = 0; destinationX < destinationWidth; ++destinationX)
+		{
+			const int firstColumnOffset = (1 < sourceWidth ? 2 * destinationX : 0) * channels;
+			const int secondColumnOffset = 1 < sourceWidth ? firstColumnOffset + channels : firstColumnOffset;
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				destinationRow[destinationX * channels + channel] = (unsigned char)((rowSums[firstColumnOffset + channel] + rowSums[secondColumnOffset + channel] + 2) >> 2);
+			}
+		}
+	}
+}
+
+void Image::GenerateMipmaps()
+{
+	if (!buffer_ || !mipmapBuffers_.empty() || compressionFormat_ != TextureCompressionFormat::None)
+	{
+		return;
+	}
+
+	std::vector<unsigned short> rowSums;
+
+	const unsigned char* sourceBuffer = buffer_;
+	int sourceWidth = width_;
+	int sourceHeight = height_;
+	while (1 < sourceWidth || 1 < sourceHeight)
+	{
+		const int mipmapWidth = 1 < sourceWidth ? sourceWidth / 2 : 1;
+		const int mipmapHeight = 1 < sourceHeight ? sourceHeight / 2 : 1;
+
+		unsigned char* mipmapBuffer = new unsigned char[mipmapWidth * mipmapHeight * channels_];
+		DownsampleBox(sourceBuffer, sourceWidth, sourceHeight, channels_, mipmapBuffer, rowSums);
+		mipmapBuffers_.push_back(mipmapBuffer);
+
+		sourceBuffer = mipmapBuffer;
+		sourceWidth = mipmapWidth;
+		sourceHeight = mipmapHeight;
+	}
+}
+
+unsigned long long Image::GetByteSize() const
+{
+	unsigned long long byteSize = 0;
+
+	const int mipLevelCount = mipmapBuffers_.empty() ? mipLevelCount_ : (int)mipmapBuffers_.size() + 1;
+
+	int mipmapWidth = width_;
+	int mipmapHeight = height_;
+	for (int mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+	{
+		byteSize +=
+			compressionFormat_ == TextureCompressionFormat::None ?
+			(unsigned long long)mipmapWidth * mipmapHeight * channels_ :
+			TextureCompression::GetCompressedByteSize(compressionFormat_, mipmapWidth, mipmapHeight);
+
+		mipmapWidth = 1 < mipmapWidth ? mipmapWidth / 2 : 1;
+		mipmapHeight = 1 < mipmapHeight ? mipmapHeight / 2 : 1;
+	}
+
+	return byteSize;
+}
+
+void Image::GetMemoryUsage(ContentMemoryUsage& memoryUsage) const
+{
+	const int category = (int)ContentMemoryCategory::Texture;
+	if (isEvicted_)
+	{
+		return;
+	}
+
+	if (!generatedTexture_)
+	{
+		memoryUsage.cpuByteCounts[category] += GetByteSize();
+	}
+	else
+	{
+		memoryUsage.gpuByteCounts[category] += GetByteSize();
+	}
+}
+
+void Image::SetPackedTexture(Texture* packedTexture, const TextureAtlasRegion& atlasRegion)
+{
+	generatedTexture_ = packedTexture;
+	atlasRegion_ = atlasRegion;
+	isPacked_ = true;
+
+	delete[] buffer_;
+	buffer_ = nullptr;
+
+	for (unsigned char* mipmapBuffer : mipmapBuffers_)
+	{
+		delete[] mipmapBuffer;
+	}
+	mipmapBuffers_.clear();
+}
+
+bool Image::Evict()
+{
+	if (isPacked_ || isEvicted_)
+	{
+		return false;
+	}
+
+	if (generatedTexture_)
+	{
+		generatedTexture_->Release();
+	}
+	// Images of headless engines are never uploaded, their decoded pixels are released instead
+	else if (engine->GetIsHeadless())
+	{
+		delete[] buffer_;
+		buffer_ = nullptr;
+
+		for (unsigned char* mipmapBuffer : mipmapBuffers_)
+		{
+			delete[] mipmapBuffer;
+		}
+		mipmapBuffers_.clear();
+	}
+	else
+	{
+		return false;
+	}
+
+	isEvicted_ = true;
+	return true;
+}
+
+void Image::Restore(Image* decodedImage)
+{
+	buffer_ = decodedImage->buffer_;
+	mipmapBuffers_.swap(decodedImage->mipmapBuffers_);
+	width_ = decodedImage->width_;
+	height_ = decodedImage->height_;
+	channels_ = decodedImage->channels_;
+	compressionFormat_ = decodedImage->compressionFormat_;
+
+	decodedImage->buffer_ = nullptr;
+
+	// Images without a texture are resident again once they have their pixels
+	if (!generatedTexture_)
+	{
+		isEvicted_ = false;
+	}
+}
+
 void Image::PreInit()
 {
-	// TODO
-	// For now a texture is generated for every image
-	// Will be changed to generating texture atlases
+	// Packed textures are initialized by the TexturePacker
+	if (isPacked_)
+	{
+		return;
+	}
+
+	// Texture takes the ownership of the mip levels
+	mipLevelCount_ = (int)mipmapBuffers_.size() + 1;
+
+	// Restored images are uploaded into the texture their materials already point to
+	if (isEvicted_)
+	{
+		generatedTexture_->SetImageData(this);
+		mipmapBuffers_.clear();
+		buffer_ = nullptr;
+
+		generatedTexture_->PreInit();
+		isEvicted_ = false;
+		return;
+	}
+
+	// Images that are not packed into atlases or array textures get a texture of their own
 	generatedTexture_ = new Texture(this);
+
+	mipmapBuffers_.clear();
 	
 	if (!name_.empty())
 	{
@@ -4,14 +4,19 @@
 #include "Core.h"
 #include "Contents/Content.h"
 #include "Renderer/Texture.h"
+#include "Renderer/TextureAtlas.h"
+
+#include <vector>
 
 class GOKNAR_API Image : public Content
 {
+	friend class CookedTextureLoader;
+
 public:
 	Image();
 	Image(const std::string& path);
 	Image(const std::string& path, int width, int height, int channels, unsigned char* buffer);
-	virtual ~Image() = default;
+	virtual ~Image();
 
 	virtual void PreInit() override;
 	virtual void Init() override;
@@ -67,6 +72,15 @@ public:
 		return generatedTexture_;
 	}
 
+	// Region of the image in its atlas or array texture, nullptr if the image has a texture of its own
+	const TextureAtlasRegion* GetAtlasRegion() const
+	{
+		return isPacked_ ? &atlasRegion_ : nullptr;
+	}
+
+	// Image is drawn from a texture shared with other images, pixels of the image are released since they are copied into the texture
+	void SetPackedTexture(Texture* packedTexture, const TextureAtlasRegion& atlasRegion);
+
 	int GetWidth() const
 	{
 		return width_;
@@ -92,18 +106,61 @@ public:
 		name_ = name;
 	}
 
+	// Block compressed images are loaded from cooked textures with their mip levels
+	TextureCompressionFormat GetCompressionFormat() const
+	{
+		return compressionFormat_;
+	}
+
+	// Builds the mip chain down to 1x1 with a 2x2 box filter on the CPU, safe to call on the loading threads
+	// Precomputed mip levels are streamed to the GPU by the TextureStreamer instead of being generated on the GPU
+	void GenerateMipmaps();
+
+	// Mip levels after the base level, owned by the generated texture after PreInit
+	const std::vector<unsigned char*>& GetMipmapBuffers() const
+	{
+		return mipmapBuffers_;
+	}
+
+	// Total size of the image and its mip levels in bytes, also valid after the texture takes the pixels
+	unsigned long long GetByteSize() const;
+
+	// Pixels are counted on the CPU until a texture takes them, packed images are counted by their regions of the shared texture
+	virtual void GetMemoryUsage(ContentMemoryUsage& memoryUsage) const override;
+
+	// Releases the texture on the GPU while the image and its texture stay valid for the materials pointing to them
+	// Images of headless engines release their decoded pixels, images packed into shared textures cannot be evicted
+	bool Evict();
+
+	// Takes the pixels of a freshly decoded copy of an evicted image, they are uploaded into the same texture by PreInit
+	void Restore(Image* decodedImage);
+
+	bool GetIsEvicted() const
+	{
+		return isEvicted_;
+	}
+
 private:
 	Texture* generatedTexture_;
 
 	unsigned char* buffer_;
 
+	std::vector<unsigned char*> mipmapBuffers_;
+
 	std::string name_;
 
 	int width_;
 	int height_;
 	int channels_;
+	// Kept once the texture takes the ownership of the mip levels
+	int mipLevelCount_{ 1 };
 
 	TextureUsage textureUsage_;
+	TextureCompressionFormat compressionFormat_{ TextureCompressionFormat::None };
+
+	TextureAtlasRegion atlasRegion_;
+	bool isPacked_{ false };
+	bool isEvicted_{ false };
 	TextureWrapping textureWrappingR_{ TextureWrapping::REPEAT };
 	TextureWrapping textureWrappingT_{ TextureWrapping::REPEAT };
 	TextureWrapping textureWrappingS_{ TextureWrapping::REPEAT };
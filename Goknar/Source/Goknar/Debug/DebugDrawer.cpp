@@ -262,19 +262,18 @@ void DebugDrawer::DrawCollisionComponent(const NonMovingTriangleMeshCollisionCom
 
 void DebugDrawer::DrawMeshUnit(const MeshUnit* meshUnit, const Colorf& color, float thickness, float time, ObjectBase* owner)
 {
-	const VertexArray* vertexArray = meshUnit->GetVerticesPointer();
-	int vertexCount = vertexArray->size();
+	const VertexData* vertexData = meshUnit->GetVertexData();
 
-	const FaceArray* faceArray = meshUnit->GetFacesPointer();
-	int faceCount = faceArray->size();
+	const Face* faceData = meshUnit->GetFaceData();
+	int faceCount = meshUnit->GetFaceCount();
 
 	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
 	{
-		const Face& face = faceArray->at(faceIndex);
+		const Face& face = faceData[faceIndex];
 		DrawTriangle(
-			vertexArray->at(face.vertexIndices[0]).position,
-			vertexArray->at(face.vertexIndices[1]).position,
-			vertexArray->at(face.vertexIndices[2]).position,
+			vertexData[face.vertexIndices[0]].position,
+			vertexData[face.vertexIndices[1]].position,
+			vertexData[face.vertexIndices[2]].position,
 			color, thickness, time, owner);
 	}
 }
@@ -4,6 +4,7 @@
 #include "Engine.h"
 
 #include "Application.h"
+#include "Camera.h"
 #include "Controller.h"
 #include "Log.h"
 #include "ObjectBase.h"
@@ -12,17 +13,24 @@
 #include "Components/Component.h"
 #include "Debug/DebugDrawer.h"
 #include "Factories/DynamicObjectFactory.h"
+#include "Factories/SpawnBatch.h"
 #include "Managers/CameraManager.h"
 #include "Managers/InputManager.h"
+#include "Managers/JobManager.h"
+#include "Managers/LevelStreamingManager.h"
+#include "Managers/MemoryManager.h"
 #include "Managers/ObjectIDManager.h"
 #include "Managers/ObjectManager.h"
 #include "Managers/ResourceManager.h"
+#include "Managers/TimerManager.h"
 #include "Managers/WindowManager.h"
+#include "Memory/FrameArena.h"
 #include "Physics/PhysicsWorld.h"
 #include "Renderer/Renderer.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderBuilder.h"
 #include "Renderer/ShaderBuilderNew.h"
+#include "Renderer/ShaderProgramCache.h"
 #include "UI/HUD.h"
 
 #include "Lights/DirectionalLight.h"
@@ -38,29 +46,47 @@
 
 GOKNAR_API Engine* engine;
 
-Engine::Engine()
+Engine::Engine(bool isHeadless) :
+	isHeadless_(isHeadless)
 {
 	engine = this;
 
 	Log::Init();
 
-	windowManager_ = new WindowManager();
+	if (!isHeadless_)
+	{
+		windowManager_ = new WindowManager();
+		inputManager_ = new InputManager();
+	}
 
-	inputManager_ = new InputManager();
 	resourceManager_ = new ResourceManager();
 	objectManager_ = new ObjectManager();
-	renderer_ = new Renderer();
+
+	if (!isHeadless_)
+	{
+		renderer_ = new Renderer();
+	}
+
 	physicsWorld_ = new PhysicsWorld();
 	cameraManager_ = new CameraManager();
 
 	debugDrawer_ = new DebugDrawer();
 
+	frameArena_ = new FrameArena();
+	jobManager_ = new JobManager();
+	timerManager_ = new TimerManager();
+	levelStreamingManager_ = new LevelStreamingManager();
+
 	// TODO
 	//application_ = CreateApplication();
 }
 
 Engine::~Engine()
 {
+	// Cell loading jobs must finish before the resource manager and the job manager are deleted
+	delete levelStreamingManager_;
+	levelStreamingManager_ = nullptr;
+
 	delete physicsWorld_;
 	physicsWorld_ = nullptr;
 
@@ -87,42 +113,67 @@ Engine::~Engine()
 	delete inputManager_;
 	inputManager_ = nullptr;
 
+	delete timerManager_;
+	timerManager_ = nullptr;
+
 	// Delete singletons
 	delete ObjectIDManager::GetInstance();
 	delete ShaderBuilder::GetInstance();
 	delete ShaderBuilderNew::GetInstance();
+	delete ShaderProgramCache::GetInstance();
 	delete DynamicObjectFactory::GetInstance();
 
 	delete windowManager_;
 	windowManager_ = nullptr;
+
+	delete frameArena_;
+	frameArena_ = nullptr;
+
+	delete jobManager_;
+	jobManager_ = nullptr;
+
+	MemoryManager::GetInstance()->LogAllocationStatistics();
+	delete MemoryManager::GetInstance();
 }
 
 void Engine::PreInit() const
 {
 	std::chrono::steady_clock::time_point lastFrameTimePoint = std::chrono::steady_clock::now();
-	windowManager_->PreInit();
-	std::chrono::steady_clock::time_point currentTimePoint = std::chrono::steady_clock::now();
-	float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
-	GOKNAR_CORE_INFO("Window Manager Initialization: {} s.", elapsedTime);
-	lastFrameTimePoint = currentTimePoint;
+	std::chrono::steady_clock::time_point currentTimePoint;
+	float elapsedTime;
 
-	inputManager_->PreInit();
-	currentTimePoint = std::chrono::steady_clock::now();
-	elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
-	GOKNAR_CORE_INFO("Input Manager Initialization: {} s.", elapsedTime);
-	lastFrameTimePoint = currentTimePoint;
+	if (!isHeadless_)
+	{
+		windowManager_->PreInit();
+		currentTimePoint = std::chrono::steady_clock::now();
+		elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
+		GOKNAR_CORE_INFO("Window Manager Initialization: {} s.", elapsedTime);
+		lastFrameTimePoint = currentTimePoint;
 
-	application_->PreInit();
-	currentTimePoint = std::chrono::steady_clock::now();
-	elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
-	GOKNAR_CORE_INFO("Application Initialization: {} s.", elapsedTime);
-	lastFrameTimePoint = currentTimePoint;
+		inputManager_->PreInit();
+		currentTimePoint = std::chrono::steady_clock::now();
+		elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
+		GOKNAR_CORE_INFO("Input Manager Initialization: {} s.", elapsedTime);
+		lastFrameTimePoint = currentTimePoint;
+	}
 
-	ShaderBuilder::GetInstance()->Init();
-	currentTimePoint = std::chrono::steady_clock::now();
-	elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
-	GOKNAR_CORE_INFO("Shader Builder Initialization: {} s.", elapsedTime);
-	lastFrameTimePoint = currentTimePoint;
+	if (application_)
+	{
+		application_->PreInit();
+		currentTimePoint = std::chrono::steady_clock::now();
+		elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
+		GOKNAR_CORE_INFO("Application Initialization: {} s.", elapsedTime);
+		lastFrameTimePoint = currentTimePoint;
+	}
+
+	if (!isHeadless_)
+	{
+		ShaderBuilder::GetInstance()->Init();
+		currentTimePoint = std::chrono::steady_clock::now();
+		elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
+		GOKNAR_CORE_INFO("Shader Builder Initialization: {} s.", elapsedTime);
+		lastFrameTimePoint = currentTimePoint;
+	}
 
 	resourceManager_->PreInit();
 	currentTimePoint = std::chrono::steady_clock::now();
@@ -149,20 +200,29 @@ void Engine::PreInit() const
 	GOKNAR_CORE_INFO("Physics Initialization: {} s.", elapsedTime);
 	lastFrameTimePoint = currentTimePoint;
 
-	renderer_->PreInit();
-	currentTimePoint = std::chrono::steady_clock::now();
-	elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
-	GOKNAR_CORE_INFO("Renderer Initialization: {} s.", elapsedTime);
-	lastFrameTimePoint = currentTimePoint;
+	if (!isHeadless_)
+	{
+		renderer_->PreInit();
+		currentTimePoint = std::chrono::steady_clock::now();
+		elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
+		GOKNAR_CORE_INFO("Renderer Initialization: {} s.", elapsedTime);
+		lastFrameTimePoint = currentTimePoint;
+	}
 }
 
 void Engine::Init() const
 {
-	windowManager_->Init();
+	if (!isHeadless_)
+	{
+		windowManager_->Init();
 
-	inputManager_->Init();
+		inputManager_->Init();
+	}
 
-	application_->Init();
+	if (application_)
+	{
+		application_->Init();
+	}
 
 	resourceManager_->Init();
 
@@ -170,16 +230,25 @@ void Engine::Init() const
 
 	physicsWorld_->Init();
 
-	renderer_->Init();
+	if (!isHeadless_)
+	{
+		renderer_->Init();
+	}
 }
 
 void Engine::PostInit() const
 {
-	windowManager_->PostInit();
+	if (!isHeadless_)
+	{
+		windowManager_->PostInit();
 
-	inputManager_->PostInit();
+		inputManager_->PostInit();
+	}
 
-	application_->PostInit();
+	if (application_)
+	{
+		application_->PostInit();
+	}
 
 	resourceManager_->PostInit();
 
@@ -187,7 +256,13 @@ void Engine::PostInit() const
 
 	physicsWorld_->PostInit();
 
-	renderer_->PostInit();
+	if (!isHeadless_)
+	{
+		renderer_->PostInit();
+
+		// Startup programs are created by now, compare with a run without cache files to see the time saved
+		ShaderProgramCache::GetInstance()->LogStatistics();
+	}
 }
 
 void Engine::Run()
@@ -196,49 +271,11 @@ void Engine::Run()
 	std::chrono::steady_clock::time_point currentTimePoint = std::chrono::steady_clock::now();
 	while (!windowManager_->GetWindowShouldBeClosed())
 	{
-		// Initialize dynamically created object and components /////
-
-		if (hasUninitializedComponents_)
-		{
-			PreInitComponents();
-		}
-
-		if (hasUninitializedObjects_)
-		{
-			PreInitObjects();
-		}
-
-		if (hasUninitializedComponents_)
-		{
-			InitComponents();
-		}
-
-		if (hasUninitializedObjects_)
-		{
-			InitObjects();
-		}
-
-		if (hasUninitializedComponents_)
-		{
-			PostInitComponents();
-		}
-
-		if (hasUninitializedObjects_)
-		{
-			PostInitObjects();
-		}
-
-		if (hasUninitializedComponents_)
-		{
-			BeginGameComponents();
-		}
-
-		if (hasUninitializedObjects_)
-		{
-			BeginGameObjects();
-		}
+		// Objects created by the content load callbacks and the streamed cells are initialized in the same frame
+		resourceManager_->ProcessContentLoads();
+		levelStreamingManager_->Update();
 
-		////////////////////////////////////////////////////////////////////////////
+		InitializePendingObjectsAndComponents();
 
 		if (0.25f < deltaTime_)
 		{
@@ -261,12 +298,7 @@ void Engine::Run()
 		const float unscaledDeltaTime = deltaTime_;
 		deltaTime_ *= timeScale_;
 
-		elapsedTime_ += deltaTime_;
-
-		physicsWorld_->PhysicsTick(deltaTime_);
-
-		application_->Run();
-		Tick(deltaTime_);
+		UpdateFrame(deltaTime_);
 
 		renderer_->RenderCurrentFrame();
 
@@ -277,17 +309,9 @@ void Engine::Run()
 
 		windowManager_->Update();
 
-		if (0 < timeDependentObjectsToBeRegisteredSize_)
-		{
-			RegisterTimeDependentObjects();
-		}
-
 		cameraManager_->HandleNewlyAddedCameras();
 
-		if (hasObjectsOrComponentsPendingDestroy_)
-		{
-			DestroyAllPendingObjectAndComponents();
-		}
+		EndFrame();
 
 		currentTimePoint = std::chrono::steady_clock::now();
 		deltaTime_ = std::chrono::duration_cast<std::chrono::duration<float>>(currentTimePoint - lastFrameTimePoint).count();
@@ -296,6 +320,103 @@ void Engine::Run()
 	}
 }
 
+void Engine::RunHeadlessFrame(float deltaTime)
+{
+	GOKNAR_CORE_ASSERT(isHeadless_, "Only headless engines can run headless frames");
+
+	resourceManager_->ProcessContentLoads();
+	levelStreamingManager_->Update();
+
+	InitializePendingObjectsAndComponents();
+
+	deltaTime_ = deltaTime * timeScale_;
+
+	UpdateFrame(deltaTime_);
+
+	EndFrame();
+}
+
+void Engine::InitializePendingObjectsAndComponents()
+{
+	if (!spawnBatches_.empty())
+	{
+		ProcessSpawnBatches();
+	}
+
+	// Initialize dynamically created object and components /////
+
+	if (hasUninitializedComponents_)
+	{
+		PreInitComponents();
+	}
+
+	if (hasUninitializedObjects_)
+	{
+		PreInitObjects();
+	}
+
+	if (hasUninitializedComponents_)
+	{
+		InitComponents();
+	}
+
+	if (hasUninitializedObjects_)
+	{
+		InitObjects();
+	}
+
+	if (hasUninitializedComponents_)
+	{
+		PostInitComponents();
+	}
+
+	if (hasUninitializedObjects_)
+	{
+		PostInitObjects();
+	}
+
+	if (hasUninitializedComponents_)
+	{
+		BeginGameComponents();
+	}
+
+	if (hasUninitializedObjects_)
+	{
+		BeginGameObjects();
+	}
+}
+
+void Engine::UpdateFrame(float deltaTime)
+{
+	elapsedTime_ += deltaTime;
+
+	UpdateTickLODs(deltaTime);
+
+	RunTickGroup(TickGroup::PrePhysics, deltaTime);
+
+	// Physics step writes the transforms of rigid bodies and their owners back,
+	// so the group ticks after it instead of alongside it
+	physicsWorld_->PhysicsTick(deltaTime);
+	RunTickGroup(TickGroup::DuringPhysics, deltaTime);
+
+	if (application_)
+	{
+		application_->Run();
+	}
+	Tick(deltaTime);
+}
+
+void Engine::EndFrame()
+{
+	if (hasObjectsOrComponentsPendingDestroy_)
+	{
+		DestroyAllPendingObjectAndComponents();
+	}
+
+	// Everything allocated from the frame arena is released at the end of the frame
+	frameArena_->Reset();
+}
+
 void Engine::BeginGame()
 {
 	PreInitComponents();
@@ -347,6 +468,9 @@ void Engine::PostInitObjects()
 		objectsToBeInitialized_[objectIndex]->PostInit();
 	}
 
+	// Newly initialized objects can start ticking
+	areTickGroupsDirty_ = true;
+
 	GOKNAR_CORE_ASSERT(objectsToBeInitialized_.size() == objectsToBeInitializedSize_, "CANNOT ADD OBJECTS BEFORE INITIALIZATION!");
 }
 
@@ -398,6 +522,9 @@ void Engine::PostInitComponents()
 		componentsToBeInitialized_[componentIndex]->PostInit();
 	}
 
+	// Newly initialized components can start ticking
+	areTickGroupsDirty_ = true;
+
 	GOKNAR_CORE_ASSERT(componentsToBeInitialized_.size() == componentsToBeInitializedSize_, "CANNOT ADD COMPONENTS BEFORE INITIALIZATION!");
 }
 
@@ -421,33 +548,259 @@ void Engine::BeginGameComponents()
 
 void Engine::Tick(float deltaTime)
 {
+	RunTickGroup(TickGroup::PostPhysics, deltaTime);
+
+	timerManager_->Tick(deltaTime);
+
+	RunTickGroup(TickGroup::PostUpdateWork, deltaTime);
+}
+
+float Engine::GetTickLODInterval(const Vector3& worldPosition) const
+{
+	const float squareDistance = tickLODViewPosition_.SquareDistance(worldPosition);
+
+	float tickLODInterval = 0.f;
+	for (const TickLODLevel& tickLODLevel : tickLODLevels_)
+	{
+		if (squareDistance < tickLODLevel.distance * tickLODLevel.distance)
+		{
+			break;
+		}
+
+		tickLODInterval = tickLODLevel.tickInterval;
+	}
+
+	return tickLODInterval;
+}
+
+void Engine::UpdateTickLODs(float deltaTime)
+{
+	timeSinceLastTickLODUpdate_ += deltaTime;
+	if (timeSinceLastTickLODUpdate_ < tickLODUpdateInterval_)
+	{
+		return;
+	}
+	timeSinceLastTickLODUpdate_ = 0.f;
+
+	Camera* activeCamera = cameraManager_->GetActiveCamera();
+	if (!activeCamera)
+	{
+		return;
+	}
+
+	if (areTickGroupsDirty_)
+	{
+		RebuildTickGroups();
+	}
+
+	tickLODViewPosition_ = activeCamera->GetPosition();
+
+	for (TickGroupData& tickGroupData : tickGroups_)
+	{
+		for (ObjectBase* object : tickGroupData.objects)
+		{
+			if (object->GetIsTickLODEnabled())
+			{
+				object->SetTickLODInterval(GetTickLODInterval(object->GetWorldPosition()));
+			}
+		}
+
+		for (ComponentTickWave& componentTickWave : tickGroupData.componentWaves)
+		{
+			for (Component* component : componentTickWave.parallelComponents)
+			{
+				if (component->GetIsTickLODEnabled())
+				{
+					component->SetTickLODInterval(GetTickLODInterval(component->GetWorldPosition()));
+				}
+			}
+
+			for (Component* component : componentTickWave.serialComponents)
+			{
+				if (component->GetIsTickLODEnabled())
+				{
+					component->SetTickLODInterval(GetTickLODInterval(component->GetWorldPosition()));
+				}
+			}
+		}
+	}
+}
+
+void Engine::RunTickGroup(TickGroup tickGroup, float deltaTime)
+{
+	if (areTickGroupsDirty_)
+	{
+		RebuildTickGroups();
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	TickGroupData& tickGroupData = tickGroups_[(int)tickGroup];
+
+	for (ObjectBase* object : tickGroupData.objects)
+	{
+		float objectDeltaTime;
+		if (object->ConsumeTickDeltaTime(deltaTime, objectDeltaTime))
+		{
+			object->Tick(objectDeltaTime);
+		}
+	}
+
+	TickComponentWaves(tickGroupData, deltaTime);
+
+	tickGroupData.lastTickDuration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+}
+
+void Engine::TickComponentWaves(const TickGroupData& tickGroupData, float deltaTime)
+{
+	for (const ComponentTickWave& componentTickWave : tickGroupData.componentWaves)
+	{
+		const std::vector<Component*>& parallelComponents = componentTickWave.parallelComponents;
+		jobManager_->ParallelFor((int)parallelComponents.size(), 16,
+			[&parallelComponents, deltaTime](int beginIndex, int endIndex)
+			{
+				for (int componentIndex = beginIndex; componentIndex < endIndex; ++componentIndex)
+				{
+					Component* component = parallelComponents[componentIndex];
+					float componentDeltaTime;
+					if (component->ConsumeTickDeltaTime(deltaTime, componentDeltaTime))
+					{
+						component->TickComponent(componentDeltaTime);
+					}
+				}
+			});
+
+		for (Component* component : componentTickWave.serialComponents)
+		{
+			float componentDeltaTime;
+			if (component->ConsumeTickDeltaTime(deltaTime, componentDeltaTime))
+			{
+				component->TickComponent(componentDeltaTime);
+			}
+		}
+	}
+}
+
+void Engine::RebuildTickGroups()
+{
+	for (int tickGroupIndex = 0; tickGroupIndex < (int)TickGroup::Count; ++tickGroupIndex)
+	{
+		tickGroups_[tickGroupIndex].Clear();
+	}
+
 	for (ObjectBase* object : tickableObjects_)
 	{
 		if (object->GetIsInitialized() && object->GetIsActive() && object->GetIsTickEnabled())
 		{
-			object->Tick(deltaTime);
+			tickGroups_[(int)object->GetTickGroup()].objects.push_back(object);
 		}
 	}
 
+	// Wave indices are only needed if any ticking component has a prerequisite
+	std::unordered_map<const Component*, int> componentTickWaveIndices;
+	bool hasTickPrerequisites = false;
+
 	for (Component* component : tickableComponents_)
 	{
-		if (component->GetIsInitialized() && component->GetIsActive() && component->GetIsTickEnabled())
+		if (component->GetIsInitialized() && component->GetIsActive() && component->GetIsTickEnabled() && !component->GetTickPrerequisites().empty())
 		{
-			component->TickComponent(deltaTime);
+			hasTickPrerequisites = true;
+			break;
 		}
 	}
 
-	for (TimeDependentObject* object : timeDependentObjects_)
+	if (hasTickPrerequisites)
 	{
-		if (object->GetIsActive())
+		componentTickWaveIndices.reserve(tickableComponents_.size());
+		for (Component* component : tickableComponents_)
 		{
-			object->Tick(deltaTime);
+			if (component->GetIsInitialized() && component->GetIsActive() && component->GetIsTickEnabled())
+			{
+				componentTickWaveIndices[component] = -1;
+			}
 		}
 	}
+
+	for (Component* component : tickableComponents_)
+	{
+		if (!(component->GetIsInitialized() && component->GetIsActive() && component->GetIsTickEnabled()))
+		{
+			continue;
+		}
+
+		const int componentWaveIndex = hasTickPrerequisites ? CalculateComponentTickWaveIndex(component, componentTickWaveIndices) : 0;
+
+		std::vector<ComponentTickWave>& componentWaves = tickGroups_[(int)component->GetTickGroup()].componentWaves;
+		if ((int)componentWaves.size() <= componentWaveIndex)
+		{
+			componentWaves.resize(componentWaveIndex + 1);
+		}
+
+		if (component->GetIsTickThreadSafe())
+		{
+			componentWaves[componentWaveIndex].parallelComponents.push_back(component);
+		}
+		else
+		{
+			componentWaves[componentWaveIndex].serialComponents.push_back(component);
+		}
+	}
+
+	areTickGroupsDirty_ = false;
+}
+
+int Engine::CalculateComponentTickWaveIndex(const Component* component, std::unordered_map<const Component*, int>& componentTickWaveIndices)
+{
+	// -1: Not calculated yet, -2: Being calculated
+	std::unordered_map<const Component*, int>::iterator componentIterator = componentTickWaveIndices.find(component);
+	if (0 <= componentIterator->second)
+	{
+		return componentIterator->second;
+	}
+
+	componentIterator->second = -2;
+
+	int componentWaveIndex = 0;
+	for (const Component* prerequisite : component->GetTickPrerequisites())
+	{
+		// Prerequisites are only dereferenced if they are ticking this frame
+		// since they might have been destroyed already
+		std::unordered_map<const Component*, int>::iterator prerequisiteIterator = componentTickWaveIndices.find(prerequisite);
+		if (prerequisiteIterator == componentTickWaveIndices.end())
+		{
+			continue;
+		}
+
+		if (prerequisite->GetTickGroup() != component->GetTickGroup())
+		{
+			continue;
+		}
+
+		if (prerequisiteIterator->second == -2)
+		{
+			GOKNAR_CORE_WARN("Circular tick prerequisite between components {} and {}, ignoring.", ((Component*)component)->GetGUID(), ((Component*)prerequisite)->GetGUID());
+			continue;
+		}
+
+		const int prerequisiteWaveIndex = CalculateComponentTickWaveIndex(prerequisite, componentTickWaveIndices);
+		if (componentWaveIndex <= prerequisiteWaveIndex)
+		{
+			componentWaveIndex = prerequisiteWaveIndex + 1;
+		}
+	}
+
+	componentIterator->second = componentWaveIndex;
+	return componentWaveIndex;
 }
 
 void Engine::ClearMemory()
 {
+	for (SpawnBatch* spawnBatch : spawnBatches_)
+	{
+		delete spawnBatch;
+	}
+	spawnBatches_.clear();
+
 	std::vector<Component*>::iterator registeredComponentsIterator = registeredComponents_.begin();
 	for (; registeredComponentsIterator != registeredComponents_.end(); ++registeredComponentsIterator)
 	{
@@ -479,6 +832,7 @@ void Engine::ClearMemory()
 	registeredComponents_.clear();
 	tickableComponents_.clear();
 	componentsToBeInitialized_.clear();
+	areTickGroupsDirty_ = true;
 
 	registeredObjects_.clear();
 	tickableObjects_.clear();
@@ -545,6 +899,7 @@ void Engine::DestroyAllObjectsAndComponents()
 	registeredComponents_.clear();
 	tickableComponents_.clear();
 	componentsToBeInitialized_.clear();
+	areTickGroupsDirty_ = true;
 
 	std::vector<ObjectBase*>::iterator registeredObjectsIterator = registeredObjects_.begin();
 	for (; registeredObjectsIterator != registeredObjects_.end(); ++registeredObjectsIterator)
@@ -553,6 +908,51 @@ void Engine::DestroyAllObjectsAndComponents()
 	}
 }
 
+void Engine::ReserveObjectCapacity(int objectCount, int tickableObjectCount, int componentCount, int tickableComponentCount)
+{
+	registeredObjects_.reserve(registeredObjects_.size() + objectCount);
+	objectsToBeInitialized_.reserve(objectsToBeInitialized_.size() + objectCount);
+	tickableObjects_.reserve(tickableObjects_.size() + tickableObjectCount);
+
+	registeredComponents_.reserve(registeredComponents_.size() + componentCount);
+	componentsToBeInitialized_.reserve(componentsToBeInitialized_.size() + componentCount);
+	tickableComponents_.reserve(tickableComponents_.size() + tickableComponentCount);
+}
+
+void Engine::AddSpawnBatch(SpawnBatch* spawnBatch)
+{
+	spawnBatches_.push_back(spawnBatch);
+}
+
+void Engine::ProcessSpawnBatches()
+{
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	// Batches are processed in submission order and share the frame budget
+	// Indexed loop since spawned objects may add new batches
+	size_t spawnBatchIndex = 0;
+	while (spawnBatchIndex < spawnBatches_.size())
+	{
+		const float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+		const float remainingTimeBudget = spawnBatchTimeBudget_ - elapsedTime;
+		if (remainingTimeBudget <= 0.f && 0 < spawnBatchIndex)
+		{
+			break;
+		}
+
+		SpawnBatch* spawnBatch = spawnBatches_[spawnBatchIndex];
+		if (!spawnBatch->SpawnInstances(remainingTimeBudget))
+		{
+			break;
+		}
+
+		delete spawnBatch;
+		++spawnBatchIndex;
+	}
+
+	spawnBatches_.erase(spawnBatches_.begin(), spawnBatches_.begin() + spawnBatchIndex);
+}
+
 void Engine::AddToObjectsToBeInitialized(ObjectBase* object)
 {
 	hasUninitializedObjects_ = true;
@@ -582,46 +982,7 @@ void Engine::RemoveObject(ObjectBase* object)
 void Engine::AddToTickableObjects(ObjectBase* object)
 {
 	tickableObjects_.push_back(object);
-}
-
-void Engine::RegisterTimeDependentObjects()
-{
-	if (timeDependentObjects_.empty())
-	{
-		timeDependentObjects_ = std::move(timeDependentObjectsToRegisterForNextFrame_);
-	}
-	else
-	{
-		timeDependentObjects_.reserve(timeDependentObjects_.size() + timeDependentObjectsToBeRegisteredSize_);
-
-		std::move(
-			std::begin(timeDependentObjectsToRegisterForNextFrame_),
-			std::end(timeDependentObjectsToRegisterForNextFrame_),
-			std::back_inserter(timeDependentObjects_));
-	}
-
-	timeDependentObjectsToRegisterForNextFrame_.clear();
-	timeDependentObjectsToBeRegisteredSize_ = 0;
-}
-
-void Engine::RegisterTimeDependentObject(TimeDependentObject* timeDependentObject)
-{
-	timeDependentObjectsToRegisterForNextFrame_.push_back(timeDependentObject);
-	++timeDependentObjectsToBeRegisteredSize_;
-}
-
-void Engine::RemoveTimeDependentObject(TimeDependentObject* timeDependentObject)
-{
-	size_t timeDependentObjectsSize = timeDependentObjects_.size();
-
-	for (size_t timeDependentObjectIndex = 0; timeDependentObjectIndex < timeDependentObjectsSize; timeDependentObjectIndex++)
-	{
-		if (timeDependentObjects_[timeDependentObjectIndex] == timeDependentObject)
-		{
-			timeDependentObjects_.erase(timeDependentObjects_.begin() + timeDependentObjectIndex);
-			return;
-		}
-	}
+	areTickGroupsDirty_ = true;
 }
 
 void Engine::RemoveFromTickableObjects(ObjectBase* object)
@@ -633,6 +994,7 @@ void Engine::RemoveFromTickableObjects(ObjectBase* object)
 		if (tickableObjects_[tickableObjectIndex] == object)
 		{
 			tickableObjects_.erase(tickableObjects_.begin() + tickableObjectIndex);
+			areTickGroupsDirty_ = true;
 			return;
 		}
 	}
@@ -688,6 +1050,7 @@ void Engine::RemoveComponent(Component* component)
 void Engine::AddToTickableComponents(Component* component)
 {
 	tickableComponents_.push_back(component);
+	areTickGroupsDirty_ = true;
 }
 
 void Engine::RemoveFromTickableComponents(Component* component)
@@ -699,6 +1062,7 @@ void Engine::RemoveFromTickableComponents(Component* component)
 		if (tickableComponents_[tickableComponentIndex] == component)
 		{
 			tickableComponents_.erase(tickableComponents_.begin() + tickableComponentIndex);
+			areTickGroupsDirty_ = true;
 			return;
 		}
 	}
@@ -728,22 +1092,34 @@ void Engine::AddToComponentsToBeInitialized(Component* component)
 
 void Engine::Exit()
 {
-	windowManager_->CloseWindow();
+	if (windowManager_)
+	{
+		windowManager_->CloseWindow();
+	}
 }
 
 void Engine::AddStaticMeshToRenderer(StaticMesh* staticMesh)
 {
-	renderer_->AddStaticMeshToRenderer(staticMesh);
+	if (renderer_)
+	{
+		renderer_->AddStaticMeshToRenderer(staticMesh);
+	}
 }
 
 void Engine::AddSkeletalMeshToRenderer(SkeletalMesh* skeletalMesh)
 {
-	renderer_->AddSkeletalMeshToRenderer(skeletalMesh);
+	if (renderer_)
+	{
+		renderer_->AddSkeletalMeshToRenderer(skeletalMesh);
+	}
 }
 
 void Engine::AddDynamicMeshToRenderer(DynamicMesh* dynamicMesh)
 {
-	renderer_->AddDynamicMeshToRenderer(dynamicMesh);
+	if (renderer_)
+	{
+		renderer_->AddDynamicMeshToRenderer(dynamicMesh);
+	}
 }
 
 void Engine::SetApplication(Application* application)
@@ -1,9 +1,12 @@
 #ifndef __ENGINE_H__
 #define __ENGINE_H__
 
+#include <unordered_map>
 #include <vector>
 
 #include "Core.h"
+#include "TickTypes.h"
+#include "Math/GoknarMath.h"
 
 class DebugDrawer;
 
@@ -13,13 +16,19 @@ class CameraManager;
 class Component;
 class Controller;
 class InputManager;
+class JobManager;
+class LevelStreamingManager;
 class ObjectBase;
 class ObjectManager;
 class Renderer;
 class ResourceManager;
 class Shader;
+class SpawnBatch;
+class TimerManager;
 class WindowManager;
 
+class FrameArena;
+
 class DynamicMesh;
 class StaticMesh;
 class SkeletalMesh;
@@ -34,7 +43,8 @@ GOKNAR_API extern class Engine *engine;
 class GOKNAR_API Engine
 {
 public:
-	Engine();
+	// Headless engines have no window, input or renderer and are advanced with RunHeadlessFrame
+	Engine(bool isHeadless = false);
 	~Engine();
 
 	void PreInit() const;
@@ -56,6 +66,51 @@ public:
 	void Run();
 	void Tick(float deltaTime);
 
+	// Runs a frame of everything but rendering with the given delta time, before the time scale is applied
+	void RunHeadlessFrame(float deltaTime);
+
+	bool GetIsHeadless() const
+	{
+		return isHeadless_;
+	}
+
+	// Hot tick arrays are rebuilt before the next tick group runs
+	void MarkTickGroupsDirty()
+	{
+		areTickGroupsDirty_ = true;
+	}
+
+	float GetTickGroupDuration(TickGroup tickGroup) const
+	{
+		return tickGroups_[(int)tickGroup].lastTickDuration;
+	}
+
+	// Levels must be sorted by their distances in ascending order
+	void SetTickLODLevels(const std::vector<TickLODLevel>& tickLODLevels)
+	{
+		tickLODLevels_ = tickLODLevels;
+		timeSinceLastTickLODUpdate_ = tickLODUpdateInterval_;
+	}
+
+	const std::vector<TickLODLevel>& GetTickLODLevels() const
+	{
+		return tickLODLevels_;
+	}
+
+	// Tick LODs of the ticking entries are re-evaluated once per interval seconds
+	void SetTickLODUpdateInterval(float tickLODUpdateInterval)
+	{
+		tickLODUpdateInterval_ = tickLODUpdateInterval;
+	}
+
+	float GetTickLODUpdateInterval() const
+	{
+		return tickLODUpdateInterval_;
+	}
+
+	// Tick interval of the farthest tick LOD level the world position is in
+	float GetTickLODInterval(const Vector3& worldPosition) const;
+
 	inline WindowManager* GetWindowManager() const
 	{
 		return windowManager_;
@@ -104,6 +159,26 @@ public:
 	{
 		return HUD_;
 	}
+
+	inline FrameArena* GetFrameArena() const
+	{
+		return frameArena_;
+	}
+
+	inline JobManager* GetJobManager() const
+	{
+		return jobManager_;
+	}
+
+	inline TimerManager* GetTimerManager() const
+	{
+		return timerManager_;
+	}
+
+	inline LevelStreamingManager* GetLevelStreamingManager() const
+	{
+		return levelStreamingManager_;
+	}
 	
 	void RegisterObject(ObjectBase *object);
 	void AddToTickableObjects(ObjectBase* object);
@@ -115,15 +190,27 @@ public:
 	template<class T = ObjectBase>
 	std::vector<T*> GetObjectsOfType() const;
 
+	void ReserveObjectCapacity(int objectCount, int tickableObjectCount, int componentCount, int tickableComponentCount);
+
+	// Engine takes the ownership of the spawn batch
+	void AddSpawnBatch(SpawnBatch* spawnBatch);
+
+	void SetSpawnBatchTimeBudget(float spawnBatchTimeBudget)
+	{
+		spawnBatchTimeBudget_ = spawnBatchTimeBudget;
+	}
+
+	float GetSpawnBatchTimeBudget() const
+	{
+		return spawnBatchTimeBudget_;
+	}
+
 	void RegisterComponent(Component* component);
 	void AddToTickableComponents(Component* component);
 	void RemoveFromTickableComponents(Component* component);
 	void RemoveFromComponentsToBeInitialized(Component* component);
 	void AddToComponentsToBeInitialized(Component* component);
 
-	void RegisterTimeDependentObject(TimeDependentObject* timeDependentObject);
-	void RemoveTimeDependentObject(TimeDependentObject* timeDependentObject);
-
 	const std::vector<ObjectBase*>& GetRegisteredObjects() const
 	{
 		return registeredObjects_;
@@ -169,18 +256,33 @@ private:
 	void DestroyComponent(Component* component);
 	void RemoveComponent(Component* component);
 
-	void RegisterTimeDependentObjects();
+	void ProcessSpawnBatches();
+
+	void InitializePendingObjectsAndComponents();
+	void UpdateFrame(float deltaTime);
+	void EndFrame();
+
+	void RebuildTickGroups();
+	int CalculateComponentTickWaveIndex(const Component* component, std::unordered_map<const Component*, int>& componentTickWaveIndices);
+
+	void UpdateTickLODs(float deltaTime);
+	void RunTickGroup(TickGroup tickGroup, float deltaTime);
+	void TickComponentWaves(const TickGroupData& tickGroupData, float deltaTime);
 
 	DebugDrawer* debugDrawer_{ nullptr };
 
-	InputManager* inputManager_;
+	InputManager* inputManager_{ nullptr };
 	ResourceManager* resourceManager_;
 	ObjectManager* objectManager_;
-	Renderer* renderer_;
-	WindowManager* windowManager_;
+	Renderer* renderer_{ nullptr };
+	WindowManager* windowManager_{ nullptr };
 	CameraManager* cameraManager_;
 	PhysicsWorld* physicsWorld_{ nullptr };
 	HUD* HUD_{ nullptr };
+	FrameArena* frameArena_{ nullptr };
+	JobManager* jobManager_{ nullptr };
+	TimerManager* timerManager_{ nullptr };
+	LevelStreamingManager* levelStreamingManager_{ nullptr };
 
 	Application* application_{ nullptr };
 
@@ -192,23 +294,33 @@ private:
 	std::vector<Component*> registeredComponents_;
 	std::vector<Component*> tickableComponents_;
 
+	TickGroupData tickGroups_[(int)TickGroup::Count];
+
+	std::vector<TickLODLevel> tickLODLevels_;
+	Vector3 tickLODViewPosition_{ Vector3::ZeroVector };
+	float tickLODUpdateInterval_{ 0.25f };
+	float timeSinceLastTickLODUpdate_{ 0.f };
+
 	std::vector<ObjectBase*> objectsPendingDestroy_;
 	std::vector<Component*> componentsPendingDestroy_;
 
-	std::vector<TimeDependentObject*> timeDependentObjects_;
-	std::vector<TimeDependentObject*> timeDependentObjectsToRegisterForNextFrame_;
+	std::vector<SpawnBatch*> spawnBatches_;
 
 	int objectsToBeInitializedSize_{ 0 };
 	int componentsToBeInitializedSize_{ 0 };
-	int timeDependentObjectsToBeRegisteredSize_{ 0 };
+
+	// Time in seconds spawn batches can use per frame
+	float spawnBatchTimeBudget_{ 0.005f };
 
 	float timeScale_{ 1.f };
 	float deltaTime_{ 0.f };
 	float elapsedTime_{ 0.f };
 
+	bool isHeadless_{ false };
 	bool hasUninitializedObjects_{ false };
 	bool hasUninitializedComponents_{ false };
 	bool hasObjectsOrComponentsPendingDestroy_{ false };
+	bool areTickGroupsDirty_{ false };
 };
 
 template<class T>
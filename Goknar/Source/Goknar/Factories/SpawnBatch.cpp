@@ -0,0 +1,184 @@
+#include "pch.h"
+
+#include "SpawnBatch.h"
+
+#include "Goknar/Engine.h"
+#include "Goknar/Log.h"
+#include "Goknar/ObjectBase.h"
+#include "Goknar/Components/SkeletalMeshComponent.h"
+#include "Goknar/Components/StaticMeshComponent.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Materials/MaterialBase.h"
+#include "Goknar/Physics/PhysicsObject.h"
+#include "Goknar/Physics/PhysicsWorld.h"
+#include "Goknar/Renderer/Renderer.h"
+
+SpawnBatch::SpawnBatch(const PrototypeFunction& prototypeFunction) :
+	prototypeFunction_(prototypeFunction)
+{
+}
+
+SpawnBatch::SpawnBatch(const std::string& className)
+{
+	const std::unordered_map<std::string, DynamicObjectFactory::CreateFunction>& objectMap = DynamicObjectFactory::GetInstance()->GetObjectMap();
+
+	const auto& objectIterator = objectMap.find(className);
+	if (objectIterator != objectMap.end())
+	{
+		prototypeFunction_ = objectIterator->second;
+	}
+	else
+	{
+		GOKNAR_CORE_ERROR("SpawnBatch: Class {} is not registered to the DynamicObjectFactory!", className);
+	}
+}
+
+SpawnBatch::~SpawnBatch()
+{
+}
+
+void SpawnBatch::AddInstance(const Vector3& position, const Quaternion& rotation/* = Quaternion::Identity*/, const Vector3& scaling/* = Vector3(1.f)*/)
+{
+	SpawnTransformation transformation;
+	transformation.position = position;
+	transformation.rotation = rotation;
+	transformation.scaling = scaling;
+
+	transformations_.push_back(transformation);
+}
+
+bool SpawnBatch::SpawnInstances(float timeBudget)
+{
+	if (!prototypeFunction_)
+	{
+		// Nothing can be spawned, drop the batch
+		transformations_.clear();
+		return true;
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	const int instanceCount = GetInstanceCount();
+	const int sliceBeginIndex = GetSpawnedInstanceCount();
+
+	if (sliceBeginIndex == 0)
+	{
+		spawnedObjects_.reserve(instanceCount);
+	}
+
+	// Construction registers objects and components to the engine, so it stays on the main thread
+	int instanceIndex = sliceBeginIndex;
+	while (instanceIndex < instanceCount)
+	{
+		ObjectBase* object = prototypeFunction_();
+		spawnedObjects_.push_back(object);
+
+		if (instanceIndex == 0)
+		{
+			ReserveEngineCapacity(object);
+		}
+
+		++instanceIndex;
+
+		// Do not query the clock for every single object
+		if ((instanceIndex & 15) == 0)
+		{
+			const float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+			if (timeBudget < elapsedTime)
+			{
+				break;
+			}
+		}
+	}
+
+	const int sliceEndIndex = instanceIndex;
+
+	// Set the whole transformation at once so that the world matrices are calculated only one time
+	for (int spawnedIndex = sliceBeginIndex; spawnedIndex < sliceEndIndex; ++spawnedIndex)
+	{
+		ObjectBase* object = spawnedObjects_[spawnedIndex];
+		const SpawnTransformation& transformation = transformations_[spawnedIndex];
+
+		object->SetWorldPosition(transformation.position, false);
+		object->SetWorldRotation(transformation.rotation, false);
+		object->SetWorldScaling(transformation.scaling);
+	}
+
+	if (instanceSetupFunction_)
+	{
+		if (runInstanceSetupInParallel_)
+		{
+			engine->GetJobManager()->ParallelFor(sliceEndIndex - sliceBeginIndex, 64,
+				[this, sliceBeginIndex](int beginIndex, int endIndex)
+				{
+					for (int setupIndex = sliceBeginIndex + beginIndex; setupIndex < sliceBeginIndex + endIndex; ++setupIndex)
+					{
+						instanceSetupFunction_(spawnedObjects_[setupIndex], setupIndex);
+					}
+				});
+		}
+		else
+		{
+			for (int setupIndex = sliceBeginIndex; setupIndex < sliceEndIndex; ++setupIndex)
+			{
+				instanceSetupFunction_(spawnedObjects_[setupIndex], setupIndex);
+			}
+		}
+	}
+
+	const bool isFinished = GetIsFinished();
+	if (isFinished && onFinished_)
+	{
+		onFinished_(spawnedObjects_);
+	}
+
+	return isFinished;
+}
+
+void SpawnBatch::ReserveEngineCapacity(ObjectBase* firstObject)
+{
+	const int remainingInstanceCount = GetInstanceCount() - 1;
+	if (remainingInstanceCount <= 0)
+	{
+		return;
+	}
+
+	const std::vector<Component*>& components = firstObject->GetComponents();
+	const int componentCount = (int)components.size();
+
+	// Headless engines have no renderer
+	Renderer* renderer = engine->GetRenderer();
+
+	int tickableComponentCount = 0;
+	for (Component* component : components)
+	{
+		if (component->GetIsTickable())
+		{
+			++tickableComponentCount;
+		}
+
+		StaticMeshComponent* staticMeshComponent = dynamic_cast<StaticMeshComponent*>(component);
+		if (renderer && staticMeshComponent && staticMeshComponent->GetMeshInstance()->GetMesh())
+		{
+			renderer->ReserveStaticMeshInstances(staticMeshComponent->GetMeshInstance()->GetMaterial()->GetBlendModel(), remainingInstanceCount);
+			continue;
+		}
+
+		SkeletalMeshComponent* skeletalMeshComponent = dynamic_cast<SkeletalMeshComponent*>(component);
+		if (renderer && skeletalMeshComponent && skeletalMeshComponent->GetMeshInstance()->GetMesh())
+		{
+			renderer->ReserveSkeletalMeshInstances(skeletalMeshComponent->GetMeshInstance()->GetMaterial()->GetBlendModel(), remainingInstanceCount);
+		}
+	}
+
+	engine->ReserveObjectCapacity(
+		remainingInstanceCount,
+		firstObject->GetIsTickable() ? remainingInstanceCount : 0,
+		remainingInstanceCount * componentCount,
+		remainingInstanceCount * tickableComponentCount);
+
+	if (dynamic_cast<PhysicsObject*>(firstObject))
+	{
+		engine->GetPhysicsWorld()->ReservePhysicsObjects(remainingInstanceCount);
+	}
+}
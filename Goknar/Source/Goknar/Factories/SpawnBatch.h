@@ -0,0 +1,94 @@
+#ifndef __SPAWNBATCH_H__
+#define __SPAWNBATCH_H__
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Goknar/Core.h"
+#include "Goknar/Factories/DynamicObjectFactory.h"
+#include "Goknar/Math/GoknarMath.h"
+#include "Goknar/Math/Quaternion.h"
+
+class ObjectBase;
+
+struct GOKNAR_API SpawnTransformation
+{
+	Vector3 position{ Vector3::ZeroVector };
+	Quaternion rotation{ Quaternion::Identity };
+	Vector3 scaling{ Vector3(1.f) };
+};
+
+// Spawns many objects built by the same prototype function
+// Submit it with Engine::AddSpawnBatch, the engine constructs the instances over
+// multiple frames under its spawn batch time budget and deletes the batch when it is finished
+// Engine containers, renderer instance arrays and physics object arrays are reserved
+// once for the whole batch instead of growing per object
+class GOKNAR_API SpawnBatch
+{
+public:
+	using PrototypeFunction = DynamicObjectFactory::CreateFunction;
+	// Must only modify the given object since it can run on worker threads
+	using InstanceSetupFunction = std::function<void(ObjectBase* object, int instanceIndex)>;
+	using FinishedFunction = std::function<void(const std::vector<ObjectBase*>& spawnedObjects)>;
+
+	SpawnBatch(const PrototypeFunction& prototypeFunction);
+	SpawnBatch(const std::string& className);
+	~SpawnBatch();
+
+	void Reserve(int instanceCount)
+	{
+		transformations_.reserve(instanceCount);
+	}
+
+	void AddInstance(const Vector3& position, const Quaternion& rotation = Quaternion::Identity, const Vector3& scaling = Vector3(1.f));
+
+	void SetInstanceSetupFunction(const InstanceSetupFunction& instanceSetupFunction, bool runInParallel = false)
+	{
+		instanceSetupFunction_ = instanceSetupFunction;
+		runInstanceSetupInParallel_ = runInParallel;
+	}
+
+	void SetOnFinished(const FinishedFunction& onFinished)
+	{
+		onFinished_ = onFinished;
+	}
+
+	int GetInstanceCount() const
+	{
+		return (int)transformations_.size();
+	}
+
+	int GetSpawnedInstanceCount() const
+	{
+		return (int)spawnedObjects_.size();
+	}
+
+	bool GetIsFinished() const
+	{
+		return transformations_.size() <= spawnedObjects_.size();
+	}
+
+	const std::vector<ObjectBase*>& GetSpawnedObjects() const
+	{
+		return spawnedObjects_;
+	}
+
+	// Spawns instances until timeBudget(in seconds) is exceeded
+	// At least one instance is spawned per call, returns true if every instance is spawned
+	bool SpawnInstances(float timeBudget);
+
+private:
+	void ReserveEngineCapacity(ObjectBase* firstObject);
+
+	std::vector<SpawnTransformation> transformations_;
+	std::vector<ObjectBase*> spawnedObjects_;
+
+	PrototypeFunction prototypeFunction_;
+	InstanceSetupFunction instanceSetupFunction_;
+	FinishedFunction onFinished_;
+
+	bool runInstanceSetupInParallel_{ false };
+};
+
+#endif
@@ -2,11 +2,16 @@
 
 #include "SceneParser.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "Goknar/Camera.h"
 #include "Goknar/Engine.h"
+#include "Goknar/Log.h"
 #include "Goknar/Scene.h"
 #include "Goknar/ObjectBase.h"
 
@@ -17,6 +22,8 @@
 
 #include "Goknar/Factories/DynamicObjectFactory.h"
 
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/CookedSceneLoader.h"
 #include "Goknar/IO/ModelLoader.h"
 
 #include "Goknar/Lights/DirectionalLight.h"
@@ -24,6 +31,7 @@
 #include "Goknar/Lights/SpotLight.h"
 
 #include "Goknar/Managers/CameraManager.h"
+#include "Goknar/Managers/LevelStreamingManager.h"
 #include "Goknar/Managers/ResourceManager.h"
 
 #include "Goknar/Materials/MaterialBase.h"
@@ -47,15 +55,157 @@
 
 #include "tinyxml2.h"
 
+// Text of the element, an empty string for missing and empty elements
+static const char* GetElementText(const tinyxml2::XMLElement* element)
+{
+	const char* text = element ? element->GetText() : nullptr;
+	return text ? text : "";
+}
+
+// Parses up to count whitespace separated numbers without allocating, advances text past the parsed numbers
+// Returns the number of parsed values, the values that are not parsed are left untouched
+static int ParseFloats(const char*& text, float* values, int count)
+{
+	for (int valueIndex = 0; valueIndex < count; ++valueIndex)
+	{
+		char* end;
+		const float value = std::strtof(text, &end);
+		if (end == text)
+		{
+			return valueIndex;
+		}
+
+		values[valueIndex] = value;
+		text = end;
+	}
+
+	return count;
+}
+
+static int ParseInts(const char*& text, long* values, int count)
+{
+	for (int valueIndex = 0; valueIndex < count; ++valueIndex)
+	{
+		char* end;
+		const long value = std::strtol(text, &end, 10);
+		if (end == text)
+		{
+			return valueIndex;
+		}
+
+		values[valueIndex] = value;
+		text = end;
+	}
+
+	return count;
+}
+
+static float ParseFloat(const tinyxml2::XMLElement* element, float defaultValue = 0.f)
+{
+	const char* text = GetElementText(element);
+	ParseFloats(text, &defaultValue, 1);
+	return defaultValue;
+}
+
+static int ParseInt(const tinyxml2::XMLElement* element, int defaultValue = 0)
+{
+	const char* text = GetElementText(element);
+	long value = defaultValue;
+	ParseInts(text, &value, 1);
+	return (int)value;
+}
+
+static Vector3 ParseVector3(const tinyxml2::XMLElement* element, const Vector3& defaultValue = Vector3::ZeroVector)
+{
+	const char* text = GetElementText(element);
+	float values[3] = { defaultValue.x, defaultValue.y, defaultValue.z };
+	ParseFloats(text, values, 3);
+	return Vector3(values[0], values[1], values[2]);
+}
+
+static Vector4 ParseVector4(const tinyxml2::XMLElement* element)
+{
+	const char* text = GetElementText(element);
+	float values[4] = { 0.f, 0.f, 0.f, 0.f };
+	ParseFloats(text, values, 4);
+	return Vector4(values[0], values[1], values[2], values[3]);
+}
+
+// First whitespace separated word of the element
+static std::string ParseWord(const tinyxml2::XMLElement* element)
+{
+	const char* text = GetElementText(element);
+	while (*text && std::isspace((unsigned char)*text))
+	{
+		++text;
+	}
+
+	const char* wordEnd = text;
+	while (*wordEnd && !std::isspace((unsigned char)*wordEnd))
+	{
+		++wordEnd;
+	}
+
+	return std::string(text, wordEnd);
+}
+
+static bool GetIsWord(const tinyxml2::XMLElement* element, const char* word)
+{
+	return ParseWord(element) == word;
+}
+
+template<class LightType>
+static void ParseShadowValues(LightType* light, tinyxml2::XMLElement* lightElement)
+{
+	tinyxml2::XMLElement* child = lightElement->FirstChildElement("IsCastingShadow");
+	if (child)
+	{
+		light->SetIsShadowEnabled(ParseInt(child) != 0);
+	}
+
+	child = lightElement->FirstChildElement("ShadowIntensity");
+	if (child)
+	{
+		light->SetShadowIntensity(ParseFloat(child));
+	}
+
+	child = lightElement->FirstChildElement("ShadowMapResolution");
+	if (child)
+	{
+		const char* text = GetElementText(child);
+		long resolution[2] = { 1024, 1024 };
+		ParseInts(text, resolution, 2);
+		light->SetShadowWidth((int)resolution[0]);
+		light->SetShadowHeight((int)resolution[1]);
+	}
+}
+
 void SceneParser::Parse(Scene* scene, const std::string& filePath)
 {
+	std::string extension = ResourceManagerUtils::GetExtension(filePath);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	if (extension == COOKED_SCENE_EXTENSION)
+	{
+		if (!CookedSceneLoader::LoadCookedScene(scene, filePath))
+		{
+			GOKNAR_CORE_FATAL("Cooked scene file could not be loaded at {}.", filePath);
+			exit(EXIT_FAILURE);
+		}
+		return;
+	}
+
+	// An up to date cooked scene skips the XML parsing
+	const std::string cookedPath = CookedSceneLoader::GetCookedPath(filePath);
+	if (CookedFileUtils::GetIsCookedFileUpToDate(filePath, cookedPath) && CookedSceneLoader::LoadCookedScene(scene, cookedPath))
+	{
+		return;
+	}
+
 	tinyxml2::XMLDocument xmlFile;
-	std::stringstream stream;
 
 	tinyxml2::XMLError res;
 
-	ResourceManager* resourceManager = engine->GetResourceManager();
-
 	try
 	{
 		res = xmlFile.LoadFile(filePath.c_str());
@@ -70,6 +220,13 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		exit(EXIT_FAILURE);
 	}
 
+	ParseDocument(scene, xmlFile);
+}
+
+void SceneParser::ParseDocument(Scene* scene, tinyxml2::XMLDocument& xmlFile)
+{
+	ResourceManager* resourceManager = engine->GetResourceManager();
+
 	auto root = xmlFile.FirstChild();
 	if (!root)
 	{
@@ -78,22 +235,10 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 
 	//Get BackgroundColor
 	tinyxml2::XMLElement* element = root->FirstChildElement("BackgroundColor");
-	if (element)
-	{
-		stream << element->GetText() << std::endl;
-	}
-	else
-	{
-		stream << "0 0 0" << std::endl;
-	}
-
-	Colorf backgroundColor;
-	stream >> backgroundColor.r >> backgroundColor.g >> backgroundColor.b;
+	Colorf backgroundColor = Colorf(ParseVector3(element));
 
 	scene->SetBackgroundColor(backgroundColor / 255.f);
 
-	stream.clear();
-
 	//Get Cameras
 	element = root->FirstChildElement("Cameras");
 	if (element)
@@ -104,48 +249,33 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		{
 			camera = new Camera();
 			auto child = element->FirstChildElement("Position");
-			stream << child->GetText() << std::endl;
-			float x, y, z;
-			stream >> x >> y >> z;
-			camera->SetPosition(Vector3(x, y, z));
+			camera->SetPosition(ParseVector3(child));
 
 			child = element->FirstChildElement("NearDistance");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				float nearDistance;
-				stream >> nearDistance;
-				camera->SetNearDistance(nearDistance);
+				camera->SetNearDistance(ParseFloat(child));
 			}
 
 			child = element->FirstChildElement("FarDistance");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				float farDistance;
-				stream >> farDistance;
-				camera->SetFarDistance(farDistance);
+				camera->SetFarDistance(ParseFloat(child));
 			}
 
 			child = element->FirstChildElement("Projection");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string projection;
-				stream >> projection;
-				camera->SetProjection(projection == "Orthographic" ? CameraProjection::Orthographic : CameraProjection::Perspective);
+				camera->SetProjection(GetIsWord(child, "Orthographic") ? CameraProjection::Orthographic : CameraProjection::Perspective);
 			}
 
 			const char* cameraType = element->Attribute("type");
-			if (cameraType && std::string(cameraType) == "simple")
+			if (cameraType && std::strcmp(cameraType, "simple") == 0)
 			{
 				child = element->FirstChildElement("GazePoint");
 				if (child)
 				{
-					Vector3 gazePoint;
-					stream << child->GetText() << std::endl;
-					stream >> gazePoint.x >> gazePoint.y >> gazePoint.z;
-
+					Vector3 gazePoint = ParseVector3(child);
 					camera->SetForwardVector((gazePoint - camera->GetPosition()).GetNormalized());
 				}
 				else
@@ -153,17 +283,12 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 					child = element->FirstChildElement("Gaze");
 					if (child)
 					{
-						stream << child->GetText() << std::endl;
-						float x, y, z;
-						stream >> x >> y >> z;
-						camera->SetForwardVector(Vector3(x, y, z));
+						camera->SetForwardVector(ParseVector3(child));
 					}
 				}
 
-				float fovY;
 				child = element->FirstChildElement("FovY");
-				stream << child->GetText() << std::endl;
-				stream >> fovY;
+				float fovY = ParseFloat(child);
 
 				float resolutionProportion = (float)camera->GetImageWidth() / camera->GetImageHeight();
 
@@ -179,26 +304,16 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			else
 			{
 				child = element->FirstChildElement("Gaze");
-				stream << child->GetText() << std::endl;
-				Vector3 forward;
-				stream >> forward.x >> forward.y >> forward.z;
-				camera->SetForwardVector(forward);
+				camera->SetForwardVector(ParseVector3(child));
 
 				child = element->FirstChildElement("NearPlane");
-				stream << child->GetText() << std::endl;
-				Vector4 nearPlane;
-				stream >> nearPlane.x >> nearPlane.y >> nearPlane.z >> nearPlane.w;
-				camera->SetNearPlane(nearPlane);
+				camera->SetNearPlane(ParseVector4(child));
 			}
 
 			child = element->FirstChildElement("Up");
-			stream << child->GetText() << std::endl;
-			Vector3 up;
-			stream >> up.x >> up.y >> up.z;
-			camera->SetUpVector(up);
+			camera->SetUpVector(ParseVector3(child));
 
 			element = element->NextSiblingElement("Camera");
-			stream.clear();
 		}
 	}
 
@@ -211,11 +326,7 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		child = element->FirstChildElement("AmbientLight");
 		if (child)
 		{
-			stream << child->GetText() << std::endl;
-			Vector3 ambientLight;
-			stream >> ambientLight.x >> ambientLight.y >> ambientLight.z;
-
-			scene->SetAmbientLight(ambientLight);
+			scene->SetAmbientLight(ParseVector3(child));
 		}
 	}
 
@@ -229,84 +340,14 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		{
 			pointLight = new PointLight();
 
-			child = element->FirstChildElement("Position");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Color");
-			stream << child->GetText() << std::endl;
+			pointLight->SetPosition(ParseVector3(element->FirstChildElement("Position")));
+			pointLight->SetColor(ParseVector3(element->FirstChildElement("Color")));
+			pointLight->SetIntensity(ParseFloat(element->FirstChildElement("Intensity")));
+			pointLight->SetRadius(ParseFloat(element->FirstChildElement("Radius")));
 
-			child = element->FirstChildElement("Intensity");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Radius");
-			stream << child->GetText() << std::endl;
-
-			bool isCastingShadowElementFound = false;
-			child = element->FirstChildElement("IsCastingShadow");
-			if (child)
-			{
-				isCastingShadowElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowIntensityElementFound = false;
-			child = element->FirstChildElement("ShadowIntensity");
-			if (child)
-			{
-				shadowIntensityElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowMapResolutionElementFound = false;
-			child = element->FirstChildElement("ShadowMapResolution");
-			if (child)
-			{
-				shadowMapResolutionElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			Vector3 position;
-			stream >> position.x >> position.y >> position.z;
-			pointLight->SetPosition(position);
-
-			Vector3 color;
-			stream >> color.x >> color.y >> color.z;
-			pointLight->SetColor(color);
-
-			float intensity;
-			stream >> intensity;
-			pointLight->SetIntensity(intensity);
-
-			float radius;
-			stream >> radius;
-			pointLight->SetRadius(radius);
-
-			if (isCastingShadowElementFound)
-			{
-				bool isCastingShadow = false;
-				stream >> isCastingShadow;
-				pointLight->SetIsShadowEnabled(isCastingShadow);
-			}
-
-			if (shadowIntensityElementFound)
-			{
-				float shadowIntensity = 0.f;
-				stream >> shadowIntensity;
-				pointLight->SetShadowIntensity(shadowIntensity);
-			}
-
-			if (shadowMapResolutionElementFound)
-			{
-				int x = 1024;
-				int y = 1024;
-				stream >> x >> y;
-				pointLight->SetShadowWidth(x);
-				pointLight->SetShadowHeight(y);
-			}
+			ParseShadowValues(pointLight, element);
 
 			element = element->NextSiblingElement("PointLight");
-
-			stream.clear();
 		}
 	}
 
@@ -320,78 +361,16 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		{
 			directionalLight = new DirectionalLight();
 
-			child = element->FirstChildElement("Direction");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Color");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Intensity");
-			stream << child->GetText() << std::endl;
-
-			bool isCastingShadowElementFound = false;
-			child = element->FirstChildElement("IsCastingShadow");
-			if (child)
-			{
-				isCastingShadowElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowIntensityElementFound = false;
-			child = element->FirstChildElement("ShadowIntensity");
-			if (child)
-			{
-				shadowIntensityElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowMapResolutionElementFound = false;
-			child = element->FirstChildElement("ShadowMapResolution");
-			if (child)
-			{
-				shadowMapResolutionElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			Vector3 direction;
-			stream >> direction.x >> direction.y >> direction.z;
+			Vector3 direction = ParseVector3(element->FirstChildElement("Direction"));
 			direction.Normalize();
 			directionalLight->SetDirection(direction);
 
-			Vector3 color;
-			stream >> color.x >> color.y >> color.z;
-			directionalLight->SetColor(color);
+			directionalLight->SetColor(ParseVector3(element->FirstChildElement("Color")));
+			directionalLight->SetIntensity(ParseFloat(element->FirstChildElement("Intensity")));
 
-			float intensity;
-			stream >> intensity;
-			directionalLight->SetIntensity(intensity);
-
-			if (isCastingShadowElementFound)
-			{
-				bool isCastingShadow = false;
-				stream >> isCastingShadow;
-				directionalLight->SetIsShadowEnabled(isCastingShadow);
-			}
-
-			if (shadowIntensityElementFound)
-			{
-				float shadowIntensity = 0.f;
-				stream >> shadowIntensity;
-				directionalLight->SetShadowIntensity(shadowIntensity);
-			}
-
-			if (shadowMapResolutionElementFound)
-			{
-				int x = 1024;
-				int y = 1024;
-				stream >> x >> y;
-				directionalLight->SetShadowWidth(x);
-				directionalLight->SetShadowHeight(y);
-			}
+			ParseShadowValues(directionalLight, element);
 
 			element = element->NextSiblingElement("DirectionalLight");
-
-			stream.clear();
 		}
 	}
 
@@ -405,99 +384,21 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 		{
 			spotLight = new SpotLight();
 
-			child = element->FirstChildElement("Position");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Direction");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Color");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("Intensity");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("CoverageAngle");
-			stream << child->GetText() << std::endl;
-
-			child = element->FirstChildElement("FalloffAngle");
-			stream << child->GetText() << std::endl;
-
-			bool isCastingShadowElementFound = false;
-			child = element->FirstChildElement("IsCastingShadow");
-			if (child)
-			{
-				isCastingShadowElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowIntensityElementFound = false;
-			child = element->FirstChildElement("ShadowIntensity");
-			if (child)
-			{
-				shadowIntensityElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			bool shadowMapResolutionElementFound = false;
-			child = element->FirstChildElement("ShadowMapResolution");
-			if (child)
-			{
-				shadowMapResolutionElementFound = true;
-				stream << child->GetText() << std::endl;
-			}
-
-			Vector3 position;
-			stream >> position.x >> position.y >> position.z;
-			spotLight->SetPosition(position);
+			spotLight->SetPosition(ParseVector3(element->FirstChildElement("Position")));
 
-			Vector3 direction;
-			stream >> direction.x >> direction.y >> direction.z;
+			Vector3 direction = ParseVector3(element->FirstChildElement("Direction"));
 			direction.Normalize();
 			spotLight->SetDirection(direction);
 
-			Vector3 color;
-			stream >> color.x >> color.y >> color.z;
-			spotLight->SetColor(color);
+			spotLight->SetColor(ParseVector3(element->FirstChildElement("Color")));
+			spotLight->SetIntensity(ParseFloat(element->FirstChildElement("Intensity")));
+			spotLight->SetCoverageAngle(ParseFloat(element->FirstChildElement("CoverageAngle")));
+			spotLight->SetFalloffAngle(ParseFloat(element->FirstChildElement("FalloffAngle")));
 
-			float intensity;
-			stream >> intensity;
-			spotLight->SetIntensity(intensity);
-
-			float coverageAngle;
-			stream >> coverageAngle;
-			spotLight->SetCoverageAngle(coverageAngle);
-
-			float falloffAngle;
-			stream >> falloffAngle;
-			spotLight->SetFalloffAngle(falloffAngle);
-
-			if (isCastingShadowElementFound)
-			{
-				bool isCastingShadow = false;
-				stream >> isCastingShadow;
-				spotLight->SetIsShadowEnabled(isCastingShadow);
-			}
-
-			if (shadowIntensityElementFound)
-			{
-				float shadowIntensity = 0.f;
-				stream >> shadowIntensity;
-				spotLight->SetShadowIntensity(shadowIntensity);
-			}
-
-			if (shadowMapResolutionElementFound)
-			{
-				int x = 1024;
-				int y = 1024;
-				stream >> x >> y;
-				spotLight->SetShadowWidth(x);
-				spotLight->SetShadowHeight(y);
-			}
+			ParseShadowValues(spotLight, element);
 
 			element = element->NextSiblingElement("SpotLight");
 		}
-		stream.clear();
 	}
 
 	//Get Textures
@@ -513,19 +414,13 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("Path");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string textureImagePath;
-				stream >> textureImagePath;
-				texture->SetTextureImagePath(textureImagePath);
+				texture->SetTextureImagePath(ParseWord(child));
 			}
-			stream.clear();
 
 			child = element->FirstChildElement("Wrapping");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string textureWrapping;
-				stream >> textureWrapping;
+				const std::string textureWrapping = ParseWord(child);
 
 				texture->SetTextureWrappingS(textureWrapping == "Repeat" ? TextureWrapping::REPEAT :
 											textureWrapping == "MirroredRepeat" ? TextureWrapping::MIRRORED_REPEAT :
@@ -533,14 +428,11 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 											textureWrapping == "ClampToBorder" ? TextureWrapping::CLAMP_TO_BORDER :
 											texture->GetTextureWrappingS());
 			}
-			stream.clear();
 
 			child = element->FirstChildElement("MinFilter");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string textureMinFilter;
-				stream >> textureMinFilter;
+				const std::string textureMinFilter = ParseWord(child);
 
 				texture->SetTextureMinFilter(textureMinFilter == "Nearest" ? TextureMinFilter::NEAREST :
 											textureMinFilter == "Linear" ? TextureMinFilter::LINEAR :
@@ -550,27 +442,21 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 											textureMinFilter == "LinearMipMapLinear" ? TextureMinFilter::LINEAR_MIPMAP_LINEAR :
 											texture->GetTextureMinFilter());
 			}
-			stream.clear();
 
 			child = element->FirstChildElement("MagFilter");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string textureMagFilter;
-				stream >> textureMagFilter;
+				const std::string textureMagFilter = ParseWord(child);
 
 				texture->SetTextureMagFilter(textureMagFilter == "Nearest" ? TextureMagFilter::NEAREST :
 											 textureMagFilter == "Linear" ? TextureMagFilter::LINEAR :
 											 texture->GetTextureMagFilter());
 			}
-			stream.clear();
 
 			child = element->FirstChildElement("Usage");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string usage;
-				stream >> usage;
+				const std::string usage = ParseWord(child);
 
 				texture->SetTextureUsage(	usage == "Diffuse" ? TextureUsage::Diffuse :
 											usage == "Normal" ? TextureUsage::Normal :
@@ -581,21 +467,16 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 											usage == "Specular" ? TextureUsage::Specular :
 											TextureUsage::None);
 			}
-			stream.clear();
 
 			child = element->FirstChildElement("Name");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string textureName;
-				stream >> textureName;
-				texture->SetName(textureName.c_str());
+				texture->SetName(ParseWord(child).c_str());
 			}
 
 			scene->AddTexture(texture);
 			element = element->NextSiblingElement("Texture");
 		}
-		stream.clear();
 	}
 
 	//Get Materials
@@ -611,9 +492,7 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("BlendModel");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string blendModel;
-				stream >> blendModel;
+				const std::string blendModel = ParseWord(child);
 				material->SetBlendModel(blendModel == "Masked" ? MaterialBlendModel::Masked :
 					blendModel == "Transparent" ? MaterialBlendModel::Transparent :
 					MaterialBlendModel::Opaque);
@@ -622,9 +501,7 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("ShadingModel");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				std::string shadingModel;
-				stream >> shadingModel;
+				const std::string shadingModel = ParseWord(child);
 				material->SetShadingModel(shadingModel == "Default" ? MaterialShadingModel::Default :
 										  shadingModel == "TwoSided" ? MaterialShadingModel::TwoSided :
 										  material->GetShadingModel());
@@ -633,7 +510,7 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("Texture");
 			while (child)
 			{
-				int textureId = std::stoi(child->Attribute("id"));
+				int textureId = child->IntAttribute("id");
 				material->GetShader(RenderPassType::Forward)->AddTexture(scene->GetTexture(textureId));
 				child = child->NextSiblingElement("Texture");
 			}
@@ -641,46 +518,26 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("AmbientReflectance");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				Vector3 ambientReflectance;
-				stream >> ambientReflectance.x >> ambientReflectance.y >> ambientReflectance.z;
-				material->SetAmbientReflectance(ambientReflectance);
+				material->SetAmbientReflectance(ParseVector3(child));
 			}
 
 			child = element->FirstChildElement("DiffuseReflectance");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				Vector3 diffuseReflectance;
-				stream >> diffuseReflectance.x >> diffuseReflectance.y >> diffuseReflectance.z;
-				material->SetBaseColor(diffuseReflectance);
+				material->SetBaseColor(ParseVector3(child));
 			}
 
 			child = element->FirstChildElement("SpecularReflectance");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				Vector3 specularReflectance;
-				stream >> specularReflectance.x >> specularReflectance.y >> specularReflectance.z;
-				material->SetSpecularReflectance(specularReflectance);
+				material->SetSpecularReflectance(ParseVector3(child));
 			}
 
 			child = element->FirstChildElement("PhongExponent");
-			if (child)
-			{
-				stream << child->GetText() << std::endl;
-			}
-			else
-			{
-				stream << "1" << std::endl;
-			}
-			float phongExponent;
-			stream >> phongExponent;
-			material->SetPhongExponent(phongExponent);
+			material->SetPhongExponent(child ? ParseFloat(child) : 1.f);
 
 			element = element->NextSiblingElement("Material");
 		}
-		stream.clear();
 	}
 
 	//Get Static Meshes
@@ -695,18 +552,13 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("Material");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				stream >> materialId;
+				materialId = ParseInt(child);
 			}
 
 			child = element->FirstChildElement("Path");
 			if (child)
 			{
-				std::string modelFilePath;
-				stream << child->GetText() << std::endl;
-				stream >> modelFilePath;
-
-				mesh = engine->GetResourceManager()->GetContent<StaticMesh>(modelFilePath);
+				mesh = engine->GetResourceManager()->GetContent<StaticMesh>(ParseWord(child));
 				if (mesh != nullptr)
 				{
 					if (0 <= materialId)
@@ -714,11 +566,9 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 						mesh->SetMaterial(resourceManager->GetMaterial(materialId));
 					}
 				}
-				stream.clear();
 			}
 			element = element->NextSiblingElement("Mesh");
 		}
-		stream.clear();
 	}
 
 	//Get Static Meshes
@@ -733,102 +583,70 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("Material");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				stream >> materialId;
+				materialId = ParseInt(child);
 			}
 
-			bool loadedWithFile = false;
-
 			child = element->FirstChildElement("Path");
 			if (child)
 			{
-				std::string modelFilePath;
-				stream << child->GetText() << std::endl;
-				stream >> modelFilePath;
-
-				mesh = engine->GetResourceManager()->GetContent<StaticMesh>(modelFilePath);
+				mesh = engine->GetResourceManager()->GetContent<StaticMesh>(ParseWord(child));
 				if (mesh != nullptr)
 				{
 					if (0 <= materialId)
 					{
 						mesh->SetMaterial(resourceManager->GetMaterial(materialId));
 					}
-					loadedWithFile = true;
 				}
-				stream.clear();
 				element = element->NextSiblingElement("StaticMesh");
 				continue;
 			}
 
-			if (!mesh)
+			mesh = new StaticMesh();
+			if (0 <= materialId)
 			{
-				mesh = new StaticMesh();
-				if (0 <= materialId)
-				{
-					mesh->SetMaterial(resourceManager->GetMaterial(materialId));
-				}
+				mesh->SetMaterial(resourceManager->GetMaterial(materialId));
+			}
 
-				child = element->FirstChildElement("Vertices");
-				stream << child->GetText() << std::endl;
-				Vector3 vertex;
-				while (!(stream >> vertex.x).eof())
-				{
-					stream >> vertex.y >> vertex.z;
-					mesh->AddVertex(vertex);
-				}
-				stream.clear();
+			const char* text = GetElementText(element->FirstChildElement("Vertices"));
+			float vertexValues[3];
+			while (ParseFloats(text, vertexValues, 3) == 3)
+			{
+				mesh->AddVertex(Vector3(vertexValues[0], vertexValues[1], vertexValues[2]));
+			}
 
-				child = element->FirstChildElement("Normals");
-				if (child)
+			child = element->FirstChildElement("Normals");
+			if (child)
+			{
+				text = GetElementText(child);
+				int normalIndex = 0;
+				float normalValues[3];
+				while (ParseFloats(text, normalValues, 3) == 3)
 				{
-					stream << child->GetText() << std::endl;
-					int normalIndex = 0;
-					Vector3 normal;
-					while (!(stream >> normal.x).eof())
-					{
-						stream >> normal.y >> normal.z;
-						mesh->SetVertexNormal(normalIndex++, normal);
-					}
+					mesh->SetVertexNormal(normalIndex++, Vector3(normalValues[0], normalValues[1], normalValues[2]));
 				}
-				stream.clear();
+			}
 
-				child = element->FirstChildElement("Faces");
-				stream << child->GetText() << std::endl;
-				unsigned int v0;
-				while (!(stream >> v0).eof())
-				{
-					Face face = Face();
-					face.vertexIndices[0] = v0;
-					stream >> face.vertexIndices[1] >> face.vertexIndices[2];
-					mesh->AddFace(face);
-				}
-				stream.clear();
+			text = GetElementText(element->FirstChildElement("Faces"));
+			long faceValues[3];
+			while (ParseInts(text, faceValues, 3) == 3)
+			{
+				mesh->AddFace(Face((unsigned int)faceValues[0], (unsigned int)faceValues[1], (unsigned int)faceValues[2]));
+			}
 
-				child = element->FirstChildElement("UVs");
-				if (child)
+			child = element->FirstChildElement("UVs");
+			if (child)
+			{
+				text = GetElementText(child);
+				unsigned int uvIndex = 0;
+				float uvValues[2];
+				while (uvIndex < mesh->GetVertexCount() && ParseFloats(text, uvValues, 2) == 2)
 				{
-					stream << child->GetText() << std::endl;
-					unsigned int uvIndex = 0;
-					Vector2 UV;
-					while (!(stream >> UV.x).eof())
-					{
-						stream >> UV.y;
-						if (uvIndex < mesh->GetVertexCount())
-						{
-							mesh->SetVertexUV(uvIndex++, UV);
-						}
-						else
-						{
-							break;
-						}
-					}
+					mesh->SetVertexUV(uvIndex++, Vector2(uvValues[0], uvValues[1]));
 				}
-				stream.clear();
 			}
 
 			element = element->NextSiblingElement("StaticMesh");
 		}
-		stream.clear();
 	}
 
 	//Get Skeletal Meshes
@@ -842,19 +660,14 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 			child = element->FirstChildElement("Material");
 			if (child)
 			{
-				stream << child->GetText() << std::endl;
-				stream >> materialId;
+				materialId = ParseInt(child);
 			}
 
 			child = element->FirstChildElement("Path");
 			SkeletalMesh* skeletalMesh;
 			if (child)
 			{
-				std::string modelFilePath;
-				stream << child->GetText() << std::endl;
-				stream >> modelFilePath;
-
-				skeletalMesh = engine->GetResourceManager()->GetContent<SkeletalMesh>(modelFilePath);
+				skeletalMesh = engine->GetResourceManager()->GetContent<SkeletalMesh>(ParseWord(child));
 				if (skeletalMesh != nullptr)
 				{
 					if (0 <= materialId)
@@ -862,39 +675,70 @@ void SceneParser::Parse(Scene* scene, const std::string& filePath)
 						skeletalMesh->SetMaterial(resourceManager->GetMaterial(materialId));
 					}
 				}
-				stream.clear();
 			}
 			element = element->NextSiblingElement("SkeletalMesh");
 		}
-		stream.clear();
 	}
 
 	//Get Static Objects
 	element = root->FirstChildElement("Objects");
 	if (element)
 	{
-		DynamicObjectFactory* dynamicObjectFactory = DynamicObjectFactory::GetInstance();
-		const auto& factoryObjects = dynamicObjectFactory->GetObjectMap();
+		const std::unordered_map<std::string, DynamicObjectFactory::CreateFunction>& factoryObjects = DynamicObjectFactory::GetInstance()->GetObjectMap();
 
-		for (const auto& factoryObject : factoryObjects)
+		// Objects are created in document order, the class name buffer is reused for the factory lookups
+		std::string objectFactoryName;
+		for (tinyxml2::XMLElement* objectElement = element->FirstChildElement(); objectElement; objectElement = objectElement->NextSiblingElement())
 		{
-			const std::string& objectFactoryName = factoryObject.first;
-			tinyxml2::XMLElement* objectElement = element->FirstChildElement(objectFactoryName.c_str());
-			while (objectElement)
+			objectFactoryName.assign(objectElement->Name());
+
+			const auto factoryObject = factoryObjects.find(objectFactoryName);
+			if (factoryObject == factoryObjects.end())
 			{
-				ObjectBase* object = factoryObject.second();
-				object->SetName(objectFactoryName);
+				continue;
+			}
 
-				if (RigidBody* rigidBody = dynamic_cast<RigidBody*>(object))
-				{
-					ParseRigidBody(rigidBody, objectElement);
-				}
+			ObjectBase* object = factoryObject->second();
+			object->SetName(objectFactoryName);
 
-				ParseObjectBase(object, objectElement);
+			if (RigidBody* rigidBody = dynamic_cast<RigidBody*>(object))
+			{
+				ParseRigidBody(rigidBody, objectElement);
+			}
+
+			ParseObjectBase(object, objectElement);
+		}
+	}
 
-				objectElement = objectElement->NextSiblingElement(objectFactoryName.c_str());
+	//Get Streaming Cells
+	element = root->FirstChildElement("StreamingCells");
+	if (element)
+	{
+		LevelStreamingManager* levelStreamingManager = engine->GetLevelStreamingManager();
+
+		child = element->FirstChildElement("StreamingRadius");
+		if (child)
+		{
+			levelStreamingManager->SetStreamingRadius(ParseFloat(child));
+		}
+
+		child = element->FirstChildElement("UnloadMargin");
+		if (child)
+		{
+			levelStreamingManager->SetUnloadMargin(ParseFloat(child));
+		}
+
+		for (tinyxml2::XMLElement* cellElement = element->FirstChildElement("Cell"); cellElement; cellElement = cellElement->NextSiblingElement("Cell"))
+		{
+			StreamingCell* cell = levelStreamingManager->AddCell(
+				ParseWord(cellElement->FirstChildElement("Name")),
+				Box(ParseVector3(cellElement->FirstChildElement("Min")), ParseVector3(cellElement->FirstChildElement("Max"))),
+				ParseWord(cellElement->FirstChildElement("Scene")));
+
+			for (tinyxml2::XMLElement* dependencyElement = cellElement->FirstChildElement("Dependency"); dependencyElement; dependencyElement = dependencyElement->NextSiblingElement("Dependency"))
+			{
+				cell->AddDependency(ParseWord(dependencyElement));
 			}
-			stream.clear();
 		}
 	}
 }
@@ -922,209 +766,349 @@ void SceneParser::SaveScene(Scene* scene, const std::string& filePath)
 	sceneXML.SaveFile(filePath.c_str());
 }
 
-void SceneParser::ParseComponentValues(Component* component, tinyxml2::XMLElement* componentElement)
+// Every distinct string is stored once in the string table of the cooked scene
+static uint32_t AddCookedString(CookedSceneData& sceneData, std::unordered_map<std::string, uint32_t>& stringOffsets, const std::string& value)
+{
+	const auto stringOffsetIterator = stringOffsets.find(value);
+	if (stringOffsetIterator != stringOffsets.end())
+	{
+		return stringOffsetIterator->second;
+	}
+
+	const uint32_t stringOffset = (uint32_t)sceneData.strings.size();
+	sceneData.strings.append(value);
+	sceneData.strings.push_back('\0');
+
+	stringOffsets[value] = stringOffset;
+	return stringOffset;
+}
+
+static void CookComponents(tinyxml2::XMLElement* componentsElement, const char* componentName, CookedSceneComponentType componentType, CookedSceneData& sceneData, std::unordered_map<std::string, uint32_t>& stringOffsets)
+{
+	for (tinyxml2::XMLElement* componentElement = componentsElement->FirstChildElement(componentName); componentElement; componentElement = componentElement->NextSiblingElement(componentName))
+	{
+		CookedSceneComponent component{};
+		component.type = (uint32_t)componentType;
+
+		tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement(componentType == CookedSceneComponentType::StaticMesh ? "MeshPath" : "Mesh");
+		if (dataElement && (componentType == CookedSceneComponentType::StaticMesh ||
+			componentType == CookedSceneComponentType::MovingTriangleMeshCollision ||
+			componentType == CookedSceneComponentType::NonMovingTriangleMeshCollision))
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::Mesh;
+			component.meshPathOffset = AddCookedString(sceneData, stringOffsets, ParseWord(dataElement));
+		}
+
+		dataElement = componentElement->FirstChildElement("HalfSize");
+		if (dataElement && componentType == CookedSceneComponentType::BoxCollision)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::HalfSize;
+			component.halfSize = ParseVector3(dataElement);
+		}
+
+		dataElement = componentElement->FirstChildElement("Radius");
+		if (dataElement && (componentType == CookedSceneComponentType::SphereCollision || componentType == CookedSceneComponentType::CapsuleCollision))
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::Radius;
+			component.radius = ParseFloat(dataElement);
+		}
+
+		dataElement = componentElement->FirstChildElement("Height");
+		if (dataElement && componentType == CookedSceneComponentType::CapsuleCollision)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::Height;
+			component.height = ParseFloat(dataElement);
+		}
+
+		dataElement = componentElement->FirstChildElement("PivotPoint");
+		if (dataElement)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::PivotPoint;
+			component.pivotPoint = ParseVector3(dataElement);
+		}
+
+		dataElement = componentElement->FirstChildElement("RelativePosition");
+		if (dataElement)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::RelativePosition;
+			component.relativeTransformation.position = ParseVector3(dataElement);
+		}
+
+		dataElement = componentElement->FirstChildElement("EulerRelativeRotation");
+		if (dataElement)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::RelativeRotation;
+			component.relativeTransformation.rotation = Quaternion::FromEulerDegrees(ParseVector3(dataElement));
+		}
+
+		dataElement = componentElement->FirstChildElement("RelativeScaling");
+		if (dataElement)
+		{
+			component.flags |= (uint32_t)CookedSceneComponentFlag::RelativeScaling;
+			component.relativeTransformation.scaling = ParseVector3(dataElement);
+		}
+
+		sceneData.components.push_back(component);
+	}
+}
+
+bool SceneParser::CookScene(const std::string& sourcePath, const std::string& cookedPath)
+{
+	CookedSceneData sceneData;
+	if (!BuildCookedScene(sourcePath, sceneData))
+	{
+		return false;
+	}
+
+	return CookedSceneLoader::SaveCookedScene(sceneData, cookedPath);
+}
+
+bool SceneParser::BuildCookedScene(const std::string& sourcePath, CookedSceneData& sceneData)
 {
-	std::stringstream stream;
+	tinyxml2::XMLDocument xmlFile;
+	if (xmlFile.LoadFile(sourcePath.c_str()))
+	{
+		GOKNAR_CORE_WARN("Scene XML file could not be loaded at {}.", sourcePath);
+		return false;
+	}
+
+	tinyxml2::XMLNode* root = xmlFile.FirstChild();
+	if (!root)
+	{
+		GOKNAR_CORE_WARN("Root of the scene XML file {} could not be found.", sourcePath);
+		return false;
+	}
+
+	std::unordered_map<std::string, uint32_t> stringOffsets;
+	std::unordered_map<std::string, uint32_t> classIndices;
+
+	tinyxml2::XMLElement* objectsElement = root->FirstChildElement("Objects");
+	if (objectsElement)
+	{
+		// Classes are not resolved here since the cooker may not register the game's classes
+		std::string className;
+		for (tinyxml2::XMLElement* objectElement = objectsElement->FirstChildElement(); objectElement; objectElement = objectElement->NextSiblingElement())
+		{
+			className.assign(objectElement->Name());
 
+			CookedSceneObject object{};
+
+			const auto classIndexIterator = classIndices.find(className);
+			if (classIndexIterator != classIndices.end())
+			{
+				object.classIndex = classIndexIterator->second;
+			}
+			else
+			{
+				object.classIndex = (uint32_t)sceneData.classNameOffsets.size();
+				classIndices[className] = object.classIndex;
+				sceneData.classNameOffsets.push_back(AddCookedString(sceneData, stringOffsets, className));
+			}
+
+			SpawnTransformation transformation;
+
+			tinyxml2::XMLElement* child = objectElement->FirstChildElement("Name");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::Name;
+				object.nameOffset = AddCookedString(sceneData, stringOffsets, ParseWord(child));
+			}
+
+			child = objectElement->FirstChildElement("WorldPosition");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::WorldPosition;
+				transformation.position = ParseVector3(child);
+			}
+
+			child = objectElement->FirstChildElement("EulerWorldRotation");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::WorldRotation;
+				transformation.rotation = Quaternion::FromEulerDegrees(ParseVector3(child));
+			}
+
+			child = objectElement->FirstChildElement("WorldScaling");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::WorldScaling;
+				transformation.scaling = ParseVector3(child);
+			}
+
+			child = objectElement->FirstChildElement("Mass");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::Mass;
+				object.mass = ParseFloat(child);
+			}
+
+			child = objectElement->FirstChildElement("CollisionGroup");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::CollisionGroup;
+				object.collisionGroup = (uint32_t)ParseInt(child);
+			}
+
+			child = objectElement->FirstChildElement("CollisionMask");
+			if (child)
+			{
+				object.flags |= (uint32_t)CookedSceneObjectFlag::CollisionMask;
+				object.collisionMask = (uint32_t)ParseInt(child);
+			}
+
+			object.firstComponentIndex = (uint32_t)sceneData.components.size();
+
+			child = objectElement->FirstChildElement("Components");
+			if (child)
+			{
+				CookComponents(child, "BoxCollisionComponent", CookedSceneComponentType::BoxCollision, sceneData, stringOffsets);
+				CookComponents(child, "SphereCollisionComponent", CookedSceneComponentType::SphereCollision, sceneData, stringOffsets);
+				CookComponents(child, "CapsuleCollisionComponent", CookedSceneComponentType::CapsuleCollision, sceneData, stringOffsets);
+				CookComponents(child, "MovingTriangleMeshCollisionComponent", CookedSceneComponentType::MovingTriangleMeshCollision, sceneData, stringOffsets);
+				CookComponents(child, "NonMovingTriangleMeshCollisionComponent", CookedSceneComponentType::NonMovingTriangleMeshCollision, sceneData, stringOffsets);
+				CookComponents(child, "StaticMeshComponent", CookedSceneComponentType::StaticMesh, sceneData, stringOffsets);
+			}
+
+			object.componentCount = (uint32_t)sceneData.components.size() - object.firstComponentIndex;
+
+			sceneData.objects.push_back(object);
+			sceneData.objectTransformations.push_back(transformation);
+		}
+
+		root->DeleteChild(objectsElement);
+	}
+
+	tinyxml2::XMLPrinter printer;
+	xmlFile.Print(&printer);
+	sceneData.settingsXML = printer.CStr();
+
+	return true;
+}
+
+void SceneParser::ParseComponentValues(Component* component, tinyxml2::XMLElement* componentElement)
+{
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("PivotPoint");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		Vector3 pivotPoint;
-		stream >> pivotPoint.x >> pivotPoint.y >> pivotPoint.z;
-		component->SetPivotPoint(pivotPoint);
+		component->SetPivotPoint(ParseVector3(dataElement));
 	}
-	stream.clear();
 
 	dataElement = componentElement->FirstChildElement("RelativePosition");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		Vector3 relativePosition;
-		stream >> relativePosition.x >> relativePosition.y >> relativePosition.z;
-		component->SetRelativePosition(relativePosition);
+		component->SetRelativePosition(ParseVector3(dataElement));
 	}
-	stream.clear();
 
 	dataElement = componentElement->FirstChildElement("EulerRelativeRotation");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		Vector3 relativeRotation;
-		stream >> relativeRotation.x >> relativeRotation.y >> relativeRotation.z;
-		component->SetRelativeRotation(Quaternion::FromEulerDegrees(relativeRotation));
+		component->SetRelativeRotation(Quaternion::FromEulerDegrees(ParseVector3(dataElement)));
 	}
-	stream.clear();
 
 	dataElement = componentElement->FirstChildElement("RelativeScaling");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		Vector3 relativeScaling;
-		stream >> relativeScaling.x >> relativeScaling.y >> relativeScaling.z;
-		component->SetRelativeScaling(relativeScaling);
+		component->SetRelativeScaling(ParseVector3(dataElement));
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseStaticMeshComponentValues(StaticMeshComponent* staticMeshComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("MeshPath");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		std::string meshPath;
-		stream >> meshPath;
-		StaticMesh* staticMesh = engine->GetResourceManager()->GetContent<StaticMesh>(meshPath);
+		StaticMesh* staticMesh = engine->GetResourceManager()->GetContent<StaticMesh>(ParseWord(dataElement));
 		if (staticMesh)
 		{
 			staticMeshComponent->SetMesh(staticMesh);
 		}
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseBoxCollisionComponentValues(BoxCollisionComponent* boxCollisionComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("HalfSize");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		Vector3 halfSize;
-		stream >> halfSize.x >> halfSize.y >> halfSize.z;
-		boxCollisionComponent->SetHalfSize(halfSize);
+		boxCollisionComponent->SetHalfSize(ParseVector3(dataElement));
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseCapsuleCollisionComponentValues(CapsuleCollisionComponent* capsuleCollisionComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("Radius");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		float radius;
-		stream >> radius;
-		capsuleCollisionComponent->SetRadius(radius);
+		capsuleCollisionComponent->SetRadius(ParseFloat(dataElement));
 	}
-	stream.clear();
 
 	dataElement = componentElement->FirstChildElement("Height");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		float height;
-		stream >> height;
-		capsuleCollisionComponent->SetHeight(height);
+		capsuleCollisionComponent->SetHeight(ParseFloat(dataElement));
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseSphereCollisionComponentValues(SphereCollisionComponent* sphereCollisionComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("Radius");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		float radius;
-		stream >> radius;
-		sphereCollisionComponent->SetRadius(radius);
+		sphereCollisionComponent->SetRadius(ParseFloat(dataElement));
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseMovingTriangleMeshCollisionComponentValues(MovingTriangleMeshCollisionComponent* movingTriangleMeshCollisionComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("Mesh");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		std::string meshPath;
-		stream >> meshPath;
-
-		MeshUnit* relativeMesh = engine->GetResourceManager()->GetContent<MeshUnit>(meshPath);
+		MeshUnit* relativeMesh = engine->GetResourceManager()->GetContent<MeshUnit>(ParseWord(dataElement));
 		if (relativeMesh)
 		{
 			movingTriangleMeshCollisionComponent->SetMesh(relativeMesh);
 		}
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseNonMovingTriangleMeshCollisionComponentValues(NonMovingTriangleMeshCollisionComponent* nonMovingTriangleMeshCollisionComponent, tinyxml2::XMLElement* componentElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* dataElement = componentElement->FirstChildElement("Mesh");
 	if (dataElement)
 	{
-		stream << dataElement->GetText() << std::endl;
-		std::string meshPath;
-		stream >> meshPath;
-
-		MeshUnit* relativeMesh = engine->GetResourceManager()->GetContent<MeshUnit>(meshPath);
+		MeshUnit* relativeMesh = engine->GetResourceManager()->GetContent<MeshUnit>(ParseWord(dataElement));
 		if(relativeMesh)
 		{
 			nonMovingTriangleMeshCollisionComponent->SetMesh(relativeMesh);
 		}
 	}
-	stream.clear();
 }
 
 void SceneParser::ParseObjectBase(ObjectBase* object, tinyxml2::XMLElement* objectElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* child = objectElement->FirstChildElement("Name");
-
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		std::string name;
-		stream >> name;
-		object->SetName(name);
+		object->SetName(ParseWord(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("WorldPosition");
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		Vector3 worldPosition;
-		stream >> worldPosition.x >> worldPosition.y >> worldPosition.z;
-		object->SetWorldPosition(worldPosition);
+		object->SetWorldPosition(ParseVector3(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("EulerWorldRotation");
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		Vector3 worldRotation;
-		stream >> worldRotation.x >> worldRotation.y >> worldRotation.z;
-		object->SetWorldRotation(Quaternion::FromEulerDegrees(worldRotation));
+		object->SetWorldRotation(Quaternion::FromEulerDegrees(ParseVector3(child)));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("WorldScaling");
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		Vector3 worldScaling;
-		stream >> worldScaling.x >> worldScaling.y >> worldScaling.z;
-		object->SetWorldScaling(worldScaling);
+		object->SetWorldScaling(ParseVector3(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("Components");
 	if (child)
@@ -1144,38 +1128,23 @@ void SceneParser::ParseObjectBase(ObjectBase* object, tinyxml2::XMLElement* obje
 
 void SceneParser::ParseRigidBody(RigidBody* rigidBody, tinyxml2::XMLElement* objectElement)
 {
-	std::stringstream stream;
-
 	tinyxml2::XMLElement* child = objectElement->FirstChildElement("Mass");
-
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		float mass;
-		stream >> mass;
-		rigidBody->SetMass(mass);
+		rigidBody->SetMass(ParseFloat(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("CollisionGroup");
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		int collisionGroupInt;
-		stream >> collisionGroupInt;
-		rigidBody->SetCollisionGroup((CollisionGroup)collisionGroupInt);
+		rigidBody->SetCollisionGroup((CollisionGroup)ParseInt(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("CollisionMask");
 	if (child)
 	{
-		stream << child->GetText() << std::endl;
-		int collisionMaskInt;
-		stream >> collisionMaskInt;
-		rigidBody->SetCollisionMask((CollisionMask)collisionMaskInt);
+		rigidBody->SetCollisionMask((CollisionMask)ParseInt(child));
 	}
-	stream.clear();
 
 	child = objectElement->FirstChildElement("Components");
 	if (child)
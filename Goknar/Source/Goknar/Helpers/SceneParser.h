@@ -17,13 +17,25 @@ class SphereCollisionComponent;
 class StaticMeshComponent;
 class ObjectBase;
 
+struct CookedSceneData;
+
 class GOKNAR_API SceneParser
 {
+	friend class CookedSceneLoader;
 public:
+	// Loads the cooked sibling of the file instead if it is up to date, .gkscene files are loaded directly
 	static void Parse(Scene* scene, const std::string& filePath);
 	static void SaveScene(Scene* scene, const std::string& filePath);
 
+	// Writes the scene XML file into the cooked binary scene format
+	static bool CookScene(const std::string& sourcePath, const std::string& cookedPath);
+
+	// Converts the scene XML file into the contents of a cooked scene without writing it, safe to call on the job manager's worker threads
+	static bool BuildCookedScene(const std::string& sourcePath, CookedSceneData& sceneData);
+
 private:
+	static void ParseDocument(Scene* scene, tinyxml2::XMLDocument& xmlFile);
+
 	static void ParseComponentValues(Component* component, tinyxml2::XMLElement* componentElement);
 	static void ParseStaticMeshComponentValues(StaticMeshComponent* staticMeshComponent, tinyxml2::XMLElement* componentElement);
 	static void ParseBoxCollisionComponentValues(BoxCollisionComponent* boxCollisionComponent, tinyxml2::XMLElement* componentElement);
@@ -0,0 +1,29 @@
+#include "pch.h"
+
+#include "CookedFileUtils.h"
+
+#include <filesystem>
+
+std::string CookedFileUtils::GetCookedPath(const std::string& sourcePath, const char* cookedExtension)
+{
+	return sourcePath + "." + cookedExtension;
+}
+
+bool CookedFileUtils::GetIsCookedFileUpToDate(const std::string& sourcePath, const std::string& cookedPath)
+{
+	std::error_code errorCode;
+
+	const std::filesystem::file_time_type cookedWriteTime = std::filesystem::last_write_time(cookedPath, errorCode);
+	if (errorCode)
+	{
+		return false;
+	}
+
+	const std::filesystem::file_time_type sourceWriteTime = std::filesystem::last_write_time(sourcePath, errorCode);
+	if (errorCode)
+	{
+		return true;
+	}
+
+	return sourceWriteTime <= cookedWriteTime;
+}
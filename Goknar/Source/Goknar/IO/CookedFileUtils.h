@@ -0,0 +1,22 @@
+#ifndef __COOKEDFILEUTILS_H__
+#define __COOKEDFILEUTILS_H__
+
+#include "Goknar/Core.h"
+
+#include <string>
+
+// Paths and freshness checks shared by the cooked mesh, texture and scene files
+class GOKNAR_API CookedFileUtils
+{
+public:
+	CookedFileUtils() = delete;
+
+	// Cooked file sits next to its source file and keeps the source extension(Foo.png -> Foo.png.gktex),
+	// so sources that only differ in their extensions do not share a cooked file
+	static std::string GetCookedPath(const std::string& sourcePath, const char* cookedExtension);
+
+	// Cooked file exists and is not older than its source, a missing source counts as up to date
+	static bool GetIsCookedFileUpToDate(const std::string& sourcePath, const std::string& cookedPath);
+};
+
+#endif
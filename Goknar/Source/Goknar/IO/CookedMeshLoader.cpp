@@ -0,0 +1,597 @@
+#include "pch.h"
+
+#include "CookedMeshLoader.h"
+
+#include <cstring>
+
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Engine.h"
+#include "Goknar/GoknarAssert.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/MappedFile.h"
+#include "Goknar/Log.h"
+#include "Goknar/Managers/ResourceManager.h"
+#include "Goknar/Materials/Material.h"
+#include "Goknar/Model/SkeletalMesh.h"
+#include "Goknar/Model/StaticMesh.h"
+
+// File layout:
+//	CookedMeshFileHeader
+//	Vertex array(VertexData), face array(Face) and vertex bone data array(VertexBoneData, skeletal meshes only), each aligned to COOKED_MESH_ARRAY_ALIGNMENT
+//	Metadata: name, AABB, material, bones, armature and animations with their key arrays
+struct CookedMeshFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+
+	// Sizes of the structures the arrays are laid out with, files cooked with other layouts are rejected
+	uint32_t vertexDataSize;
+	uint32_t faceSize;
+	uint32_t vertexBoneDataSize;
+	uint32_t matrixSize;
+	uint32_t vectorKeySize;
+	uint32_t quaternionKeySize;
+
+	uint32_t isSkeletal;
+	uint32_t vertexCount;
+	uint32_t faceCount;
+	uint32_t padding;
+
+	uint64_t vertexDataOffset;
+	uint64_t faceDataOffset;
+	uint64_t vertexBoneDataOffset;
+	uint64_t metadataOffset;
+	uint64_t metadataSize;
+};
+
+// "GMSH"
+constexpr uint32_t COOKED_MESH_FILE_MAGIC = 0x48534D47;
+constexpr uint32_t COOKED_MESH_FILE_VERSION = 1;
+
+constexpr uint64_t COOKED_MESH_ARRAY_ALIGNMENT = 16;
+
+struct CookedMaterialTexture
+{
+	std::string path;
+	uint32_t textureUsage;
+};
+
+struct CookedMaterial
+{
+	std::string name;
+	Vector3 ambientReflectance;
+	Vector4 baseColor;
+	Vector3 specularReflectance;
+	Vector3 emmisiveColor;
+	float phongExponent;
+	float translucency;
+	uint32_t blendModel;
+	uint32_t shadingModel;
+	std::vector<CookedMaterialTexture> textures;
+};
+
+class CookedMeshWriter
+{
+public:
+	void WriteBytes(const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		buffer_.insert(buffer_.end(), bytes, bytes + size);
+	}
+
+	template<class T>
+	void Write(const T& value)
+	{
+		WriteBytes(&value, sizeof(T));
+	}
+
+	void WriteString(const std::string& value)
+	{
+		Write((uint32_t)value.size());
+		WriteBytes(value.data(), value.size());
+	}
+
+	void Align(uint64_t alignment)
+	{
+		buffer_.resize((buffer_.size() + alignment - 1) / alignment * alignment, 0);
+	}
+
+	uint64_t GetSize() const
+	{
+		return buffer_.size();
+	}
+
+	unsigned char* GetData()
+	{
+		return buffer_.data();
+	}
+
+private:
+	std::vector<unsigned char> buffer_;
+};
+
+// Every read is bounds checked, a failed read invalidates the reader instead of throwing
+class CookedMeshReader
+{
+public:
+	CookedMeshReader(const unsigned char* data, uint64_t size) :
+		data_(data),
+		size_(size)
+	{
+	}
+
+	bool GetIsValid() const
+	{
+		return isValid_;
+	}
+
+	void Invalidate()
+	{
+		isValid_ = false;
+	}
+
+	bool CanRead(uint64_t size)
+	{
+		if (!isValid_ || size_ - offset_ < size)
+		{
+			isValid_ = false;
+		}
+
+		return isValid_;
+	}
+
+	void ReadBytes(void* data, uint64_t size)
+	{
+		if (!CanRead(size))
+		{
+			return;
+		}
+
+		memcpy(data, data_ + offset_, size);
+		offset_ += size;
+	}
+
+	template<class T>
+	T Read()
+	{
+		T value{};
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+
+	std::string ReadString()
+	{
+		const uint32_t size = Read<uint32_t>();
+		if (!CanRead(size))
+		{
+			return "";
+		}
+
+		std::string value((const char*)data_ + offset_, size);
+		offset_ += size;
+		return value;
+	}
+
+	// Arrays are copied with a single copy since their layouts match the in-memory structures
+	template<class T>
+	T* ReadArray(int count)
+	{
+		if (count < 0 || !CanRead((uint64_t)count * sizeof(T)))
+		{
+			Invalidate();
+			return nullptr;
+		}
+
+		T* values = new T[count];
+		ReadBytes(values, (uint64_t)count * sizeof(T));
+		return values;
+	}
+
+private:
+	const unsigned char* data_;
+	uint64_t size_;
+	uint64_t offset_{ 0 };
+	bool isValid_{ true };
+};
+
+static void WriteMaterial(CookedMeshWriter& writer, const Material* material)
+{
+	writer.WriteString(material->GetName());
+	writer.Write(material->GetAmbientReflectance());
+	writer.Write(material->GetBaseColor());
+	writer.Write(material->GetSpecularReflectance());
+	writer.Write(material->GetEmmisiveColor());
+	writer.Write(material->GetPhongExponent());
+	writer.Write(material->GetTranslucency());
+	writer.Write((uint32_t)material->GetBlendModel());
+	writer.Write((uint32_t)material->GetShadingModel());
+
+	// Images are loaded through the resource manager, so their paths are stored relative to the content directory
+	std::vector<const Image*> textureImages;
+	for (const Image* image : *material->GetTextureImages())
+	{
+		if (image->GetPath().compare(0, ContentDir.size(), ContentDir) == 0)
+		{
+			textureImages.push_back(image);
+		}
+		else
+		{
+			GOKNAR_CORE_WARN("Texture {} of material {} is not in the content directory and is not cooked.", image->GetPath(), material->GetName());
+		}
+	}
+
+	writer.Write((uint32_t)textureImages.size());
+	for (const Image* image : textureImages)
+	{
+		writer.WriteString(image->GetPath().substr(ContentDir.size()));
+		writer.Write((uint32_t)image->GetTextureUsage());
+	}
+}
+
+static void ReadMaterial(CookedMeshReader& reader, CookedMaterial& cookedMaterial)
+{
+	cookedMaterial.name = reader.ReadString();
+	cookedMaterial.ambientReflectance = reader.Read<Vector3>();
+	cookedMaterial.baseColor = reader.Read<Vector4>();
+	cookedMaterial.specularReflectance = reader.Read<Vector3>();
+	cookedMaterial.emmisiveColor = reader.Read<Vector3>();
+	cookedMaterial.phongExponent = reader.Read<float>();
+	cookedMaterial.translucency = reader.Read<float>();
+	cookedMaterial.blendModel = reader.Read<uint32_t>();
+	cookedMaterial.shadingModel = reader.Read<uint32_t>();
+
+	const uint32_t textureCount = reader.Read<uint32_t>();
+	for (uint32_t textureIndex = 0; textureIndex < textureCount && reader.GetIsValid(); ++textureIndex)
+	{
+		CookedMaterialTexture texture;
+		texture.path = reader.ReadString();
+		texture.textureUsage = reader.Read<uint32_t>();
+		cookedMaterial.textures.push_back(texture);
+	}
+}
+
+static Material* CreateMaterial(const CookedMaterial& cookedMaterial)
+{
+	Material* material = new Material();
+	material->SetName(cookedMaterial.name);
+	material->SetAmbientReflectance(cookedMaterial.ambientReflectance);
+	material->SetBaseColor(cookedMaterial.baseColor);
+	material->SetSpecularReflectance(cookedMaterial.specularReflectance);
+	material->SetEmmisiveColor(cookedMaterial.emmisiveColor);
+	material->SetPhongExponent(cookedMaterial.phongExponent);
+	material->SetTranslucency(cookedMaterial.translucency);
+	material->SetBlendModel((MaterialBlendModel)cookedMaterial.blendModel);
+	material->SetShadingModel((MaterialShadingModel)cookedMaterial.shadingModel);
+
+	for (const CookedMaterialTexture& texture : cookedMaterial.textures)
+	{
+		Image* image = engine->GetResourceManager()->GetContent<Image>(texture.path);
+		if (image)
+		{
+			image->SetTextureUsage((TextureUsage)texture.textureUsage);
+			material->AddTextureImage(image);
+		}
+	}
+
+	return material;
+}
+
+static void WriteSkeleton(CookedMeshWriter& writer, const SkeletalMesh* skeletalMesh)
+{
+	const std::vector<Bone*>& bones = skeletalMesh->GetBones();
+	const BoneNameToIdMap* boneNameToIdMap = skeletalMesh->GetBoneNameToIdMap();
+
+	writer.Write((uint32_t)bones.size());
+	for (const Bone* bone : bones)
+	{
+		writer.WriteString(bone->name);
+		writer.Write(bone->offset);
+		writer.Write(bone->transformation);
+	}
+
+	// Children are written after all the bones so that they are linked by their ids on load
+	for (const Bone* bone : bones)
+	{
+		writer.Write((uint32_t)bone->children.size());
+		for (const Bone* childBone : bone->children)
+		{
+			writer.Write((uint32_t)boneNameToIdMap->at(childBone->name));
+		}
+	}
+
+	const Armature* armature = skeletalMesh->GetArmature();
+	writer.Write(armature->root ? (int32_t)boneNameToIdMap->at(armature->root->name) : (int32_t)-1);
+	writer.Write(armature->globalInverseTransform);
+
+	const SkeletalAnimationVector& skeletalAnimations = skeletalMesh->GetSkeletalAnimations();
+	writer.Write((uint32_t)skeletalAnimations.size());
+	for (const SkeletalAnimation* skeletalAnimation : skeletalAnimations)
+	{
+		writer.WriteString(skeletalAnimation->name);
+		writer.Write(skeletalAnimation->duration);
+		writer.Write(skeletalAnimation->ticksPerSecond);
+		writer.Write(skeletalAnimation->maxKeyframe);
+		writer.Write(skeletalAnimation->animationNodeSize);
+
+		for (unsigned int animationNodeIndex = 0; animationNodeIndex < skeletalAnimation->animationNodeSize; ++animationNodeIndex)
+		{
+			const SkeletalAnimationNode* skeletalAnimationNode = skeletalAnimation->animationNodes[animationNodeIndex];
+			writer.WriteString(skeletalAnimationNode->affectedBoneName);
+
+			writer.Write((int32_t)skeletalAnimationNode->rotationKeySize);
+			writer.WriteBytes(skeletalAnimationNode->rotationKeys, skeletalAnimationNode->rotationKeySize * sizeof(AnimationQuaternionKey));
+
+			writer.Write((int32_t)skeletalAnimationNode->positionKeySize);
+			writer.WriteBytes(skeletalAnimationNode->positionKeys, skeletalAnimationNode->positionKeySize * sizeof(AnimationVectorKey));
+
+			writer.Write((int32_t)skeletalAnimationNode->scalingKeySize);
+			writer.WriteBytes(skeletalAnimationNode->scalingKeys, skeletalAnimationNode->scalingKeySize * sizeof(AnimationVectorKey));
+		}
+	}
+}
+
+static void ReadSkeleton(CookedMeshReader& reader, SkeletalMesh* skeletalMesh)
+{
+	const uint32_t boneCount = reader.Read<uint32_t>();
+	for (uint32_t boneIndex = 0; boneIndex < boneCount && reader.GetIsValid(); ++boneIndex)
+	{
+		const std::string boneName = reader.ReadString();
+		const Matrix offset = reader.Read<Matrix>();
+		const Matrix transformation = reader.Read<Matrix>();
+
+		skeletalMesh->GetBoneId(boneName);
+		skeletalMesh->AddBone(new Bone(boneName, offset, transformation));
+	}
+
+	for (uint32_t boneIndex = 0; boneIndex < boneCount && reader.GetIsValid(); ++boneIndex)
+	{
+		Bone* bone = skeletalMesh->GetBone(boneIndex);
+
+		const uint32_t childCount = reader.Read<uint32_t>();
+		for (uint32_t childIndex = 0; childIndex < childCount && reader.GetIsValid(); ++childIndex)
+		{
+			const uint32_t childBoneId = reader.Read<uint32_t>();
+			if (boneCount <= childBoneId)
+			{
+				reader.Invalidate();
+				return;
+			}
+
+			bone->children.push_back(skeletalMesh->GetBone(childBoneId));
+		}
+	}
+
+	Armature* armature = skeletalMesh->GetArmature();
+	const int32_t rootBoneId = reader.Read<int32_t>();
+	armature->globalInverseTransform = reader.Read<Matrix>();
+	if (0 <= rootBoneId && rootBoneId < (int32_t)boneCount)
+	{
+		armature->root = skeletalMesh->GetBone(rootBoneId);
+	}
+
+	const uint32_t skeletalAnimationCount = reader.Read<uint32_t>();
+	for (uint32_t skeletalAnimationIndex = 0; skeletalAnimationIndex < skeletalAnimationCount && reader.GetIsValid(); ++skeletalAnimationIndex)
+	{
+		SkeletalAnimation* skeletalAnimation = new SkeletalAnimation();
+		skeletalAnimation->name = reader.ReadString();
+		skeletalAnimation->duration = reader.Read<float>();
+		skeletalAnimation->ticksPerSecond = reader.Read<float>();
+		skeletalAnimation->maxKeyframe = reader.Read<unsigned int>();
+
+		// Node count is checked against the remaining size before the node array is allocated
+		const unsigned int animationNodeSize = reader.Read<unsigned int>();
+		if (!reader.CanRead((uint64_t)animationNodeSize * sizeof(uint32_t)))
+		{
+			delete skeletalAnimation;
+			return;
+		}
+
+		skeletalAnimation->animationNodeSize = animationNodeSize;
+		skeletalAnimation->animationNodes = new SkeletalAnimationNode * [animationNodeSize]();
+
+		// The mesh owns the animation from now on, so a failed read below does not leak it
+		skeletalMesh->AddSkeletalAnimation(skeletalAnimation);
+
+		for (unsigned int animationNodeIndex = 0; animationNodeIndex < animationNodeSize && reader.GetIsValid(); ++animationNodeIndex)
+		{
+			SkeletalAnimationNode* skeletalAnimationNode = new SkeletalAnimationNode();
+			skeletalAnimationNode->affectedBoneName = reader.ReadString();
+
+			skeletalAnimationNode->rotationKeySize = reader.Read<int32_t>();
+			skeletalAnimationNode->rotationKeys = reader.ReadArray<AnimationQuaternionKey>(skeletalAnimationNode->rotationKeySize);
+
+			skeletalAnimationNode->positionKeySize = reader.Read<int32_t>();
+			skeletalAnimationNode->positionKeys = reader.ReadArray<AnimationVectorKey>(skeletalAnimationNode->positionKeySize);
+
+			skeletalAnimationNode->scalingKeySize = reader.Read<int32_t>();
+			skeletalAnimationNode->scalingKeys = reader.ReadArray<AnimationVectorKey>(skeletalAnimationNode->scalingKeySize);
+
+			skeletalAnimation->AddSkeletalAnimationNode(animationNodeIndex, skeletalAnimationNode);
+		}
+	}
+}
+
+static bool GetIsArrayInFile(uint64_t fileSize, uint64_t offset, uint64_t count, uint64_t elementSize)
+{
+	return
+		offset % COOKED_MESH_ARRAY_ALIGNMENT == 0 &&
+		offset <= fileSize &&
+		count <= (fileSize - offset) / elementSize;
+}
+
+std::string CookedMeshLoader::GetCookedPath(const std::string& sourcePath)
+{
+	return CookedFileUtils::GetCookedPath(sourcePath, COOKED_MESH_EXTENSION);
+}
+
+StaticMesh* CookedMeshLoader::LoadCookedModel(const std::string& path)
+{
+	MappedFile* mappedFile = new MappedFile();
+	if (!mappedFile->Open(path))
+	{
+		delete mappedFile;
+		return nullptr;
+	}
+
+	const unsigned char* fileData = mappedFile->GetData();
+	const uint64_t fileSize = mappedFile->GetSize();
+
+	CookedMeshFileHeader header;
+	memset(&header, 0, sizeof(CookedMeshFileHeader));
+	if (sizeof(CookedMeshFileHeader) <= fileSize)
+	{
+		memcpy(&header, fileData, sizeof(CookedMeshFileHeader));
+	}
+
+	if (header.magic != COOKED_MESH_FILE_MAGIC ||
+		header.version != COOKED_MESH_FILE_VERSION ||
+		header.vertexDataSize != sizeof(VertexData) ||
+		header.faceSize != sizeof(Face) ||
+		header.vertexBoneDataSize != sizeof(VertexBoneData) ||
+		header.matrixSize != sizeof(Matrix) ||
+		header.vectorKeySize != sizeof(AnimationVectorKey) ||
+		header.quaternionKeySize != sizeof(AnimationQuaternionKey) ||
+		!GetIsArrayInFile(fileSize, header.vertexDataOffset, header.vertexCount, sizeof(VertexData)) ||
+		!GetIsArrayInFile(fileSize, header.faceDataOffset, header.faceCount, sizeof(Face)) ||
+		(header.isSkeletal && !GetIsArrayInFile(fileSize, header.vertexBoneDataOffset, header.vertexCount, sizeof(VertexBoneData))) ||
+		!GetIsArrayInFile(fileSize, header.metadataOffset, header.metadataSize, 1))
+	{
+		GOKNAR_CORE_WARN("Cooked mesh file {} is invalid or out of date, it should be cooked again.", path);
+		delete mappedFile;
+		return nullptr;
+	}
+
+	StaticMesh* staticMesh = nullptr;
+	SkeletalMesh* skeletalMesh = nullptr;
+	if (header.isSkeletal)
+	{
+		skeletalMesh = new SkeletalMesh();
+		staticMesh = skeletalMesh;
+	}
+	else
+	{
+		staticMesh = new StaticMesh();
+	}
+
+	CookedMeshReader reader(fileData + header.metadataOffset, header.metadataSize);
+
+	staticMesh->SetName(reader.ReadString());
+
+	const Vector3 aabbMin = reader.Read<Vector3>();
+	const Vector3 aabbMax = reader.Read<Vector3>();
+	staticMesh->SetAABB(Box(aabbMin, aabbMax));
+
+	CookedMaterial cookedMaterial;
+	const bool hasMaterial = reader.Read<uint32_t>() != 0;
+	if (hasMaterial)
+	{
+		ReadMaterial(reader, cookedMaterial);
+	}
+
+	if (skeletalMesh)
+	{
+		ReadSkeleton(reader, skeletalMesh);
+	}
+
+	if (!reader.GetIsValid())
+	{
+		GOKNAR_CORE_WARN("Cooked mesh file {} could not be read, it should be cooked again.", path);
+		delete staticMesh;
+		delete mappedFile;
+		return nullptr;
+	}
+
+	if (hasMaterial)
+	{
+		staticMesh->SetMaterial(CreateMaterial(cookedMaterial));
+	}
+
+	if (skeletalMesh)
+	{
+		skeletalMesh->SetMappedVertexBoneData((const VertexBoneData*)(fileData + header.vertexBoneDataOffset));
+	}
+
+	staticMesh->SetMappedData(
+		mappedFile,
+		(const VertexData*)(fileData + header.vertexDataOffset), header.vertexCount,
+		(const Face*)(fileData + header.faceDataOffset), header.faceCount);
+
+	return staticMesh;
+}
+
+bool CookedMeshLoader::SaveCookedModel(const StaticMesh* mesh, const std::string& path)
+{
+	const SkeletalMesh* skeletalMesh = dynamic_cast<const SkeletalMesh*>(mesh);
+
+	const unsigned int vertexCount = mesh->GetVertexCount();
+	const unsigned int faceCount = mesh->GetFaceCount();
+
+	GOKNAR_CORE_ASSERT(vertexCount == 0 || mesh->GetVertexData(), "Mesh data is cleared from memory and cannot be cooked");
+
+	CookedMeshFileHeader header;
+	memset(&header, 0, sizeof(CookedMeshFileHeader));
+	header.magic = COOKED_MESH_FILE_MAGIC;
+	header.version = COOKED_MESH_FILE_VERSION;
+	header.vertexDataSize = sizeof(VertexData);
+	header.faceSize = sizeof(Face);
+	header.vertexBoneDataSize = sizeof(VertexBoneData);
+	header.matrixSize = sizeof(Matrix);
+	header.vectorKeySize = sizeof(AnimationVectorKey);
+	header.quaternionKeySize = sizeof(AnimationQuaternionKey);
+	header.isSkeletal = skeletalMesh ? 1 : 0;
+	header.vertexCount = vertexCount;
+	header.faceCount = faceCount;
+
+	CookedMeshWriter writer;
+	writer.Write(header);
+
+	writer.Align(COOKED_MESH_ARRAY_ALIGNMENT);
+	header.vertexDataOffset = writer.GetSize();
+	writer.WriteBytes(mesh->GetVertexData(), vertexCount * sizeof(VertexData));
+
+	writer.Align(COOKED_MESH_ARRAY_ALIGNMENT);
+	header.faceDataOffset = writer.GetSize();
+	writer.WriteBytes(mesh->GetFaceData(), faceCount * sizeof(Face));
+
+	if (skeletalMesh)
+	{
+		writer.Align(COOKED_MESH_ARRAY_ALIGNMENT);
+		header.vertexBoneDataOffset = writer.GetSize();
+		writer.WriteBytes(skeletalMesh->GetVertexBoneData(), vertexCount * sizeof(VertexBoneData));
+	}
+
+	writer.Align(COOKED_MESH_ARRAY_ALIGNMENT);
+	header.metadataOffset = writer.GetSize();
+
+	writer.WriteString(mesh->GetName());
+
+	// AABB is written as its corners since the mesh is not initialized yet
+	const Box& aabb = mesh->GetAABB();
+	writer.Write(aabb.GetMin());
+	writer.Write(aabb.GetMax());
+
+	const Material* material = const_cast<StaticMesh*>(mesh)->GetMaterial();
+	writer.Write((uint32_t)(material ? 1 : 0));
+	if (material)
+	{
+		WriteMaterial(writer, material);
+	}
+
+	if (skeletalMesh)
+	{
+		WriteSkeleton(writer, skeletalMesh);
+	}
+
+	header.metadataSize = writer.GetSize() - header.metadataOffset;
+	memcpy(writer.GetData(), &header, sizeof(CookedMeshFileHeader));
+
+	std::ofstream cookedFile(path, std::ios::binary);
+	if (!cookedFile.is_open())
+	{
+		GOKNAR_CORE_WARN("Cooked mesh file {} could not be written.", path);
+		return false;
+	}
+
+	cookedFile.write((const char*)writer.GetData(), writer.GetSize());
+	return (bool)cookedFile;
+}
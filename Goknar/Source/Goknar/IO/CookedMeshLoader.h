@@ -0,0 +1,29 @@
+#ifndef __COOKEDMESHLOADER_H__
+#define __COOKEDMESHLOADER_H__
+
+#include "Goknar/Core.h"
+
+#include <string>
+
+class StaticMesh;
+
+// Extension of the cooked mesh files, a cooked file sits next to its source file(Foo.fbx -> Foo.fbx.gkmesh)
+#define COOKED_MESH_EXTENSION "gkmesh"
+
+// Versioned binary mesh and animation container
+// Vertex, face, bone and key arrays are stored with the layouts of their in-memory structures,
+// cooked meshes point into the memory mapped file and are uploaded to the GPU without copying the vertices
+class GOKNAR_API CookedMeshLoader
+{
+	friend class IOManager;
+public:
+	CookedMeshLoader() = delete;
+
+	static std::string GetCookedPath(const std::string& sourcePath);
+
+private:
+	static StaticMesh* LoadCookedModel(const std::string& path);
+	static bool SaveCookedModel(const StaticMesh* mesh, const std::string& path);
+};
+
+#endif
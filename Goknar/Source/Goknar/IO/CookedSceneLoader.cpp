@@ -0,0 +1,548 @@
+#include "pch.h"
+
+#include "CookedSceneLoader.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#include "Goknar/Engine.h"
+#include "Goknar/Factories/DynamicObjectFactory.h"
+#include "Goknar/Helpers/SceneParser.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/MappedFile.h"
+#include "Goknar/Log.h"
+#include "Goknar/Managers/ResourceManager.h"
+#include "Goknar/Model/StaticMesh.h"
+#include "Goknar/ObjectBase.h"
+
+#include "Goknar/Components/StaticMeshComponent.h"
+
+#include "Goknar/Physics/RigidBody.h"
+#include "Goknar/Physics/Components/BoxCollisionComponent.h"
+#include "Goknar/Physics/Components/CapsuleCollisionComponent.h"
+#include "Goknar/Physics/Components/SphereCollisionComponent.h"
+#include "Goknar/Physics/Components/MovingTriangleMeshCollisionComponent.h"
+#include "Goknar/Physics/Components/NonMovingTriangleMeshCollisionComponent.h"
+
+#include "TinyXML/include/tinyxml2.h"
+
+// File layout:
+//	CookedSceneFileHeader
+//	Settings XML text, class name offsets, objects(CookedSceneObject), object transformations(SpawnTransformation),
+//	components(CookedSceneComponent) and the string table, each aligned to COOKED_SCENE_ARRAY_ALIGNMENT
+struct CookedSceneFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+
+	// Sizes of the structures the arrays are laid out with, files cooked with other layouts are rejected
+	uint32_t objectSize;
+	uint32_t transformationSize;
+	uint32_t componentSize;
+
+	uint32_t classCount;
+	uint32_t objectCount;
+	uint32_t componentCount;
+
+	uint64_t settingsOffset;
+	uint64_t settingsSize;
+	uint64_t classNameOffsetsOffset;
+	uint64_t objectOffset;
+	uint64_t objectTransformationOffset;
+	uint64_t componentOffset;
+	uint64_t stringOffset;
+	uint64_t stringSize;
+};
+
+// "GSCN"
+constexpr uint32_t COOKED_SCENE_FILE_MAGIC = 0x4E435347;
+constexpr uint32_t COOKED_SCENE_FILE_VERSION = 1;
+
+constexpr uint64_t COOKED_SCENE_ARRAY_ALIGNMENT = 16;
+
+static uint64_t AppendArray(std::vector<unsigned char>& buffer, const void* data, uint64_t size)
+{
+	buffer.resize((buffer.size() + COOKED_SCENE_ARRAY_ALIGNMENT - 1) / COOKED_SCENE_ARRAY_ALIGNMENT * COOKED_SCENE_ARRAY_ALIGNMENT, 0);
+
+	const uint64_t offset = buffer.size();
+	const unsigned char* bytes = (const unsigned char*)data;
+	buffer.insert(buffer.end(), bytes, bytes + size);
+	return offset;
+}
+
+static bool GetIsArrayInFile(uint64_t fileSize, uint64_t offset, uint64_t count, uint64_t elementSize)
+{
+	return
+		offset % COOKED_SCENE_ARRAY_ALIGNMENT == 0 &&
+		offset <= fileSize &&
+		count <= (fileSize - offset) / elementSize;
+}
+
+static bool HasFlag(uint32_t flags, CookedSceneObjectFlag flag)
+{
+	return (flags & (uint32_t)flag) != 0;
+}
+
+static bool HasFlag(uint32_t flags, CookedSceneComponentFlag flag)
+{
+	return (flags & (uint32_t)flag) != 0;
+}
+
+// Offsets and ranges are checked once so that the objects are instantiated without any checks
+static bool GetIsCookedSceneValid(const CookedSceneFileHeader& header, const uint32_t* classNameOffsets, const CookedSceneObject* objects, const CookedSceneComponent* components, const char* strings)
+{
+	if (header.stringSize == 0 || strings[header.stringSize - 1] != '\0')
+	{
+		return header.classCount == 0 && header.objectCount == 0;
+	}
+
+	for (uint32_t classIndex = 0; classIndex < header.classCount; ++classIndex)
+	{
+		if (header.stringSize <= classNameOffsets[classIndex])
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t objectIndex = 0; objectIndex < header.objectCount; ++objectIndex)
+	{
+		const CookedSceneObject& object = objects[objectIndex];
+		if (header.classCount <= object.classIndex ||
+			header.componentCount < object.firstComponentIndex ||
+			header.componentCount - object.firstComponentIndex < object.componentCount ||
+			(HasFlag(object.flags, CookedSceneObjectFlag::Name) && header.stringSize <= object.nameOffset))
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t componentIndex = 0; componentIndex < header.componentCount; ++componentIndex)
+	{
+		const CookedSceneComponent& component = components[componentIndex];
+		if ((uint32_t)CookedSceneComponentType::NonMovingTriangleMeshCollision < component.type ||
+			(HasFlag(component.flags, CookedSceneComponentFlag::Mesh) && header.stringSize <= component.meshPathOffset))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Only the last present value updates the relative transformation matrix
+static void SetComponentValues(Component* component, const CookedSceneComponent& cookedComponent)
+{
+	const bool hasRelativePosition = HasFlag(cookedComponent.flags, CookedSceneComponentFlag::RelativePosition);
+	const bool hasRelativeRotation = HasFlag(cookedComponent.flags, CookedSceneComponentFlag::RelativeRotation);
+	const bool hasRelativeScaling = HasFlag(cookedComponent.flags, CookedSceneComponentFlag::RelativeScaling);
+
+	if (HasFlag(cookedComponent.flags, CookedSceneComponentFlag::PivotPoint))
+	{
+		component->SetPivotPoint(cookedComponent.pivotPoint);
+	}
+
+	if (hasRelativePosition)
+	{
+		component->SetRelativePosition(cookedComponent.relativeTransformation.position, !hasRelativeRotation && !hasRelativeScaling);
+	}
+
+	if (hasRelativeRotation)
+	{
+		component->SetRelativeRotation(cookedComponent.relativeTransformation.rotation, !hasRelativeScaling);
+	}
+
+	if (hasRelativeScaling)
+	{
+		component->SetRelativeScaling(cookedComponent.relativeTransformation.scaling);
+	}
+}
+
+// Meshes are looked up once per distinct path
+class CookedSceneMeshCache
+{
+public:
+	CookedSceneMeshCache(const char* strings, bool areMeshesAcquired) :
+		strings_(strings),
+		areMeshesAcquired_(areMeshesAcquired)
+	{
+	}
+
+	template<class T>
+	T* GetMesh(std::unordered_map<uint32_t, T*>& meshes, uint32_t pathOffset)
+	{
+		const auto meshIterator = meshes.find(pathOffset);
+		if (meshIterator != meshes.end())
+		{
+			return meshIterator->second;
+		}
+
+		ResourceManager* resourceManager = engine->GetResourceManager();
+		T* mesh = areMeshesAcquired_ ? resourceManager->GetAcquiredContent<T>(strings_ + pathOffset) : resourceManager->GetContent<T>(strings_ + pathOffset);
+		meshes[pathOffset] = mesh;
+		return mesh;
+	}
+
+	StaticMesh* GetStaticMesh(uint32_t pathOffset)
+	{
+		return GetMesh(staticMeshes_, pathOffset);
+	}
+
+	MeshUnit* GetMeshUnit(uint32_t pathOffset)
+	{
+		return GetMesh(meshUnits_, pathOffset);
+	}
+
+private:
+	const char* strings_;
+	bool areMeshesAcquired_;
+	std::unordered_map<uint32_t, StaticMesh*> staticMeshes_;
+	std::unordered_map<uint32_t, MeshUnit*> meshUnits_;
+};
+
+static void AddCollisionComponent(RigidBody* rigidBody, const CookedSceneComponent& cookedComponent, CookedSceneMeshCache& meshCache)
+{
+	const bool hasMesh = HasFlag(cookedComponent.flags, CookedSceneComponentFlag::Mesh);
+
+	Component* component = nullptr;
+	switch ((CookedSceneComponentType)cookedComponent.type)
+	{
+	case CookedSceneComponentType::BoxCollision:
+	{
+		BoxCollisionComponent* boxCollisionComponent = rigidBody->AddSubComponent<BoxCollisionComponent>();
+		if (HasFlag(cookedComponent.flags, CookedSceneComponentFlag::HalfSize))
+		{
+			boxCollisionComponent->SetHalfSize(cookedComponent.halfSize);
+		}
+		component = boxCollisionComponent;
+		break;
+	}
+	case CookedSceneComponentType::SphereCollision:
+	{
+		SphereCollisionComponent* sphereCollisionComponent = rigidBody->AddSubComponent<SphereCollisionComponent>();
+		if (HasFlag(cookedComponent.flags, CookedSceneComponentFlag::Radius))
+		{
+			sphereCollisionComponent->SetRadius(cookedComponent.radius);
+		}
+		component = sphereCollisionComponent;
+		break;
+	}
+	case CookedSceneComponentType::CapsuleCollision:
+	{
+		CapsuleCollisionComponent* capsuleCollisionComponent = rigidBody->AddSubComponent<CapsuleCollisionComponent>();
+		if (HasFlag(cookedComponent.flags, CookedSceneComponentFlag::Radius))
+		{
+			capsuleCollisionComponent->SetRadius(cookedComponent.radius);
+		}
+		if (HasFlag(cookedComponent.flags, CookedSceneComponentFlag::Height))
+		{
+			capsuleCollisionComponent->SetHeight(cookedComponent.height);
+		}
+		component = capsuleCollisionComponent;
+		break;
+	}
+	case CookedSceneComponentType::MovingTriangleMeshCollision:
+	{
+		MovingTriangleMeshCollisionComponent* movingTriangleMeshCollisionComponent = rigidBody->AddSubComponent<MovingTriangleMeshCollisionComponent>();
+		MeshUnit* relativeMesh = hasMesh ? meshCache.GetMeshUnit(cookedComponent.meshPathOffset) : nullptr;
+		if (relativeMesh)
+		{
+			movingTriangleMeshCollisionComponent->SetMesh(relativeMesh);
+		}
+		component = movingTriangleMeshCollisionComponent;
+		break;
+	}
+	case CookedSceneComponentType::NonMovingTriangleMeshCollision:
+	{
+		NonMovingTriangleMeshCollisionComponent* nonMovingTriangleMeshCollisionComponent = rigidBody->AddSubComponent<NonMovingTriangleMeshCollisionComponent>();
+		MeshUnit* relativeMesh = hasMesh ? meshCache.GetMeshUnit(cookedComponent.meshPathOffset) : nullptr;
+		if (relativeMesh)
+		{
+			nonMovingTriangleMeshCollisionComponent->SetMesh(relativeMesh);
+		}
+		component = nonMovingTriangleMeshCollisionComponent;
+		break;
+	}
+	default:
+		return;
+	}
+
+	SetComponentValues(component, cookedComponent);
+}
+
+std::string CookedSceneLoader::GetCookedPath(const std::string& sourcePath)
+{
+	return CookedFileUtils::GetCookedPath(sourcePath, COOKED_SCENE_EXTENSION);
+}
+
+bool CookedSceneLoader::ReadCookedScene(const std::string& path, CookedSceneData& sceneData)
+{
+	MappedFile mappedFile;
+	if (!mappedFile.Open(path))
+	{
+		return false;
+	}
+
+	const unsigned char* fileData = mappedFile.GetData();
+	const uint64_t fileSize = mappedFile.GetSize();
+
+	CookedSceneFileHeader header;
+	memset(&header, 0, sizeof(CookedSceneFileHeader));
+	if (sizeof(CookedSceneFileHeader) <= fileSize)
+	{
+		memcpy(&header, fileData, sizeof(CookedSceneFileHeader));
+	}
+
+	if (header.magic != COOKED_SCENE_FILE_MAGIC ||
+		header.version != COOKED_SCENE_FILE_VERSION ||
+		header.objectSize != sizeof(CookedSceneObject) ||
+		header.transformationSize != sizeof(SpawnTransformation) ||
+		header.componentSize != sizeof(CookedSceneComponent) ||
+		!GetIsArrayInFile(fileSize, header.settingsOffset, header.settingsSize, 1) ||
+		!GetIsArrayInFile(fileSize, header.classNameOffsetsOffset, header.classCount, sizeof(uint32_t)) ||
+		!GetIsArrayInFile(fileSize, header.objectOffset, header.objectCount, sizeof(CookedSceneObject)) ||
+		!GetIsArrayInFile(fileSize, header.objectTransformationOffset, header.objectCount, sizeof(SpawnTransformation)) ||
+		!GetIsArrayInFile(fileSize, header.componentOffset, header.componentCount, sizeof(CookedSceneComponent)) ||
+		!GetIsArrayInFile(fileSize, header.stringOffset, header.stringSize, 1))
+	{
+		GOKNAR_CORE_WARN("Cooked scene file {} is invalid or out of date, it should be cooked again.", path);
+		return false;
+	}
+
+	const uint32_t* classNameOffsets = (const uint32_t*)(fileData + header.classNameOffsetsOffset);
+	const CookedSceneObject* objects = (const CookedSceneObject*)(fileData + header.objectOffset);
+	const SpawnTransformation* objectTransformations = (const SpawnTransformation*)(fileData + header.objectTransformationOffset);
+	const CookedSceneComponent* components = (const CookedSceneComponent*)(fileData + header.componentOffset);
+	const char* strings = (const char*)(fileData + header.stringOffset);
+
+	if (!GetIsCookedSceneValid(header, classNameOffsets, objects, components, strings))
+	{
+		GOKNAR_CORE_WARN("Cooked scene file {} could not be read, it should be cooked again.", path);
+		return false;
+	}
+
+	sceneData.settingsXML.assign((const char*)(fileData + header.settingsOffset), header.settingsSize);
+	sceneData.classNameOffsets.assign(classNameOffsets, classNameOffsets + header.classCount);
+	sceneData.objects.assign(objects, objects + header.objectCount);
+	sceneData.objectTransformations.assign(objectTransformations, objectTransformations + header.objectCount);
+	sceneData.components.assign(components, components + header.componentCount);
+	sceneData.strings.assign(strings, header.stringSize);
+
+	return true;
+}
+
+bool CookedSceneLoader::LoadCookedScene(Scene* scene, const std::string& path)
+{
+	CookedSceneData sceneData;
+	if (!ReadCookedScene(path, sceneData))
+	{
+		return false;
+	}
+
+	tinyxml2::XMLDocument settingsDocument;
+	if (settingsDocument.Parse(sceneData.settingsXML.data(), sceneData.settingsXML.size()))
+	{
+		GOKNAR_CORE_WARN("Settings of the cooked scene file {} could not be parsed, it should be cooked again.", path);
+		return false;
+	}
+
+	SceneParser::ParseDocument(scene, settingsDocument);
+
+	CookedSceneInstancer instancer(std::move(sceneData), path);
+	instancer.InstantiateObjects(MAX_FLOAT);
+
+	return true;
+}
+
+bool CookedSceneLoader::SaveCookedScene(const CookedSceneData& sceneData, const std::string& path)
+{
+	CookedSceneFileHeader header;
+	memset(&header, 0, sizeof(CookedSceneFileHeader));
+	header.magic = COOKED_SCENE_FILE_MAGIC;
+	header.version = COOKED_SCENE_FILE_VERSION;
+	header.objectSize = sizeof(CookedSceneObject);
+	header.transformationSize = sizeof(SpawnTransformation);
+	header.componentSize = sizeof(CookedSceneComponent);
+	header.classCount = (uint32_t)sceneData.classNameOffsets.size();
+	header.objectCount = (uint32_t)sceneData.objects.size();
+	header.componentCount = (uint32_t)sceneData.components.size();
+
+	std::vector<unsigned char> buffer;
+	AppendArray(buffer, &header, sizeof(CookedSceneFileHeader));
+
+	header.settingsSize = sceneData.settingsXML.size();
+	header.settingsOffset = AppendArray(buffer, sceneData.settingsXML.data(), header.settingsSize);
+	header.classNameOffsetsOffset = AppendArray(buffer, sceneData.classNameOffsets.data(), sceneData.classNameOffsets.size() * sizeof(uint32_t));
+	header.objectOffset = AppendArray(buffer, sceneData.objects.data(), sceneData.objects.size() * sizeof(CookedSceneObject));
+	header.objectTransformationOffset = AppendArray(buffer, sceneData.objectTransformations.data(), sceneData.objectTransformations.size() * sizeof(SpawnTransformation));
+	header.componentOffset = AppendArray(buffer, sceneData.components.data(), sceneData.components.size() * sizeof(CookedSceneComponent));
+	header.stringSize = sceneData.strings.size();
+	header.stringOffset = AppendArray(buffer, sceneData.strings.data(), header.stringSize);
+
+	memcpy(buffer.data(), &header, sizeof(CookedSceneFileHeader));
+
+	std::ofstream cookedFile(path, std::ios::binary);
+	if (!cookedFile.is_open())
+	{
+		GOKNAR_CORE_WARN("Cooked scene file {} could not be written.", path);
+		return false;
+	}
+
+	cookedFile.write((const char*)buffer.data(), buffer.size());
+	return (bool)cookedFile;
+}
+
+CookedSceneInstancer::CookedSceneInstancer(CookedSceneData&& sceneData, const std::string& path, bool areMeshesAcquired) :
+	sceneData_(std::move(sceneData))
+{
+	const uint32_t classCount = (uint32_t)sceneData_.classNameOffsets.size();
+	const char* strings = sceneData_.strings.c_str();
+
+	// Classes are resolved once instead of once per object
+	const std::unordered_map<std::string, DynamicObjectFactory::CreateFunction>& factoryObjects = DynamicObjectFactory::GetInstance()->GetObjectMap();
+	createFunctions_.resize(classCount, nullptr);
+	classNames_.resize(classCount);
+	for (uint32_t classIndex = 0; classIndex < classCount; ++classIndex)
+	{
+		classNames_[classIndex] = strings + sceneData_.classNameOffsets[classIndex];
+
+		const auto factoryObject = factoryObjects.find(classNames_[classIndex]);
+		if (factoryObject != factoryObjects.end())
+		{
+			createFunctions_[classIndex] = &factoryObject->second;
+		}
+		else
+		{
+			GOKNAR_CORE_WARN("Class {} of the cooked scene file {} is not registered, its objects are skipped.", classNames_[classIndex], path);
+		}
+	}
+
+	meshCache_ = new CookedSceneMeshCache(strings, areMeshesAcquired);
+}
+
+CookedSceneInstancer::~CookedSceneInstancer()
+{
+	delete meshCache_;
+}
+
+bool CookedSceneInstancer::InstantiateObjects(float timeBudget)
+{
+	const uint32_t objectCount = (uint32_t)sceneData_.objects.size();
+
+	if (nextObjectIndex_ == 0)
+	{
+		engine->ReserveObjectCapacity(objectCount, 0, (int)sceneData_.components.size(), 0);
+		objects_.reserve(objectCount);
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+	while (nextObjectIndex_ < objectCount)
+	{
+		ObjectBase* object = InstantiateObject(nextObjectIndex_);
+		if (object)
+		{
+			objects_.push_back(object);
+		}
+
+		++nextObjectIndex_;
+
+		// Do not query the clock for every single object
+		if ((nextObjectIndex_ & 15) == 0)
+		{
+			const float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+			if (timeBudget < elapsedTime)
+			{
+				break;
+			}
+		}
+	}
+
+	return GetIsFinished();
+}
+
+ObjectBase* CookedSceneInstancer::InstantiateObject(uint32_t objectIndex)
+{
+	const CookedSceneObject& cookedObject = sceneData_.objects[objectIndex];
+	const DynamicObjectFactory::CreateFunction* createFunction = createFunctions_[cookedObject.classIndex];
+	if (!createFunction)
+	{
+		return nullptr;
+	}
+
+	ObjectBase* object = (*createFunction)();
+	object->SetName(classNames_[cookedObject.classIndex]);
+
+	const CookedSceneComponent* objectComponents = sceneData_.components.data() + cookedObject.firstComponentIndex;
+
+	// Same order as the XML parser: rigid body values and collision components first, then the object values and static mesh components
+	if (RigidBody* rigidBody = dynamic_cast<RigidBody*>(object))
+	{
+		if (HasFlag(cookedObject.flags, CookedSceneObjectFlag::Mass))
+		{
+			rigidBody->SetMass(cookedObject.mass);
+		}
+
+		if (HasFlag(cookedObject.flags, CookedSceneObjectFlag::CollisionGroup))
+		{
+			rigidBody->SetCollisionGroup((CollisionGroup)cookedObject.collisionGroup);
+		}
+
+		if (HasFlag(cookedObject.flags, CookedSceneObjectFlag::CollisionMask))
+		{
+			rigidBody->SetCollisionMask((CollisionMask)cookedObject.collisionMask);
+		}
+
+		for (uint32_t componentIndex = 0; componentIndex < cookedObject.componentCount; ++componentIndex)
+		{
+			AddCollisionComponent(rigidBody, objectComponents[componentIndex], *meshCache_);
+		}
+	}
+
+	if (HasFlag(cookedObject.flags, CookedSceneObjectFlag::Name))
+	{
+		object->SetName(sceneData_.strings.c_str() + cookedObject.nameOffset);
+	}
+
+	// World transformation matrix is calculated only once
+	const SpawnTransformation& transformation = sceneData_.objectTransformations[objectIndex];
+	const bool hasWorldPosition = HasFlag(cookedObject.flags, CookedSceneObjectFlag::WorldPosition);
+	const bool hasWorldRotation = HasFlag(cookedObject.flags, CookedSceneObjectFlag::WorldRotation);
+	const bool hasWorldScaling = HasFlag(cookedObject.flags, CookedSceneObjectFlag::WorldScaling);
+
+	if (hasWorldPosition)
+	{
+		object->SetWorldPosition(transformation.position, !hasWorldRotation && !hasWorldScaling);
+	}
+
+	if (hasWorldRotation)
+	{
+		object->SetWorldRotation(transformation.rotation, !hasWorldScaling);
+	}
+
+	if (hasWorldScaling)
+	{
+		object->SetWorldScaling(transformation.scaling);
+	}
+
+	for (uint32_t componentIndex = 0; componentIndex < cookedObject.componentCount; ++componentIndex)
+	{
+		const CookedSceneComponent& cookedComponent = objectComponents[componentIndex];
+		if ((CookedSceneComponentType)cookedComponent.type != CookedSceneComponentType::StaticMesh)
+		{
+			continue;
+		}
+
+		StaticMeshComponent* staticMeshComponent = object->AddSubComponent<StaticMeshComponent>();
+
+		StaticMesh* staticMesh = HasFlag(cookedComponent.flags, CookedSceneComponentFlag::Mesh) ? meshCache_->GetStaticMesh(cookedComponent.meshPathOffset) : nullptr;
+		if (staticMesh)
+		{
+			staticMeshComponent->SetMesh(staticMesh);
+		}
+
+		SetComponentValues(staticMeshComponent, cookedComponent);
+	}
+
+	return object;
+}
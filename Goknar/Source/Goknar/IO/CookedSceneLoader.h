@@ -0,0 +1,156 @@
+#ifndef __COOKEDSCENELOADER_H__
+#define __COOKEDSCENELOADER_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Factories/SpawnBatch.h"
+#include "Goknar/Math/GoknarMath.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CookedSceneMeshCache;
+class ObjectBase;
+class Scene;
+
+// Extension of the cooked scene files, a cooked file sits next to its source file(Foo.xml -> Foo.xml.gkscene)
+#define COOKED_SCENE_EXTENSION "gkscene"
+
+// Values of a cooked object that were present in the scene file, the others keep the defaults of the object's class
+enum class CookedSceneObjectFlag : uint32_t
+{
+	Name = 1 << 0,
+	WorldPosition = 1 << 1,
+	WorldRotation = 1 << 2,
+	WorldScaling = 1 << 3,
+	Mass = 1 << 4,
+	CollisionGroup = 1 << 5,
+	CollisionMask = 1 << 6
+};
+
+enum class CookedSceneComponentFlag : uint32_t
+{
+	PivotPoint = 1 << 0,
+	RelativePosition = 1 << 1,
+	RelativeRotation = 1 << 2,
+	RelativeScaling = 1 << 3,
+	Mesh = 1 << 4,
+	HalfSize = 1 << 5,
+	Radius = 1 << 6,
+	Height = 1 << 7
+};
+
+enum class CookedSceneComponentType : uint32_t
+{
+	StaticMesh = 0,
+	BoxCollision,
+	SphereCollision,
+	CapsuleCollision,
+	MovingTriangleMeshCollision,
+	NonMovingTriangleMeshCollision
+};
+
+struct CookedSceneObject
+{
+	// Index into the class names of the scene, resolved to a factory function once per class on load
+	uint32_t classIndex;
+	uint32_t flags;
+	// Offset of the name in the string table
+	uint32_t nameOffset;
+	uint32_t firstComponentIndex;
+	uint32_t componentCount;
+	float mass;
+	uint32_t collisionGroup;
+	uint32_t collisionMask;
+};
+
+struct CookedSceneComponent
+{
+	uint32_t type;
+	uint32_t flags;
+	// Offset of the mesh path in the string table
+	uint32_t meshPathOffset;
+	float radius;
+	float height;
+	Vector3 halfSize;
+	Vector3 pivotPoint;
+	SpawnTransformation relativeTransformation;
+};
+
+// Contents of a cooked scene
+// Lights, cameras, textures, materials and assets are kept as XML since they are few, objects and their components are
+// stored as flat arrays with their Euler rotations converted to quaternions
+// Collision components of an object are stored before its static mesh components, in the order the XML parser adds them
+struct CookedSceneData
+{
+	std::string settingsXML;
+	std::vector<uint32_t> classNameOffsets;
+	std::vector<CookedSceneObject> objects;
+	std::vector<SpawnTransformation> objectTransformations;
+	std::vector<CookedSceneComponent> components;
+	// Null terminated strings, every distinct string is stored once
+	std::string strings;
+};
+
+// Versioned binary scene container, written from scene XML files by SceneParser::CookScene
+class GOKNAR_API CookedSceneLoader
+{
+	friend class SceneParser;
+public:
+	CookedSceneLoader() = delete;
+
+	static std::string GetCookedPath(const std::string& sourcePath);
+
+	// Reads and validates the cooked file, safe to call on the job manager's worker threads
+	static bool ReadCookedScene(const std::string& path, CookedSceneData& sceneData);
+
+private:
+	// Parses the settings XML and instantiates the objects of the cooked file in bulk
+	static bool LoadCookedScene(Scene* scene, const std::string& path);
+	static bool SaveCookedScene(const CookedSceneData& sceneData, const std::string& path);
+};
+
+// Instantiates the objects of a cooked scene on the main thread, in one call or spread over several frames
+// Classes are resolved once in the constructor, the settings XML of the scene is not parsed
+class GOKNAR_API CookedSceneInstancer
+{
+public:
+	// Meshes already acquired from the resource manager are looked up without being pinned by GetContent
+	CookedSceneInstancer(CookedSceneData&& sceneData, const std::string& path, bool areMeshesAcquired = false);
+	~CookedSceneInstancer();
+
+	// Instantiates objects until timeBudget(in seconds) is exceeded
+	// At least one object is instantiated per call, returns true if every object is instantiated
+	bool InstantiateObjects(float timeBudget);
+
+	bool GetIsFinished() const
+	{
+		return sceneData_.objects.size() <= nextObjectIndex_;
+	}
+
+	// Objects of unregistered classes are skipped
+	const std::vector<ObjectBase*>& GetObjects() const
+	{
+		return objects_;
+	}
+
+	const CookedSceneData& GetSceneData() const
+	{
+		return sceneData_;
+	}
+
+private:
+	ObjectBase* InstantiateObject(uint32_t objectIndex);
+
+	CookedSceneData sceneData_;
+
+	std::vector<const DynamicObjectFactory::CreateFunction*> createFunctions_;
+	std::vector<std::string> classNames_;
+	std::vector<ObjectBase*> objects_;
+
+	CookedSceneMeshCache* meshCache_{ nullptr };
+
+	uint32_t nextObjectIndex_{ 0 };
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "pch.h"
+
+#include "CookedTextureLoader.h"
+
+#include <cstring>
+
+#include "Goknar/Contents/Image.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/MappedFile.h"
+#include "Goknar/Log.h"
+#include "Goknar/Renderer/TextureCompression.h"
+
+// File layout:
+//	CookedTextureFileHeader
+//	CookedTextureMipLevel array of mipLevelCount
+//	Compressed blocks of every mip level, finest level first, each aligned to COOKED_TEXTURE_MIP_LEVEL_ALIGNMENT
+struct CookedTextureFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+
+	uint32_t compressionFormat;
+	uint32_t width;
+	uint32_t height;
+	uint32_t mipLevelCount;
+};
+
+struct CookedTextureMipLevel
+{
+	uint64_t offset;
+	uint64_t size;
+};
+
+// "GTEX"
+constexpr uint32_t COOKED_TEXTURE_FILE_MAGIC = 0x58455447;
+constexpr uint32_t COOKED_TEXTURE_FILE_VERSION = 1;
+
+constexpr uint64_t COOKED_TEXTURE_MIP_LEVEL_ALIGNMENT = 16;
+
+// A 32768x32768 texture has 16 mip levels
+constexpr uint32_t COOKED_TEXTURE_MAX_MIP_LEVEL_COUNT = 16;
+
+std::string CookedTextureLoader::GetCookedPath(const std::string& sourcePath)
+{
+	return CookedFileUtils::GetCookedPath(sourcePath, COOKED_TEXTURE_EXTENSION);
+}
+
+Image* CookedTextureLoader::LoadCookedTexture(const std::string& path)
+{
+	MappedFile mappedFile;
+	if (!mappedFile.Open(path))
+	{
+		return nullptr;
+	}
+
+	const unsigned char* fileData = mappedFile.GetData();
+	const uint64_t fileSize = mappedFile.GetSize();
+
+	CookedTextureFileHeader header;
+	memset(&header, 0, sizeof(CookedTextureFileHeader));
+	if (sizeof(CookedTextureFileHeader) <= fileSize)
+	{
+		memcpy(&header, fileData, sizeof(CookedTextureFileHeader));
+	}
+
+	const TextureCompressionFormat compressionFormat = (TextureCompressionFormat)header.compressionFormat;
+
+	bool isValid =
+		header.magic == COOKED_TEXTURE_FILE_MAGIC &&
+		header.version == COOKED_TEXTURE_FILE_VERSION &&
+		0 < TextureCompression::GetBlockByteSize(compressionFormat) &&
+		0 < header.width && 0 < header.height &&
+		0 < header.mipLevelCount && header.mipLevelCount <= COOKED_TEXTURE_MAX_MIP_LEVEL_COUNT &&
+		sizeof(CookedTextureFileHeader) + header.mipLevelCount * sizeof(CookedTextureMipLevel) <= fileSize;
+
+	std::vector<CookedTextureMipLevel> mipLevels(isValid ? header.mipLevelCount : 0);
+	if (isValid)
+	{
+		memcpy(mipLevels.data(), fileData + sizeof(CookedTextureFileHeader), header.mipLevelCount * sizeof(CookedTextureMipLevel));
+	}
+
+	for (uint32_t mipLevel = 0; isValid && mipLevel < header.mipLevelCount; ++mipLevel)
+	{
+		const int mipLevelWidth = 0 < (int)(header.width >> mipLevel) ? (int)(header.width >> mipLevel) : 1;
+		const int mipLevelHeight = 0 < (int)(header.height >> mipLevel) ? (int)(header.height >> mipLevel) : 1;
+
+		const CookedTextureMipLevel& cookedMipLevel = mipLevels[mipLevel];
+		isValid =
+			cookedMipLevel.size == TextureCompression::GetCompressedByteSize(compressionFormat, mipLevelWidth, mipLevelHeight) &&
+			cookedMipLevel.offset <= fileSize &&
+			cookedMipLevel.size <= fileSize - cookedMipLevel.offset;
+	}
+
+	if (!isValid)
+	{
+		GOKNAR_CORE_WARN("Cooked texture file {} is invalid or out of date, it should be cooked again.", path);
+		return nullptr;
+	}
+
+	// Levels are copied since textures release each level once it is uploaded
+	std::vector<unsigned char*> mipLevelBuffers(header.mipLevelCount);
+	for (uint32_t mipLevel = 0; mipLevel < header.mipLevelCount; ++mipLevel)
+	{
+		const CookedTextureMipLevel& cookedMipLevel = mipLevels[mipLevel];
+		mipLevelBuffers[mipLevel] = new unsigned char[cookedMipLevel.size];
+		memcpy(mipLevelBuffers[mipLevel], fileData + cookedMipLevel.offset, cookedMipLevel.size);
+	}
+
+	Image* image = new Image(path, header.width, header.height, TextureCompression::GetChannelCount(compressionFormat), mipLevelBuffers[0]);
+	image->compressionFormat_ = compressionFormat;
+	image->mipmapBuffers_.assign(mipLevelBuffers.begin() + 1, mipLevelBuffers.end());
+
+	return image;
+}
+
+bool CookedTextureLoader::SaveCookedTexture(Image* image, TextureCompressionFormat compressionFormat, const std::string& path)
+{
+	if (image->GetCompressionFormat() != TextureCompressionFormat::None || TextureCompression::GetBlockByteSize(compressionFormat) == 0)
+	{
+		GOKNAR_CORE_WARN("Cooked texture file {} could not be written, the image is already compressed or the format is invalid.", path);
+		return false;
+	}
+
+	image->GenerateMipmaps();
+
+	std::vector<const unsigned char*> mipLevelBuffers;
+	mipLevelBuffers.push_back(image->GetBuffer());
+	mipLevelBuffers.insert(mipLevelBuffers.end(), image->GetMipmapBuffers().begin(), image->GetMipmapBuffers().end());
+
+	CookedTextureFileHeader header;
+	memset(&header, 0, sizeof(CookedTextureFileHeader));
+	header.magic = COOKED_TEXTURE_FILE_MAGIC;
+	header.version = COOKED_TEXTURE_FILE_VERSION;
+	header.compressionFormat = (uint32_t)compressionFormat;
+	header.width = image->GetWidth();
+	header.height = image->GetHeight();
+	header.mipLevelCount = (uint32_t)mipLevelBuffers.size();
+
+	std::vector<CookedTextureMipLevel> mipLevels(header.mipLevelCount);
+
+	uint64_t fileSize = sizeof(CookedTextureFileHeader) + header.mipLevelCount * sizeof(CookedTextureMipLevel);
+	for (uint32_t mipLevel = 0; mipLevel < header.mipLevelCount; ++mipLevel)
+	{
+		const int mipLevelWidth = 0 < (int)(header.width >> mipLevel) ? (int)(header.width >> mipLevel) : 1;
+		const int mipLevelHeight = 0 < (int)(header.height >> mipLevel) ? (int)(header.height >> mipLevel) : 1;
+
+		fileSize = (fileSize + COOKED_TEXTURE_MIP_LEVEL_ALIGNMENT - 1) / COOKED_TEXTURE_MIP_LEVEL_ALIGNMENT * COOKED_TEXTURE_MIP_LEVEL_ALIGNMENT;
+		mipLevels[mipLevel].offset = fileSize;
+		mipLevels[mipLevel].size = TextureCompression::GetCompressedByteSize(compressionFormat, mipLevelWidth, mipLevelHeight);
+		fileSize += mipLevels[mipLevel].size;
+	}
+
+	std::vector<unsigned char> fileData(fileSize, 0);
+	memcpy(fileData.data(), &header, sizeof(CookedTextureFileHeader));
+	memcpy(fileData.data() + sizeof(CookedTextureFileHeader), mipLevels.data(), header.mipLevelCount * sizeof(CookedTextureMipLevel));
+
+	for (uint32_t mipLevel = 0; mipLevel < header.mipLevelCount; ++mipLevel)
+	{
+		const int mipLevelWidth = 0 < (int)(header.width >> mipLevel) ? (int)(header.width >> mipLevel) : 1;
+		const int mipLevelHeight = 0 < (int)(header.height >> mipLevel) ? (int)(header.height >> mipLevel) : 1;
+
+		TextureCompression::Compress(compressionFormat, mipLevelBuffers[mipLevel], mipLevelWidth, mipLevelHeight, image->GetChannels(), fileData.data() + mipLevels[mipLevel].offset);
+	}
+
+	std::ofstream cookedFile(path, std::ios::binary);
+	if (!cookedFile.is_open())
+	{
+		GOKNAR_CORE_WARN("Cooked texture file {} could not be written.", path);
+		return false;
+	}
+
+	cookedFile.write((const char*)fileData.data(), fileData.size());
+	return (bool)cookedFile;
+}
@@ -0,0 +1,32 @@
+#ifndef __COOKEDTEXTURELOADER_H__
+#define __COOKEDTEXTURELOADER_H__
+
+#include "Goknar/Core.h"
+
+#include <string>
+
+class Image;
+
+enum class TextureCompressionFormat : unsigned char;
+
+// Extension of the cooked texture files, a cooked file sits next to its source file(Foo.png -> Foo.png.gktex)
+#define COOKED_TEXTURE_EXTENSION "gktex"
+
+// Versioned block compressed texture container with the whole mip chain
+// Mip levels are compressed offline so loading is a copy of each level and no mipmaps are generated at runtime
+class GOKNAR_API CookedTextureLoader
+{
+	friend class IOManager;
+public:
+	CookedTextureLoader() = delete;
+
+	static std::string GetCookedPath(const std::string& sourcePath);
+
+private:
+	static Image* LoadCookedTexture(const std::string& path);
+
+	// Generates the mip chain of the image and compresses every level of it
+	static bool SaveCookedTexture(Image* image, TextureCompressionFormat compressionFormat, const std::string& path);
+};
+
+#endif
@@ -5,8 +5,14 @@
 #include <iostream>
 
 #include "Log.h"
+#include "CookedFileUtils.h"
+#include "CookedMeshLoader.h"
+#include "CookedTextureLoader.h"
 #include "ModelLoader.h"
 #include "Contents/Image.h"
+#include "Renderer/Texture.h"
+#include "Managers/ResourceManager.h"
+#include "Model/StaticMesh.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -65,6 +71,24 @@ bool IOManager::WriteFile(const char* filePath, const char* rawTextBuffer)
 
 Image* IOManager::LoadImage(const std::string& filePath)
 {
+    std::string extension = ResourceManagerUtils::GetExtension(filePath);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (extension == COOKED_TEXTURE_EXTENSION)
+    {
+        return CookedTextureLoader::LoadCookedTexture(filePath);
+    }
+
+    const std::string cookedPath = CookedTextureLoader::GetCookedPath(filePath);
+    if (CookedFileUtils::GetIsCookedFileUpToDate(filePath, cookedPath))
+    {
+        Image* cookedImage = CookedTextureLoader::LoadCookedTexture(cookedPath);
+        if (cookedImage)
+        {
+            return cookedImage;
+        }
+    }
+
     int width;
     int height;
     int channels;
@@ -145,5 +169,78 @@ StaticMesh* IOManager::LoadPlyFile(const std::string& path)
 
 StaticMesh* IOManager::LoadModel(const std::string& path)
 {
+    std::string extension = ResourceManagerUtils::GetExtension(path);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    if (extension == COOKED_MESH_EXTENSION)
+    {
+        return CookedMeshLoader::LoadCookedModel(path);
+    }
+
+    const std::string cookedPath = CookedMeshLoader::GetCookedPath(path);
+    if (CookedFileUtils::GetIsCookedFileUpToDate(path, cookedPath))
+    {
+        StaticMesh* cookedMesh = CookedMeshLoader::LoadCookedModel(cookedPath);
+        if (cookedMesh)
+        {
+            return cookedMesh;
+        }
+    }
+
     return ModelLoader::LoadModel(path);
 }
+
+bool IOManager::CookModel(const std::string& sourcePath, const std::string& cookedPath)
+{
+    StaticMesh* mesh = ModelLoader::LoadModel(sourcePath);
+    if (!mesh)
+    {
+        return false;
+    }
+
+    const bool isCooked = CookedMeshLoader::SaveCookedModel(mesh, cookedPath);
+
+    // Material stays registered in the resource manager
+    delete mesh;
+
+    return isCooked;
+}
+
+bool IOManager::CookTexture(const std::string& sourcePath, const std::string& cookedPath, TextureCompressionFormat compressionFormat)
+{
+    int width;
+    int height;
+    int channels;
+    unsigned char* buffer = stbi_load(sourcePath.c_str(), &width, &height, &channels, 0);
+
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+
+    if (compressionFormat == TextureCompressionFormat::None)
+    {
+        compressionFormat = TextureCompressionFormat::BC1;
+        if (channels == 4)
+        {
+            const int pixelCount = width * height;
+            for (int pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+            {
+                if (buffer[pixelIndex * 4 + 3] != 255)
+                {
+                    compressionFormat = TextureCompressionFormat::BC3;
+                    break;
+                }
+            }
+        }
+    }
+
+    Image* image = new Image(sourcePath, width, height, channels, buffer);
+    const bool isCooked = CookedTextureLoader::SaveCookedTexture(image, compressionFormat, cookedPath);
+
+    // Base level is owned by the generated texture otherwise
+    delete image;
+    stbi_image_free(buffer);
+
+    return isCooked;
+}
@@ -6,6 +6,8 @@
 class Image;
 class StaticMesh;
 
+enum class TextureCompressionFormat : unsigned char;
+
 class GOKNAR_API IOManager
 {
 public:
@@ -15,14 +17,24 @@ public:
 	static bool ReadFile(const char* filePath, std::string& rawTextBuffer);
 	static bool WriteFile(const char* filePath, const char* rawTextBuffer);
 
+	// Cooked textures are preferred over their source files while they are up to date
 	static Image* LoadImage(const std::string& filePath);
 	static bool ReadImage(const char* filePath, int& width, int& height, int& channels, const unsigned char** rawDataBuffer);
 	static bool WritePng(const char* filePath, int width, int height, int channels, const unsigned char* rawDataBuffer);
 	static bool WritePpm(const char* filePath, int width, int height, const unsigned char* rawDataBuffer);
 
 	static StaticMesh* LoadPlyFile(const std::string& path);
+
+	// Cooked files are preferred over their source files while they are up to date, Assimp is the fallback
 	static StaticMesh* LoadModel(const std::string& path);
 
+	// Imports the source file with Assimp and writes it as a cooked file
+	static bool CookModel(const std::string& sourcePath, const std::string& cookedPath);
+
+	// Block compresses the source image and its mip chain and writes them as a cooked file
+	// TextureCompressionFormat::None picks BC1 for opaque images and BC3 for the images with transparent pixels
+	static bool CookTexture(const std::string& sourcePath, const std::string& cookedPath, TextureCompressionFormat compressionFormat);
+
 protected:
 
 private:
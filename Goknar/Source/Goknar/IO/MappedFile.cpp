@@ -0,0 +1,116 @@
+#include "pch.h"
+
+#include "MappedFile.h"
+
+#if defined(GOKNAR_PLATFORM_UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Log.h"
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#if defined(GOKNAR_PLATFORM_WINDOWS)
+	HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE fileMappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!fileMappingHandle)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	void* data = MapViewOfFile(fileMappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		CloseHandle(fileMappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	fileHandle_ = fileHandle;
+	fileMappingHandle_ = fileMappingHandle;
+	data_ = (const unsigned char*)data;
+	size_ = (unsigned long long)fileSize.QuadPart;
+#elif defined(GOKNAR_PLATFORM_UNIX)
+	const int fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+
+	void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	close(fileDescriptor);
+
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	madvise(data, (size_t)fileStat.st_size, MADV_WILLNEED);
+
+	data_ = (const unsigned char*)data;
+	size_ = (unsigned long long)fileStat.st_size;
+#else
+	GOKNAR_CORE_WARN("Memory mapped files are not supported on this platform, {} is not mapped", path);
+	return false;
+#endif
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (!data_)
+	{
+		return;
+	}
+
+#if defined(GOKNAR_PLATFORM_WINDOWS)
+	UnmapViewOfFile(data_);
+	CloseHandle((HANDLE)fileMappingHandle_);
+	CloseHandle((HANDLE)fileHandle_);
+
+	fileMappingHandle_ = nullptr;
+	fileHandle_ = nullptr;
+#elif defined(GOKNAR_PLATFORM_UNIX)
+	munmap((void*)data_, (size_t)size_);
+#endif
+
+	data_ = nullptr;
+	size_ = 0;
+}
@@ -0,0 +1,43 @@
+#ifndef __MAPPEDFILE_H__
+#define __MAPPEDFILE_H__
+
+#include "Goknar/Core.h"
+
+#include <string>
+
+// Read only memory mapping of a whole file
+class GOKNAR_API MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool Open(const std::string& path);
+	void Close();
+
+	bool GetIsOpen() const
+	{
+		return data_ != nullptr;
+	}
+
+	const unsigned char* GetData() const
+	{
+		return data_;
+	}
+
+	unsigned long long GetSize() const
+	{
+		return size_;
+	}
+
+private:
+	const unsigned char* data_{ nullptr };
+	unsigned long long size_{ 0 };
+
+#if defined(GOKNAR_PLATFORM_WINDOWS)
+	void* fileHandle_{ nullptr };
+	void* fileMappingHandle_{ nullptr };
+#endif
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "pch.h"
+
+#include "JobManager.h"
+
+JobManager::JobManager() :
+	mainThreadId_(std::this_thread::get_id())
+{
+	const int hardwareThreadCount = (int)std::thread::hardware_concurrency();
+	StartWorkerThreads(1 < hardwareThreadCount ? hardwareThreadCount - 1 : 0);
+}
+
+JobManager::~JobManager()
+{
+	StopWorkerThreads();
+}
+
+void JobManager::SetWorkerThreadCount(int workerThreadCount)
+{
+	if (workerThreadCount < 0)
+	{
+		workerThreadCount = 0;
+	}
+
+	if (workerThreadCount == GetWorkerThreadCount())
+	{
+		return;
+	}
+
+	WaitForAllJobs();
+	StopWorkerThreads();
+	StartWorkerThreads(workerThreadCount);
+}
+
+void JobManager::AddJob(const Job& job)
+{
+	if (workerThreads_.empty())
+	{
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex_);
+		jobs_.push_back(job);
+	}
+
+	jobAddedConditionVariable_.notify_one();
+}
+
+void JobManager::ParallelFor(int count, int batchSize, const ParallelForFunction& function)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	if (batchSize < 1)
+	{
+		batchSize = 1;
+	}
+
+	const int batchCount = (count + batchSize - 1) / batchSize;
+	if (batchCount == 1 || workerThreads_.empty())
+	{
+		function(0, count);
+		return;
+	}
+
+	struct ParallelForData
+	{
+		std::atomic<int> nextBatchIndex{ 0 };
+		std::atomic<int> remainingBatchCount{ 0 };
+	};
+
+	std::shared_ptr<ParallelForData> parallelForData = std::make_shared<ParallelForData>();
+	parallelForData->remainingBatchCount = batchCount;
+
+	// function is only accessed while there are unclaimed batches
+	// and this call does not return before every claimed batch is finished
+	const ParallelForFunction* functionPointer = &function;
+	Job runBatches = [parallelForData, functionPointer, count, batchSize, batchCount]()
+		{
+			int batchIndex = parallelForData->nextBatchIndex.fetch_add(1);
+			while (batchIndex < batchCount)
+			{
+				const int beginIndex = batchIndex * batchSize;
+				const int endIndex = count < beginIndex + batchSize ? count : beginIndex + batchSize;
+				(*functionPointer)(beginIndex, endIndex);
+
+				parallelForData->remainingBatchCount.fetch_sub(1);
+				batchIndex = parallelForData->nextBatchIndex.fetch_add(1);
+			}
+		};
+
+	// Helpers go to the front so batches of the frame do not wait behind long background jobs like content decodes
+	const int helperJobCount = GetWorkerThreadCount() < batchCount - 1 ? GetWorkerThreadCount() : batchCount - 1;
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex_);
+		for (int helperJobIndex = 0; helperJobIndex < helperJobCount; ++helperJobIndex)
+		{
+			jobs_.push_front(runBatches);
+		}
+	}
+	jobAddedConditionVariable_.notify_all();
+
+	runBatches();
+
+	// Every batch is claimed once runBatches returns, the calling thread only waits for the ones still running on the workers
+	// instead of picking up unrelated jobs from the queue
+	while (0 < parallelForData->remainingBatchCount.load())
+	{
+		std::this_thread::yield();
+	}
+}
+
+void JobManager::WaitForAllJobs()
+{
+	std::unique_lock<std::mutex> lock(jobsMutex_);
+	jobsFinishedConditionVariable_.wait(lock, [this]() { return jobs_.empty() && runningJobCount_ == 0; });
+}
+
+void JobManager::StartWorkerThreads(int workerThreadCount)
+{
+	isRunning_ = true;
+
+	workerThreads_.reserve(workerThreadCount);
+	for (int workerThreadIndex = 0; workerThreadIndex < workerThreadCount; ++workerThreadIndex)
+	{
+		workerThreads_.emplace_back(&JobManager::WorkerThreadLoop, this);
+	}
+}
+
+void JobManager::StopWorkerThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex_);
+		isRunning_ = false;
+	}
+	jobAddedConditionVariable_.notify_all();
+
+	for (std::thread& workerThread : workerThreads_)
+	{
+		if (workerThread.joinable())
+		{
+			workerThread.join();
+		}
+	}
+	workerThreads_.clear();
+}
+
+void JobManager::WorkerThreadLoop()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(jobsMutex_);
+			jobAddedConditionVariable_.wait(lock, [this]() { return !isRunning_ || !jobs_.empty(); });
+
+			if (jobs_.empty())
+			{
+				// Not running anymore and nothing left to do
+				return;
+			}
+
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+			++runningJobCount_;
+		}
+
+		job();
+
+		{
+			std::lock_guard<std::mutex> lock(jobsMutex_);
+			--runningJobCount_;
+		}
+		jobsFinishedConditionVariable_.notify_all();
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef __JOBMANAGER_H__
+#define __JOBMANAGER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Goknar/Core.h"
+
+// Engine thread pool
+// Jobs must not touch engine registries(objects, components, renderer etc.)
+// since those are only safe to modify on the main thread
+class GOKNAR_API JobManager
+{
+public:
+	using Job = std::function<void()>;
+	using ParallelForFunction = std::function<void(int beginIndex, int endIndex)>;
+
+	JobManager();
+	~JobManager();
+
+	// Restarts the worker threads, should not be called while jobs are in flight
+	void SetWorkerThreadCount(int workerThreadCount);
+	int GetWorkerThreadCount() const
+	{
+		return (int)workerThreads_.size();
+	}
+
+	void AddJob(const Job& job);
+
+	// Splits [0, count) into batches of batchSize and runs them on the workers
+	// The calling thread takes batches of the same call as well and the call returns when all batches are done
+	// Batches are queued ahead of the jobs added by AddJob
+	void ParallelFor(int count, int batchSize, const ParallelForFunction& function);
+
+	void WaitForAllJobs();
+
+	bool GetIsMainThread() const
+	{
+		return std::this_thread::get_id() == mainThreadId_;
+	}
+
+private:
+	void StartWorkerThreads(int workerThreadCount);
+	void StopWorkerThreads();
+
+	void WorkerThreadLoop();
+
+	std::vector<std::thread> workerThreads_;
+	std::deque<Job> jobs_;
+
+	std::mutex jobsMutex_;
+	std::condition_variable jobAddedConditionVariable_;
+	std::condition_variable jobsFinishedConditionVariable_;
+
+	std::thread::id mainThreadId_;
+
+	int runningJobCount_{ 0 };
+	bool isRunning_{ false };
+};
+
+#endif
@@ -0,0 +1,314 @@
+#include "pch.h"
+
+#include "LevelStreamingManager.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <unordered_set>
+
+#include "Goknar/Camera.h"
+#include "Goknar/Engine.h"
+#include "Goknar/Log.h"
+#include "Goknar/ObjectBase.h"
+#include "Goknar/Helpers/SceneParser.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/CookedSceneLoader.h"
+#include "Goknar/Managers/CameraManager.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Managers/ResourceManager.h"
+
+static float GetDistanceToBox(const Vector3& point, const Box& box)
+{
+	const Vector3& min = box.GetMin();
+	const Vector3& max = box.GetMax();
+
+	const float distanceX = point.x < min.x ? min.x - point.x : max.x < point.x ? point.x - max.x : 0.f;
+	const float distanceY = point.y < min.y ? min.y - point.y : max.y < point.y ? point.y - max.y : 0.f;
+	const float distanceZ = point.z < min.z ? min.z - point.z : max.z < point.z ? point.z - max.z : 0.f;
+
+	return std::sqrt(distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ);
+}
+
+// Runs on the job manager's worker threads
+static bool ReadCellScene(const std::string& path, CookedSceneData& sceneData)
+{
+	std::string extension = ResourceManagerUtils::GetExtension(path);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	if (extension == COOKED_SCENE_EXTENSION)
+	{
+		return CookedSceneLoader::ReadCookedScene(path, sceneData);
+	}
+
+	const std::string cookedPath = CookedSceneLoader::GetCookedPath(path);
+	if (CookedFileUtils::GetIsCookedFileUpToDate(path, cookedPath) && CookedSceneLoader::ReadCookedScene(cookedPath, sceneData))
+	{
+		return true;
+	}
+
+	return SceneParser::BuildCookedScene(path, sceneData);
+}
+
+StreamingCell::StreamingCell(const std::string& name, const Box& bounds, const std::string& scenePath) :
+	name_(name),
+	scenePath_(scenePath),
+	bounds_(bounds)
+{
+}
+
+StreamingCell::~StreamingCell()
+{
+	delete sceneData_;
+	delete instancer_;
+}
+
+const std::vector<ObjectBase*>& StreamingCell::GetObjects() const
+{
+	static const std::vector<ObjectBase*> noObjects;
+	return instancer_ ? instancer_->GetObjects() : noObjects;
+}
+
+unsigned long long StreamingCell::GetResidentByteCount() const
+{
+	const ResourceManager* resourceManager = engine->GetResourceManager();
+
+	unsigned long long residentByteCount = 0;
+	for (const std::string& acquiredContentPath : acquiredContentPaths_)
+	{
+		residentByteCount += resourceManager->GetResidentContentByteCount(acquiredContentPath);
+	}
+
+	return residentByteCount;
+}
+
+LevelStreamingManager::LevelStreamingManager()
+{
+}
+
+LevelStreamingManager::~LevelStreamingManager()
+{
+	// Loading jobs write into the cells
+	for (StreamingCell* cell : cells_)
+	{
+		if (cell->state_ == StreamingCellState::Loading && !cell->isSceneDataRead_)
+		{
+			engine->GetJobManager()->WaitForAllJobs();
+			break;
+		}
+	}
+
+	for (StreamingCell* cell : cells_)
+	{
+		delete cell;
+	}
+}
+
+StreamingCell* LevelStreamingManager::AddCell(const std::string& name, const Box& bounds, const std::string& scenePath)
+{
+	StreamingCell* cell = new StreamingCell(name, bounds, scenePath);
+	cells_.push_back(cell);
+	return cell;
+}
+
+StreamingCell* LevelStreamingManager::GetCell(const std::string& name) const
+{
+	for (StreamingCell* cell : cells_)
+	{
+		if (cell->name_ == name)
+		{
+			return cell;
+		}
+	}
+
+	return nullptr;
+}
+
+void LevelStreamingManager::Update()
+{
+	if (cells_.empty())
+	{
+		return;
+	}
+
+	Camera* activeCamera = engine->GetCameraManager()->GetActiveCamera();
+	if (activeCamera)
+	{
+		const Vector3 viewPosition = activeCamera->GetPosition();
+		for (StreamingCell* cell : cells_)
+		{
+			const float distance = GetDistanceToBox(viewPosition, cell->bounds_);
+			if (distance <= streamingRadius_)
+			{
+				if (cell->state_ == StreamingCellState::Unloaded || cell->isUnloadRequested_)
+				{
+					LoadCell(cell);
+				}
+			}
+			else if (streamingRadius_ + unloadMargin_ < distance && cell->state_ != StreamingCellState::Unloaded)
+			{
+				UnloadCell(cell);
+			}
+		}
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	// Cells share the activation budget in the order they are added
+	bool hasActivatedObjects = false;
+	for (StreamingCell* cell : cells_)
+	{
+		if (cell->state_ == StreamingCellState::Loading)
+		{
+			UpdateLoadingCell(cell);
+		}
+
+		if (cell->state_ != StreamingCellState::Activating)
+		{
+			continue;
+		}
+
+		const float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+		const float remainingTimeBudget = activationTimeBudget_ - elapsedTime;
+		if (remainingTimeBudget <= 0.f && hasActivatedObjects)
+		{
+			continue;
+		}
+
+		hasActivatedObjects = true;
+		if (cell->instancer_->InstantiateObjects(remainingTimeBudget))
+		{
+			cell->state_ = StreamingCellState::Active;
+		}
+	}
+}
+
+void LevelStreamingManager::LoadCell(StreamingCell* cell)
+{
+	// Cell came back into the streaming radius before its scene file is read
+	if (cell->isUnloadRequested_)
+	{
+		cell->isUnloadRequested_ = false;
+		return;
+	}
+
+	cell->state_ = StreamingCellState::Loading;
+
+	for (const std::string& dependency : cell->dependencies_)
+	{
+		AcquireCellContent(cell, dependency);
+	}
+
+	cell->sceneData_ = new CookedSceneData();
+	cell->isSceneDataValid_ = false;
+	cell->areSceneContentsAcquired_ = false;
+	cell->isSceneDataRead_ = false;
+
+	const std::string scenePath = ContentDir + cell->scenePath_;
+	engine->GetJobManager()->AddJob(
+		[cell, scenePath]()
+		{
+			cell->isSceneDataValid_ = ReadCellScene(scenePath, *cell->sceneData_);
+			cell->isSceneDataRead_ = true;
+		});
+}
+
+void LevelStreamingManager::UnloadCell(StreamingCell* cell)
+{
+	// Loading job still writes into the cell
+	if (cell->state_ == StreamingCellState::Loading && !cell->isSceneDataRead_)
+	{
+		cell->isUnloadRequested_ = true;
+		return;
+	}
+
+	if (cell->instancer_)
+	{
+		for (ObjectBase* object : cell->instancer_->GetObjects())
+		{
+			object->Destroy();
+		}
+
+		delete cell->instancer_;
+		cell->instancer_ = nullptr;
+	}
+
+	delete cell->sceneData_;
+	cell->sceneData_ = nullptr;
+
+	ResourceManager* resourceManager = engine->GetResourceManager();
+	for (const std::string& acquiredContentPath : cell->acquiredContentPaths_)
+	{
+		resourceManager->ReleaseContent(acquiredContentPath);
+	}
+	cell->acquiredContentPaths_.clear();
+	cell->contentLoadRequests_.clear();
+
+	cell->isUnloadRequested_ = false;
+	cell->state_ = StreamingCellState::Unloaded;
+}
+
+void LevelStreamingManager::UpdateLoadingCell(StreamingCell* cell)
+{
+	if (!cell->isSceneDataRead_)
+	{
+		return;
+	}
+
+	if (cell->isUnloadRequested_)
+	{
+		UnloadCell(cell);
+		return;
+	}
+
+	// Meshes of the components are loaded together with the dependencies of the cell
+	if (!cell->areSceneContentsAcquired_)
+	{
+		cell->areSceneContentsAcquired_ = true;
+
+		if (!cell->isSceneDataValid_)
+		{
+			GOKNAR_CORE_WARN("Scene file {} of the streaming cell {} could not be read, the cell has no objects.", cell->scenePath_, cell->name_);
+			*cell->sceneData_ = CookedSceneData();
+		}
+
+		// Strings are stored once in cooked scenes, so each mesh path has a single offset
+		const CookedSceneData& sceneData = *cell->sceneData_;
+		std::unordered_set<uint32_t> meshPathOffsets;
+		for (const CookedSceneComponent& component : sceneData.components)
+		{
+			if ((component.flags & (uint32_t)CookedSceneComponentFlag::Mesh) && meshPathOffsets.insert(component.meshPathOffset).second)
+			{
+				AcquireCellContent(cell, sceneData.strings.c_str() + component.meshPathOffset);
+			}
+		}
+	}
+
+	for (const ContentLoadRequest* contentLoadRequest : cell->contentLoadRequests_)
+	{
+		if (!contentLoadRequest->GetIsDone())
+		{
+			return;
+		}
+	}
+
+	cell->instancer_ = new CookedSceneInstancer(std::move(*cell->sceneData_), ContentDir + cell->scenePath_, true);
+
+	delete cell->sceneData_;
+	cell->sceneData_ = nullptr;
+
+	cell->state_ = StreamingCellState::Activating;
+}
+
+void LevelStreamingManager::AcquireCellContent(StreamingCell* cell, const std::string& path)
+{
+	// Each content is acquired once per cell
+	if (std::find(cell->acquiredContentPaths_.begin(), cell->acquiredContentPaths_.end(), path) != cell->acquiredContentPaths_.end())
+	{
+		return;
+	}
+
+	cell->acquiredContentPaths_.push_back(path);
+	cell->contentLoadRequests_.push_back(engine->GetResourceManager()->AcquireContent(path));
+}
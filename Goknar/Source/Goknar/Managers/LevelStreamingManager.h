@@ -0,0 +1,168 @@
+#ifndef __LEVELSTREAMINGMANAGER_H__
+#define __LEVELSTREAMINGMANAGER_H__
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "Goknar/Core.h"
+#include "Goknar/Geometry/Box.h"
+
+class ContentLoadRequest;
+class CookedSceneInstancer;
+class ObjectBase;
+
+struct CookedSceneData;
+
+enum class GOKNAR_API StreamingCellState : unsigned char
+{
+	Unloaded = 0,
+	// Scene file is read on a worker thread and the contents of the cell are loaded
+	Loading,
+	// Objects are instantiated over several frames
+	Activating,
+	Active
+};
+
+// Spatial cell(sublevel) of a streamed level
+// Objects of the cell are loaded from its scene file, only the objects of the scene file are streamed, its other settings are ignored
+class GOKNAR_API StreamingCell
+{
+	friend class LevelStreamingManager;
+
+public:
+	const std::string& GetName() const
+	{
+		return name_;
+	}
+
+	const Box& GetBounds() const
+	{
+		return bounds_;
+	}
+
+	const std::string& GetScenePath() const
+	{
+		return scenePath_;
+	}
+
+	// Content paths relative to the content directory, loaded before the objects of the cell are activated
+	// Meshes used by the scene file of the cell are loaded without being added as dependencies
+	void AddDependency(const std::string& path)
+	{
+		dependencies_.push_back(path);
+	}
+
+	const std::vector<std::string>& GetDependencies() const
+	{
+		return dependencies_;
+	}
+
+	StreamingCellState GetState() const
+	{
+		return state_;
+	}
+
+	// Objects of the cell are destroyed when the cell is unloaded, so they must not be destroyed by anything else
+	const std::vector<ObjectBase*>& GetObjects() const;
+
+	// Bytes of the resident contents the cell uses, contents shared by several cells are counted in each of them
+	unsigned long long GetResidentByteCount() const;
+
+private:
+	StreamingCell(const std::string& name, const Box& bounds, const std::string& scenePath);
+	~StreamingCell();
+
+	std::string name_;
+	std::string scenePath_;
+	Box bounds_;
+
+	std::vector<std::string> dependencies_;
+
+	// Contents acquired from the resource manager while the cell is loaded
+	std::vector<std::string> acquiredContentPaths_;
+	std::vector<ContentLoadRequest*> contentLoadRequests_;
+
+	// Written by the loading job until isSceneDataRead_ is set
+	CookedSceneData* sceneData_{ nullptr };
+	CookedSceneInstancer* instancer_{ nullptr };
+
+	std::atomic<bool> isSceneDataRead_{ false };
+	bool isSceneDataValid_{ false };
+	bool areSceneContentsAcquired_{ false };
+	// Cell went out of the streaming radius while its scene file was being read
+	bool isUnloadRequested_{ false };
+
+	StreamingCellState state_{ StreamingCellState::Unloaded };
+};
+
+// Streams the cells of a level in and out around the active camera
+// Cells closer than the streaming radius are loaded and their objects are activated under a time budget per frame,
+// cells farther than the streaming radius plus the unload margin are unloaded and their contents are released to the resource manager
+class GOKNAR_API LevelStreamingManager
+{
+public:
+	LevelStreamingManager();
+	~LevelStreamingManager();
+
+	// Called by the engine once per frame
+	void Update();
+
+	// Scene path is relative to the content directory, .gkscene files and scene XML files with up to date cooked siblings are read without the XML parser
+	StreamingCell* AddCell(const std::string& name, const Box& bounds, const std::string& scenePath);
+
+	const std::vector<StreamingCell*>& GetCells() const
+	{
+		return cells_;
+	}
+
+	StreamingCell* GetCell(const std::string& name) const;
+
+	void SetStreamingRadius(float streamingRadius)
+	{
+		streamingRadius_ = streamingRadius;
+	}
+
+	float GetStreamingRadius() const
+	{
+		return streamingRadius_;
+	}
+
+	// Keeps the cells on the streaming radius from being loaded and unloaded repeatedly
+	void SetUnloadMargin(float unloadMargin)
+	{
+		unloadMargin_ = unloadMargin;
+	}
+
+	float GetUnloadMargin() const
+	{
+		return unloadMargin_;
+	}
+
+	void SetActivationTimeBudget(float activationTimeBudget)
+	{
+		activationTimeBudget_ = activationTimeBudget;
+	}
+
+	float GetActivationTimeBudget() const
+	{
+		return activationTimeBudget_;
+	}
+
+private:
+	void LoadCell(StreamingCell* cell);
+	void UnloadCell(StreamingCell* cell);
+
+	void UpdateLoadingCell(StreamingCell* cell);
+	void AcquireCellContent(StreamingCell* cell, const std::string& path);
+
+	std::vector<StreamingCell*> cells_;
+
+	float streamingRadius_{ 200.f };
+	float unloadMargin_{ 20.f };
+
+	// Time in seconds object activations can use per frame
+	float activationTimeBudget_{ 0.004f };
+};
+
+#endif
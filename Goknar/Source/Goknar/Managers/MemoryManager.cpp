@@ -0,0 +1,123 @@
+#include "pch.h"
+
+#include "MemoryManager.h"
+
+#include "Goknar/Log.h"
+#include "Goknar/Memory/PoolAllocator.h"
+
+MemoryManager* MemoryManager::instance_ = nullptr;
+
+MemoryManager::MemoryManager()
+{
+}
+
+MemoryManager::~MemoryManager()
+{
+	for (std::size_t poolIndex = 0; poolIndex < POOL_COUNT; ++poolIndex)
+	{
+		delete pools_[poolIndex];
+		pools_[poolIndex] = nullptr;
+	}
+
+	instance_ = nullptr;
+}
+
+void* MemoryManager::Allocate(std::size_t size, AllocationCategory category)
+{
+	AllocationStatistics& statistics = allocationStatistics_[(int)category];
+	++statistics.allocationCount;
+	++statistics.liveCount;
+	statistics.liveBytes += size;
+	if (statistics.peakLiveBytes < statistics.liveBytes)
+	{
+		statistics.peakLiveBytes = statistics.liveBytes;
+	}
+
+	PoolAllocator* pool = GetPool(size);
+	if (pool)
+	{
+		++statistics.pooledAllocationCount;
+		return pool->Allocate();
+	}
+
+	++statistics.heapAllocationCount;
+	return ::operator new(size);
+}
+
+void MemoryManager::Deallocate(void* pointer, std::size_t size, AllocationCategory category)
+{
+	if (!pointer)
+	{
+		return;
+	}
+
+	AllocationStatistics& statistics = allocationStatistics_[(int)category];
+	++statistics.deallocationCount;
+	--statistics.liveCount;
+	statistics.liveBytes -= size;
+
+	PoolAllocator* pool = GetPool(size);
+	if (pool)
+	{
+		pool->Deallocate(pointer);
+	}
+	else
+	{
+		::operator delete(pointer);
+	}
+}
+
+const char* MemoryManager::GetAllocationCategoryName(AllocationCategory category)
+{
+	switch (category)
+	{
+	case AllocationCategory::ObjectBase:
+		return "ObjectBase";
+	case AllocationCategory::Component:
+		return "Component";
+	case AllocationCategory::MaterialInstance:
+		return "MaterialInstance";
+	case AllocationCategory::MeshInstance:
+		return "MeshInstance";
+	default:
+		break;
+	}
+
+	return "Unknown";
+}
+
+void MemoryManager::LogAllocationStatistics() const
+{
+	for (int categoryIndex = 0; categoryIndex < (int)AllocationCategory::Count; ++categoryIndex)
+	{
+		const AllocationStatistics& statistics = allocationStatistics_[categoryIndex];
+		GOKNAR_CORE_INFO("{}: {} allocations({} pooled, {} heap), {} deallocations, {} live objects, {} live bytes, {} peak bytes",
+			GetAllocationCategoryName((AllocationCategory)categoryIndex),
+			statistics.allocationCount,
+			statistics.pooledAllocationCount,
+			statistics.heapAllocationCount,
+			statistics.deallocationCount,
+			statistics.liveCount,
+			statistics.liveBytes,
+			statistics.peakLiveBytes);
+	}
+}
+
+PoolAllocator* MemoryManager::GetPool(std::size_t size)
+{
+	if (size == 0 || MAX_POOLED_SIZE < size)
+	{
+		return nullptr;
+	}
+
+	const std::size_t poolIndex = (size - 1) / POOL_SIZE_GRANULARITY;
+	if (!pools_[poolIndex])
+	{
+		const std::size_t blockSize = (poolIndex + 1) * POOL_SIZE_GRANULARITY;
+		// Keep chunks around 64KB regardless of the size class
+		const std::size_t blocksPerChunk = blockSize < 65536 / 16 ? 65536 / blockSize : 16;
+		pools_[poolIndex] = new PoolAllocator(blockSize, blocksPerChunk);
+	}
+
+	return pools_[poolIndex];
+}
@@ -0,0 +1,88 @@
+#ifndef __MEMORYMANAGER_H__
+#define __MEMORYMANAGER_H__
+
+#include <cstddef>
+
+#include "Goknar/Core.h"
+
+class PoolAllocator;
+
+enum class GOKNAR_API AllocationCategory : unsigned char
+{
+	ObjectBase = 0,
+	Component,
+	MaterialInstance,
+	MeshInstance,
+	Count
+};
+
+struct GOKNAR_API AllocationStatistics
+{
+	std::size_t allocationCount{ 0 };
+	std::size_t deallocationCount{ 0 };
+	std::size_t pooledAllocationCount{ 0 };
+	std::size_t heapAllocationCount{ 0 };
+	std::size_t liveCount{ 0 };
+	std::size_t liveBytes{ 0 };
+	std::size_t peakLiveBytes{ 0 };
+};
+
+// Engine-aware allocator for engine types
+// ObjectBase, Component, MaterialInstance and mesh instances route their operator new/delete here
+// Allocations are served from size-class pools so destroyed objects are recycled
+// instead of being given back to the general purpose heap
+// Only main thread allocations are supported
+class GOKNAR_API MemoryManager
+{
+public:
+	static MemoryManager* GetInstance()
+	{
+		if (instance_ == nullptr)
+		{
+			instance_ = new MemoryManager();
+		}
+
+		return instance_;
+	}
+
+	~MemoryManager();
+
+	void* Allocate(std::size_t size, AllocationCategory category);
+	void Deallocate(void* pointer, std::size_t size, AllocationCategory category);
+
+	const AllocationStatistics& GetAllocationStatistics(AllocationCategory category) const
+	{
+		return allocationStatistics_[(int)category];
+	}
+
+	static const char* GetAllocationCategoryName(AllocationCategory category);
+
+	void LogAllocationStatistics() const;
+
+	static constexpr std::size_t POOL_SIZE_GRANULARITY = 16;
+	static constexpr std::size_t MAX_POOLED_SIZE = 4096;
+	static constexpr std::size_t POOL_COUNT = MAX_POOLED_SIZE / POOL_SIZE_GRANULARITY;
+
+private:
+	MemoryManager();
+
+	PoolAllocator* GetPool(std::size_t size);
+
+	static MemoryManager* instance_;
+
+	PoolAllocator* pools_[POOL_COUNT]{};
+
+	AllocationStatistics allocationStatistics_[(int)AllocationCategory::Count];
+};
+
+#define GOKNAR_POOLED_ALLOCATION(category) \
+	static void* operator new(std::size_t size) \
+	{ \
+		return MemoryManager::GetInstance()->Allocate(size, category); \
+	} \
+	static void operator delete(void* pointer, std::size_t size) \
+	{ \
+		MemoryManager::GetInstance()->Deallocate(pointer, size, category); \
+	}
+
+#endif
@@ -2,22 +2,198 @@
 
 #include "Managers/ResourceManager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+#include "Engine.h"
 #include "Log.h"
 
 #include "Contents/Audio.h"
 #include "Contents/Image.h"
+#include "Model/SkeletalMesh.h"
 #include "Model/StaticMesh.h"
+#include "IO/CookedMeshLoader.h"
+#include "IO/CookedTextureLoader.h"
 #include "IO/IOManager.h"
+#include "Managers/JobManager.h"
 #include "Materials/Material.h"
+#include "Physics/PhysicsShapeCache.h"
+#include "Physics/PhysicsWorld.h"
+#include "Renderer/ShaderBuilderNew.h"
+#include "Renderer/TexturePacker.h"
+
+// Set on the threads running a content loading job, contents and materials they create are staged instead of being registered
+static thread_local bool isLoadingContentAsync = false;
+// Set while a model is decoded, images its loaders get are referenced through the materials of the model instead of being pinned
+static thread_local bool isLoadingModel = false;
+
+static void GetMaterialImagePaths(Content* content, std::vector<std::string>& imagePaths)
+{
+	MeshUnit* mesh = dynamic_cast<MeshUnit*>(content);
+	Material* material = mesh ? mesh->GetMaterial() : nullptr;
+	if (!material)
+	{
+		return;
+	}
+
+	for (const Image* image : *material->GetTextureImages())
+	{
+		if (image && std::find(imagePaths.begin(), imagePaths.end(), image->GetPath()) == imagePaths.end())
+		{
+			imagePaths.push_back(image->GetPath());
+		}
+	}
+}
+
+static bool GetIsContentEvicted(const Content* content)
+{
+	if (const Image* image = dynamic_cast<const Image*>(content))
+	{
+		return image->GetIsEvicted();
+	}
+
+	const MeshUnit* mesh = dynamic_cast<const MeshUnit*>(content);
+	return mesh && mesh->GetIsDataEvicted();
+}
+
+// Static meshes free their vertices and faces on the CPU and the convex hulls built from them,
+// their copies on the GPU stay since the vertex and index buffers of the renderer only grow
+static bool EvictContent(Content* content)
+{
+	if (Image* image = dynamic_cast<Image*>(content))
+	{
+		return image->Evict();
+	}
+
+	// Bone data of skeletal meshes is not restored
+	StaticMesh* staticMesh = dynamic_cast<StaticMesh*>(content);
+	if (!staticMesh || dynamic_cast<SkeletalMesh*>(staticMesh) || !staticMesh->EvictData())
+	{
+		return false;
+	}
+
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	if (physicsWorld)
+	{
+		physicsWorld->GetShapeCache()->ReleaseMeshData(staticMesh);
+	}
+
+	return true;
+}
+
+void ContentLoadRequest::AddCallback(const ContentLoadCallback& callback)
+{
+	if (!callback)
+	{
+		return;
+	}
+
+	if (GetIsDone())
+	{
+		callback(content_);
+		return;
+	}
+
+	callbacks_.push_back(callback);
+}
+
+ContentHandle::ContentHandle(const std::string& path, const ContentLoadCallback& callback) :
+	path_(path),
+	request_(engine->GetResourceManager()->AcquireContent(path, callback))
+{
+}
+
+ContentHandle::ContentHandle(const ContentHandle& other) :
+	path_(other.path_),
+	request_(other.request_ ? engine->GetResourceManager()->AcquireContent(other.path_) : nullptr)
+{
+}
+
+ContentHandle::ContentHandle(ContentHandle&& other) noexcept :
+	path_(std::move(other.path_)),
+	request_(other.request_)
+{
+	other.request_ = nullptr;
+}
+
+ContentHandle::~ContentHandle()
+{
+	Reset();
+}
+
+ContentHandle& ContentHandle::operator=(const ContentHandle& other)
+{
+	if (this != &other)
+	{
+		// Acquired before the release so that a content shared by both handles is not queued for eviction
+		ContentLoadRequest* request = other.request_ ? engine->GetResourceManager()->AcquireContent(other.path_) : nullptr;
+		Reset();
+		path_ = other.path_;
+		request_ = request;
+	}
+
+	return *this;
+}
+
+ContentHandle& ContentHandle::operator=(ContentHandle&& other) noexcept
+{
+	if (this != &other)
+	{
+		Reset();
+		path_ = std::move(other.path_);
+		request_ = other.request_;
+		other.request_ = nullptr;
+	}
+
+	return *this;
+}
+
+void ContentHandle::Reset()
+{
+	if (request_)
+	{
+		engine->GetResourceManager()->ReleaseContent(path_);
+		request_ = nullptr;
+	}
+}
 
 ResourceManager::ResourceManager() :
-	resourceContainer_(new ResourceContainer())
+	resourceContainer_(new ResourceContainer()),
+	prebuiltTextureAtlases_(new PrebuiltTextureAtlases())
 {
 }
 
 ResourceManager::~ResourceManager()
 {
+	// Loading jobs write to the staging arrays
+	if (0 < pendingContentLoadCount_)
+	{
+		engine->GetJobManager()->WaitForAllJobs();
+	}
+
+	for (Content* stagedContent : stagedContents_)
+	{
+		delete stagedContent;
+	}
+
+	for (const std::pair<Content*, Content*>& restoredContent : restoredContents_)
+	{
+		delete restoredContent.second;
+	}
+
+	for (auto& contentLoadRequestPair : contentLoadRequests_)
+	{
+		delete contentLoadRequestPair.second;
+	}
+
 	delete resourceContainer_;
+	delete prebuiltTextureAtlases_;
+
+	for (auto material : stagedMaterials_)
+	{
+		delete material;
+	}
 
 	for (auto material : materials_)
 	{
@@ -27,7 +203,26 @@ ResourceManager::~ResourceManager()
 
 void ResourceManager::PreInit()
 {
+	if (isPackingImages_ && !engine->GetIsHeadless())
+	{
+		const std::string defaultAtlasManifestPath = ContentDir + "Atlas." TEXTURE_ATLAS_MANIFEST_EXTENSION;
+		std::error_code errorCode;
+		if (prebuiltTextureAtlases_->GetImageCount() == 0 && std::filesystem::exists(defaultAtlasManifestPath, errorCode))
+		{
+			prebuiltTextureAtlases_->LoadManifest(defaultAtlasManifestPath);
+		}
+
+		TexturePacker::PackImages(resourceContainer_->GetImageArray(), prebuiltTextureAtlases_);
+	}
+
 	resourceContainer_->PreInit();
+
+	isInitialized_ = true;
+}
+
+bool ResourceManager::LoadTextureAtlasManifest(const std::string& path)
+{
+	return prebuiltTextureAtlases_->LoadManifest(ContentDir + path);
 }
 
 void ResourceManager::Init()
@@ -40,7 +235,122 @@ void ResourceManager::PostInit()
 	resourceContainer_->PostInit();
 }
 
+void ResourceManager::AddMaterial(Material* material)
+{
+	if (isLoadingContentAsync)
+	{
+		std::lock_guard<std::mutex> lock(contentMutex_);
+		stagedMaterials_.push_back(material);
+		return;
+	}
+
+	materials_.push_back(material);
+}
+
+Content* ResourceManager::FindOrLoadContent(const std::string& path)
+{
+	if (isLoadingContentAsync)
+	{
+		return LoadStagedContent(path);
+	}
+
+	Content* content = resourceContainer_->GetContent<Content>(path);
+
+	// Content might be decoded by a loading job already
+	if (!content && 0 < pendingContentLoadCount_)
+	{
+		{
+			std::lock_guard<std::mutex> lock(contentMutex_);
+			RegisterStagedContentsLocked();
+		}
+
+		content = resourceContainer_->GetContent<Content>(path);
+	}
+
+	if (!content)
+	{
+		content = LoadContent(path);
+	}
+
+	if (content && !isLoadingModel)
+	{
+		PinContent(path);
+		PinContentDependencies(content);
+	}
+
+	return content;
+}
+
+Content* ResourceManager::FindAcquiredContent(const std::string& fullPath) const
+{
+	std::unordered_map<std::string, ContentReference>::const_iterator contentReferenceIterator = contentReferences_.find(fullPath);
+	if (contentReferenceIterator == contentReferences_.end() || contentReferenceIterator->second.referenceCount <= 0)
+	{
+		return nullptr;
+	}
+
+	return contentReferenceIterator->second.content;
+}
+
 Content* ResourceManager::LoadContent(const std::string& path)
+{
+	Content* content = DecodeContent(path);
+	if (!content)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(contentMutex_);
+
+	// A loading job might have staged the same content while it was decoded here
+	Content* existingContent = FindContentLocked(path);
+	if (existingContent)
+	{
+		delete content;
+		RegisterStagedContentsLocked();
+		return existingContent;
+	}
+
+	RegisterContent(content);
+
+	return content;
+}
+
+Content* ResourceManager::LoadStagedContent(const std::string& path)
+{
+	{
+		std::lock_guard<std::mutex> lock(contentMutex_);
+
+		Content* content = FindContentLocked(path);
+		if (content)
+		{
+			return content;
+		}
+	}
+
+	Content* content = DecodeContent(path);
+	if (!content)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(contentMutex_);
+
+	// Another job or the main thread might have loaded the same content in the meantime
+	Content* existingContent = FindContentLocked(path);
+	if (existingContent)
+	{
+		delete content;
+		return existingContent;
+	}
+
+	stagedContents_.push_back(content);
+	stagedContentPathMap_[path] = content;
+
+	return content;
+}
+
+Content* ResourceManager::DecodeContent(const std::string& path)
 {
 	Content* content = nullptr;
 
@@ -49,13 +359,21 @@ Content* ResourceManager::LoadContent(const std::string& path)
 	{
 	case ResourceType::Image:
 	{
+		const std::chrono::steady_clock::time_point decodeStartTimePoint = std::chrono::steady_clock::now();
+
 		Image* image = IOManager::LoadImage(path);
 		if (image)
 		{
-			image->SetPath(path);
-			resourceContainer_->AddImage(image);
-			content = image;
+			if (isPrecomputingImageMipmaps_)
+			{
+				image->GenerateMipmaps();
+			}
+
+			decodedImageByteCount_ += image->GetByteSize();
+			imageDecodeTimeInNanoseconds_ += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decodeStartTimePoint).count();
 		}
+
+		content = image;
 		break;
 	}
 	case ResourceType::Model:
@@ -73,24 +391,14 @@ Content* ResourceManager::LoadContent(const std::string& path)
 		//	resourceContainer_->AddAnimationData(animationData);
 		//	content = animationData;
 		//}
-		MeshUnit* mesh = IOManager::LoadModel(path);
-		if (mesh)
-		{
-			mesh->SetPath(path);
-			resourceContainer_->AddMesh(mesh);
-			content = mesh;
-		}
+		isLoadingModel = true;
+		content = IOManager::LoadModel(path);
+		isLoadingModel = false;
 		break;
 	}
 	case ResourceType::Audio:
 	{
-		//Audio* audio = IOManager::LoadAudio(path);
-		//if(audio)
-		//{
-		//	audio->SetPath(path); 
-		//	resourceContainer_->AddAudio(audio);
-		//	content = audio;
-		//}
+		//content = IOManager::LoadAudio(path);
 		break;
 	}
 	case ResourceType::None:
@@ -100,12 +408,600 @@ Content* ResourceManager::LoadContent(const std::string& path)
 
 	if (content)
 	{
-		resourceContainer_->contentPathMap_[path] = content;
+		content->SetPath(path);
 	}
 
 	return content;
 }
 
+void ResourceManager::RegisterContent(Content* content)
+{
+	if (Image* image = dynamic_cast<Image*>(content))
+	{
+		resourceContainer_->AddImage(image);
+	}
+	else if (MeshUnit* mesh = dynamic_cast<MeshUnit*>(content))
+	{
+		resourceContainer_->AddMesh(mesh);
+	}
+	else if (Audio* audio = dynamic_cast<Audio*>(content))
+	{
+		resourceContainer_->AddAudio(audio);
+	}
+}
+
+Content* ResourceManager::FindContentLocked(const std::string& path)
+{
+	Content* content = resourceContainer_->GetContent<Content>(path);
+	if (content)
+	{
+		return content;
+	}
+
+	std::unordered_map<std::string, Content*>::const_iterator stagedContentIterator = stagedContentPathMap_.find(path);
+	if (stagedContentIterator != stagedContentPathMap_.end())
+	{
+		return stagedContentIterator->second;
+	}
+
+	return nullptr;
+}
+
+void ResourceManager::RegisterStagedContentsLocked()
+{
+	materials_.insert(materials_.end(), stagedMaterials_.begin(), stagedMaterials_.end());
+	stagedMaterials_.clear();
+
+	// Staging order is kept so textures are uploaded before the meshes using them
+	for (Content* stagedContent : stagedContents_)
+	{
+		RegisterContent(stagedContent);
+
+		Image* stagedImage = isPackingImages_ ? dynamic_cast<Image*>(stagedContent) : nullptr;
+		if (stagedImage)
+		{
+			imagesPendingPacking_.push_back(stagedImage);
+		}
+
+		contentUploadQueue_.push_back(stagedContent);
+		contentsPendingUpload_.insert(stagedContent);
+	}
+	stagedContents_.clear();
+	stagedContentPathMap_.clear();
+}
+
+ContentLoadRequest* ResourceManager::RequestContentAsync(const std::string& path, const ContentLoadCallback& callback)
+{
+	const std::string fullPath = ContentDir + path;
+	PinContent(fullPath);
+
+	ContentLoadRequest* request = StartContentLoad(fullPath, nullptr);
+	request->AddCallback(
+		[this](Content* content)
+		{
+			if (content)
+			{
+				PinContentDependencies(content);
+			}
+		});
+
+	request->AddCallback(callback);
+	return request;
+}
+
+ContentLoadRequest* ResourceManager::StartContentLoad(const std::string& fullPath, const ContentLoadCallback& callback)
+{
+	std::unordered_map<std::string, ContentLoadRequest*>::iterator contentLoadRequestIterator = contentLoadRequests_.find(fullPath);
+	if (contentLoadRequestIterator != contentLoadRequests_.end())
+	{
+		contentLoadRequestIterator->second->AddCallback(callback);
+		return contentLoadRequestIterator->second;
+	}
+
+	ContentLoadRequest* request = new ContentLoadRequest(fullPath);
+	contentLoadRequests_[fullPath] = request;
+
+	Content* content = resourceContainer_->GetContent<Content>(fullPath);
+	if (content)
+	{
+		request->content_ = content;
+		request->state_ = ContentLoadState::Loaded;
+		request->AddCallback(callback);
+		return request;
+	}
+
+	request->AddCallback(callback);
+	++pendingContentLoadCount_;
+
+	engine->GetJobManager()->AddJob(
+		[this, request]()
+		{
+			isLoadingContentAsync = true;
+			Content* content = LoadStagedContent(request->path_);
+			isLoadingContentAsync = false;
+
+			std::lock_guard<std::mutex> lock(contentMutex_);
+			decodedContentLoadRequests_.push_back(std::make_pair(request, content));
+		});
+
+	return request;
+}
+
+ContentLoadRequest* ResourceManager::AcquireContent(const std::string& path, const ContentLoadCallback& callback)
+{
+	return AcquireContentAtFullPath(ContentDir + path, callback);
+}
+
+ContentLoadRequest* ResourceManager::AcquireContentAtFullPath(const std::string& fullPath, const ContentLoadCallback& callback)
+{
+	ContentReference& contentReference = contentReferences_[fullPath];
+	++contentReference.referenceCount;
+
+	// Acquiring a content does not pin it, unlike requesting it
+	ContentLoadRequest* request = StartContentLoad(fullPath, nullptr);
+
+	// Evicted images are decoded again and uploaded into the textures they had, evicted meshes take back their data
+	if (request->GetIsDone() && GetIsContentEvicted(contentReference.content))
+	{
+		RestoreContent(request, contentReference.content);
+	}
+
+	if (!contentReference.isResident)
+	{
+		request->AddCallback(
+			[this, fullPath](Content* content)
+			{
+				OnAcquiredContentLoaded(fullPath, content);
+			});
+	}
+	// Images of a content that stayed resident are acquired again with it
+	else if (contentReference.referenceCount == 1)
+	{
+		AcquireContentDependencies(contentReference);
+	}
+
+	request->AddCallback(callback);
+	return request;
+}
+
+void ResourceManager::ReleaseContent(const std::string& path)
+{
+	ReleaseContentAtFullPath(ContentDir + path);
+}
+
+void ResourceManager::ReleaseContentAtFullPath(const std::string& fullPath)
+{
+	std::unordered_map<std::string, ContentReference>::iterator contentReferenceIterator = contentReferences_.find(fullPath);
+	if (contentReferenceIterator == contentReferences_.end() || contentReferenceIterator->second.referenceCount <= 0)
+	{
+		GOKNAR_CORE_WARN("Content({}) is released without being acquired.", fullPath);
+		return;
+	}
+
+	ContentReference& contentReference = contentReferenceIterator->second;
+	--contentReference.referenceCount;
+	if (contentReference.referenceCount == 0)
+	{
+		++contentReference.releaseCount;
+		unreferencedContents_.push_back(std::make_pair(contentReferenceIterator->first, contentReference.releaseCount));
+		isContentEvictionPending_ = true;
+
+		// Released after the content so they are evicted after it
+		ReleaseContentDependencies(contentReference);
+	}
+}
+
+void ResourceManager::AcquireContentDependencies(ContentReference& contentReference)
+{
+	if (!contentReference.acquiredDependencyPaths.empty())
+	{
+		return;
+	}
+
+	GetMaterialImagePaths(contentReference.content, contentReference.acquiredDependencyPaths);
+	for (const std::string& dependencyPath : contentReference.acquiredDependencyPaths)
+	{
+		AcquireContentAtFullPath(dependencyPath, nullptr);
+	}
+}
+
+void ResourceManager::ReleaseContentDependencies(ContentReference& contentReference)
+{
+	std::vector<std::string> dependencyPaths;
+	dependencyPaths.swap(contentReference.acquiredDependencyPaths);
+
+	for (const std::string& dependencyPath : dependencyPaths)
+	{
+		ReleaseContentAtFullPath(dependencyPath);
+	}
+}
+
+int ResourceManager::GetContentReferenceCount(const std::string& path) const
+{
+	std::unordered_map<std::string, ContentReference>::const_iterator contentReferenceIterator = contentReferences_.find(ContentDir + path);
+	return contentReferenceIterator != contentReferences_.end() ? contentReferenceIterator->second.referenceCount : 0;
+}
+
+unsigned long long ResourceManager::GetResidentContentByteCount(const std::string& path) const
+{
+	std::unordered_map<std::string, ContentReference>::const_iterator contentReferenceIterator = contentReferences_.find(ContentDir + path);
+	if (contentReferenceIterator == contentReferences_.end() || !contentReferenceIterator->second.isResident)
+	{
+		return 0;
+	}
+
+	return contentReferenceIterator->second.memoryUsage.GetTotalByteCount();
+}
+
+void ResourceManager::OnAcquiredContentLoaded(const std::string& path, Content* content)
+{
+	ContentReference& contentReference = contentReferences_[path];
+	if (!content || contentReference.isResident)
+	{
+		return;
+	}
+
+	// Evicted meshes are still counted by the copies the renderer keeps
+	residentContentMemoryUsage_.Subtract(contentReference.memoryUsage);
+
+	contentReference.content = content;
+	contentReference.memoryUsage = ContentMemoryUsage();
+	content->GetMemoryUsage(contentReference.memoryUsage);
+	contentReference.isResident = true;
+	residentContentMemoryUsage_.Add(contentReference.memoryUsage);
+	isContentEvictionPending_ = true;
+
+	// Content might be released before its load is finished
+	if (contentReference.referenceCount == 0)
+	{
+		++contentReference.releaseCount;
+		unreferencedContents_.push_back(std::make_pair(path, contentReference.releaseCount));
+		return;
+	}
+
+	AcquireContentDependencies(contentReference);
+}
+
+void ResourceManager::RestoreContent(ContentLoadRequest* request, Content* content)
+{
+	request->state_ = ContentLoadState::Loading;
+	++pendingContentLoadCount_;
+
+	engine->GetJobManager()->AddJob(
+		[this, content]()
+		{
+			// Images the model loaders get while decoding a mesh are found among the registered contents
+			isLoadingContentAsync = true;
+			Content* decodedContent = DecodeContent(content->GetPath());
+			isLoadingContentAsync = false;
+
+			std::lock_guard<std::mutex> lock(contentMutex_);
+			restoredContents_.push_back(std::make_pair(content, decodedContent));
+		});
+}
+
+void ResourceManager::PinContent(const std::string& fullPath)
+{
+	pinnedContentPaths_.insert(fullPath);
+}
+
+void ResourceManager::PinContentDependencies(Content* content)
+{
+	std::vector<std::string> imagePaths;
+	GetMaterialImagePaths(content, imagePaths);
+
+	pinnedContentPaths_.insert(imagePaths.begin(), imagePaths.end());
+}
+
+void ResourceManager::EvictUnreferencedContents()
+{
+	std::unique_lock<std::mutex> lock(contentMutex_);
+
+	// Contents that would not bring anything over budget back under it keep their place in the queue
+	std::deque<std::pair<std::string, unsigned int>> keptContents;
+
+	while (GetIsOverContentMemoryBudget() && !unreferencedContents_.empty())
+	{
+		std::pair<std::string, unsigned int> unreferencedContent = unreferencedContents_.front();
+		unreferencedContents_.pop_front();
+
+		// Content is acquired again or released again later
+		ContentReference& contentReference = contentReferences_[unreferencedContent.first];
+		if (0 < contentReference.referenceCount || contentReference.releaseCount != unreferencedContent.second || !contentReference.isResident)
+		{
+			continue;
+		}
+
+		if (pinnedContentPaths_.find(unreferencedContent.first) != pinnedContentPaths_.end())
+		{
+			continue;
+		}
+
+		if (!GetIsEvictionUseful(contentReference.memoryUsage) || !EvictContent(contentReference.content))
+		{
+			keptContents.push_back(std::move(unreferencedContent));
+			continue;
+		}
+
+		// Evicted meshes keep counting their copies on the GPU
+		contentReference.isResident = false;
+		residentContentMemoryUsage_.Subtract(contentReference.memoryUsage);
+		contentReference.memoryUsage = ContentMemoryUsage();
+		contentReference.content->GetMemoryUsage(contentReference.memoryUsage);
+		residentContentMemoryUsage_.Add(contentReference.memoryUsage);
+	}
+
+	unreferencedContents_.insert(unreferencedContents_.begin(), keptContents.begin(), keptContents.end());
+	lock.unlock();
+
+	// Copies of the meshes on the GPU, skeletal meshes and animations cannot be evicted, so exceeding the budgets because of them is only reported
+	for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+	{
+		const ContentMemoryCategory category = (ContentMemoryCategory)categoryIndex;
+		const unsigned int categoryBit = 1u << categoryIndex;
+		if (residentContentMemoryUsage_.GetByteCount(category) <= contentMemoryBudgets_[categoryIndex])
+		{
+			warnedContentMemoryCategoryBits_ &= ~categoryBit;
+		}
+		else if (!(warnedContentMemoryCategoryBits_ & categoryBit))
+		{
+			warnedContentMemoryCategoryBits_ |= categoryBit;
+			GOKNAR_CORE_WARN("Resident contents of memory category {} use {} bytes, more than the budget of {} bytes.",
+				categoryIndex, residentContentMemoryUsage_.GetByteCount(category), contentMemoryBudgets_[categoryIndex]);
+		}
+	}
+}
+
+bool ResourceManager::GetIsOverContentMemoryBudget() const
+{
+	if (contentMemoryBudget_ < residentContentMemoryUsage_.GetTotalByteCount())
+	{
+		return true;
+	}
+
+	for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+	{
+		if (contentMemoryBudgets_[categoryIndex] < residentContentMemoryUsage_.GetByteCount((ContentMemoryCategory)categoryIndex))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ResourceManager::GetIsEvictionUseful(const ContentMemoryUsage& memoryUsage) const
+{
+	if (contentMemoryBudget_ < residentContentMemoryUsage_.GetTotalByteCount())
+	{
+		return true;
+	}
+
+	for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+	{
+		const ContentMemoryCategory category = (ContentMemoryCategory)categoryIndex;
+		if (0 < memoryUsage.GetByteCount(category) && contentMemoryBudgets_[categoryIndex] < residentContentMemoryUsage_.GetByteCount(category))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ContentMemoryUsage ResourceManager::GetContentMemoryUsage() const
+{
+	ContentMemoryUsage memoryUsage;
+	for (const auto& contentPathPair : resourceContainer_->contentPathMap_)
+	{
+		contentPathPair.second->GetMemoryUsage(memoryUsage);
+	}
+
+	return memoryUsage;
+}
+
+std::vector<ContentMemoryReportEntry> ResourceManager::GetTopContentMemoryConsumers(int count) const
+{
+	std::vector<ContentMemoryReportEntry> reportEntries;
+	reportEntries.reserve(resourceContainer_->contentPathMap_.size());
+
+	for (const auto& contentPathPair : resourceContainer_->contentPathMap_)
+	{
+		ContentMemoryReportEntry reportEntry;
+		reportEntry.path = contentPathPair.first;
+		contentPathPair.second->GetMemoryUsage(reportEntry.memoryUsage);
+
+		std::unordered_map<std::string, ContentReference>::const_iterator contentReferenceIterator = contentReferences_.find(contentPathPair.first);
+		if (contentReferenceIterator != contentReferences_.end())
+		{
+			reportEntry.referenceCount = contentReferenceIterator->second.referenceCount;
+		}
+
+		reportEntries.push_back(std::move(reportEntry));
+	}
+
+	const int topCount = std::max(0, std::min(count, (int)reportEntries.size()));
+	std::partial_sort(reportEntries.begin(), reportEntries.begin() + topCount, reportEntries.end(),
+		[](const ContentMemoryReportEntry& a, const ContentMemoryReportEntry& b)
+		{
+			return b.memoryUsage.GetTotalByteCount() < a.memoryUsage.GetTotalByteCount();
+		});
+	reportEntries.resize(topCount);
+
+	return reportEntries;
+}
+
+void ResourceManager::LogContentMemoryReport(int count) const
+{
+	static const char* categoryNames[(int)ContentMemoryCategory::Count] = { "Textures", "Meshes", "Animations" };
+	constexpr float bytesPerMegabyte = 1024.f * 1024.f;
+
+	const ContentMemoryUsage memoryUsage = GetContentMemoryUsage();
+	GOKNAR_CORE_INFO("Content memory: {:.2f} MB CPU, {:.2f} MB GPU, {:.2f} MB resident acquired",
+		memoryUsage.GetCPUByteCount() / bytesPerMegabyte, memoryUsage.GetGPUByteCount() / bytesPerMegabyte, GetResidentContentByteCount() / bytesPerMegabyte);
+
+	for (int categoryIndex = 0; categoryIndex < (int)ContentMemoryCategory::Count; ++categoryIndex)
+	{
+		GOKNAR_CORE_INFO("\t{}: {:.2f} MB CPU, {:.2f} MB GPU",
+			categoryNames[categoryIndex], memoryUsage.cpuByteCounts[categoryIndex] / bytesPerMegabyte, memoryUsage.gpuByteCounts[categoryIndex] / bytesPerMegabyte);
+	}
+
+	for (const ContentMemoryReportEntry& reportEntry : GetTopContentMemoryConsumers(count))
+	{
+		GOKNAR_CORE_INFO("\t{:.2f} MB CPU, {:.2f} MB GPU, {} references: {}",
+			reportEntry.memoryUsage.GetCPUByteCount() / bytesPerMegabyte, reportEntry.memoryUsage.GetGPUByteCount() / bytesPerMegabyte, reportEntry.referenceCount, reportEntry.path);
+	}
+}
+
+void ResourceManager::ProcessContentLoads()
+{
+	if (isContentEvictionPending_)
+	{
+		isContentEvictionPending_ = false;
+		EvictUnreferencedContents();
+	}
+
+	if (pendingContentLoadCount_ == 0)
+	{
+		return;
+	}
+
+	// Decoded requests are taken together with the staged contents, so contents of the taken requests are always registered
+	std::vector<std::pair<ContentLoadRequest*, Content*>> decodedContentLoadRequests;
+	std::vector<std::pair<Content*, Content*>> restoredContents;
+	{
+		std::lock_guard<std::mutex> lock(contentMutex_);
+		decodedContentLoadRequests.swap(decodedContentLoadRequests_);
+		restoredContents.swap(restoredContents_);
+		RegisterStagedContentsLocked();
+	}
+
+	for (const std::pair<Content*, Content*>& restoredContent : restoredContents)
+	{
+		Content* content = restoredContent.first;
+		Content* decodedContent = restoredContent.second;
+
+		ContentLoadRequest* request = contentLoadRequests_[content->GetPath()];
+
+		Image* image = dynamic_cast<Image*>(content);
+		Image* decodedImage = dynamic_cast<Image*>(decodedContent);
+		if (image && decodedImage)
+		{
+			image->Restore(decodedImage);
+			delete decodedImage;
+
+			request->state_ = ContentLoadState::Uploading;
+			contentUploadQueue_.push_back(image);
+			contentsPendingUpload_.insert(image);
+			continue;
+		}
+
+		MeshUnit* mesh = dynamic_cast<MeshUnit*>(content);
+		MeshUnit* decodedMesh = dynamic_cast<MeshUnit*>(decodedContent);
+		if (mesh && decodedMesh)
+		{
+			mesh->RestoreData(decodedMesh);
+
+			// Mesh keeps the material it is rendered with, the one built for the decoded copy is registered by now
+			Material* decodedMaterial = decodedMesh->GetMaterial();
+			if (decodedMaterial)
+			{
+				materials_.erase(std::remove(materials_.begin(), materials_.end(), decodedMaterial), materials_.end());
+				delete decodedMaterial;
+			}
+			delete decodedMesh;
+
+			CompleteContentLoadRequest(request, mesh);
+			continue;
+		}
+
+		delete decodedContent;
+		CompleteContentLoadRequest(request, nullptr);
+	}
+
+	for (const std::pair<ContentLoadRequest*, Content*>& decodedContentLoadRequest : decodedContentLoadRequests)
+	{
+		ContentLoadRequest* request = decodedContentLoadRequest.first;
+		Content* content = decodedContentLoadRequest.second;
+
+		if (content && contentsPendingUpload_.find(content) != contentsPendingUpload_.end())
+		{
+			request->content_ = content;
+			request->state_ = ContentLoadState::Uploading;
+		}
+		else
+		{
+			CompleteContentLoadRequest(request, content);
+		}
+	}
+
+	// Contents are initialized with the rest of the container if the resource manager is not initialized yet
+	// Headless engines initialize only the mesh data, images have no GL context to be uploaded to
+	const bool canUploadContents = isInitialized_;
+	const bool canUploadImages = canUploadContents && !engine->GetIsHeadless();
+
+	// Images of the resource container are packed by its initialization
+	if (!imagesPendingPacking_.empty())
+	{
+		if (canUploadImages)
+		{
+			TexturePacker::PackImages(imagesPendingPacking_, prebuiltTextureAtlases_);
+		}
+		imagesPendingPacking_.clear();
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+	while (!contentUploadQueue_.empty())
+	{
+		Content* content = contentUploadQueue_.front();
+		contentUploadQueue_.pop_front();
+
+		if (canUploadImages || (canUploadContents && !dynamic_cast<Image*>(content)))
+		{
+			content->PreInit();
+			content->Init();
+			content->PostInit();
+		}
+		contentsPendingUpload_.erase(content);
+
+		std::unordered_map<std::string, ContentLoadRequest*>::iterator contentLoadRequestIterator = contentLoadRequests_.find(content->GetPath());
+		if (contentLoadRequestIterator != contentLoadRequests_.end() && contentLoadRequestIterator->second->state_ == ContentLoadState::Uploading)
+		{
+			CompleteContentLoadRequest(contentLoadRequestIterator->second, content);
+		}
+
+		// Budget is checked after the upload so at least one content is uploaded every frame
+		const float elapsedTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+		if (contentUploadTimeBudget_ <= elapsedTime)
+		{
+			break;
+		}
+	}
+}
+
+void ResourceManager::CompleteContentLoadRequest(ContentLoadRequest* request, Content* content)
+{
+	--pendingContentLoadCount_;
+
+	request->content_ = content;
+	if (content)
+	{
+		request->state_ = ContentLoadState::Loaded;
+	}
+	else
+	{
+		request->state_ = ContentLoadState::Failed;
+		GOKNAR_CORE_WARN("Content({}) could not be loaded.", request->path_);
+	}
+
+	std::vector<ContentLoadCallback> callbacks;
+	callbacks.swap(request->callbacks_);
+	for (const ContentLoadCallback& callback : callbacks)
+	{
+		callback(content);
+	}
+}
+
 ResourceContainer::ResourceContainer()
 {
 }
@@ -130,9 +1026,15 @@ ResourceContainer::~ResourceContainer()
 
 void ResourceContainer::PreInit()
 {
-	for (Image* image : imageArray_)
+	// Headless engines have no GL context for the images and the materials
+	if (!engine->GetIsHeadless())
 	{
-		image->PreInit();
+		for (Image* image : imageArray_)
+		{
+			image->PreInit();
+		}
+
+		BuildMeshMaterials();
 	}
 
 	for (MeshUnit* mesh : meshArray_)
@@ -146,11 +1048,40 @@ void ResourceContainer::PreInit()
 	}
 }
 
+void ResourceContainer::BuildMeshMaterials()
+{
+	std::vector<Material*> materials;
+	for (MeshUnit* mesh : meshArray_)
+	{
+		Material* material = mesh->GetMaterial();
+		if (material && !material->GetIsBuilt())
+		{
+			material->CreateShaders(mesh);
+			materials.push_back(material);
+		}
+	}
+
+	// Instance is created here since creating it on the workers would race
+	ShaderBuilderNew::GetInstance();
+
+	engine->GetJobManager()->ParallelFor((int)materials.size(), 1,
+		[&materials](int beginIndex, int endIndex)
+		{
+			for (int materialIndex = beginIndex; materialIndex < endIndex; ++materialIndex)
+			{
+				materials[materialIndex]->BuildShaderScripts();
+			}
+		});
+}
+
 void ResourceContainer::Init()
 {
-	for (Image* image : imageArray_)
+	if (!engine->GetIsHeadless())
 	{
-		image->Init();
+		for (Image* image : imageArray_)
+		{
+			image->Init();
+		}
 	}
 
 	for (MeshUnit* mesh : meshArray_)
@@ -166,9 +1097,12 @@ void ResourceContainer::Init()
 
 void ResourceContainer::PostInit()
 {
-	for (Image* image : imageArray_)
+	if (!engine->GetIsHeadless())
 	{
-		image->PostInit();
+		for (Image* image : imageArray_)
+		{
+			image->PostInit();
+		}
 	}
 
 	for (MeshUnit* mesh : meshArray_)
@@ -216,11 +1150,11 @@ ResourceType ResourceManagerUtils::GetResourceType(const std::string& path)
 		extension.begin(),
 		[](unsigned char c) { return std::tolower(c); });
 
-	if (extension == "jpg" || extension == "png")
+	if (extension == "jpg" || extension == "png" || extension == COOKED_TEXTURE_EXTENSION)
 	{
 		return ResourceType::Image;
 	}
-	else if (extension == "fbx")
+	else if (extension == "fbx" || extension == COOKED_MESH_EXTENSION)
 	{
 		return ResourceType::Model;
 	}
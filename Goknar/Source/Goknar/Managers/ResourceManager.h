@@ -2,14 +2,22 @@
 #define __RESOURCEMANAGER_H__
 
 #include "Core.h"
+#include "Contents/Content.h"
 
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 class Audio;
-class Content;
 class Material;
 class MeshUnit;
 class Image;
+class PrebuiltTextureAtlases;
 
 enum class GOKNAR_API ResourceType : unsigned char
 {
@@ -100,6 +108,9 @@ public:
 protected:
 
 private:
+	// Shader scripts of the mesh materials are generated on the worker threads before the meshes submit their programs
+	void BuildMeshMaterials();
+
 	std::map<std::string, Content*> contentPathMap_;
 
 	std::vector<Image*> imageArray_;
@@ -107,6 +118,123 @@ private:
 	std::vector<Audio*> audioArray_;
 };
 
+enum class GOKNAR_API ContentLoadState : unsigned char
+{
+	Loading = 0,
+	Uploading,
+	Loaded,
+	Failed
+};
+
+using ContentLoadCallback = std::function<void(Content* content)>;
+
+// Handle of an asynchronous content load, owned by the resource manager
+class GOKNAR_API ContentLoadRequest
+{
+	friend class ResourceManager;
+
+public:
+	// Callbacks are called on the main thread, immediately if the request is already done
+	void AddCallback(const ContentLoadCallback& callback);
+
+	const std::string& GetPath() const
+	{
+		return path_;
+	}
+
+	ContentLoadState GetState() const
+	{
+		return state_;
+	}
+
+	bool GetIsDone() const
+	{
+		return state_ == ContentLoadState::Loaded || state_ == ContentLoadState::Failed;
+	}
+
+	template<class T = Content>
+	T* GetContent() const
+	{
+		return dynamic_cast<T*>(content_);
+	}
+
+private:
+	ContentLoadRequest(const std::string& path) :
+		path_(path)
+	{
+	}
+
+	std::vector<ContentLoadCallback> callbacks_;
+	std::string path_;
+	Content* content_{ nullptr };
+	ContentLoadState state_{ ContentLoadState::Loading };
+};
+
+// Keeps a content acquired from the resource manager while the handle or one of its copies is alive
+// Handles must be reset before the engine is destroyed
+class GOKNAR_API ContentHandle
+{
+public:
+	ContentHandle() = default;
+	// Path is relative to the content directory
+	explicit ContentHandle(const std::string& path, const ContentLoadCallback& callback = nullptr);
+	ContentHandle(const ContentHandle& other);
+	ContentHandle(ContentHandle&& other) noexcept;
+	~ContentHandle();
+
+	ContentHandle& operator=(const ContentHandle& other);
+	ContentHandle& operator=(ContentHandle&& other) noexcept;
+
+	// Releases the content
+	void Reset();
+
+	bool GetIsValid() const
+	{
+		return request_ != nullptr;
+	}
+
+	const std::string& GetPath() const
+	{
+		return path_;
+	}
+
+	ContentLoadRequest* GetRequest() const
+	{
+		return request_;
+	}
+
+	// nullptr until the content is loaded
+	template<class T = Content>
+	T* GetContent() const
+	{
+		return request_ ? request_->GetContent<T>() : nullptr;
+	}
+
+private:
+	std::string path_;
+	ContentLoadRequest* request_{ nullptr };
+};
+
+struct GOKNAR_API ContentMemoryReportEntry
+{
+	std::string path;
+	ContentMemoryUsage memoryUsage;
+	int referenceCount{ 0 };
+};
+
+// Reference count and residency of a content acquired by AcquireContent
+struct ContentReference
+{
+	Content* content{ nullptr };
+	ContentMemoryUsage memoryUsage;
+	// Incremented on every release, outdated entries of the unreferenced content queue are skipped with it
+	unsigned int releaseCount{ 0 };
+	int referenceCount{ 0 };
+	bool isResident{ false };
+	// Full paths of the images the material of a mesh uses, acquired while the mesh is referenced and resident
+	std::vector<std::string> acquiredDependencyPaths;
+};
+
 class GOKNAR_API ResourceManager
 {
 public:
@@ -125,36 +253,157 @@ public:
 	template <class T>
 	T* GetContent(const std::string& path)
 	{
-		std::string fullPath = ContentDir + path;
-
-		T* content = resourceContainer_->GetContent<T>(fullPath);
-		if (content)
-		{
-			return content;
-		}
-
-		return dynamic_cast<T*>(LoadContent(fullPath));
+		return dynamic_cast<T*>(FindOrLoadContent(ContentDir + path));
 	}
 
 #if defined(GOKNAR_BUILD_DEBUG)
 	template <class T>
 	T* GetEngineContent(const std::string& path)
 	{
-		std::string fullPath = EngineContentDir + path;
+		return dynamic_cast<T*>(FindOrLoadContent(EngineContentDir + path));
+	}
+#endif
 
-		T* content = resourceContainer_->GetContent<T>(fullPath);
-		if (content)
-		{
-			return content;
-		}
+	// Content is decoded on the job manager's worker threads and its GPU resources are created by ProcessContentLoads on the main thread
+	// Requests of the same path share the same handle
+	ContentLoadRequest* RequestContentAsync(const std::string& path, const ContentLoadCallback& callback = nullptr);
+
+	// Registers the decoded contents, uploads them within the time budget and calls the callbacks of the finished requests
+	// Called by the engine once per frame
+	void ProcessContentLoads();
+
+	// Acquired contents are reference counted and loaded like RequestContentAsync, ContentHandle acquires and releases them automatically
+	// Released contents stay resident until the acquired contents exceed the memory budget or one of the category budgets,
+	// then the least recently released ones in the categories over budget are evicted
+	// Evicted images release the storage of their textures on the GPU and are decoded again when they are acquired again
+	// Images of the material of an acquired mesh are acquired with the mesh and released with it
+	// Images requested by GetContent or RequestContentAsync, directly or through a mesh, are never evicted
+	// since materials outside the acquired contents might still use them
+	// Evicted static meshes free their vertices and faces on the CPU and the convex hulls the physics shape cache built from them,
+	// they are decoded again when they are acquired again
+	// Their copies on the GPU stay since the vertex and index buffers of the renderer only grow, skeletal meshes and animations are never evicted
+	ContentLoadRequest* AcquireContent(const std::string& path, const ContentLoadCallback& callback = nullptr);
+	void ReleaseContent(const std::string& path);
+
+	// Loaded content of an acquired path, nullptr otherwise
+	// Unlike GetContent, it neither loads nor pins the content, so the content can still be evicted once it is released
+	template <class T>
+	T* GetAcquiredContent(const std::string& path) const
+	{
+		return dynamic_cast<T*>(FindAcquiredContent(ContentDir + path));
+	}
 
-		return dynamic_cast<T*>(LoadContent(fullPath));
+	int GetContentReferenceCount(const std::string& path) const;
+
+	// Bytes of the acquired content if it is resident, 0 otherwise
+	unsigned long long GetResidentContentByteCount(const std::string& path) const;
+
+	// Bytes of all resident acquired contents, referenced or not, and of the copies the renderer keeps of the evicted meshes
+	unsigned long long GetResidentContentByteCount() const
+	{
+		return residentContentMemoryUsage_.GetTotalByteCount();
 	}
-#endif
 
-	void AddMaterial(Material* material)
+	// CPU and GPU bytes of the resident acquired contents in the category
+	unsigned long long GetResidentContentByteCount(ContentMemoryCategory category) const
 	{
-		materials_.push_back(material);
+		return residentContentMemoryUsage_.GetByteCount(category);
+	}
+
+	void SetContentMemoryBudget(unsigned long long contentMemoryBudget)
+	{
+		contentMemoryBudget_ = contentMemoryBudget;
+		isContentEvictionPending_ = true;
+	}
+
+	unsigned long long GetContentMemoryBudget() const
+	{
+		return contentMemoryBudget_;
+	}
+
+	// Categories are not limited by default, only by the total budget
+	void SetContentMemoryBudget(ContentMemoryCategory category, unsigned long long contentMemoryBudget)
+	{
+		contentMemoryBudgets_[(int)category] = contentMemoryBudget;
+		isContentEvictionPending_ = true;
+	}
+
+	unsigned long long GetContentMemoryBudget(ContentMemoryCategory category) const
+	{
+		return contentMemoryBudgets_[(int)category];
+	}
+
+	// Memory usage of every content of the resource container, acquired or not
+	ContentMemoryUsage GetContentMemoryUsage() const;
+
+	// Contents of the resource container with the most CPU and GPU bytes, the largest first
+	std::vector<ContentMemoryReportEntry> GetTopContentMemoryConsumers(int count) const;
+
+	// Logs the totals per category and the top consumers
+	void LogContentMemoryReport(int count = 10) const;
+
+	int GetPendingContentLoadCount() const
+	{
+		return pendingContentLoadCount_;
+	}
+
+	void SetContentUploadTimeBudget(float contentUploadTimeBudget)
+	{
+		contentUploadTimeBudget_ = contentUploadTimeBudget;
+	}
+
+	float GetContentUploadTimeBudget() const
+	{
+		return contentUploadTimeBudget_;
+	}
+
+	void AddMaterial(Material* material);
+
+	// Loaded images build their mip chains on the loading threads and their textures stream the finer levels on demand
+	// Must be set before the images are loaded
+	void SetIsPrecomputingImageMipmaps(bool isPrecomputingImageMipmaps)
+	{
+		isPrecomputingImageMipmaps_ = isPrecomputingImageMipmaps;
+	}
+
+	bool GetIsPrecomputingImageMipmaps() const
+	{
+		return isPrecomputingImageMipmaps_;
+	}
+
+	// Images loaded before PreInit are packed into atlases and array textures instead of getting a texture each
+	void SetIsPackingImages(bool isPackingImages)
+	{
+		isPackingImages_ = isPackingImages;
+	}
+
+	bool GetIsPackingImages() const
+	{
+		return isPackingImages_;
+	}
+
+	// Images listed in the manifest are drawn from the atlases GoknarAtlasPacker built for them instead of being packed at runtime
+	// Path is relative to the content directory, manifests are loaded before PreInit
+	// Without one, Atlas.gkatlas in the content directory is loaded by PreInit if it exists and images are packed
+	bool LoadTextureAtlasManifest(const std::string& path);
+
+	// Decoded bytes include the precomputed mip levels
+	unsigned long long GetDecodedImageByteCount() const
+	{
+		return decodedImageByteCount_;
+	}
+
+	// Sum of the decoding times of all loading threads
+	float GetImageDecodeTime() const
+	{
+		return imageDecodeTimeInNanoseconds_ * 0.000000001f;
+	}
+
+	// MB/s of a single loading thread
+	float GetImageDecodeRate() const
+	{
+		const float imageDecodeTime = GetImageDecodeTime();
+		return 0.f < imageDecodeTime ? decodedImageByteCount_ / (imageDecodeTime * 1000000.f) : 0.f;
 	}
 
 	const std::vector<Material*>& GetMaterials() const
@@ -168,11 +417,90 @@ public:
 	}
 
 private:
+	Content* FindOrLoadContent(const std::string& path);
+	Content* FindAcquiredContent(const std::string& fullPath) const;
 	Content* LoadContent(const std::string& path);
+	Content* LoadStagedContent(const std::string& path);
+	Content* DecodeContent(const std::string& path);
+
+	ContentLoadRequest* StartContentLoad(const std::string& fullPath, const ContentLoadCallback& callback);
+
+	ContentLoadRequest* AcquireContentAtFullPath(const std::string& fullPath, const ContentLoadCallback& callback);
+	void ReleaseContentAtFullPath(const std::string& fullPath);
+	void AcquireContentDependencies(ContentReference& contentReference);
+	void ReleaseContentDependencies(ContentReference& contentReference);
+
+	// Marks the content as used outside the acquired contents so it is never evicted
+	void PinContent(const std::string& fullPath);
+	void PinContentDependencies(Content* content);
+
+	void RegisterContent(Content* content);
+
+	// Must be called with contentMutex_ locked
+	Content* FindContentLocked(const std::string& path);
+	void RegisterStagedContentsLocked();
+
+	void CompleteContentLoadRequest(ContentLoadRequest* request, Content* content);
+
+	void OnAcquiredContentLoaded(const std::string& path, Content* content);
+	void RestoreContent(ContentLoadRequest* request, Content* content);
+	void EvictUnreferencedContents();
+	bool GetIsOverContentMemoryBudget() const;
+	// Whether evicting a content with the memory usage brings the total or one of the categories closer to its budget
+	bool GetIsEvictionUseful(const ContentMemoryUsage& memoryUsage) const;
 
 	std::vector<Material*> materials_;
 
 	ResourceContainer* resourceContainer_;
+
+	PrebuiltTextureAtlases* prebuiltTextureAtlases_;
+
+	// Only the main thread writes to the resource container, it locks the mutex while doing so since the loading jobs read from it
+	// Contents and materials created by the loading jobs are staged under the same mutex until the main thread registers them
+	std::mutex contentMutex_;
+	std::vector<Content*> stagedContents_;
+	std::unordered_map<std::string, Content*> stagedContentPathMap_;
+	std::vector<Material*> stagedMaterials_;
+	std::vector<std::pair<ContentLoadRequest*, Content*>> decodedContentLoadRequests_;
+
+	// Contents and images used outside the acquired contents, only the main thread pins contents
+	std::unordered_set<std::string> pinnedContentPaths_;
+
+	std::unordered_map<std::string, ContentLoadRequest*> contentLoadRequests_;
+
+	// Evicted contents and their decoded copies, written by the loading jobs under contentMutex_
+	std::vector<std::pair<Content*, Content*>> restoredContents_;
+
+	std::unordered_map<std::string, ContentReference> contentReferences_;
+	// Paths of the released contents in release order with their release counts
+	std::deque<std::pair<std::string, unsigned int>> unreferencedContents_;
+
+	std::deque<Content*> contentUploadQueue_;
+	std::unordered_set<const Content*> contentsPendingUpload_;
+
+	// Images registered since the last upload, packed together before they are uploaded
+	std::vector<Image*> imagesPendingPacking_;
+
+	std::atomic<unsigned long long> decodedImageByteCount_{ 0 };
+	std::atomic<long long> imageDecodeTimeInNanoseconds_{ 0 };
+
+	ContentMemoryUsage residentContentMemoryUsage_;
+	unsigned long long contentMemoryBudget_{ 512ull * 1024 * 1024 };
+	unsigned long long contentMemoryBudgets_[(int)ContentMemoryCategory::Count]{ ULLONG_MAX, ULLONG_MAX, ULLONG_MAX };
+
+	// Bits of the categories over budget that are already warned about
+	unsigned int warnedContentMemoryCategoryBits_{ 0 };
+
+	int pendingContentLoadCount_{ 0 };
+
+	// Time in seconds content uploads can use per frame
+	float contentUploadTimeBudget_{ 0.004f };
+
+	bool isInitialized_{ false };
+	// Set when the resident contents or the budgets change
+	bool isContentEvictionPending_{ false };
+	bool isPrecomputingImageMipmaps_{ false };
+	bool isPackingImages_{ false };
 };
 
 #endif
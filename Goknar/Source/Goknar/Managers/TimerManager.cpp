@@ -0,0 +1,253 @@
+#include "pch.h"
+
+#include "TimerManager.h"
+
+#include "Goknar/TimeDependentObject.h"
+#include "Goknar/Timer.h"
+
+TimerManager::TimerManager()
+{
+	for (int level = 0; level < TIMER_WHEEL_LEVEL_COUNT; ++level)
+	{
+		for (int slotIndex = 0; slotIndex < TIMER_WHEEL_SLOT_COUNT; ++slotIndex)
+		{
+			slots_[level][slotIndex] = nullptr;
+		}
+	}
+}
+
+TimerManager::~TimerManager()
+{
+	// Remaining timers and objects must not try to remove themselves from a destroyed manager
+	for (int level = 0; level < TIMER_WHEEL_LEVEL_COUNT; ++level)
+	{
+		for (int slotIndex = 0; slotIndex < TIMER_WHEEL_SLOT_COUNT; ++slotIndex)
+		{
+			while (slots_[level][slotIndex])
+			{
+				UnlinkTimer(slots_[level][slotIndex]);
+			}
+		}
+	}
+
+	for (TimeDependentObject* timeDependentObject : timeDependentObjects_)
+	{
+		if (timeDependentObject)
+		{
+			timeDependentObject->timeDependentObjectIndex_ = -1;
+		}
+	}
+}
+
+void TimerManager::Tick(float deltaTime)
+{
+	currentTime_ += deltaTime;
+	targetWheelTick_ = (uint64_t)(currentTime_ / TIMER_WHEEL_RESOLUTION);
+
+	while (currentWheelTick_ < targetWheelTick_)
+	{
+		++currentWheelTick_;
+
+		// Whenever a level completes a turn the next slot of the level above is spread into the lower levels
+		for (int level = 1; level < TIMER_WHEEL_LEVEL_COUNT; ++level)
+		{
+			const uint64_t levelMask = (1ull << (level * TIMER_WHEEL_SLOT_BITS)) - 1;
+			if ((currentWheelTick_ & levelMask) != 0)
+			{
+				break;
+			}
+
+			CascadeSlot(level, (int)((currentWheelTick_ >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK));
+		}
+
+		FireDueTimers();
+	}
+
+	isTickingTimeDependentObjects_ = true;
+
+	// Objects added during the pass are ticked starting from the next frame
+	const int timeDependentObjectCount = (int)timeDependentObjects_.size();
+	for (int timeDependentObjectIndex = 0; timeDependentObjectIndex < timeDependentObjectCount; ++timeDependentObjectIndex)
+	{
+		TimeDependentObject* timeDependentObject = timeDependentObjects_[timeDependentObjectIndex];
+		if (timeDependentObject && timeDependentObject->GetIsActive())
+		{
+			timeDependentObject->Tick(deltaTime);
+		}
+	}
+
+	isTickingTimeDependentObjects_ = false;
+
+	// Objects removed during the pass are left as null entries, compact them keeping the order
+	if (0 < removedTimeDependentObjectCount_)
+	{
+		int aliveTimeDependentObjectCount = 0;
+		for (TimeDependentObject* timeDependentObject : timeDependentObjects_)
+		{
+			if (timeDependentObject)
+			{
+				timeDependentObject->timeDependentObjectIndex_ = aliveTimeDependentObjectCount;
+				timeDependentObjects_[aliveTimeDependentObjectCount] = timeDependentObject;
+				++aliveTimeDependentObjectCount;
+			}
+		}
+
+		timeDependentObjects_.resize(aliveTimeDependentObjectCount);
+		removedTimeDependentObjectCount_ = 0;
+	}
+}
+
+void TimerManager::AddTimeDependentObject(TimeDependentObject* timeDependentObject)
+{
+	if (0 <= timeDependentObject->timeDependentObjectIndex_)
+	{
+		return;
+	}
+
+	timeDependentObject->timeDependentObjectIndex_ = (int)timeDependentObjects_.size();
+	timeDependentObjects_.push_back(timeDependentObject);
+}
+
+void TimerManager::RemoveTimeDependentObject(TimeDependentObject* timeDependentObject)
+{
+	const int timeDependentObjectIndex = timeDependentObject->timeDependentObjectIndex_;
+	if (timeDependentObjectIndex < 0)
+	{
+		return;
+	}
+
+	timeDependentObject->timeDependentObjectIndex_ = -1;
+
+	if (isTickingTimeDependentObjects_)
+	{
+		timeDependentObjects_[timeDependentObjectIndex] = nullptr;
+		++removedTimeDependentObjectCount_;
+		return;
+	}
+
+	TimeDependentObject* lastTimeDependentObject = timeDependentObjects_.back();
+	timeDependentObjects_[timeDependentObjectIndex] = lastTimeDependentObject;
+	lastTimeDependentObject->timeDependentObjectIndex_ = timeDependentObjectIndex;
+	timeDependentObjects_.pop_back();
+}
+
+void TimerManager::ScheduleTimer(Timer* timer, float delayInSeconds)
+{
+	CancelTimer(timer);
+	ScheduleTimerAt(timer, currentTime_ + delayInSeconds);
+}
+
+void TimerManager::CancelTimer(Timer* timer)
+{
+	if (timer->scheduledListHead_)
+	{
+		UnlinkTimer(timer);
+		--scheduledTimerCount_;
+	}
+}
+
+void TimerManager::ScheduleTimerAt(Timer* timer, double dueTime)
+{
+	timer->dueTime_ = dueTime;
+
+	// A timer fires at most once per frame, so it is never put into a slot that is processed this frame
+	const uint64_t dueWheelTick = (uint64_t)(dueTime / TIMER_WHEEL_RESOLUTION);
+	timer->dueWheelTick_ = targetWheelTick_ < dueWheelTick ? dueWheelTick : targetWheelTick_ + 1;
+
+	InsertTimer(timer);
+	++scheduledTimerCount_;
+}
+
+void TimerManager::InsertTimer(Timer* timer)
+{
+	const uint64_t wheelTickDelta = timer->dueWheelTick_ - currentWheelTick_;
+
+	for (int level = 0; level < TIMER_WHEEL_LEVEL_COUNT - 1; ++level)
+	{
+		if (wheelTickDelta < (1ull << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+		{
+			const int slotIndex = (int)((timer->dueWheelTick_ >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK);
+			LinkTimer(slots_[level][slotIndex], timer);
+			return;
+		}
+	}
+
+	// Timers beyond the range of the wheel wait in the farthest slot of the last level and get reinserted on its cascade
+	constexpr int lastLevel = TIMER_WHEEL_LEVEL_COUNT - 1;
+	constexpr uint64_t maxWheelTickDelta = (1ull << (TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_BITS)) - 1;
+
+	const uint64_t slotWheelTick = wheelTickDelta < maxWheelTickDelta ? timer->dueWheelTick_ : currentWheelTick_ + maxWheelTickDelta;
+	const int slotIndex = (int)((slotWheelTick >> (lastLevel * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK);
+	LinkTimer(slots_[lastLevel][slotIndex], timer);
+}
+
+void TimerManager::CascadeSlot(int level, int slotIndex)
+{
+	Timer* timer = slots_[level][slotIndex];
+	slots_[level][slotIndex] = nullptr;
+
+	while (timer)
+	{
+		Timer* nextTimer = timer->nextScheduledTimer_;
+
+		timer->nextScheduledTimer_ = nullptr;
+		timer->previousScheduledTimer_ = nullptr;
+		timer->scheduledListHead_ = nullptr;
+
+		InsertTimer(timer);
+
+		timer = nextTimer;
+	}
+}
+
+void TimerManager::FireDueTimers()
+{
+	Timer*& slot = slots_[0][currentWheelTick_ & TIMER_WHEEL_SLOT_MASK];
+
+	// Rescheduled timers always go to a later slot so the loop ends
+	while (slot)
+	{
+		Timer* timer = slot;
+		UnlinkTimer(timer);
+		--scheduledTimerCount_;
+
+		// Next due time is relative to this one so the period does not drift with the frame rate
+		ScheduleTimerAt(timer, timer->dueTime_ + timer->GetTimeToTick());
+
+		timer->Operate();
+	}
+}
+
+void TimerManager::LinkTimer(Timer*& listHead, Timer* timer)
+{
+	timer->previousScheduledTimer_ = nullptr;
+	timer->nextScheduledTimer_ = listHead;
+	if (listHead)
+	{
+		listHead->previousScheduledTimer_ = timer;
+	}
+
+	listHead = timer;
+	timer->scheduledListHead_ = &listHead;
+}
+
+void TimerManager::UnlinkTimer(Timer* timer)
+{
+	if (timer->previousScheduledTimer_)
+	{
+		timer->previousScheduledTimer_->nextScheduledTimer_ = timer->nextScheduledTimer_;
+	}
+	else
+	{
+		*timer->scheduledListHead_ = timer->nextScheduledTimer_;
+	}
+
+	if (timer->nextScheduledTimer_)
+	{
+		timer->nextScheduledTimer_->previousScheduledTimer_ = timer->previousScheduledTimer_;
+	}
+
+	timer->nextScheduledTimer_ = nullptr;
+	timer->previousScheduledTimer_ = nullptr;
+	timer->scheduledListHead_ = nullptr;
+}
@@ -0,0 +1,77 @@
+#ifndef __TIMERMANAGER_H__
+#define __TIMERMANAGER_H__
+
+#include <cstdint>
+#include <vector>
+
+#include "Goknar/Core.h"
+
+class TimeDependentObject;
+class Timer;
+
+// Each wheel level has 64 slots and each slot of a level spans a full turn of the level below it
+constexpr int TIMER_WHEEL_LEVEL_COUNT = 4;
+constexpr int TIMER_WHEEL_SLOT_BITS = 6;
+constexpr int TIMER_WHEEL_SLOT_COUNT = 1 << TIMER_WHEEL_SLOT_BITS;
+constexpr int TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOT_COUNT - 1;
+
+// Duration of a wheel tick in seconds
+constexpr double TIMER_WHEEL_RESOLUTION = 0.001;
+
+// Updates time dependent objects
+// Timers sleep on a hierarchical timer wheel and are only visited when they are due,
+// continuous objects(interpolating values etc.) are kept in a dense array that is ticked in one pass
+class GOKNAR_API TimerManager
+{
+public:
+	TimerManager();
+	~TimerManager();
+
+	void Tick(float deltaTime);
+
+	void AddTimeDependentObject(TimeDependentObject* timeDependentObject);
+	void RemoveTimeDependentObject(TimeDependentObject* timeDependentObject);
+
+	// Timer is fired after delayInSeconds, scheduling an already scheduled timer reschedules it
+	void ScheduleTimer(Timer* timer, float delayInSeconds);
+	void CancelTimer(Timer* timer);
+
+	// Seconds passed on the timer manager's clock, scaled by the engine's time scale
+	double GetCurrentTime() const
+	{
+		return currentTime_;
+	}
+
+	int GetScheduledTimerCount() const
+	{
+		return scheduledTimerCount_;
+	}
+
+	int GetTimeDependentObjectCount() const
+	{
+		return (int)timeDependentObjects_.size() - removedTimeDependentObjectCount_;
+	}
+
+private:
+	void ScheduleTimerAt(Timer* timer, double dueTime);
+	void InsertTimer(Timer* timer);
+	void CascadeSlot(int level, int slotIndex);
+	void FireDueTimers();
+
+	static void LinkTimer(Timer*& listHead, Timer* timer);
+	static void UnlinkTimer(Timer* timer);
+
+	std::vector<TimeDependentObject*> timeDependentObjects_;
+
+	Timer* slots_[TIMER_WHEEL_LEVEL_COUNT][TIMER_WHEEL_SLOT_COUNT];
+
+	double currentTime_{ 0.0 };
+	uint64_t currentWheelTick_{ 0 };
+	uint64_t targetWheelTick_{ 0 };
+
+	int scheduledTimerCount_{ 0 };
+	int removedTimeDependentObjectCount_{ 0 };
+	bool isTickingTimeDependentObjects_{ false };
+};
+
+#endif
@@ -41,6 +41,12 @@ Material::~Material()
 }
 
 void Material::Build(MeshUnit* meshUnit)
+{
+	CreateShaders(meshUnit);
+	BuildShaderScripts();
+}
+
+void Material::CreateShaders(MeshUnit* meshUnit)
 {
 	int ownerMeshBoneCount = 0;
 	if (SkeletalMesh* skeletalMesh = dynamic_cast<SkeletalMesh*>(meshUnit))
@@ -63,61 +69,79 @@ void Material::Build(MeshUnit* meshUnit)
 	std::vector<const Image*>::iterator imageIterator = textureImages_.begin();
 	for (; imageIterator != textureImages_.end(); ++imageIterator)
 	{
-		forwardRenderingShader->AddTexture((*imageIterator)->GetGeneratedTexture());
+		// Images packed into the same texture share a sampler
+		const Texture* texture = (*imageIterator)->GetGeneratedTexture();
+		const std::vector<const Texture*>* shaderTextures = forwardRenderingShader->GetTextures();
+		if (std::find(shaderTextures->begin(), shaderTextures->end(), texture) != shaderTextures->end())
+		{
+			continue;
+		}
+
+		forwardRenderingShader->AddTexture(texture);
 		if(gBufferShader)
 		{
-			gBufferShader->AddTexture((*imageIterator)->GetGeneratedTexture());
+			gBufferShader->AddTexture(texture);
 		}
 	}
 	renderPassTypeShaderMap_[RenderPassType::Forward] = forwardRenderingShader;
-	
+
 	if(gBufferShader)
 	{
 		renderPassTypeShaderMap_[RenderPassType::GeometryBuffer] = gBufferShader;
+	}
+
+	renderPassTypeShaderMap_[RenderPassType::Shadow] = new Shader();
+	renderPassTypeShaderMap_[RenderPassType::PointLightShadow] = new Shader();
+
+	isBuilt_ = true;
+}
+
+void Material::BuildShaderScripts()
+{
+	ShaderBuilderNew* shaderBuilder = ShaderBuilderNew::GetInstance();
 
-		std::string vertexShader = ShaderBuilderNew::GetInstance()->GeometryBufferPass_GetVertexShaderScript(initializationData_, gBufferShader);
+	Shader* gBufferShader = GetShader(RenderPassType::GeometryBuffer);
+	if(gBufferShader)
+	{
+		std::string vertexShader = shaderBuilder->GeometryBufferPass_GetVertexShaderScript(initializationData_, gBufferShader);
 		gBufferShader->SetVertexShaderScript(vertexShader);
 
-		std::string fragmentShader = ShaderBuilderNew::GetInstance()->GeometryBufferPass_GetFragmentShaderScript(initializationData_, gBufferShader);
+		std::string fragmentShader = shaderBuilder->GeometryBufferPass_GetFragmentShaderScript(initializationData_, gBufferShader);
 		gBufferShader->SetFragmentShaderScript(fragmentShader);
 	}
 
+	Shader* forwardRenderingShader = GetShader(RenderPassType::Forward);
 	if (forwardRenderingShader->GetShaderType() == ShaderType::Scene)
 	{
-		std::string vertexShader = ShaderBuilderNew::GetInstance()->ForwardRenderPass_GetVertexShaderScript(initializationData_, forwardRenderingShader);
+		std::string vertexShader = shaderBuilder->ForwardRenderPass_GetVertexShaderScript(initializationData_, forwardRenderingShader);
 		forwardRenderingShader->SetVertexShaderScript(vertexShader);
 
-		std::string fragmentShader = ShaderBuilderNew::GetInstance()->ForwardRenderPass_GetFragmentShaderScript(initializationData_, forwardRenderingShader);
+		std::string fragmentShader = shaderBuilder->ForwardRenderPass_GetFragmentShaderScript(initializationData_, forwardRenderingShader);
 		forwardRenderingShader->SetFragmentShaderScript(fragmentShader);
 	}
 
 	{
-		Shader* shadowShader = new Shader();
+		Shader* shadowShader = GetShader(RenderPassType::Shadow);
 
-		std::string shadowPassVertexShader = ShaderBuilderNew::GetInstance()->ShadowPass_GetVertexShaderScript(initializationData_, shadowShader);
+		std::string shadowPassVertexShader = shaderBuilder->ShadowPass_GetVertexShaderScript(initializationData_, shadowShader);
 		shadowShader->SetVertexShaderScript(shadowPassVertexShader);
 
-		std::string shadowPassFragmentShader = ShaderBuilderNew::GetInstance()->ShadowPass_GetFragmentShaderScript(initializationData_, shadowShader);
+		std::string shadowPassFragmentShader = shaderBuilder->ShadowPass_GetFragmentShaderScript(initializationData_, shadowShader);
 		shadowShader->SetFragmentShaderScript(shadowPassFragmentShader);
-
-		renderPassTypeShaderMap_[RenderPassType::Shadow] = shadowShader;
 	}
 
 	{
-		Shader* pointLightShadowShader = new Shader();
+		Shader* pointLightShadowShader = GetShader(RenderPassType::PointLightShadow);
 
-		std::string pointLightShadowPassVertexShader = ShaderBuilderNew::GetInstance()->PointShadowPass_GetVertexShaderScript(initializationData_, pointLightShadowShader);
+		std::string pointLightShadowPassVertexShader = shaderBuilder->PointShadowPass_GetVertexShaderScript(initializationData_, pointLightShadowShader);
 		pointLightShadowShader->SetVertexShaderScript(pointLightShadowPassVertexShader);
 
-		std::string pointLightShadowPassGeometryShader = ShaderBuilderNew::GetInstance()->PointShadowPass_GetGeometryShaderScript(initializationData_, pointLightShadowShader);
+		std::string pointLightShadowPassGeometryShader = shaderBuilder->PointShadowPass_GetGeometryShaderScript(initializationData_, pointLightShadowShader);
 		pointLightShadowShader->SetGeometryShaderScript(pointLightShadowPassGeometryShader);
 
-		std::string pointLightShadowPassFragmentShader = ShaderBuilderNew::GetInstance()->PointShadowPass_GetFragmentShaderScript(initializationData_, pointLightShadowShader);
+		std::string pointLightShadowPassFragmentShader = shaderBuilder->PointShadowPass_GetFragmentShaderScript(initializationData_, pointLightShadowShader);
 		pointLightShadowShader->SetFragmentShaderScript(pointLightShadowPassFragmentShader);
-
-		renderPassTypeShaderMap_[RenderPassType::PointLightShadow] = pointLightShadowShader;
 	}
-
 }
 
 void Material::PreInit()
@@ -138,6 +162,67 @@ void Material::PreInit()
 }
 
 void Material::Init()
+{
+	// Materials shared by several meshes are initialized by each of them
+	if (isInitializationDeferred_)
+	{
+		return;
+	}
+
+	// Meshes of the material are rendered with the fallback material of the renderer until then
+	if (!GetAreShaderProgramsReady())
+	{
+		isInitializationDeferred_ = true;
+		engine->GetRenderer()->AddPendingMaterial(this);
+		return;
+	}
+
+	InitShaders();
+}
+
+void Material::PostInit()
+{
+	if (isInitializationDeferred_)
+	{
+		return;
+	}
+
+	PostInitShaders();
+}
+
+bool Material::GetAreShaderProgramsReady() const
+{
+	for (const std::pair<const RenderPassType, Shader*>& renderPassTypeShaderPair : renderPassTypeShaderMap_)
+	{
+		if (renderPassTypeShaderPair.second && !renderPassTypeShaderPair.second->GetIsProgramReady())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void Material::WaitForShaderPrograms()
+{
+	for (const std::pair<const RenderPassType, Shader*>& renderPassTypeShaderPair : renderPassTypeShaderMap_)
+	{
+		if (renderPassTypeShaderPair.second)
+		{
+			renderPassTypeShaderPair.second->WaitForProgram();
+		}
+	}
+}
+
+void Material::CompleteDeferredInitialization()
+{
+	isInitializationDeferred_ = false;
+
+	InitShaders();
+	PostInitShaders();
+}
+
+void Material::InitShaders()
 {
 	Renderer* renderer = engine->GetRenderer();
 
@@ -159,7 +244,7 @@ void Material::Init()
 	}
 }
 
-void Material::PostInit()
+void Material::PostInitShaders()
 {
 	renderPassTypeShaderMap_[RenderPassType::Forward]->PostInit();
 	renderPassTypeShaderMap_[RenderPassType::Shadow]->PostInit();
@@ -70,10 +70,27 @@ public:
 
 	void Build(MeshUnit* meshUnit);
 
+	// Build split in two so that the scripts of several materials can be generated on the worker threads
+	void CreateShaders(MeshUnit* meshUnit);
+	// Only reads the material and its shaders, safe to run on a worker thread once the shader builder instance exists
+	void BuildShaderScripts();
+
+	bool GetIsBuilt() const
+	{
+		return isBuilt_;
+	}
+
 	virtual void PreInit() override;
+	// Initialization is deferred to the renderer if the programs of the material are not linked yet
 	virtual void Init() override;
 	virtual void PostInit() override;
 
+	bool GetAreShaderProgramsReady() const;
+	void WaitForShaderPrograms();
+
+	// Called by the renderer once the programs of a deferred material are linked
+	void CompleteDeferredInitialization();
+
 	inline virtual Shader* GetShader(RenderPassType renderPassType) const override
 	{
 		if (renderPassTypeShaderMap_.find(renderPassType) == renderPassTypeShaderMap_.end())
@@ -117,11 +134,17 @@ protected:
 
 
 private:
+	void InitShaders();
+	void PostInitShaders();
+
 	std::vector<MaterialInstance*> derivedMaterialInstances_;
 
 	std::unordered_map<RenderPassType, Shader*> renderPassTypeShaderMap_;
 
 	MaterialInitializationData* initializationData_{ new MaterialInitializationData( this ) };
+
+	bool isBuilt_{ false };
+	bool isInitializationDeferred_{ false };
 };
 
 #endif
\ No newline at end of file
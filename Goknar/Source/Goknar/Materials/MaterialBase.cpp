@@ -5,6 +5,8 @@
 #include "Goknar/Application.h"
 #include "Goknar/Scene.h"
 #include "Goknar/Engine.h"
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Materials/Material.h"
 #include "Goknar/Renderer/Shader.h"
 #include "Goknar/Renderer/Renderer.h"
 #include "Goknar/Lights/LightManager/LightManager.h"
@@ -71,9 +73,24 @@ void IMaterialBase::Render(RenderPassType renderPassType, const Matrix& worldAnd
 	SetShaderVariables(renderPassType, worldAndRelativeTransformationMatrix);
 }
 
-void IMaterialBase::Use(RenderPassType renderPassType) const
+Shader* IMaterialBase::GetRenderShader(RenderPassType renderPassType) const
 {
 	Shader* shader = GetShader(renderPassType);
+	if (shader && !shader->GetIsInitialized())
+	{
+		const Material* fallbackMaterial = engine->GetRenderer()->GetFallbackMaterial();
+		if (fallbackMaterial)
+		{
+			return fallbackMaterial->GetShader(renderPassType);
+		}
+	}
+
+	return shader;
+}
+
+void IMaterialBase::Use(RenderPassType renderPassType) const
+{
+	Shader* shader = GetRenderShader(renderPassType);
 	if (shader)
 	{
 		shader->Use();
@@ -96,7 +113,7 @@ void IMaterialBase::SetShaderVariables(RenderPassType renderPassType, const Matr
 		glDisable(GL_CULL_FACE);
 	}
 
-	Shader* shader = GetShader(renderPassType);
+	Shader* shader = GetRenderShader(renderPassType);
 
 	if (renderPassType == RenderPassType::Forward || renderPassType == RenderPassType::GeometryBuffer)
 	{
@@ -106,6 +123,26 @@ void IMaterialBase::SetShaderVariables(RenderPassType renderPassType, const Matr
 		shader->SetVector3(SHADER_VARIABLE_NAMES::MATERIAL::EMMISIVE_COLOR, emmisiveColor_);
 		shader->SetFloat(SHADER_VARIABLE_NAMES::MATERIAL::PHONG_EXPONENT, phongExponent_);
 		shader->SetFloat(SHADER_VARIABLE_NAMES::MATERIAL::TRANSLUCENCY, translucency_);
+
+		// Images packed into shared textures are selected by their regions
+		for (const Image* textureImage : textureImages_)
+		{
+			const TextureAtlasRegion* atlasRegion = textureImage->GetAtlasRegion();
+			if (!atlasRegion)
+			{
+				continue;
+			}
+
+			const Texture* packedTexture = textureImage->GetGeneratedTexture();
+			if (packedTexture->GetPackingType() == TexturePackingType::Array)
+			{
+				shader->SetFloat(packedTexture->GetPackedUniformName().c_str(), (float)atlasRegion->layer);
+			}
+			else
+			{
+				shader->SetVector4(packedTexture->GetPackedUniformName().c_str(), atlasRegion->uvTransform);
+			}
+		}
 	}
 	else if (renderPassType == RenderPassType::Shadow || renderPassType == RenderPassType::PointLightShadow)
 	{
@@ -42,6 +42,9 @@ public:
 
 	virtual Shader* GetShader(RenderPassType renderPassType) const = 0;
 
+	// Shader of the pass, or the fallback material's shader until the shader is initialized
+	Shader* GetRenderShader(RenderPassType renderPassType) const;
+
 	const Vector3& GetAmbientReflectance() const
 	{
 		return ambientReflectance_;
@@ -139,6 +142,12 @@ public:
 		textureImages_.push_back(image);
 	}
 
+	// Material instances can switch to another image of the same atlas or array texture without a shader of their own
+	void SetTextureImage(int index, const Image* image)
+	{
+		textureImages_[index] = image;
+	}
+
 	const std::vector<const Image*>* GetTextureImages() const
 	{
 		return &textureImages_;
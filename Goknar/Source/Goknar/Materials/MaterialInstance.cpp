@@ -46,4 +46,5 @@ Shader* MaterialInstance::GetShader(RenderPassType renderPassType) const
 void MaterialInstance::Destroy()
 {
 	parentMaterial_->RemoveDerivedMaterialInstance(this);
+	delete this;
 }
@@ -3,6 +3,8 @@
 
 #include "MaterialBase.h"
 
+#include "Goknar/Managers/MemoryManager.h"
+
 class Material;
 
 class GOKNAR_API MaterialInstance : public IMaterialBase
@@ -11,6 +13,8 @@ class GOKNAR_API MaterialInstance : public IMaterialBase
 public:
 	static MaterialInstance* Create(Material* parent);
 
+	GOKNAR_POOLED_ALLOCATION(AllocationCategory::MaterialInstance)
+
 	virtual void PreInit() override;
 	virtual void Init() override;
 	virtual void PostInit() override;
@@ -0,0 +1,77 @@
+#include "pch.h"
+
+#include "FrameArena.h"
+
+#include <cstdint>
+
+#include "Goknar/GoknarAssert.h"
+
+FrameArena::FrameArena(std::size_t capacity) :
+	capacity_(capacity)
+{
+	buffer_ = static_cast<unsigned char*>(::operator new(capacity_));
+}
+
+FrameArena::~FrameArena()
+{
+	for (void* overflowBlock : overflowBlocks_)
+	{
+		::operator delete(overflowBlock);
+	}
+	overflowBlocks_.clear();
+
+	::operator delete(buffer_);
+	buffer_ = nullptr;
+}
+
+void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+{
+	GOKNAR_CORE_ASSERT((alignment & (alignment - 1)) == 0, "FrameArena alignment must be a power of two!");
+
+	++allocationCount_;
+
+	const std::uintptr_t bufferStart = reinterpret_cast<std::uintptr_t>(buffer_);
+	const std::uintptr_t alignedAddress = (bufferStart + offset_ + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+	const std::size_t alignedOffset = alignedAddress - bufferStart;
+
+	if (alignedOffset + size <= capacity_)
+	{
+		offset_ = alignedOffset + size;
+		return buffer_ + alignedOffset;
+	}
+
+	// Out of space for this frame, fall back to the heap until the next reset
+	void* overflowBlock = ::operator new(size + alignment);
+	overflowBlocks_.push_back(overflowBlock);
+	overflowBytes_ += size + alignment;
+
+	const std::uintptr_t overflowAddress = reinterpret_cast<std::uintptr_t>(overflowBlock);
+	return reinterpret_cast<void*>((overflowAddress + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+}
+
+void FrameArena::Reset()
+{
+	const std::size_t usedBytes = GetUsedBytes();
+	if (peakUsedBytes_ < usedBytes)
+	{
+		peakUsedBytes_ = usedBytes;
+	}
+
+	if (!overflowBlocks_.empty())
+	{
+		for (void* overflowBlock : overflowBlocks_)
+		{
+			::operator delete(overflowBlock);
+		}
+		overflowBlocks_.clear();
+
+		// Grow so that the same workload fits into the linear buffer next frame
+		::operator delete(buffer_);
+		capacity_ = peakUsedBytes_ + peakUsedBytes_ / 2;
+		buffer_ = static_cast<unsigned char*>(::operator new(capacity_));
+	}
+
+	offset_ = 0;
+	overflowBytes_ = 0;
+	allocationCount_ = 0;
+}
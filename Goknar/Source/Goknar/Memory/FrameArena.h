@@ -0,0 +1,131 @@
+#ifndef __FRAMEARENA_H__
+#define __FRAMEARENA_H__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Goknar/Core.h"
+
+// Linear allocator for data that only lives until the end of the current frame
+// Allocation is a pointer bump and the whole arena is released at once on Reset
+// If a frame overflows the arena, extra blocks are allocated from the heap
+// and the arena grows to the peak usage on the next Reset
+class GOKNAR_API FrameArena
+{
+public:
+	FrameArena(std::size_t capacity = 1024 * 1024);
+	~FrameArena();
+
+	FrameArena(const FrameArena&) = delete;
+	const FrameArena& operator=(const FrameArena&) = delete;
+
+	void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+	// Objects created in the arena are never destructed
+	template<class T, class... Arguments>
+	T* New(Arguments&&... arguments)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "FrameArena can only hold trivially destructible types!");
+		return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Arguments>(arguments)...);
+	}
+
+	template<class T>
+	T* NewArray(std::size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "FrameArena can only hold trivially destructible types!");
+		T* array = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			new (array + index) T();
+		}
+		return array;
+	}
+
+	void Reset();
+
+	std::size_t GetCapacity() const
+	{
+		return capacity_;
+	}
+
+	std::size_t GetUsedBytes() const
+	{
+		return offset_ + overflowBytes_;
+	}
+
+	std::size_t GetPeakUsedBytes() const
+	{
+		return peakUsedBytes_;
+	}
+
+	std::size_t GetAllocationCount() const
+	{
+		return allocationCount_;
+	}
+
+private:
+	std::vector<void*> overflowBlocks_;
+
+	unsigned char* buffer_{ nullptr };
+
+	std::size_t capacity_{ 0 };
+	std::size_t offset_{ 0 };
+	std::size_t overflowBytes_{ 0 };
+	std::size_t peakUsedBytes_{ 0 };
+	std::size_t allocationCount_{ 0 };
+};
+
+// STL compatible allocator in order to use containers for per-frame scratch data
+// Deallocation is a no-op, memory is given back when the arena is reset
+template<class T>
+class FrameArenaAllocator
+{
+public:
+	using value_type = T;
+
+	FrameArenaAllocator(FrameArena* frameArena) : frameArena_(frameArena)
+	{
+	}
+
+	template<class U>
+	FrameArenaAllocator(const FrameArenaAllocator<U>& other) : frameArena_(other.GetFrameArena())
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		return static_cast<T*>(frameArena_->Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	void deallocate(T*, std::size_t)
+	{
+	}
+
+	FrameArena* GetFrameArena() const
+	{
+		return frameArena_;
+	}
+
+	template<class U>
+	bool operator==(const FrameArenaAllocator<U>& other) const
+	{
+		return frameArena_ == other.GetFrameArena();
+	}
+
+	template<class U>
+	bool operator!=(const FrameArenaAllocator<U>& other) const
+	{
+		return frameArena_ != other.GetFrameArena();
+	}
+
+private:
+	FrameArena* frameArena_;
+};
+
+template<class T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __OBJECTPOOL_H__
+#define __OBJECTPOOL_H__
+
+#include <utility>
+
+#include "Goknar/Memory/PoolAllocator.h"
+
+// Typed pool for objects that are created and destroyed frequently
+// Constructs objects in recycled blocks instead of going to the general purpose heap
+template<class T>
+class ObjectPool
+{
+public:
+	ObjectPool(std::size_t objectsPerChunk = 64) :
+		allocator_(sizeof(T), objectsPerChunk)
+	{
+	}
+
+	~ObjectPool()
+	{
+	}
+
+	template<class... Arguments>
+	T* Create(Arguments&&... arguments)
+	{
+		void* memory = allocator_.Allocate();
+		++totalCreatedCount_;
+		return new (memory) T(std::forward<Arguments>(arguments)...);
+	}
+
+	void Destroy(T* object)
+	{
+		if (!object)
+		{
+			return;
+		}
+
+		object->~T();
+		allocator_.Deallocate(object);
+		++totalDestroyedCount_;
+	}
+
+	std::size_t GetLiveCount() const
+	{
+		return allocator_.GetUsedBlockCount();
+	}
+
+	std::size_t GetCapacity() const
+	{
+		return allocator_.GetCapacity();
+	}
+
+	std::size_t GetTotalCreatedCount() const
+	{
+		return totalCreatedCount_;
+	}
+
+	std::size_t GetTotalDestroyedCount() const
+	{
+		return totalDestroyedCount_;
+	}
+
+private:
+	PoolAllocator allocator_;
+
+	std::size_t totalCreatedCount_{ 0 };
+	std::size_t totalDestroyedCount_{ 0 };
+};
+
+#endif
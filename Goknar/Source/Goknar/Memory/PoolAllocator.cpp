@@ -0,0 +1,67 @@
+#include "pch.h"
+
+#include "PoolAllocator.h"
+
+#include "Goknar/GoknarAssert.h"
+
+PoolAllocator::PoolAllocator(std::size_t blockSize, std::size_t blocksPerChunk) :
+	blocksPerChunk_(blocksPerChunk)
+{
+	// Every block must be able to hold the free list link and keep the default alignment
+	constexpr std::size_t alignment = alignof(std::max_align_t);
+	blockSize_ = blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize;
+	blockSize_ = (blockSize_ + alignment - 1) & ~(alignment - 1);
+
+	GOKNAR_CORE_ASSERT(0 < blocksPerChunk_, "PoolAllocator needs at least one block per chunk!");
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	for (unsigned char* chunk : chunks_)
+	{
+		::operator delete(chunk);
+	}
+	chunks_.clear();
+	freeList_ = nullptr;
+}
+
+void* PoolAllocator::Allocate()
+{
+	if (!freeList_)
+	{
+		AllocateChunk();
+	}
+
+	FreeBlock* block = freeList_;
+	freeList_ = block->next;
+	++usedBlockCount_;
+
+	return block;
+}
+
+void PoolAllocator::Deallocate(void* pointer)
+{
+	if (!pointer)
+	{
+		return;
+	}
+
+	FreeBlock* block = static_cast<FreeBlock*>(pointer);
+	block->next = freeList_;
+	freeList_ = block;
+	--usedBlockCount_;
+}
+
+void PoolAllocator::AllocateChunk()
+{
+	unsigned char* chunk = static_cast<unsigned char*>(::operator new(blockSize_ * blocksPerChunk_));
+	chunks_.push_back(chunk);
+
+	// Link the blocks in address order so that consecutive allocations are contiguous
+	for (std::size_t blockIndex = blocksPerChunk_; 0 < blockIndex; --blockIndex)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (blockIndex - 1) * blockSize_);
+		block->next = freeList_;
+		freeList_ = block;
+	}
+}
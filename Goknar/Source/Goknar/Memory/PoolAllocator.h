@@ -0,0 +1,67 @@
+#ifndef __POOLALLOCATOR_H__
+#define __POOLALLOCATOR_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "Goknar/Core.h"
+
+// Fixed-size block allocator
+// Memory is requested from the system in chunks of blocksPerChunk blocks
+// and freed blocks are kept in an intrusive free list to be recycled
+// Chunks are only released when the allocator is destroyed
+class GOKNAR_API PoolAllocator
+{
+public:
+	PoolAllocator(std::size_t blockSize, std::size_t blocksPerChunk);
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator&) = delete;
+	const PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+	void* Allocate();
+	void Deallocate(void* pointer);
+
+	std::size_t GetBlockSize() const
+	{
+		return blockSize_;
+	}
+
+	std::size_t GetChunkCount() const
+	{
+		return chunks_.size();
+	}
+
+	std::size_t GetCapacity() const
+	{
+		return chunks_.size() * blocksPerChunk_;
+	}
+
+	std::size_t GetUsedBlockCount() const
+	{
+		return usedBlockCount_;
+	}
+
+	std::size_t GetFreeBlockCount() const
+	{
+		return GetCapacity() - usedBlockCount_;
+	}
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	void AllocateChunk();
+
+	std::vector<unsigned char*> chunks_;
+
+	FreeBlock* freeList_{ nullptr };
+
+	std::size_t blockSize_;
+	std::size_t blocksPerChunk_;
+	std::size_t usedBlockCount_{ 0 };
+};
+
+#endif
@@ -22,15 +22,24 @@ void DynamicMeshInstance::Render(RenderPassType renderPassType)
 
 void DynamicMeshInstance::UpdateVertexDataAt(int index, const VertexData& newVertexData)
 {
-	engine->GetRenderer()->UpdateDynamicMeshVertex(mesh_, index, newVertexData);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->UpdateDynamicMeshVertex(mesh_, index, newVertexData);
+	}
 }
 
 void DynamicMeshInstance::AddMeshInstanceToRenderer()
 {
-	engine->GetRenderer()->AddDynamicMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->AddDynamicMeshInstance(this);
+	}
 }
 
 void DynamicMeshInstance::RemoveMeshInstanceFromRenderer()
 {
-	engine->GetRenderer()->RemoveDynamicMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->RemoveDynamicMeshInstance(this);
+	}
 }
\ No newline at end of file
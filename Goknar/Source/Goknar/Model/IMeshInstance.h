@@ -6,6 +6,7 @@
 
 #include "Goknar/Engine.h"
 #include "Goknar/Components/RenderComponent.h"
+#include "Goknar/Managers/MemoryManager.h"
 #include "Goknar/Materials/Material.h"
 #include "Goknar/Materials/MaterialInstance.h"
 
@@ -30,6 +31,8 @@ public:
 	{
 	}
 
+	GOKNAR_POOLED_ALLOCATION(AllocationCategory::MeshInstance)
+
 	inline void PreInit();
 	inline void Init();
 	inline void PostInit();
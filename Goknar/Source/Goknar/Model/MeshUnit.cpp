@@ -11,6 +11,7 @@
 
 #include "Managers/CameraManager.h"
 #include "IO/IOManager.h"
+#include "IO/MappedFile.h"
 #include "Renderer/ShaderBuilder.h"
 
 MeshUnit::MeshUnit() :
@@ -37,25 +38,35 @@ MeshUnit::~MeshUnit()
 	{
 		delete faces_;
 	}
+
+	delete mappedFile_;
 }
 
 void MeshUnit::PreInit()
 {
 	aabb_.CalculateSize();
 
-	vertexCount_ = (int)vertices_->size();
-	faceCount_ = (int)faces_->size();
+	if (!mappedFile_)
+	{
+		vertexCount_ = (int)vertices_->size();
+		faceCount_ = (int)faces_->size();
+	}
 
-	if (material_)
+	// Headless engines use the mesh data only
+	if (material_ && !engine->GetIsHeadless())
 	{
-		material_->Build(this);
+		// Materials of the startup meshes are built together by the resource container
+		if (!material_->GetIsBuilt())
+		{
+			material_->Build(this);
+		}
 		material_->PreInit();
 	}
 }
 
 void MeshUnit::Init()
 {
-	if (material_)
+	if (material_ && !engine->GetIsHeadless())
 	{
 		material_->Init();
 	}
@@ -63,7 +74,7 @@ void MeshUnit::Init()
 
 void MeshUnit::PostInit()
 {
-	if (material_)
+	if (material_ && !engine->GetIsHeadless())
 	{
 		material_->PostInit();
 	}
@@ -71,6 +82,36 @@ void MeshUnit::PostInit()
 	isInitialized_ = true;
 }
 
+void MeshUnit::SetMappedData(MappedFile* mappedFile, const VertexData* vertexData, unsigned int vertexCount, const Face* faceData, unsigned int faceCount)
+{
+	delete mappedFile_;
+	mappedFile_ = mappedFile;
+
+	mappedVertexData_ = vertexData;
+	mappedFaceData_ = faceData;
+
+	vertexCount_ = vertexCount;
+	faceCount_ = faceCount;
+}
+
+void MeshUnit::GetMemoryUsage(ContentMemoryUsage& memoryUsage) const
+{
+	const int category = (int)ContentMemoryCategory::Mesh;
+	if (mappedFile_)
+	{
+		memoryUsage.cpuByteCounts[category] += mappedFile_->GetSize();
+	}
+	else if (vertices_)
+	{
+		memoryUsage.cpuByteCounts[category] += (unsigned long long)vertices_->size() * sizeof(VertexData) + (unsigned long long)faces_->size() * sizeof(Face);
+	}
+
+	if (isInitialized_ && !engine->GetIsHeadless())
+	{
+		memoryUsage.gpuByteCounts[category] += GetByteSize();
+	}
+}
+
 void MeshUnit::ClearDataFromMemory()
 {
 	vertices_->clear();
@@ -80,4 +121,37 @@ void MeshUnit::ClearDataFromMemory()
 	faces_->clear();
 	delete faces_;
 	faces_ = nullptr;
+
+	mappedVertexData_ = nullptr;
+	mappedFaceData_ = nullptr;
+
+	delete mappedFile_;
+	mappedFile_ = nullptr;
+}
+
+bool MeshUnit::EvictData()
+{
+	// Data cleared after the upload is not evicted since it is not restored either
+	if (!isInitialized_ || isDataEvicted_ || !GetVertexData())
+	{
+		return false;
+	}
+
+	ClearDataFromMemory();
+	isDataEvicted_ = true;
+	return true;
+}
+
+void MeshUnit::RestoreData(MeshUnit* decodedMesh)
+{
+	std::swap(vertices_, decodedMesh->vertices_);
+	std::swap(faces_, decodedMesh->faces_);
+	std::swap(mappedFile_, decodedMesh->mappedFile_);
+
+	mappedVertexData_ = decodedMesh->mappedVertexData_;
+	mappedFaceData_ = decodedMesh->mappedFaceData_;
+	decodedMesh->mappedVertexData_ = nullptr;
+	decodedMesh->mappedFaceData_ = nullptr;
+
+	isDataEvicted_ = false;
 }
@@ -9,6 +9,7 @@
 
 #include <vector>
 
+class MappedFile;
 class Shader;
 class Material;
 
@@ -127,6 +128,7 @@ public:
 	void AddFace(const Face& face)
 	{
 		faces_->push_back(face);
+		faceCount_++;
 	}
 
 	const FaceArray* GetFacesPointer() const
@@ -134,6 +136,20 @@ public:
 		return faces_;
 	}
 
+	// Vertices and faces of the mesh wherever they are stored, meshes loaded from cooked files point into the mapped file
+	const VertexData* GetVertexData() const
+	{
+		return mappedVertexData_ ? mappedVertexData_ : (vertices_ && !vertices_->empty() ? vertices_->data() : nullptr);
+	}
+
+	const Face* GetFaceData() const
+	{
+		return mappedFaceData_ ? mappedFaceData_ : (faces_ && !faces_->empty() ? faces_->data() : nullptr);
+	}
+
+	// The mesh takes the ownership of the mapped file, data pointers must point into it
+	void SetMappedData(MappedFile* mappedFile, const VertexData* vertexData, unsigned int vertexCount, const Face* faceData, unsigned int faceCount);
+
 	unsigned int GetVertexCount() const
 	{
 		return vertexCount_;
@@ -176,6 +192,26 @@ public:
 
 	void ClearDataFromMemory();
 
+	// Frees the vertices and faces on the CPU once the renderer has its copy, only the resource manager evicts meshes
+	bool EvictData();
+
+	// Takes the vertices and faces of a freshly decoded copy of the evicted mesh, the renderer keeps using its copy
+	void RestoreData(MeshUnit* decodedMesh);
+
+	bool GetIsDataEvicted() const
+	{
+		return isDataEvicted_;
+	}
+
+	// Vertices and faces are counted on the CPU while they are in memory or mapped, and on the GPU once the mesh is initialized
+	virtual void GetMemoryUsage(ContentMemoryUsage& memoryUsage) const override;
+
+	// Size of the vertices and faces in bytes, also valid after the data is cleared from memory
+	unsigned long long GetByteSize() const
+	{
+		return (unsigned long long)vertexCount_ * sizeof(VertexData) + (unsigned long long)faceCount_ * sizeof(Face);
+	}
+
 protected:
 	unsigned int baseVertex_;
 	unsigned int vertexStartingIndex_;
@@ -190,12 +226,18 @@ private:
 	VertexArray* vertices_;
 	FaceArray* faces_;
 
+	MappedFile* mappedFile_{ nullptr };
+	const VertexData* mappedVertexData_{ nullptr };
+	const Face* mappedFaceData_{ nullptr };
+
 	Material* material_;
 
 	std::string name_;
 
 	unsigned int vertexCount_;
 	unsigned int faceCount_;
+
+	bool isDataEvicted_{ false };
 };
 
 #endif
\ No newline at end of file
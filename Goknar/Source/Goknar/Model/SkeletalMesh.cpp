@@ -46,6 +46,35 @@ void SkeletalMesh::PostInit()
 	MeshUnit::PostInit();
 }
 
+void SkeletalMesh::GetMemoryUsage(ContentMemoryUsage& memoryUsage) const
+{
+	MeshUnit::GetMemoryUsage(memoryUsage);
+
+	// Mapped bone data is counted with the mapped file
+	const int meshCategory = (int)ContentMemoryCategory::Mesh;
+	memoryUsage.cpuByteCounts[meshCategory] += (unsigned long long)vertexBoneDataArray_->size() * sizeof(VertexBoneData);
+	if (isInitialized_ && !engine->GetIsHeadless())
+	{
+		memoryUsage.gpuByteCounts[meshCategory] += (unsigned long long)GetVertexCount() * sizeof(VertexBoneData);
+	}
+
+	unsigned long long animationByteCount = 0;
+	for (const SkeletalAnimation* skeletalAnimation : skeletalAnimations_)
+	{
+		animationByteCount += sizeof(SkeletalAnimation) + skeletalAnimation->animationNodeSize * sizeof(SkeletalAnimationNode*);
+		for (unsigned int animationNodeIndex = 0; animationNodeIndex < skeletalAnimation->animationNodeSize; ++animationNodeIndex)
+		{
+			const SkeletalAnimationNode* animationNode = skeletalAnimation->animationNodes[animationNodeIndex];
+			animationByteCount +=
+				sizeof(SkeletalAnimationNode) +
+				animationNode->rotationKeySize * sizeof(AnimationQuaternionKey) +
+				animationNode->positionKeySize * sizeof(AnimationVectorKey) +
+				animationNode->scalingKeySize * sizeof(AnimationVectorKey);
+		}
+	}
+	memoryUsage.cpuByteCounts[(int)ContentMemoryCategory::Animation] += animationByteCount;
+}
+
 void SkeletalMesh::GetBoneTransforms(std::vector<Matrix>& transforms, const SkeletalAnimation* skeletalAnimation, float time, std::unordered_map<std::string, SocketComponent*>& socketMap)
 {
 	SetupTransforms(armature_->root, Matrix::IdentityMatrix, transforms, skeletalAnimation, time, socketMap);
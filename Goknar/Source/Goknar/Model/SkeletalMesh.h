@@ -277,6 +277,9 @@ public:
     virtual void Init() override;
     virtual void PostInit() override;
 
+    // Adds the bone data of the vertices to the mesh bytes and the keys of the animations to the animation bytes
+    virtual void GetMemoryUsage(ContentMemoryUsage& memoryUsage) const override;
+
     void ResizeVertexToBonesArray(unsigned int size)
     {
         vertexBoneDataArray_->resize(size);
@@ -321,6 +324,17 @@ public:
         return vertexBoneDataArray_;
     }
 
+    // Bone data of the vertices wherever it is stored, meshes loaded from cooked files point into the mapped file
+    const VertexBoneData* GetVertexBoneData() const
+    {
+        return mappedVertexBoneData_ ? mappedVertexBoneData_ : (vertexBoneDataArray_->empty() ? nullptr : vertexBoneDataArray_->data());
+    }
+
+    void SetMappedVertexBoneData(const VertexBoneData* vertexBoneData)
+    {
+        mappedVertexBoneData_ = vertexBoneData;
+    }
+
     const BoneNameToIdMap* GetBoneNameToIdMap() const
     {
         return boneNameToIdMap_;
@@ -336,6 +350,17 @@ public:
         return bones_[index];
     }
 
+    // Bones are indexed by their ids
+    const std::vector<Bone*>& GetBones() const
+    {
+        return bones_;
+    }
+
+    const Armature* GetArmature() const
+    {
+        return armature_;
+    }
+
     void GetBoneTransforms(std::vector<Matrix>& transforms, const SkeletalAnimation* skeletalAnimation, float time, std::unordered_map<std::string, SocketComponent*>& socketMap);
 
     void AddSkeletalAnimation(SkeletalAnimation* skeletalAnimation)
@@ -347,6 +372,11 @@ public:
         }
     }
 
+    const SkeletalAnimationVector& GetSkeletalAnimations() const
+    {
+        return skeletalAnimations_;
+    }
+
     const SkeletalAnimation* GetSkeletalAnimation(const std::string& name)
     {
         if (nameToSkeletalAnimationMap_.find(name) != nameToSkeletalAnimationMap_.end())
@@ -361,6 +391,7 @@ private:
     void SetupTransforms(Bone* bone, const Matrix& parentTransform, std::vector<Matrix>& transforms, const SkeletalAnimation* skeletalAnimation, float time, std::unordered_map<std::string, SocketComponent*>& socketMap);
 
     VertexBoneDataArray* vertexBoneDataArray_{ new VertexBoneDataArray() };
+    const VertexBoneData* mappedVertexBoneData_{ nullptr };
     BoneNameToIdMap* boneNameToIdMap_{ new BoneNameToIdMap() };
 
     SkeletalAnimationVector skeletalAnimations_;
@@ -24,7 +24,11 @@ SkeletalMeshInstance::~SkeletalMeshInstance()
 
 void SkeletalMeshInstance::PrepareForTheCurrentFrame()
 {
-	mesh_->GetBoneTransforms(boneTransformations_, skeletalMeshAnimation_.skeletalAnimation, skeletalMeshAnimation_.animationTime, sockets_);
+	if (areBoneTransformationsDirty_)
+	{
+		mesh_->GetBoneTransforms(boneTransformations_, skeletalMeshAnimation_.skeletalAnimation, skeletalMeshAnimation_.animationTime, sockets_);
+		areBoneTransformationsDirty_ = false;
+	}
 
 	// TODO: Implement a proper multi threading
 	// Following std::for_each parallelizing causes game crash
@@ -60,6 +64,25 @@ void SkeletalMeshInstance::PrepareForTheCurrentFrame()
 
 void SkeletalMeshInstance::PrepareForTheNextFrame()
 {
+	float animationUpdateInterval = animationUpdateInterval_;
+	if (isAnimationLODEnabled_)
+	{
+		const float animationLODInterval = engine->GetTickLODInterval(parentComponent_->GetWorldPosition());
+		if (animationUpdateInterval < animationLODInterval)
+		{
+			animationUpdateInterval = animationLODInterval;
+		}
+	}
+
+	// Animation time is calculated from the elapsed time, so skipped frames are caught up on the next update
+	float animationDeltaTime;
+	if (!animationThrottle_.Advance(animationUpdateInterval, engine->GetDeltaTime(), animationDeltaTime))
+	{
+		return;
+	}
+
+	areBoneTransformationsDirty_ = true;
+
 	if (skeletalMeshAnimation_.skeletalAnimation)
 	{
 		const float newElapsedTimeInSeconds = engine->GetElapsedTime() - skeletalMeshAnimation_.initialTimeInSeconds;
@@ -154,7 +177,7 @@ void SkeletalMeshInstance::Render(RenderPassType renderPassType)
 
 void SkeletalMeshInstance::SetRenderOperations(RenderPassType renderPassType)
 {
-	mesh_->GetMaterial()->GetShader(renderPassType)->SetMatrixVector(SHADER_VARIABLE_NAMES::SKELETAL_MESH::BONES, boneTransformations_);
+	mesh_->GetMaterial()->GetRenderShader(renderPassType)->SetMatrixVector(SHADER_VARIABLE_NAMES::SKELETAL_MESH::BONES, boneTransformations_);
 	IMeshInstance::Render(renderPassType);
 }
 
@@ -163,6 +186,7 @@ void SkeletalMeshInstance::SetMesh(SkeletalMesh* skeletalMesh)
 	IMeshInstance::SetMesh(skeletalMesh);
 
 	boneTransformations_.resize(skeletalMesh->GetBoneSize(), Matrix::IdentityMatrix);
+	areBoneTransformationsDirty_ = true;
 }
 
 void SkeletalMeshInstance::PlayAnimation(const std::string& animationName, const PlayLoopData& playLoopData/* = { false, {} }*/, const KeyframeData& keyframeData/* = {}*/)
@@ -182,6 +206,8 @@ void SkeletalMeshInstance::PlayAnimation(const std::string& animationName, const
 
 		skeletalMeshAnimation_.playLoopData = playLoopData;
 		skeletalMeshAnimation_.keyframeData = keyframeData;
+
+		areBoneTransformationsDirty_ = true;
 	}
 }
 
@@ -218,12 +244,18 @@ void SkeletalMeshInstance::RemoveBoneToMatrixPointer(const std::string& boneName
 
 void SkeletalMeshInstance::AddMeshInstanceToRenderer()
 {
-	engine->GetRenderer()->AddSkeletalMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->AddSkeletalMeshInstance(this);
+	}
 }
 
 void SkeletalMeshInstance::RemoveMeshInstanceFromRenderer()
 {
-	engine->GetRenderer()->RemoveSkeletalMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->RemoveSkeletalMeshInstance(this);
+	}
 }
 
 SocketComponent* SkeletalMeshInstance::AddSocketToBone(const std::string& boneName)
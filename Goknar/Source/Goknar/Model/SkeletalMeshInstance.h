@@ -7,6 +7,7 @@
 
 #include "Delegates/Delegate.h"
 #include "Model/SkeletalMesh.h"
+#include "TickTypes.h"
 
 class SkeletalAnimation;
 class SocketComponent;
@@ -56,6 +57,28 @@ public:
 	void PrepareForTheCurrentFrame();
 	void PrepareForTheNextFrame();
 
+	float GetAnimationUpdateInterval() const
+	{
+		return animationUpdateInterval_;
+	}
+
+	// Bone transformations are updated at most once per animationUpdateInterval seconds, 0 updates every frame
+	void SetAnimationUpdateInterval(float animationUpdateInterval)
+	{
+		animationUpdateInterval_ = animationUpdateInterval;
+	}
+
+	bool GetIsAnimationLODEnabled() const
+	{
+		return isAnimationLODEnabled_;
+	}
+
+	// Animation update interval is increased by the engine's tick LOD levels according to the distance to the active camera
+	void SetIsAnimationLODEnabled(bool isAnimationLODEnabled)
+	{
+		isAnimationLODEnabled_ = isAnimationLODEnabled;
+	}
+
 	void AddMeshInstanceToRenderer() override;
 	void RemoveMeshInstanceFromRenderer() override;
 
@@ -68,6 +91,11 @@ private:
 
 	SkeletalMeshAnimation skeletalMeshAnimation_{};
 
+	TickThrottle animationThrottle_{};
+	float animationUpdateInterval_{ 0.f };
+	bool isAnimationLODEnabled_{ false };
+	bool areBoneTransformationsDirty_{ true };
+
 	std::vector<Matrix> boneTransformations_ {};
 	std::unordered_map<std::string, SocketComponent*> sockets_ {};
 	std::unordered_map<int, const Matrix*> boneIdToAttachedMatrixPointerMap_ {};
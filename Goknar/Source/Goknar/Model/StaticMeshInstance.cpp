@@ -19,10 +19,16 @@ void StaticMeshInstance::Render(RenderPassType renderPassType)
 
 void StaticMeshInstance::AddMeshInstanceToRenderer()
 {
-	engine->GetRenderer()->AddStaticMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->AddStaticMeshInstance(this);
+	}
 }
 
 void StaticMeshInstance::RemoveMeshInstanceFromRenderer()
 {
-	engine->GetRenderer()->RemoveStaticMeshInstance(this);
+	if (Renderer* renderer = engine->GetRenderer())
+	{
+		renderer->RemoveStaticMeshInstance(this);
+	}
 }
\ No newline at end of file
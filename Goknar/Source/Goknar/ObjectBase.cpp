@@ -123,6 +123,24 @@ void ObjectBase::SetIsTickable(bool isTickable)
 	}
 }
 
+void ObjectBase::SetIsTickEnabled(bool isTickEnabled)
+{
+	isTickEnabled_ = isTickEnabled;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
+void ObjectBase::SetTickGroup(TickGroup tickGroup)
+{
+	tickGroup_ = tickGroup;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
+}
+
 void ObjectBase::SetWorldPosition(const Vector3& position, bool updateWorldTransformationMatrix/* = true*/)
 {
 	worldPosition_ = position;
@@ -153,6 +171,10 @@ void ObjectBase::SetWorldScaling(const Vector3& scaling, bool updateWorldTransfo
 void ObjectBase::SetIsActive(bool isActive)
 {
 	isActive_ = isActive;
+	if (isTickable_)
+	{
+		engine->MarkTickGroupsDirty();
+	}
 
 	for (int i = 0; i < children_.size(); i++)
 	{
@@ -4,7 +4,9 @@
 #include <vector>
 
 #include "Core.h"
+#include "TickTypes.h"
 
+#include "Managers/MemoryManager.h"
 #include "Math/GoknarMath.h"
 #include "Math/Matrix.h"
 
@@ -39,6 +41,8 @@ public:
 	ObjectBase(const ObjectInitializer& objectInitializer = ObjectInitializer());
 	virtual ~ObjectBase();
 
+	GOKNAR_POOLED_ALLOCATION(AllocationCategory::ObjectBase)
+
 	virtual void PreInit();
 	virtual void Init();
 	virtual void PostInit();
@@ -73,9 +77,51 @@ public:
 		return isTickEnabled_;
 	}
 
-	void SetIsTickEnabled(bool isTickEnabled)
+	void SetIsTickEnabled(bool isTickEnabled);
+
+	TickGroup GetTickGroup() const
+	{
+		return tickGroup_;
+	}
+
+	void SetTickGroup(TickGroup tickGroup);
+
+	float GetTickInterval() const
+	{
+		return tickInterval_;
+	}
+
+	// Object ticks at most once per tickInterval seconds with the delta time accumulated since its last tick
+	// 0 ticks every frame
+	void SetTickInterval(float tickInterval)
+	{
+		tickInterval_ = tickInterval;
+	}
+
+	bool GetIsTickLODEnabled() const
+	{
+		return isTickLODEnabled_;
+	}
+
+	// Tick interval is increased by the engine's tick LOD levels according to the distance to the active camera
+	void SetIsTickLODEnabled(bool isTickLODEnabled)
+	{
+		isTickLODEnabled_ = isTickLODEnabled;
+		if (!isTickLODEnabled)
+		{
+			tickLODInterval_ = 0.f;
+		}
+	}
+
+	void SetTickLODInterval(float tickLODInterval)
+	{
+		tickLODInterval_ = tickLODInterval;
+	}
+
+	// Returns true and the delta time to tick with if the object should tick this frame
+	bool ConsumeTickDeltaTime(float deltaTime, float& outDeltaTime)
 	{
-		isTickEnabled_ = isTickEnabled;
+		return tickThrottle_.Advance(tickInterval_ < tickLODInterval_ ? tickLODInterval_ : tickInterval_, deltaTime, outDeltaTime);
 	}
 
 	bool GetIsInitialized() const
@@ -219,6 +265,11 @@ private:
 	int totalComponentCount_;
 
 	unsigned int GUID_{ 0 };
+	TickGroup tickGroup_{ TickGroup::PostPhysics };
+	TickThrottle tickThrottle_{};
+	float tickInterval_{ 0.f };
+	float tickLODInterval_{ 0.f };
+	bool isTickLODEnabled_{ false };
     unsigned char isTickable_ : 1;
     unsigned char isTickEnabled_ : 1;
 	unsigned char isActive_ : 1;
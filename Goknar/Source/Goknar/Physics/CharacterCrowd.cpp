@@ -0,0 +1,417 @@
+#include "pch.h"
+
+#include "CharacterCrowd.h"
+
+#include <algorithm>
+
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletDynamics/Character/btKinematicCharacterController.h"
+
+#include "Engine.h"
+#include "GoknarAssert.h"
+#include "Managers/JobManager.h"
+#include "OverlappingPhysicsObject.h"
+#include "PhysicsUtils.h"
+#include "Components/PhysicsMovementComponent.h"
+
+constexpr int CHARACTER_CROWD_BATCH_SIZE = 16;
+constexpr int CHARACTER_CROWD_SLIDE_ITERATION_COUNT = 3;
+
+// Characters are kept this far away from what they hit so that the next sweeps do not start touching it
+constexpr float CHARACTER_CROWD_SKIN_WIDTH = 0.01f;
+
+class CharacterCrowdSweepCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+public:
+	CharacterCrowdSweepCallback(const btCollisionObject* self, const btVector3& from, const btVector3& to) :
+		btCollisionWorld::ClosestConvexResultCallback(from, to),
+		self_(self)
+	{
+		m_collisionFilterGroup = self->getBroadphaseHandle()->m_collisionFilterGroup;
+		m_collisionFilterMask = self->getBroadphaseHandle()->m_collisionFilterMask;
+	}
+
+	virtual bool needsCollision(btBroadphaseProxy* proxy0) const override
+	{
+		const btCollisionObject* collisionObject = (const btCollisionObject*)proxy0->m_clientObject;
+
+		// Only the static world is swept against, characters are separated afterwards and dynamic bodies are left to the solver
+		return
+			collisionObject != self_ &&
+			collisionObject->isStaticObject() &&
+			collisionObject->hasContactResponse() &&
+			btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy0);
+	}
+
+private:
+	const btCollisionObject* self_;
+};
+
+// Moves position towards target until the static world is hit, returns whether it is hit
+static bool SweepCharacter(btCollisionWorld* collisionWorld, const CharacterCrowdMember& member, btVector3& position, const btVector3& target, btVector3& hitNormal)
+{
+	const btMatrix3x3& basis = member.ghostObject->getWorldTransform().getBasis();
+
+	CharacterCrowdSweepCallback sweepCallback(member.ghostObject, position, target);
+	collisionWorld->convexSweepTest(
+		(const btConvexShape*)member.ghostObject->getCollisionShape(),
+		btTransform(basis, position),
+		btTransform(basis, target),
+		sweepCallback,
+		collisionWorld->getDispatchInfo().m_allowedCcdPenetration);
+
+	if (!sweepCallback.hasHit())
+	{
+		position = target;
+		return false;
+	}
+
+	hitNormal = sweepCallback.m_hitNormalWorld;
+	position.setInterpolate3(position, target, sweepCallback.m_closestHitFraction);
+	position += hitNormal * CHARACTER_CROWD_SKIN_WIDTH;
+	return true;
+}
+
+static long long GetCellKey(int cellX, int cellY)
+{
+	return ((long long)cellX << 32) | (unsigned int)cellY;
+}
+
+CharacterCrowd::CharacterCrowd()
+{
+}
+
+CharacterCrowd::~CharacterCrowd()
+{
+}
+
+void CharacterCrowd::AddMember(PhysicsMovementComponent* movementComponent)
+{
+	GOKNAR_CORE_ASSERT(movementComponent->crowdMemberIndex_ < 0, "Physics movement component is already in the crowd");
+
+	CharacterCrowdMember member;
+	member.movementComponent = movementComponent;
+	member.ghostObject = (btPairCachingGhostObject*)movementComponent->ownerPhysicsObject_->GetBulletCollisionObject();
+	member.position = member.ghostObject->getWorldTransform().getOrigin();
+
+	btVector3 aabbMin;
+	btVector3 aabbMax;
+	member.ghostObject->getCollisionShape()->getAabb(btTransform(member.ghostObject->getWorldTransform().getBasis()), aabbMin, aabbMax);
+	member.radius = 0.5f * btMax(aabbMax.x() - aabbMin.x(), aabbMax.y() - aabbMin.y());
+	member.halfHeight = 0.5f * (aabbMax.z() - aabbMin.z());
+
+	movementComponent->crowdMemberIndex_ = (int)members_.size();
+	members_.push_back(member);
+}
+
+void CharacterCrowd::RemoveMember(PhysicsMovementComponent* movementComponent)
+{
+	const int memberIndex = movementComponent->crowdMemberIndex_;
+	if (memberIndex < 0)
+	{
+		return;
+	}
+
+	const int lastMemberIndex = (int)members_.size() - 1;
+	if (memberIndex != lastMemberIndex)
+	{
+		members_[memberIndex] = members_[lastMemberIndex];
+		members_[memberIndex].movementComponent->crowdMemberIndex_ = memberIndex;
+	}
+	members_.pop_back();
+
+	movementComponent->crowdMemberIndex_ = -1;
+}
+
+bool CharacterCrowd::GetIsOnGround(const PhysicsMovementComponent* movementComponent) const
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	return members_[movementComponent->crowdMemberIndex_].isOnGround;
+}
+
+void CharacterCrowd::Jump(PhysicsMovementComponent* movementComponent, const btVector3& velocity)
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	if (member.isOnGround)
+	{
+		ApplyImpulse(movementComponent, velocity);
+	}
+}
+
+void CharacterCrowd::SetVelocityForDuration(PhysicsMovementComponent* movementComponent, const btVector3& velocity, float duration)
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	member.velocityForDuration = velocity;
+	member.velocityDuration += duration;
+}
+
+void CharacterCrowd::ClearVelocityForDuration(PhysicsMovementComponent* movementComponent)
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	member.velocityForDuration.setZero();
+	member.velocityDuration = 0.f;
+}
+
+void CharacterCrowd::SetLinearVelocity(PhysicsMovementComponent* movementComponent, const btVector3& velocity)
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	const btVector3 up = PhysicsUtils::FromVector3ToBtVector3(Vector3::UpVector);
+
+	member.verticalVelocity = velocity.dot(up);
+	member.horizontalVelocity = velocity - up * member.verticalVelocity;
+}
+
+btVector3 CharacterCrowd::GetLinearVelocity(const PhysicsMovementComponent* movementComponent) const
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	const CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	return member.horizontalVelocity + PhysicsUtils::FromVector3ToBtVector3(Vector3::UpVector) * member.verticalVelocity;
+}
+
+void CharacterCrowd::ApplyImpulse(PhysicsMovementComponent* movementComponent, const btVector3& impulse)
+{
+	GOKNAR_CORE_ASSERT(0 <= movementComponent->crowdMemberIndex_, "Physics movement component is not in the crowd");
+
+	CharacterCrowdMember& member = members_[movementComponent->crowdMemberIndex_];
+	const btVector3 up = PhysicsUtils::FromVector3ToBtVector3(Vector3::UpVector);
+
+	const btScalar verticalImpulse = impulse.dot(up);
+	member.verticalVelocity += verticalImpulse;
+	member.horizontalVelocity += impulse - up * verticalImpulse;
+
+	if (0.f < verticalImpulse)
+	{
+		member.isOnGround = false;
+	}
+}
+
+void CharacterCrowd::Update(btCollisionWorld* collisionWorld, float deltaTime)
+{
+	const int memberCount = (int)members_.size();
+	if (memberCount == 0)
+	{
+		return;
+	}
+
+	JobManager* jobManager = engine->GetJobManager();
+
+	// Members only write their own entries, the world is only read while the sweeps are running
+	jobManager->ParallelFor(memberCount, CHARACTER_CROWD_BATCH_SIZE,
+		[&](int beginIndex, int endIndex)
+		{
+			for (int memberIndex = beginIndex; memberIndex < endIndex; ++memberIndex)
+			{
+				MoveMember(collisionWorld, members_[memberIndex], deltaTime);
+			}
+		});
+
+	for (int separationIteration = 0; separationIteration < separationIterationCount_; ++separationIteration)
+	{
+		ComputeSeparationOffsets();
+
+		jobManager->ParallelFor(memberCount, CHARACTER_CROWD_BATCH_SIZE,
+			[&](int beginIndex, int endIndex)
+			{
+				for (int memberIndex = beginIndex; memberIndex < endIndex; ++memberIndex)
+				{
+					ApplySeparationOffset(collisionWorld, members_[memberIndex]);
+				}
+			});
+	}
+
+	// Ghost objects and their broadphase entries are written once per step after all the sweeps are done
+	for (CharacterCrowdMember& member : members_)
+	{
+		btTransform worldTransform = member.ghostObject->getWorldTransform();
+		worldTransform.setOrigin(member.position);
+		member.ghostObject->setWorldTransform(worldTransform);
+
+		collisionWorld->updateSingleAabb(member.ghostObject);
+	}
+}
+
+void CharacterCrowd::MoveMember(btCollisionWorld* collisionWorld, CharacterCrowdMember& member, float deltaTime)
+{
+	btKinematicCharacterController* controller = member.movementComponent->GetBulletKinematicCharacterController();
+	const btVector3 up = PhysicsUtils::FromVector3ToBtVector3(Vector3::UpVector);
+
+	// Warps and teleports of the owner are picked up from the ghost object
+	btVector3 position = member.ghostObject->getWorldTransform().getOrigin();
+	btVector3 hitNormal;
+
+	const btScalar gravity = -controller->getGravity().dot(up);
+	member.verticalVelocity = btMax(member.verticalVelocity - gravity * deltaTime, -controller->getFallSpeed());
+
+	const bool isRising = 0.f < member.verticalVelocity;
+
+	// Step up so that small obstacles are walked over, or rise while jumping
+	const btScalar stepUpDistance = member.isOnGround && !isRising ? controller->getStepHeight() : 0.f;
+	const btScalar upDistance = stepUpDistance + (isRising ? member.verticalVelocity * deltaTime : 0.f);
+	btScalar steppedUpDistance = 0.f;
+	if (0.f < upDistance)
+	{
+		const btVector3 startPosition = position;
+		if (SweepCharacter(collisionWorld, member, position, startPosition + up * upDistance, hitNormal) && isRising)
+		{
+			member.verticalVelocity = 0.f;
+		}
+		steppedUpDistance = btMax((position - startPosition).dot(up), btScalar(0.f));
+	}
+
+	// Walk and slide along what is hit
+	btVector3 movement;
+	if (0.f < member.velocityDuration)
+	{
+		const btScalar movementDuration = btMin(deltaTime, member.velocityDuration);
+		movement = member.velocityForDuration * movementDuration;
+		member.velocityDuration -= movementDuration;
+	}
+	else
+	{
+		movement = PhysicsUtils::FromVector3ToBtVector3(member.movementComponent->walkDirection_);
+	}
+
+	movement += member.horizontalVelocity * deltaTime;
+	member.horizontalVelocity *= btPow(btScalar(1.f) - controller->getLinearDamping(), deltaTime);
+
+	for (int slideIteration = 0; slideIteration < CHARACTER_CROWD_SLIDE_ITERATION_COUNT && SIMD_EPSILON < movement.length2(); ++slideIteration)
+	{
+		const btVector3 targetPosition = position + movement;
+		if (!SweepCharacter(collisionWorld, member, position, targetPosition, hitNormal))
+		{
+			break;
+		}
+
+		movement = targetPosition - position;
+		movement -= hitNormal * movement.dot(hitNormal);
+	}
+
+	if (isRising)
+	{
+		member.isOnGround = false;
+	}
+	else
+	{
+		// Step back down and follow the ground for another step height, or fall
+		const btScalar fallDistance = -member.verticalVelocity * deltaTime;
+		const btScalar stepDownDistance = btMin(steppedUpDistance, stepUpDistance);
+		const btVector3 startPosition = position;
+		if (SweepCharacter(collisionWorld, member, position, startPosition - up * (stepDownDistance + stepUpDistance + fallDistance), hitNormal))
+		{
+			member.isOnGround = btCos(controller->getMaxSlope()) <= hitNormal.dot(up);
+			if (member.isOnGround)
+			{
+				member.verticalVelocity = 0.f;
+			}
+		}
+		else
+		{
+			position = startPosition - up * (stepDownDistance + fallDistance);
+			member.isOnGround = false;
+		}
+	}
+
+	member.position = position;
+}
+
+void CharacterCrowd::ComputeSeparationOffsets()
+{
+	const int memberCount = (int)members_.size();
+
+	float maxRadius = 0.f;
+	for (CharacterCrowdMember& member : members_)
+	{
+		member.separationOffset.setZero();
+		maxRadius = btMax(maxRadius, member.radius);
+	}
+
+	if (memberCount < 2 || maxRadius <= 0.f)
+	{
+		return;
+	}
+
+	// Overlapping members are at most two radii apart, so only the neighbouring cells are visited
+	cellSize_ = 2.f * maxRadius;
+
+	cellEntries_.clear();
+	for (int memberIndex = 0; memberIndex < memberCount; ++memberIndex)
+	{
+		const btVector3& position = members_[memberIndex].position;
+		cellEntries_.push_back({ GetCellKey((int)btFloor(position.x() / cellSize_), (int)btFloor(position.y() / cellSize_)), memberIndex });
+	}
+	std::sort(cellEntries_.begin(), cellEntries_.end());
+
+	for (int memberIndex = 0; memberIndex < memberCount; ++memberIndex)
+	{
+		CharacterCrowdMember& member = members_[memberIndex];
+		const int cellX = (int)btFloor(member.position.x() / cellSize_);
+		const int cellY = (int)btFloor(member.position.y() / cellSize_);
+
+		for (int neighbourX = cellX - 1; neighbourX <= cellX + 1; ++neighbourX)
+		{
+			for (int neighbourY = cellY - 1; neighbourY <= cellY + 1; ++neighbourY)
+			{
+				const long long cellKey = GetCellKey(neighbourX, neighbourY);
+
+				std::vector<std::pair<long long, int>>::const_iterator cellEntryIterator =
+					std::lower_bound(cellEntries_.cbegin(), cellEntries_.cend(), std::pair<long long, int>(cellKey, 0));
+				for (; cellEntryIterator != cellEntries_.cend() && cellEntryIterator->first == cellKey; ++cellEntryIterator)
+				{
+					// Every pair is handled once, by its lower index
+					const int otherMemberIndex = cellEntryIterator->second;
+					if (otherMemberIndex <= memberIndex)
+					{
+						continue;
+					}
+
+					CharacterCrowdMember& otherMember = members_[otherMemberIndex];
+
+					btVector3 difference = member.position - otherMember.position;
+					if (member.halfHeight + otherMember.halfHeight <= btFabs(difference.z()))
+					{
+						continue;
+					}
+					difference.setZ(0.f);
+
+					const float minDistance = member.radius + otherMember.radius;
+					const float distanceSquared = difference.length2();
+					if (minDistance * minDistance <= distanceSquared)
+					{
+						continue;
+					}
+
+					// Coincident members are pushed apart along a fixed axis
+					const float distance = btSqrt(distanceSquared);
+					const btVector3 direction = SIMD_EPSILON < distance ? difference / distance : btVector3(1.f, 0.f, 0.f);
+					const btVector3 push = direction * (0.5f * (minDistance - distance));
+
+					member.separationOffset += push;
+					otherMember.separationOffset -= push;
+				}
+			}
+		}
+	}
+}
+
+void CharacterCrowd::ApplySeparationOffset(btCollisionWorld* collisionWorld, CharacterCrowdMember& member)
+{
+	if (member.separationOffset.length2() <= SIMD_EPSILON)
+	{
+		return;
+	}
+
+	// Separation never pushes a member into the static world
+	btVector3 hitNormal;
+	SweepCharacter(collisionWorld, member, member.position, member.position + member.separationOffset, hitNormal);
+}
@@ -0,0 +1,100 @@
+#ifndef __CHARACTERCROWD_H__
+#define __CHARACTERCROWD_H__
+
+#include "Core.h"
+
+#include <utility>
+#include <vector>
+
+#include "LinearMath/btVector3.h"
+
+class btCollisionWorld;
+class btPairCachingGhostObject;
+
+class PhysicsMovementComponent;
+
+struct GOKNAR_API CharacterCrowdMember
+{
+    PhysicsMovementComponent* movementComponent{ nullptr };
+    btPairCachingGhostObject* ghostObject{ nullptr };
+
+    btVector3 position{ 0.f, 0.f, 0.f };
+    btVector3 separationOffset{ 0.f, 0.f, 0.f };
+
+    // Horizontal radius and vertical half extent of the convex shape, used by the separation pass
+    float radius{ 0.f };
+    float halfHeight{ 0.f };
+
+    // Velocity set for a duration replaces the walk direction until the duration runs out
+    btVector3 velocityForDuration{ 0.f, 0.f, 0.f };
+    float velocityDuration{ 0.f };
+
+    // Horizontal part of the velocities set, applied as impulses or jumped with, it is added to the walk direction
+    btVector3 horizontalVelocity{ 0.f, 0.f, 0.f };
+
+    float verticalVelocity{ 0.f };
+    bool isOnGround{ false };
+};
+
+// Moves the characters of PhysicsMovementComponents that are in the crowd instead of Bullet's per character actions
+// Sweeps of all characters run in parallel and only hit the static world,
+// characters are kept apart by a cheap capsule separation pass and their ghost objects are written once per step
+class GOKNAR_API CharacterCrowd
+{
+public:
+    CharacterCrowd();
+    ~CharacterCrowd();
+
+    void AddMember(PhysicsMovementComponent* movementComponent);
+    void RemoveMember(PhysicsMovementComponent* movementComponent);
+
+    int GetMemberCount() const
+    {
+        return (int)members_.size();
+    }
+
+    bool GetIsOnGround(const PhysicsMovementComponent* movementComponent) const;
+
+    // Jumps only from the ground, the up part of the velocity is the jump speed and the rest is kept until the member is slowed down by its linear damping
+    void Jump(PhysicsMovementComponent* movementComponent, const btVector3& velocity);
+
+    // Moves the member with the velocity instead of its walk direction for the duration, set again to extend the duration like Bullet does
+    void SetVelocityForDuration(PhysicsMovementComponent* movementComponent, const btVector3& velocity, float duration);
+    void ClearVelocityForDuration(PhysicsMovementComponent* movementComponent);
+
+    // Unlike Bullet's controller, the horizontal part is added to the walk direction instead of replacing it
+    // The up part is the vertical velocity, gravity pulls it down as usual
+    void SetLinearVelocity(PhysicsMovementComponent* movementComponent, const btVector3& velocity);
+    btVector3 GetLinearVelocity(const PhysicsMovementComponent* movementComponent) const;
+
+    // Adds the impulse to the velocity of the member whether it is on the ground or not
+    void ApplyImpulse(PhysicsMovementComponent* movementComponent, const btVector3& impulse);
+
+    void SetSeparationIterationCount(int separationIterationCount)
+    {
+        separationIterationCount_ = separationIterationCount;
+    }
+
+    int GetSeparationIterationCount() const
+    {
+        return separationIterationCount_;
+    }
+
+    // Called after every internal simulation step, where Bullet would update its actions
+    void Update(btCollisionWorld* collisionWorld, float deltaTime);
+
+private:
+    void MoveMember(btCollisionWorld* collisionWorld, CharacterCrowdMember& member, float deltaTime);
+    void ComputeSeparationOffsets();
+    void ApplySeparationOffset(btCollisionWorld* collisionWorld, CharacterCrowdMember& member);
+
+    std::vector<CharacterCrowdMember> members_;
+
+    // Members sorted by their grid cell for the separation pass, reused between the steps
+    std::vector<std::pair<long long, int>> cellEntries_;
+    float cellSize_{ 1.f };
+
+    int separationIterationCount_{ 2 };
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include "Physics/PhysicsWorld.h"
 #include "Physics/RigidBody.h"
 
+#include "BulletCollision/CollisionDispatch/btCollisionObject.h"
 #include "BulletCollision/CollisionShapes/btCollisionShape.h"
 
 CollisionComponent::CollisionComponent(Component* parent) :
@@ -40,6 +41,31 @@ void CollisionComponent::UpdateTransformation()
 	bulletCollisionShape_->setLocalScaling(PhysicsUtils::FromVector3ToBtVector3(worldScaling_));
 }
 
+void CollisionComponent::ReplaceBulletCollisionShape(btCollisionShape* bulletCollisionShape)
+{
+	bulletCollisionShape_ = bulletCollisionShape;
+
+	PhysicsObject* physicsObject = dynamic_cast<PhysicsObject*>(GetOwner());
+	if (!physicsObject || physicsObject->GetCollisionComponent() != this)
+	{
+		return;
+	}
+
+	btCollisionObject* bulletCollisionObject = physicsObject->GetBulletCollisionObject();
+	if (!bulletCollisionObject)
+	{
+		return;
+	}
+
+	bulletCollisionObject->setCollisionShape(bulletCollisionShape_);
+
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	if (physicsWorld && bulletCollisionObject->getBroadphaseHandle())
+	{
+		physicsWorld->GetBulletPhysicsWorld()->updateSingleAabb(bulletCollisionObject);
+	}
+}
+
 void CollisionComponent::PreInit()
 {
 	Component::PreInit();
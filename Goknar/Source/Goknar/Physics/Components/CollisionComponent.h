@@ -95,6 +95,9 @@ public:
 	Delegate<OverlapEndAlias> OnOverlapEnd;
 
 protected:
+	// Switches the shape of an initialized owner's collision object as well, the previous shape is not destroyed
+	void ReplaceBulletCollisionShape(btCollisionShape* bulletCollisionShape);
+
 	btCollisionShape* bulletCollisionShape_{ nullptr };
 
 private:
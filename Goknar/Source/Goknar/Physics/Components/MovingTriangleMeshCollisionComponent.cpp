@@ -1,12 +1,11 @@
 #include "pch.h"
 
-#include "BulletCollision/CollisionShapes/btTriangleMesh.h"
-#include "BulletCollision/CollisionShapes/btConvexHullShape.h"
-
+#include "Engine.h"
 #include "ObjectBase.h"
 #include "MovingTriangleMeshCollisionComponent.h"
 #include "Model/MeshUnit.h"
-#include "Physics/PhysicsUtils.h"
+#include "Physics/PhysicsShapeCache.h"
+#include "Physics/PhysicsWorld.h"
 
 MovingTriangleMeshCollisionComponent::MovingTriangleMeshCollisionComponent(Component* parent) :
 	CollisionComponent(parent)
@@ -21,18 +20,21 @@ MovingTriangleMeshCollisionComponent::MovingTriangleMeshCollisionComponent(Objec
 
 MovingTriangleMeshCollisionComponent::~MovingTriangleMeshCollisionComponent()
 {
+	// Shape is owned by the shape cache
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	if (physicsWorld && bulletCollisionShape_)
+	{
+		physicsWorld->GetShapeCache()->ReleaseShape(bulletCollisionShape_);
+	}
+	bulletCollisionShape_ = nullptr;
 }
 
 void MovingTriangleMeshCollisionComponent::PreInit()
 {
 	GOKNAR_ASSERT(relativeMesh_ != nullptr);
 
-	const VertexArray* vertexArray = relativeMesh_->GetVerticesPointer();
-	int vertexCount = relativeMesh_->GetVertexCount();
-
-	GOKNAR_ASSERT(0 < vertexCount);
-
-	bulletCollisionShape_ = new btConvexHullShape(&vertexArray->at(0).position.x, vertexCount, sizeof(VertexData));
+	shapeScaling_ = worldScaling_;
+	bulletCollisionShape_ = engine->GetPhysicsWorld()->GetShapeCache()->AcquireConvexHullShape(relativeMesh_, shapeScaling_, convexHullSettings_);
 
 	CollisionComponent::PreInit();
 }
@@ -57,4 +59,22 @@ void MovingTriangleMeshCollisionComponent::TickComponent(float deltaTime)
 	CollisionComponent::TickComponent(deltaTime);
 
 	
-}
\ No newline at end of file
+}
+
+void MovingTriangleMeshCollisionComponent::UpdateTransformation()
+{
+	// Cached shapes are shared and cannot be scaled per component, a different scaling uses another cached shape
+	if (!bulletCollisionShape_ || shapeScaling_ == worldScaling_)
+	{
+		return;
+	}
+
+	PhysicsShapeCache* shapeCache = engine->GetPhysicsWorld()->GetShapeCache();
+
+	btCollisionShape* previousBulletCollisionShape = bulletCollisionShape_;
+
+	shapeScaling_ = worldScaling_;
+	ReplaceBulletCollisionShape(shapeCache->AcquireConvexHullShape(relativeMesh_, shapeScaling_, convexHullSettings_));
+
+	shapeCache->ReleaseShape(previousBulletCollisionShape);
+}
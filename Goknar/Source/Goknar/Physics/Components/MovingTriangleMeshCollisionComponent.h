@@ -2,11 +2,10 @@
 #define __MOVINGTRIANGLEMESHCOLLISIONCOMPONENT_H__
 
 #include "CollisionComponent.h"
+#include "Physics/ConvexDecomposition.h"
 
 class MeshUnit;
 
-class btTriangleMesh;
-
 // For static(moving) mesh collisions
 class GOKNAR_API MovingTriangleMeshCollisionComponent : public CollisionComponent
 {
@@ -22,6 +21,8 @@ public:
 	virtual void BeginGame() override;
 	virtual void TickComponent(float deltaTime) override;
 
+	virtual void UpdateTransformation() override;
+
 	const MeshUnit* GetMesh() const
 	{
 		return relativeMesh_;
@@ -32,9 +33,25 @@ public:
 		relativeMesh_ = relativeMesh;
 	}
 
+	// Hull vertex budget and convex decomposition of the mesh, has to be set before initialization
+	const ConvexHullSettings& GetConvexHullSettings() const
+	{
+		return convexHullSettings_;
+	}
+
+	void SetConvexHullSettings(const ConvexHullSettings& convexHullSettings)
+	{
+		convexHullSettings_ = convexHullSettings;
+	}
+
 protected:
 private:
 	const MeshUnit* relativeMesh_{ nullptr };
+
+	ConvexHullSettings convexHullSettings_;
+
+	// Scaling the cached shape is acquired with
+	Vector3 shapeScaling_{ Vector3{ 1.f } };
 };
 
 #endif
\ No newline at end of file
@@ -1,12 +1,11 @@
 #include "pch.h"
 
-#include "BulletCollision/CollisionShapes/btTriangleMesh.h"
-#include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
-
+#include "Engine.h"
 #include "ObjectBase.h"
 #include "NonMovingTriangleMeshCollisionComponent.h"
 #include "Model/MeshUnit.h"
-#include "Physics/PhysicsUtils.h"
+#include "Physics/PhysicsShapeCache.h"
+#include "Physics/PhysicsWorld.h"
 
 NonMovingTriangleMeshCollisionComponent::NonMovingTriangleMeshCollisionComponent(Component* parent) :
 	CollisionComponent(parent)
@@ -21,36 +20,21 @@ NonMovingTriangleMeshCollisionComponent::NonMovingTriangleMeshCollisionComponent
 
 NonMovingTriangleMeshCollisionComponent::~NonMovingTriangleMeshCollisionComponent()
 {
-	delete bulletTriangleMesh_;
+	// Shape is owned by the shape cache
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	if (physicsWorld && bulletCollisionShape_)
+	{
+		physicsWorld->GetShapeCache()->ReleaseShape(bulletCollisionShape_);
+	}
+	bulletCollisionShape_ = nullptr;
 }
 
 void NonMovingTriangleMeshCollisionComponent::PreInit()
 {
 	GOKNAR_ASSERT(relativeMesh_ != nullptr);
 
-	bulletTriangleMesh_ = new btTriangleMesh(true, false);
-
-	const Box& relativeMeshAABB = relativeMesh_->GetAABB();
-	bulletTriangleMesh_->setPremadeAabb(
-		PhysicsUtils::FromVector3ToBtVector3(relativeMeshAABB.GetMin()),
-		PhysicsUtils::FromVector3ToBtVector3(relativeMeshAABB.GetMax())
-	);
-
-	const VertexArray* vertexArray = relativeMesh_->GetVerticesPointer();
-
-	const FaceArray* faceArray = relativeMesh_->GetFacesPointer();
-	int faceCount = relativeMesh_->GetFaceCount();
-
-	for (int faceIndex = 0; faceIndex < faceCount; faceIndex++)
-	{
-		const Face& face = faceArray->at(faceIndex);
-		bulletTriangleMesh_->addTriangle(
-			PhysicsUtils::FromVector3ToBtVector3(vertexArray->at(face.vertexIndices[0]).position),
-			PhysicsUtils::FromVector3ToBtVector3(vertexArray->at(face.vertexIndices[2]).position),
-			PhysicsUtils::FromVector3ToBtVector3(vertexArray->at(face.vertexIndices[1]).position)
-			);
-	}
-	bulletCollisionShape_ = new btBvhTriangleMeshShape(bulletTriangleMesh_, true, true);
+	shapeScaling_ = worldScaling_;
+	bulletCollisionShape_ = engine->GetPhysicsWorld()->GetShapeCache()->AcquireTriangleMeshShape(relativeMesh_, shapeScaling_);
 
 	CollisionComponent::PreInit();
 }
@@ -75,4 +59,22 @@ void NonMovingTriangleMeshCollisionComponent::TickComponent(float deltaTime)
 	CollisionComponent::TickComponent(deltaTime);
 
 	
-}
\ No newline at end of file
+}
+
+void NonMovingTriangleMeshCollisionComponent::UpdateTransformation()
+{
+	// Cached shapes are shared and cannot be scaled per component, a different scaling uses another cached shape
+	if (!bulletCollisionShape_ || shapeScaling_ == worldScaling_)
+	{
+		return;
+	}
+
+	PhysicsShapeCache* shapeCache = engine->GetPhysicsWorld()->GetShapeCache();
+
+	btCollisionShape* previousBulletCollisionShape = bulletCollisionShape_;
+
+	shapeScaling_ = worldScaling_;
+	ReplaceBulletCollisionShape(shapeCache->AcquireTriangleMeshShape(relativeMesh_, shapeScaling_));
+
+	shapeCache->ReleaseShape(previousBulletCollisionShape);
+}
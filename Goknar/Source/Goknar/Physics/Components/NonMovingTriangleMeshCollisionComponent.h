@@ -5,8 +5,6 @@
 
 class MeshUnit;
 
-class btTriangleMesh;
-
 // For static(non-moving) collisions
 class GOKNAR_API NonMovingTriangleMeshCollisionComponent : public CollisionComponent
 {
@@ -22,6 +20,8 @@ public:
 	virtual void BeginGame() override;
 	virtual void TickComponent(float deltaTime) override;
 
+	virtual void UpdateTransformation() override;
+
 	const MeshUnit* GetMesh() const
 	{
 		return relativeMesh_;
@@ -35,7 +35,9 @@ public:
 protected:
 private:
 	const MeshUnit* relativeMesh_{ nullptr };
-	btTriangleMesh* bulletTriangleMesh_;
+
+	// Scaling the cached shape is acquired with
+	Vector3 shapeScaling_{ Vector3{ 1.f } };
 };
 
 #endif
\ No newline at end of file
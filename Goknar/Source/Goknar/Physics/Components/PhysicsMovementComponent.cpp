@@ -7,6 +7,7 @@
 #include "Physics/RigidBody.h"
 
 #include "Physics/Character.h"
+#include "Physics/CharacterCrowd.h"
 #include "Physics/Components/CollisionComponent.h"
 #include "Physics/Components/NonMovingTriangleMeshCollisionComponent.h"
 
@@ -88,19 +89,39 @@ void PhysicsMovementComponent::Init()
 
 	bulletKinematicCharacterController_->setGravity(PhysicsUtils::FromVector3ToBtVector3(initializationData_->gravity));
 
+	// Crowd characters keep their velocities in the crowd, the controller only holds their settings
+	CharacterCrowd* characterCrowd = isInCrowd_ ? physicsWorld->GetCharacterCrowd() : nullptr;
+
 	if (initializationData_->isVelocityForGivenDurationSet)
 	{
-		bulletKinematicCharacterController_->setVelocityForTimeInterval(PhysicsUtils::FromVector3ToBtVector3(initializationData_->movementVelocityForGivenDuration), initializationData_->movementVelocityForGivenDurationDuration);
+		const btVector3 movementVelocity = PhysicsUtils::FromVector3ToBtVector3(initializationData_->movementVelocityForGivenDuration);
+		if (characterCrowd)
+		{
+			characterCrowd->SetVelocityForDuration(this, movementVelocity, initializationData_->movementVelocityForGivenDurationDuration);
+		}
+		else
+		{
+			bulletKinematicCharacterController_->setVelocityForTimeInterval(movementVelocity, initializationData_->movementVelocityForGivenDurationDuration);
+		}
 	}
 
 	if (initializationData_->isMovementDirectionSet)
 	{
-		bulletKinematicCharacterController_->setWalkDirection(PhysicsUtils::FromVector3ToBtVector3(initializationData_->movementDirection * movementSpeed_));
+		walkDirection_ = initializationData_->movementDirection * movementSpeed_;
+		bulletKinematicCharacterController_->setWalkDirection(PhysicsUtils::FromVector3ToBtVector3(walkDirection_));
 	}
 
 	if (initializationData_->isLinearVelocitySet)
 	{
-		bulletKinematicCharacterController_->setLinearVelocity(PhysicsUtils::FromVector3ToBtVector3(initializationData_->linearVelocity));
+		const btVector3 linearVelocity = PhysicsUtils::FromVector3ToBtVector3(initializationData_->linearVelocity);
+		if (characterCrowd)
+		{
+			characterCrowd->SetLinearVelocity(this, linearVelocity);
+		}
+		else
+		{
+			bulletKinematicCharacterController_->setLinearVelocity(linearVelocity);
+		}
 	}
 	
 	if (initializationData_->isAngularVelocitySet)
@@ -110,7 +131,15 @@ void PhysicsMovementComponent::Init()
 	
 	if (initializationData_->isImpulseSet)
 	{
-		bulletKinematicCharacterController_->applyImpulse(PhysicsUtils::FromVector3ToBtVector3(initializationData_->impulse));
+		const btVector3 impulse = PhysicsUtils::FromVector3ToBtVector3(initializationData_->impulse);
+		if (characterCrowd)
+		{
+			characterCrowd->ApplyImpulse(this, impulse);
+		}
+		else
+		{
+			bulletKinematicCharacterController_->applyImpulse(impulse);
+		}
 	}
 
 	bulletKinematicCharacterController_->setLinearDamping(initializationData_->linearDamping);
@@ -156,7 +185,15 @@ void PhysicsMovementComponent::SetMovementDirection(const Vector3& movementDirec
 		return;
 	}
 
-	bulletKinematicCharacterController_->setWalkDirection(PhysicsUtils::FromVector3ToBtVector3(movementDirection * movementSpeed_));
+	walkDirection_ = movementDirection * movementSpeed_;
+
+	// Setting a walk direction ends the velocity set for a duration
+	if (isInCrowd_)
+	{
+		engine->GetPhysicsWorld()->GetCharacterCrowd()->ClearVelocityForDuration(this);
+	}
+
+	bulletKinematicCharacterController_->setWalkDirection(PhysicsUtils::FromVector3ToBtVector3(walkDirection_));
 }
 
 void PhysicsMovementComponent::SetMovementVelocityForGivenDuration(const Vector3& movementVelocity, float duration)
@@ -169,6 +206,12 @@ void PhysicsMovementComponent::SetMovementVelocityForGivenDuration(const Vector3
 		return;
 	}
 
+	if (isInCrowd_)
+	{
+		engine->GetPhysicsWorld()->GetCharacterCrowd()->SetVelocityForDuration(this, PhysicsUtils::FromVector3ToBtVector3(movementVelocity), duration);
+		return;
+	}
+
 	bulletKinematicCharacterController_->setVelocityForTimeInterval(PhysicsUtils::FromVector3ToBtVector3(movementVelocity), duration);
 }
 
@@ -203,6 +246,12 @@ void PhysicsMovementComponent::SetLinearVelocity(const Vector3& linearVelocity)
 		return;
 	}
 
+	if (isInCrowd_)
+	{
+		engine->GetPhysicsWorld()->GetCharacterCrowd()->SetLinearVelocity(this, PhysicsUtils::FromVector3ToBtVector3(linearVelocity));
+		return;
+	}
+
 	bulletKinematicCharacterController_->setLinearVelocity(PhysicsUtils::FromVector3ToBtVector3(linearVelocity));
 }
 
@@ -213,6 +262,11 @@ Vector3 PhysicsMovementComponent::GetLinearVelocity() const
 		return initializationData_->linearVelocity;
 	}
 
+	if (isInCrowd_)
+	{
+		return PhysicsUtils::FromBtVector3ToVector3(engine->GetPhysicsWorld()->GetCharacterCrowd()->GetLinearVelocity(this));
+	}
+
 	return PhysicsUtils::FromBtVector3ToVector3(bulletKinematicCharacterController_->getLinearVelocity());
 }
 
@@ -377,11 +431,24 @@ void PhysicsMovementComponent::SetMaxJumpHeight(float maxJumpHeight)
 
 bool PhysicsMovementComponent::CanJump() const
 {
+	if (isInCrowd_)
+	{
+		return engine->GetPhysicsWorld()->GetCharacterCrowd()->GetIsOnGround(this);
+	}
+
 	return bulletKinematicCharacterController_->canJump();
 }
 
 void PhysicsMovementComponent::Jump(const Vector3& v)
 {
+	if (isInCrowd_)
+	{
+		// Like Bullet, a zero vector jumps up with the jump speed and any other vector is the jump velocity
+		const Vector3 jumpVelocity = v == Vector3::ZeroVector ? Vector3::UpVector * GetJumpSpeed() : v;
+		engine->GetPhysicsWorld()->GetCharacterCrowd()->Jump(this, PhysicsUtils::FromVector3ToBtVector3(jumpVelocity));
+		return;
+	}
+
 	bulletKinematicCharacterController_->jump(PhysicsUtils::FromVector3ToBtVector3(v));
 }
 
@@ -394,6 +461,12 @@ void PhysicsMovementComponent::ApplyImpulse(const Vector3& impulse)
 		return;
 	}
 
+	if (isInCrowd_)
+	{
+		engine->GetPhysicsWorld()->GetCharacterCrowd()->ApplyImpulse(this, PhysicsUtils::FromVector3ToBtVector3(impulse));
+		return;
+	}
+
 	bulletKinematicCharacterController_->applyImpulse(PhysicsUtils::FromVector3ToBtVector3(impulse));
 }
 
@@ -470,8 +543,14 @@ void PhysicsMovementComponent::SetUseGhostSweepTest(bool useGhostObjectSweepTest
 
 	bulletKinematicCharacterController_->setUseGhostSweepTest(useGhostObjectSweepTest);
 }
+
 bool PhysicsMovementComponent::OnGround() const
 {
+	if (isInCrowd_)
+	{
+		return engine->GetPhysicsWorld()->GetCharacterCrowd()->GetIsOnGround(this);
+	}
+
 	return bulletKinematicCharacterController_->onGround();
 }
 
@@ -486,6 +565,26 @@ void PhysicsMovementComponent::SetUpInterpolate(bool upInterpolate)
 	bulletKinematicCharacterController_->setUpInterpolate(upInterpolate);
 }
 
+void PhysicsMovementComponent::SetIsInCrowd(bool isInCrowd)
+{
+	if (isInCrowd_ == isInCrowd)
+	{
+		return;
+	}
+
+	if (!GetIsInitialized())
+	{
+		isInCrowd_ = isInCrowd;
+		return;
+	}
+
+	// Re-registering moves the character between the crowd and Bullet's actions
+	PhysicsWorld* physicsWorld = engine->GetPhysicsWorld();
+	physicsWorld->RemovePhysicsMovementComponent(this);
+	isInCrowd_ = isInCrowd;
+	physicsWorld->AddPhysicsMovementComponent(this);
+}
+
 void PhysicsMovementComponent::UpdateOwnerTransformation()
 {
 	const btTransform& bulletWorldTransform = ownerPhysicsObject_->GetBulletCollisionObject()->getWorldTransform();
@@ -41,6 +41,7 @@ struct GOKNAR_API PhysicsMovementComponentInitializationData
 
 class GOKNAR_API PhysicsMovementComponent : public Component
 {
+	friend class CharacterCrowd;
 public:
 	PhysicsMovementComponent(Component* parent);
 	PhysicsMovementComponent(ObjectBase* parentObjectBase);
@@ -125,6 +126,17 @@ public:
 
 	virtual void UpdateOwnerTransformation();
 
+	// Crowd characters are moved by the physics world's CharacterCrowd instead of Bullet's kinematic character controller
+	// They walk, step, fall and jump against the static world and are separated from each other
+	// Velocities of crowd characters are kept by the crowd, they differ from Bullet's controller in a few ways:
+	// SetLinearVelocity, ApplyImpulse and Jump add their horizontal parts to the movement direction instead of replacing it,
+	// that part is slowed down by the linear damping, and Jump only works on the ground
+	void SetIsInCrowd(bool isInCrowd);
+	bool GetIsInCrowd() const
+	{
+		return isInCrowd_;
+	}
+
 	void SetMovementSpeed(float movementSpeed)
 	{
 		movementSpeed_ = movementSpeed;
@@ -146,7 +158,13 @@ private:
 	CollisionComponent* collisionComponent_{ nullptr };
 	OverlappingPhysicsObject* ownerPhysicsObject_{ nullptr };
 
+	// Displacement per simulation step
+	Vector3 walkDirection_{ Vector3::ZeroVector };
+
 	float movementSpeed_{ 0.25f };
+
+	int crowdMemberIndex_{ -1 };
+	bool isInCrowd_{ false };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "pch.h"
+
+#include "ConvexDecomposition.h"
+
+#include "LinearMath/btConvexHullComputer.h"
+
+#include "Model/MeshUnit.h"
+#include "Physics/PhysicsUtils.h"
+
+bool ConvexHullSettings::operator<(const ConvexHullSettings& other) const
+{
+	if (vertexLimit != other.vertexLimit)
+	{
+		return vertexLimit < other.vertexLimit;
+	}
+
+	if (isConvexDecompositionEnabled != other.isConvexDecompositionEnabled)
+	{
+		return isConvexDecompositionEnabled < other.isConvexDecompositionEnabled;
+	}
+
+	if (maxConvexHullCount != other.maxConvexHullCount)
+	{
+		return maxConvexHullCount < other.maxConvexHullCount;
+	}
+
+	return concavityThreshold < other.concavityThreshold;
+}
+
+void ConvexDecomposition::ReduceConvexHull(const PointArray& points, int vertexLimit, PointArray& outHullPoints)
+{
+	outHullPoints.clear();
+
+	if (points.empty())
+	{
+		return;
+	}
+
+	// Interior points are dropped first
+	btConvexHullComputer convexHullComputer;
+	convexHullComputer.compute((const btScalar*)points[0], sizeof(btVector3), (int)points.size(), 0.f, 0.f);
+
+	const int hullVertexCount = convexHullComputer.vertices.size();
+	if (hullVertexCount == 0)
+	{
+		outHullPoints = points;
+		return;
+	}
+
+	if (vertexLimit <= 0 || hullVertexCount <= vertexLimit)
+	{
+		outHullPoints.reserve(hullVertexCount);
+		for (int hullVertexIndex = 0; hullVertexIndex < hullVertexCount; ++hullVertexIndex)
+		{
+			outHullPoints.push_back(convexHullComputer.vertices[hullVertexIndex]);
+		}
+		return;
+	}
+
+	// Support points along directions spread evenly on a sphere(Fibonacci lattice)
+	std::vector<bool> isHullVertexSelected(hullVertexCount, false);
+
+	const float goldenAngle = PI * (3.f - std::sqrt(5.f));
+	for (int directionIndex = 0; directionIndex < vertexLimit; ++directionIndex)
+	{
+		const float z = 1.f - 2.f * (directionIndex + 0.5f) / vertexLimit;
+		const float radius = std::sqrt(1.f - z * z);
+		const float angle = goldenAngle * directionIndex;
+		const btVector3 direction(radius * std::cos(angle), radius * std::sin(angle), z);
+
+		int supportVertexIndex = 0;
+		btScalar supportDistance = direction.dot(convexHullComputer.vertices[0]);
+		for (int hullVertexIndex = 1; hullVertexIndex < hullVertexCount; ++hullVertexIndex)
+		{
+			const btScalar distance = direction.dot(convexHullComputer.vertices[hullVertexIndex]);
+			if (supportDistance < distance)
+			{
+				supportDistance = distance;
+				supportVertexIndex = hullVertexIndex;
+			}
+		}
+
+		if (!isHullVertexSelected[supportVertexIndex])
+		{
+			isHullVertexSelected[supportVertexIndex] = true;
+			outHullPoints.push_back(convexHullComputer.vertices[supportVertexIndex]);
+		}
+	}
+}
+
+void ConvexDecomposition::BuildConvexHulls(const MeshUnit* mesh, const ConvexHullSettings& settings, std::vector<PointArray>& outConvexHulls)
+{
+	outConvexHulls.clear();
+
+	const VertexData* vertexData = mesh->GetVertexData();
+	const int vertexCount = mesh->GetVertexCount();
+
+	if (!settings.isConvexDecompositionEnabled || settings.maxConvexHullCount <= 1)
+	{
+		PointArray points;
+		points.reserve(vertexCount);
+		for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			points.push_back(PhysicsUtils::FromVector3ToBtVector3(vertexData[vertexIndex].position));
+		}
+
+		outConvexHulls.emplace_back();
+		ReduceConvexHull(points, settings.vertexLimit, outConvexHulls.back());
+		return;
+	}
+
+	const Face* faceData = mesh->GetFaceData();
+	const int faceCount = mesh->GetFaceCount();
+
+	std::vector<btVector3> trianglePoints;
+	trianglePoints.reserve(faceCount * 3);
+
+	btVector3 meshMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+	btVector3 meshMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
+	{
+		const Face& face = faceData[faceIndex];
+		for (int faceVertexIndex = 0; faceVertexIndex < 3; ++faceVertexIndex)
+		{
+			const btVector3 point = PhysicsUtils::FromVector3ToBtVector3(vertexData[face.vertexIndices[faceVertexIndex]].position);
+			meshMin.setMin(point);
+			meshMax.setMax(point);
+			trianglePoints.push_back(point);
+		}
+	}
+
+	const float concavityThreshold = settings.concavityThreshold * (meshMax - meshMin).length();
+
+	struct MeshPiece
+	{
+		std::vector<int> triangleIndices;
+		float concavity{ 0.f };
+	};
+
+	std::vector<MeshPiece> meshPieces(1);
+	meshPieces[0].triangleIndices.resize(faceCount);
+	for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
+	{
+		meshPieces[0].triangleIndices[faceIndex] = faceIndex;
+	}
+	meshPieces[0].concavity = CalculateConcavity(trianglePoints, meshPieces[0].triangleIndices);
+
+	std::vector<float> triangleCentroidValues;
+
+	// The most concave piece is split in two until every piece is convex enough or the hull budget is spent
+	while ((int)meshPieces.size() < settings.maxConvexHullCount)
+	{
+		int mostConcaveMeshPieceIndex = 0;
+		for (int meshPieceIndex = 1; meshPieceIndex < (int)meshPieces.size(); ++meshPieceIndex)
+		{
+			if (meshPieces[mostConcaveMeshPieceIndex].concavity < meshPieces[meshPieceIndex].concavity)
+			{
+				mostConcaveMeshPieceIndex = meshPieceIndex;
+			}
+		}
+
+		MeshPiece& meshPiece = meshPieces[mostConcaveMeshPieceIndex];
+		if (meshPiece.concavity <= concavityThreshold)
+		{
+			break;
+		}
+
+		// Split along the longest axis of the piece, at the median of its triangle centroids
+		btVector3 pieceMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+		btVector3 pieceMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+		for (int triangleIndex : meshPiece.triangleIndices)
+		{
+			const btVector3 centroid = (trianglePoints[3 * triangleIndex] + trianglePoints[3 * triangleIndex + 1] + trianglePoints[3 * triangleIndex + 2]) / 3.f;
+			pieceMin.setMin(centroid);
+			pieceMax.setMax(centroid);
+		}
+		const int splitAxis = (pieceMax - pieceMin).maxAxis();
+
+		triangleCentroidValues.clear();
+		for (int triangleIndex : meshPiece.triangleIndices)
+		{
+			triangleCentroidValues.push_back(trianglePoints[3 * triangleIndex][splitAxis] + trianglePoints[3 * triangleIndex + 1][splitAxis] + trianglePoints[3 * triangleIndex + 2][splitAxis]);
+		}
+
+		std::vector<float>::iterator medianIterator = triangleCentroidValues.begin() + triangleCentroidValues.size() / 2;
+		std::nth_element(triangleCentroidValues.begin(), medianIterator, triangleCentroidValues.end());
+		const float splitValue = *medianIterator;
+
+		MeshPiece lowerMeshPiece;
+		MeshPiece upperMeshPiece;
+		for (int triangleIndex : meshPiece.triangleIndices)
+		{
+			const float centroidValue = trianglePoints[3 * triangleIndex][splitAxis] + trianglePoints[3 * triangleIndex + 1][splitAxis] + trianglePoints[3 * triangleIndex + 2][splitAxis];
+			(centroidValue < splitValue ? lowerMeshPiece : upperMeshPiece).triangleIndices.push_back(triangleIndex);
+		}
+
+		// Piece cannot be split any further
+		if (lowerMeshPiece.triangleIndices.empty() || upperMeshPiece.triangleIndices.empty())
+		{
+			meshPiece.concavity = 0.f;
+			continue;
+		}
+
+		lowerMeshPiece.concavity = CalculateConcavity(trianglePoints, lowerMeshPiece.triangleIndices);
+		upperMeshPiece.concavity = CalculateConcavity(trianglePoints, upperMeshPiece.triangleIndices);
+
+		meshPiece = std::move(lowerMeshPiece);
+		meshPieces.push_back(std::move(upperMeshPiece));
+	}
+
+	PointArray piecePoints;
+	for (const MeshPiece& meshPiece : meshPieces)
+	{
+		GetTrianglePiecePoints(trianglePoints, meshPiece.triangleIndices, piecePoints);
+
+		outConvexHulls.emplace_back();
+		ReduceConvexHull(piecePoints, settings.vertexLimit, outConvexHulls.back());
+	}
+}
+
+uint64_t ConvexDecomposition::GetHash(const MeshUnit* mesh, const ConvexHullSettings& settings)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	const auto hashBytes =
+		[&hash](const void* data, size_t size)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			for (size_t byteIndex = 0; byteIndex < size; ++byteIndex)
+			{
+				hash = (hash ^ bytes[byteIndex]) * 1099511628211ull;
+			}
+		};
+
+	const VertexData* vertexData = mesh->GetVertexData();
+	const unsigned int vertexCount = mesh->GetVertexCount();
+	for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		hashBytes(&vertexData[vertexIndex].position, sizeof(Vector3));
+	}
+
+	if (settings.isConvexDecompositionEnabled)
+	{
+		hashBytes(mesh->GetFaceData(), mesh->GetFaceCount() * sizeof(Face));
+	}
+
+	hashBytes(&settings.vertexLimit, sizeof(int));
+	hashBytes(&settings.isConvexDecompositionEnabled, sizeof(bool));
+	hashBytes(&settings.maxConvexHullCount, sizeof(int));
+	hashBytes(&settings.concavityThreshold, sizeof(float));
+
+	return hash;
+}
+
+float ConvexDecomposition::CalculateConcavity(const std::vector<btVector3>& trianglePoints, const std::vector<int>& triangleIndices)
+{
+	PointArray points;
+	GetTrianglePiecePoints(trianglePoints, triangleIndices, points);
+
+	btConvexHullComputer convexHullComputer;
+	convexHullComputer.compute((const btScalar*)points[0], sizeof(btVector3), (int)points.size(), 0.f, 0.f);
+
+	const int hullVertexCount = convexHullComputer.vertices.size();
+	const int hullFaceCount = convexHullComputer.faces.size();
+	if (hullVertexCount == 0 || hullFaceCount == 0)
+	{
+		return 0.f;
+	}
+
+	btVector3 hullCenter(0.f, 0.f, 0.f);
+	for (int hullVertexIndex = 0; hullVertexIndex < hullVertexCount; ++hullVertexIndex)
+	{
+		hullCenter += convexHullComputer.vertices[hullVertexIndex];
+	}
+	hullCenter /= (btScalar)hullVertexCount;
+
+	std::vector<btVector3> planeNormals;
+	std::vector<btScalar> planeDistances;
+	for (int hullFaceIndex = 0; hullFaceIndex < hullFaceCount; ++hullFaceIndex)
+	{
+		const btConvexHullComputer::Edge* edge = &convexHullComputer.edges[convexHullComputer.faces[hullFaceIndex]];
+		const btVector3& point0 = convexHullComputer.vertices[edge->getSourceVertex()];
+		const btVector3& point1 = convexHullComputer.vertices[edge->getTargetVertex()];
+		const btVector3& point2 = convexHullComputer.vertices[edge->getNextEdgeOfFace()->getTargetVertex()];
+
+		btVector3 planeNormal = (point1 - point0).cross(point2 - point0);
+		if (planeNormal.length2() < SIMD_EPSILON)
+		{
+			continue;
+		}
+		planeNormal.normalize();
+
+		// Normals are made to point outwards
+		if (0.f < planeNormal.dot(hullCenter - point0))
+		{
+			planeNormal = -planeNormal;
+		}
+
+		planeNormals.push_back(planeNormal);
+		planeDistances.push_back(planeNormal.dot(point0));
+	}
+
+	// Concavity is how deep the surface of the piece gets inside its hull
+	float concavity = 0.f;
+	const int triangleCount = (int)triangleIndices.size();
+	for (int triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const int firstPointIndex = 3 * triangleIndices[triangleIndex];
+		const btVector3 centroid = (trianglePoints[firstPointIndex] + trianglePoints[firstPointIndex + 1] + trianglePoints[firstPointIndex + 2]) / 3.f;
+
+		btScalar depth = BT_LARGE_FLOAT;
+		const int planeCount = (int)planeNormals.size();
+		for (int planeIndex = 0; planeIndex < planeCount; ++planeIndex)
+		{
+			depth = btMin(depth, planeDistances[planeIndex] - planeNormals[planeIndex].dot(centroid));
+		}
+
+		if (depth < BT_LARGE_FLOAT)
+		{
+			concavity = btMax(concavity, (float)depth);
+		}
+	}
+
+	return concavity;
+}
+
+void ConvexDecomposition::GetTrianglePiecePoints(const std::vector<btVector3>& trianglePoints, const std::vector<int>& triangleIndices, PointArray& outPoints)
+{
+	outPoints.clear();
+	outPoints.reserve(triangleIndices.size() * 3);
+
+	for (int triangleIndex : triangleIndices)
+	{
+		outPoints.push_back(trianglePoints[3 * triangleIndex]);
+		outPoints.push_back(trianglePoints[3 * triangleIndex + 1]);
+		outPoints.push_back(trianglePoints[3 * triangleIndex + 2]);
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef __CONVEXDECOMPOSITION_H__
+#define __CONVEXDECOMPOSITION_H__
+
+#include "Core.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "LinearMath/btVector3.h"
+
+class MeshUnit;
+
+struct GOKNAR_API ConvexHullSettings
+{
+    // Maximum vertex count of a hull, 0 keeps every vertex on the hull
+    int vertexLimit{ 64 };
+
+    // Splits the mesh into multiple convex hulls that follow its concave parts
+    bool isConvexDecompositionEnabled{ false };
+    int maxConvexHullCount{ 16 };
+
+    // Pieces deeper than this fraction of the mesh's bounding box diagonal inside their hull are split further
+    float concavityThreshold{ 0.02f };
+
+    bool operator<(const ConvexHullSettings& other) const;
+};
+
+// Builds simplified convex hulls of meshes for dynamic collision shapes
+class GOKNAR_API ConvexDecomposition
+{
+public:
+    typedef std::vector<btVector3> PointArray;
+
+    // Points on the convex hull of the given points, reduced to at most vertexLimit points
+    // by keeping the hull vertices furthest along evenly distributed directions
+    static void ReduceConvexHull(const PointArray& points, int vertexLimit, PointArray& outHullPoints);
+
+    // Convex hulls approximating the mesh, a single hull unless convex decomposition is enabled
+    static void BuildConvexHulls(const MeshUnit* mesh, const ConvexHullSettings& settings, std::vector<PointArray>& outConvexHulls);
+
+    // Hash of the mesh's vertex positions and the settings
+    static uint64_t GetHash(const MeshUnit* mesh, const ConvexHullSettings& settings);
+
+private:
+    static float CalculateConcavity(const std::vector<btVector3>& trianglePoints, const std::vector<int>& triangleIndices);
+    static void GetTrianglePiecePoints(const std::vector<btVector3>& trianglePoints, const std::vector<int>& triangleIndices, PointArray& outPoints);
+};
+
+#endif
@@ -0,0 +1,609 @@
+#include "pch.h"
+
+#include "PhysicsShapeCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+#include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "BulletCollision/CollisionShapes/btConvexHullShape.h"
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+#include "BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btTriangleMesh.h"
+#include "LinearMath/btAlignedAllocator.h"
+
+#include "Log.h"
+#include "Model/MeshUnit.h"
+#include "Physics/PhysicsUtils.h"
+
+struct BvhCacheFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t triangleMeshHash;
+	uint32_t bvhSize;
+	uint32_t scalarSize;
+};
+
+struct ConvexHullCacheFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t convexHullHash;
+	uint32_t convexHullCount;
+	uint32_t scalarSize;
+};
+
+// "GBVH"
+constexpr uint32_t BVH_CACHE_FILE_MAGIC = 0x48564247;
+constexpr uint32_t BVH_CACHE_FILE_VERSION = 1 + (BT_BULLET_VERSION << 8);
+
+// "GHUL"
+constexpr uint32_t CONVEX_HULL_CACHE_FILE_MAGIC = 0x4C554847;
+constexpr uint32_t CONVEX_HULL_CACHE_FILE_VERSION = 1;
+
+// Sizes read from a cache file are checked against it so that corrupt files cannot cause huge allocations
+static unsigned long long GetRemainingByteCount(std::ifstream& file)
+{
+	const std::streampos position = file.tellg();
+	file.seekg(0, std::ios::end);
+	const std::streampos endPosition = file.tellg();
+	file.seekg(position);
+
+	return position < endPosition ? (unsigned long long)(endPosition - position) : 0;
+}
+
+bool PhysicsShapeKey::operator<(const PhysicsShapeKey& other) const
+{
+	if (mesh != other.mesh)
+	{
+		return mesh < other.mesh;
+	}
+
+	if (type != other.type)
+	{
+		return type < other.type;
+	}
+
+	if (scaling.x != other.scaling.x)
+	{
+		return scaling.x < other.scaling.x;
+	}
+
+	if (scaling.y != other.scaling.y)
+	{
+		return scaling.y < other.scaling.y;
+	}
+
+	if (scaling.z != other.scaling.z)
+	{
+		return scaling.z < other.scaling.z;
+	}
+
+	return convexHullSettings < other.convexHullSettings;
+}
+
+PhysicsShapeCache::PhysicsShapeCache() :
+	cacheDirectory_(ContentDir + "Cache/Physics/")
+{
+}
+
+PhysicsShapeCache::~PhysicsShapeCache()
+{
+	// Scaled shapes are destroyed before the triangle mesh shapes they wrap
+	for (std::pair<const PhysicsShapeKey, PhysicsShapeCacheEntry>& shapeEntryPair : shapeEntries_)
+	{
+		if (shapeEntryPair.first.type == PhysicsShapeType::ScaledTriangleMesh)
+		{
+			delete shapeEntryPair.second.collisionShape;
+			shapeEntryPair.second.collisionShape = nullptr;
+		}
+	}
+
+	for (std::pair<const PhysicsShapeKey, PhysicsShapeCacheEntry>& shapeEntryPair : shapeEntries_)
+	{
+		PhysicsShapeCacheEntry& shapeEntry = shapeEntryPair.second;
+
+		delete shapeEntry.collisionShape;
+		delete shapeEntry.triangleMesh;
+
+		for (btCollisionShape* childCollisionShape : shapeEntry.childCollisionShapes)
+		{
+			delete childCollisionShape;
+		}
+
+		if (shapeEntry.serializedBvh)
+		{
+			shapeEntry.serializedBvh->~btOptimizedBvh();
+			btAlignedFree(shapeEntry.serializedBvhBuffer);
+		}
+	}
+}
+
+btCollisionShape* PhysicsShapeCache::AcquireTriangleMeshShape(const MeshUnit* mesh, const Vector3& scaling)
+{
+	PhysicsShapeKey shapeKey;
+	shapeKey.mesh = mesh;
+
+	// Unscaled instances use the triangle mesh shape itself
+	if (scaling != Vector3{ 1.f })
+	{
+		shapeKey.scaling = scaling;
+		shapeKey.type = PhysicsShapeType::ScaledTriangleMesh;
+	}
+	else
+	{
+		shapeKey.type = PhysicsShapeType::TriangleMesh;
+	}
+
+	return AcquireShape(shapeKey);
+}
+
+btCollisionShape* PhysicsShapeCache::AcquireConvexHullShape(const MeshUnit* mesh, const Vector3& scaling, const ConvexHullSettings& convexHullSettings/* = ConvexHullSettings()*/)
+{
+	PhysicsShapeKey shapeKey;
+	shapeKey.mesh = mesh;
+	shapeKey.scaling = scaling;
+	shapeKey.type = convexHullSettings.isConvexDecompositionEnabled ? PhysicsShapeType::ConvexDecomposition : PhysicsShapeType::ConvexHull;
+	shapeKey.convexHullSettings = convexHullSettings;
+
+	return AcquireShape(shapeKey);
+}
+
+void PhysicsShapeCache::ReleaseShape(btCollisionShape* collisionShape)
+{
+	decltype(shapeKeys_.begin()) shapeKeyIterator = shapeKeys_.find(collisionShape);
+	if (shapeKeyIterator == shapeKeys_.end())
+	{
+		GOKNAR_CORE_ASSERT(false, "Released collision shape is not in the shape cache");
+		return;
+	}
+
+	const PhysicsShapeKey shapeKey = shapeKeyIterator->second;
+
+	PhysicsShapeCacheEntry& shapeEntry = shapeEntries_[shapeKey];
+	--shapeEntry.referenceCount;
+
+	if (shapeEntry.referenceCount <= 0)
+	{
+		shapeKeys_.erase(shapeKeyIterator);
+		DestroyShape(shapeKey, shapeEntry);
+		shapeEntries_.erase(shapeKey);
+	}
+}
+
+void PhysicsShapeCache::ReleaseMeshData(const MeshUnit* mesh)
+{
+	decltype(meshConvexHullHashes_.begin()) meshConvexHullHashesIterator = meshConvexHullHashes_.find(mesh);
+	if (meshConvexHullHashesIterator == meshConvexHullHashes_.end())
+	{
+		return;
+	}
+
+	const std::vector<uint64_t> convexHullHashes = std::move(meshConvexHullHashesIterator->second);
+	meshConvexHullHashes_.erase(meshConvexHullHashesIterator);
+
+	// Hulls are keyed by the content of the meshes, other meshes with the same content keep them
+	for (uint64_t convexHullHash : convexHullHashes)
+	{
+		const bool isUsedByAnotherMesh = std::any_of(meshConvexHullHashes_.begin(), meshConvexHullHashes_.end(),
+			[convexHullHash](const std::pair<const MeshUnit* const, std::vector<uint64_t>>& otherMeshConvexHullHashes)
+			{
+				const std::vector<uint64_t>& otherConvexHullHashes = otherMeshConvexHullHashes.second;
+				return std::find(otherConvexHullHashes.begin(), otherConvexHullHashes.end(), convexHullHash) != otherConvexHullHashes.end();
+			});
+
+		if (!isUsedByAnotherMesh)
+		{
+			convexHulls_.erase(convexHullHash);
+		}
+	}
+}
+
+btCollisionShape* PhysicsShapeCache::AcquireShape(const PhysicsShapeKey& shapeKey)
+{
+	PhysicsShapeCacheEntry& shapeEntry = shapeEntries_[shapeKey];
+	if (!shapeEntry.collisionShape)
+	{
+		CreateShape(shapeKey, shapeEntry);
+		shapeKeys_[shapeEntry.collisionShape] = shapeKey;
+	}
+
+	++shapeEntry.referenceCount;
+	return shapeEntry.collisionShape;
+}
+
+void PhysicsShapeCache::CreateShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry)
+{
+	GOKNAR_CORE_ASSERT(shapeKey.mesh != nullptr);
+
+	switch (shapeKey.type)
+	{
+		case PhysicsShapeType::TriangleMesh:
+		{
+			CreateTriangleMeshShape(shapeKey.mesh, shapeEntry);
+			break;
+		}
+		case PhysicsShapeType::ScaledTriangleMesh:
+		{
+			// Scaled shape keeps a reference to the triangle mesh shape it wraps
+			btBvhTriangleMeshShape* triangleMeshShape = (btBvhTriangleMeshShape*)AcquireTriangleMeshShape(shapeKey.mesh, Vector3{ 1.f });
+			shapeEntry.collisionShape = new btScaledBvhTriangleMeshShape(triangleMeshShape, PhysicsUtils::FromVector3ToBtVector3(shapeKey.scaling));
+			break;
+		}
+		case PhysicsShapeType::ConvexHull:
+		case PhysicsShapeType::ConvexDecomposition:
+		{
+			CreateConvexHullShape(shapeKey, shapeEntry);
+			break;
+		}
+	}
+}
+
+void PhysicsShapeCache::CreateTriangleMeshShape(const MeshUnit* mesh, PhysicsShapeCacheEntry& shapeEntry)
+{
+	GOKNAR_CORE_ASSERT(!mesh->GetIsDataEvicted(), "Collision shapes cannot be built from an evicted mesh, it must be acquired first");
+
+	btTriangleMesh* triangleMesh = new btTriangleMesh(true, false);
+
+	const Box& meshAABB = mesh->GetAABB();
+	triangleMesh->setPremadeAabb(
+		PhysicsUtils::FromVector3ToBtVector3(meshAABB.GetMin()),
+		PhysicsUtils::FromVector3ToBtVector3(meshAABB.GetMax())
+	);
+
+	const VertexData* vertexData = mesh->GetVertexData();
+
+	const Face* faceData = mesh->GetFaceData();
+	const int faceCount = mesh->GetFaceCount();
+
+	// FNV-1a hash of the triangles identifies the BVH cache file of the mesh
+	uint64_t triangleMeshHash = 14695981039346656037ull;
+
+	for (int faceIndex = 0; faceIndex < faceCount; faceIndex++)
+	{
+		const Face& face = faceData[faceIndex];
+
+		const btVector3 triangleVertices[3] =
+		{
+			PhysicsUtils::FromVector3ToBtVector3(vertexData[face.vertexIndices[0]].position),
+			PhysicsUtils::FromVector3ToBtVector3(vertexData[face.vertexIndices[2]].position),
+			PhysicsUtils::FromVector3ToBtVector3(vertexData[face.vertexIndices[1]].position)
+		};
+
+		triangleMesh->addTriangle(triangleVertices[0], triangleVertices[1], triangleVertices[2]);
+
+		for (const btVector3& triangleVertex : triangleVertices)
+		{
+			const unsigned char* triangleVertexBytes = (const unsigned char*)(const btScalar*)triangleVertex;
+			for (int byteIndex = 0; byteIndex < 3 * (int)sizeof(btScalar); ++byteIndex)
+			{
+				triangleMeshHash = (triangleMeshHash ^ triangleVertexBytes[byteIndex]) * 1099511628211ull;
+			}
+		}
+	}
+
+	shapeEntry.triangleMesh = triangleMesh;
+
+	if (isSerializationEnabled_)
+	{
+		const std::string bvhCacheFilePath = GetCacheFilePath(triangleMeshHash, "bvh");
+
+		if (ReadBvh(bvhCacheFilePath, triangleMeshHash, shapeEntry))
+		{
+			btBvhTriangleMeshShape* triangleMeshShape = new btBvhTriangleMeshShape(triangleMesh, true, false);
+			triangleMeshShape->setOptimizedBvh(shapeEntry.serializedBvh);
+			shapeEntry.collisionShape = triangleMeshShape;
+			return;
+		}
+
+		btBvhTriangleMeshShape* triangleMeshShape = new btBvhTriangleMeshShape(triangleMesh, true, true);
+		WriteBvh(bvhCacheFilePath, triangleMeshHash, triangleMeshShape);
+		shapeEntry.collisionShape = triangleMeshShape;
+		return;
+	}
+
+	shapeEntry.collisionShape = new btBvhTriangleMeshShape(triangleMesh, true, true);
+}
+
+void PhysicsShapeCache::CreateConvexHullShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry)
+{
+	const std::vector<ConvexDecomposition::PointArray>& convexHulls = GetConvexHulls(shapeKey.mesh, shapeKey.convexHullSettings);
+	GOKNAR_CORE_ASSERT(!convexHulls.empty() && !convexHulls[0].empty());
+
+	const btVector3 bulletScaling = PhysicsUtils::FromVector3ToBtVector3(shapeKey.scaling);
+
+	if (shapeKey.type == PhysicsShapeType::ConvexHull)
+	{
+		const ConvexDecomposition::PointArray& convexHull = convexHulls[0];
+
+		btConvexHullShape* convexHullShape = new btConvexHullShape((const btScalar*)convexHull[0], (int)convexHull.size(), sizeof(btVector3));
+		convexHullShape->setLocalScaling(bulletScaling);
+		shapeEntry.collisionShape = convexHullShape;
+		return;
+	}
+
+	// Hull points are in the mesh's space, children are scaled instead of the compound so that they stay at identity transforms
+	btCompoundShape* compoundShape = new btCompoundShape(true, (int)convexHulls.size());
+
+	btTransform childTransform;
+	childTransform.setIdentity();
+
+	for (const ConvexDecomposition::PointArray& convexHull : convexHulls)
+	{
+		if (convexHull.empty())
+		{
+			continue;
+		}
+
+		btConvexHullShape* convexHullShape = new btConvexHullShape((const btScalar*)convexHull[0], (int)convexHull.size(), sizeof(btVector3));
+		convexHullShape->setLocalScaling(bulletScaling);
+
+		compoundShape->addChildShape(childTransform, convexHullShape);
+		shapeEntry.childCollisionShapes.push_back(convexHullShape);
+	}
+
+	shapeEntry.collisionShape = compoundShape;
+}
+
+const std::vector<ConvexDecomposition::PointArray>& PhysicsShapeCache::GetConvexHulls(const MeshUnit* mesh, const ConvexHullSettings& convexHullSettings)
+{
+	GOKNAR_CORE_ASSERT(!mesh->GetIsDataEvicted(), "Collision shapes cannot be built from an evicted mesh, it must be acquired first");
+
+	const uint64_t convexHullHash = ConvexDecomposition::GetHash(mesh, convexHullSettings);
+
+	std::vector<uint64_t>& meshConvexHullHashes = meshConvexHullHashes_[mesh];
+	if (std::find(meshConvexHullHashes.begin(), meshConvexHullHashes.end(), convexHullHash) == meshConvexHullHashes.end())
+	{
+		meshConvexHullHashes.push_back(convexHullHash);
+	}
+
+	decltype(convexHulls_.begin()) convexHullsIterator = convexHulls_.find(convexHullHash);
+	if (convexHullsIterator != convexHulls_.end())
+	{
+		return convexHullsIterator->second;
+	}
+
+	std::vector<ConvexDecomposition::PointArray>& convexHulls = convexHulls_[convexHullHash];
+
+	const std::string convexHullCacheFilePath = GetCacheFilePath(convexHullHash, "hull");
+	if (!isSerializationEnabled_ || !ReadConvexHulls(convexHullCacheFilePath, convexHullHash, convexHulls))
+	{
+		ConvexDecomposition::BuildConvexHulls(mesh, convexHullSettings, convexHulls);
+
+		if (isSerializationEnabled_)
+		{
+			WriteConvexHulls(convexHullCacheFilePath, convexHullHash, convexHulls);
+		}
+	}
+
+	return convexHulls;
+}
+
+void PhysicsShapeCache::DestroyShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry)
+{
+	if (shapeKey.type == PhysicsShapeType::ScaledTriangleMesh)
+	{
+		btCollisionShape* triangleMeshShape = ((btScaledBvhTriangleMeshShape*)shapeEntry.collisionShape)->getChildShape();
+
+		delete shapeEntry.collisionShape;
+		shapeEntry.collisionShape = nullptr;
+
+		ReleaseShape(triangleMeshShape);
+		return;
+	}
+
+	delete shapeEntry.collisionShape;
+	shapeEntry.collisionShape = nullptr;
+
+	delete shapeEntry.triangleMesh;
+	shapeEntry.triangleMesh = nullptr;
+
+	for (btCollisionShape* childCollisionShape : shapeEntry.childCollisionShapes)
+	{
+		delete childCollisionShape;
+	}
+	shapeEntry.childCollisionShapes.clear();
+
+	if (shapeEntry.serializedBvh)
+	{
+		// BVH is deserialized in place and does not own its memory
+		shapeEntry.serializedBvh->~btOptimizedBvh();
+		shapeEntry.serializedBvh = nullptr;
+
+		btAlignedFree(shapeEntry.serializedBvhBuffer);
+		shapeEntry.serializedBvhBuffer = nullptr;
+	}
+}
+
+bool PhysicsShapeCache::ReadBvh(const std::string& bvhCacheFilePath, uint64_t triangleMeshHash, PhysicsShapeCacheEntry& shapeEntry)
+{
+	std::ifstream bvhCacheFile(bvhCacheFilePath, std::ios::binary);
+	if (!bvhCacheFile.is_open())
+	{
+		return false;
+	}
+
+	BvhCacheFileHeader header;
+	bvhCacheFile.read((char*)&header, sizeof(BvhCacheFileHeader));
+
+	if (!bvhCacheFile ||
+		header.magic != BVH_CACHE_FILE_MAGIC ||
+		header.version != BVH_CACHE_FILE_VERSION ||
+		header.triangleMeshHash != triangleMeshHash ||
+		header.scalarSize != sizeof(btScalar))
+	{
+		GOKNAR_CORE_WARN("BVH cache file {} is out of date, BVH is rebuilt.", bvhCacheFilePath);
+		return false;
+	}
+
+	if (header.bvhSize == 0 || GetRemainingByteCount(bvhCacheFile) < header.bvhSize)
+	{
+		GOKNAR_CORE_WARN("BVH cache file {} is corrupt, BVH is rebuilt.", bvhCacheFilePath);
+		return false;
+	}
+
+	// Serialized BVH is used in place, its buffer is kept alive along with the shape
+	void* bvhBuffer = btAlignedAlloc(header.bvhSize, 16);
+	bvhCacheFile.read((char*)bvhBuffer, header.bvhSize);
+
+	btQuantizedBvh* bvh = bvhCacheFile ? btOptimizedBvh::deSerializeInPlace(bvhBuffer, header.bvhSize, false) : nullptr;
+	if (!bvh)
+	{
+		GOKNAR_CORE_WARN("BVH cache file {} could not be read, BVH is rebuilt.", bvhCacheFilePath);
+		btAlignedFree(bvhBuffer);
+		return false;
+	}
+
+	shapeEntry.serializedBvh = (btOptimizedBvh*)bvh;
+	shapeEntry.serializedBvhBuffer = bvhBuffer;
+	return true;
+}
+
+void PhysicsShapeCache::WriteBvh(const std::string& bvhCacheFilePath, uint64_t triangleMeshHash, const btBvhTriangleMeshShape* triangleMeshShape)
+{
+	const btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(triangleMeshShape)->getOptimizedBvh();
+
+	BvhCacheFileHeader header;
+	header.magic = BVH_CACHE_FILE_MAGIC;
+	header.version = BVH_CACHE_FILE_VERSION;
+	header.triangleMeshHash = triangleMeshHash;
+	header.bvhSize = bvh->calculateSerializeBufferSize();
+	header.scalarSize = sizeof(btScalar);
+
+	void* bvhBuffer = btAlignedAlloc(header.bvhSize, 16);
+	if (bvh->serializeInPlace(bvhBuffer, header.bvhSize, false))
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(cacheDirectory_, errorCode);
+
+		std::ofstream bvhCacheFile(bvhCacheFilePath, std::ios::binary);
+		if (bvhCacheFile.is_open())
+		{
+			bvhCacheFile.write((const char*)&header, sizeof(BvhCacheFileHeader));
+			bvhCacheFile.write((const char*)bvhBuffer, header.bvhSize);
+		}
+		else
+		{
+			GOKNAR_CORE_WARN("BVH cache file {} could not be written.", bvhCacheFilePath);
+		}
+	}
+
+	btAlignedFree(bvhBuffer);
+}
+
+bool PhysicsShapeCache::ReadConvexHulls(const std::string& convexHullCacheFilePath, uint64_t convexHullHash, std::vector<ConvexDecomposition::PointArray>& outConvexHulls)
+{
+	std::ifstream convexHullCacheFile(convexHullCacheFilePath, std::ios::binary);
+	if (!convexHullCacheFile.is_open())
+	{
+		return false;
+	}
+
+	ConvexHullCacheFileHeader header;
+	convexHullCacheFile.read((char*)&header, sizeof(ConvexHullCacheFileHeader));
+
+	if (!convexHullCacheFile ||
+		header.magic != CONVEX_HULL_CACHE_FILE_MAGIC ||
+		header.version != CONVEX_HULL_CACHE_FILE_VERSION ||
+		header.convexHullHash != convexHullHash ||
+		header.scalarSize != sizeof(btScalar))
+	{
+		GOKNAR_CORE_WARN("Convex hull cache file {} is out of date, convex hulls are rebuilt.", convexHullCacheFilePath);
+		return false;
+	}
+
+	// Each hull has a point count and at least 4 points
+	constexpr unsigned long long pointByteCount = 3 * sizeof(btScalar);
+	constexpr unsigned long long minConvexHullByteCount = sizeof(uint32_t) + 4 * pointByteCount;
+
+	unsigned long long remainingByteCount = GetRemainingByteCount(convexHullCacheFile);
+	if (header.convexHullCount == 0 || remainingByteCount / minConvexHullByteCount < header.convexHullCount)
+	{
+		GOKNAR_CORE_WARN("Convex hull cache file {} is corrupt, convex hulls are rebuilt.", convexHullCacheFilePath);
+		return false;
+	}
+
+	outConvexHulls.resize(header.convexHullCount);
+	for (ConvexDecomposition::PointArray& convexHull : outConvexHulls)
+	{
+		uint32_t pointCount = 0;
+		convexHullCacheFile.read((char*)&pointCount, sizeof(uint32_t));
+		remainingByteCount -= sizeof(uint32_t);
+
+		if (!convexHullCacheFile || pointCount < 4 || remainingByteCount / pointByteCount < pointCount)
+		{
+			GOKNAR_CORE_WARN("Convex hull cache file {} is corrupt, convex hulls are rebuilt.", convexHullCacheFilePath);
+			outConvexHulls.clear();
+			return false;
+		}
+		remainingByteCount -= pointCount * pointByteCount;
+
+		convexHull.resize(pointCount);
+		for (btVector3& point : convexHull)
+		{
+			btScalar coordinates[3];
+			convexHullCacheFile.read((char*)coordinates, sizeof(coordinates));
+			point.setValue(coordinates[0], coordinates[1], coordinates[2]);
+		}
+	}
+
+	if (!convexHullCacheFile)
+	{
+		GOKNAR_CORE_WARN("Convex hull cache file {} could not be read, convex hulls are rebuilt.", convexHullCacheFilePath);
+		outConvexHulls.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void PhysicsShapeCache::WriteConvexHulls(const std::string& convexHullCacheFilePath, uint64_t convexHullHash, const std::vector<ConvexDecomposition::PointArray>& convexHulls)
+{
+	// Degenerate hulls are rejected by ReadConvexHulls, so they are not written
+	if (convexHulls.empty() ||
+		std::any_of(convexHulls.begin(), convexHulls.end(), [](const ConvexDecomposition::PointArray& convexHull) { return convexHull.size() < 4; }))
+	{
+		return;
+	}
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(cacheDirectory_, errorCode);
+
+	std::ofstream convexHullCacheFile(convexHullCacheFilePath, std::ios::binary);
+	if (!convexHullCacheFile.is_open())
+	{
+		GOKNAR_CORE_WARN("Convex hull cache file {} could not be written.", convexHullCacheFilePath);
+		return;
+	}
+
+	ConvexHullCacheFileHeader header;
+	header.magic = CONVEX_HULL_CACHE_FILE_MAGIC;
+	header.version = CONVEX_HULL_CACHE_FILE_VERSION;
+	header.convexHullHash = convexHullHash;
+	header.convexHullCount = (uint32_t)convexHulls.size();
+	header.scalarSize = sizeof(btScalar);
+
+	convexHullCacheFile.write((const char*)&header, sizeof(ConvexHullCacheFileHeader));
+
+	for (const ConvexDecomposition::PointArray& convexHull : convexHulls)
+	{
+		const uint32_t pointCount = (uint32_t)convexHull.size();
+		convexHullCacheFile.write((const char*)&pointCount, sizeof(uint32_t));
+
+		for (const btVector3& point : convexHull)
+		{
+			convexHullCacheFile.write((const char*)(const btScalar*)point, 3 * sizeof(btScalar));
+		}
+	}
+}
+
+std::string PhysicsShapeCache::GetCacheFilePath(uint64_t hash, const char* extension) const
+{
+	char hashText[17];
+	std::snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)hash);
+
+	return cacheDirectory_ + hashText + "." + extension;
+}
@@ -0,0 +1,130 @@
+#ifndef __PHYSICSSHAPECACHE_H__
+#define __PHYSICSSHAPECACHE_H__
+
+#include "Core.h"
+#include "Math/GoknarMath.h"
+#include "Physics/ConvexDecomposition.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class btBvhTriangleMeshShape;
+class btCollisionShape;
+class btOptimizedBvh;
+class btTriangleMesh;
+
+class MeshUnit;
+
+enum class GOKNAR_API PhysicsShapeType : unsigned char
+{
+    TriangleMesh = 0,
+    ScaledTriangleMesh,
+    ConvexHull,
+    ConvexDecomposition
+};
+
+struct GOKNAR_API PhysicsShapeKey
+{
+    const MeshUnit* mesh{ nullptr };
+    Vector3 scaling{ Vector3{ 1.f } };
+    PhysicsShapeType type{ PhysicsShapeType::TriangleMesh };
+    ConvexHullSettings convexHullSettings;
+
+    bool operator<(const PhysicsShapeKey& other) const;
+};
+
+struct GOKNAR_API PhysicsShapeCacheEntry
+{
+    btCollisionShape* collisionShape{ nullptr };
+
+    // Hulls of a convex decomposition compound
+    std::vector<btCollisionShape*> childCollisionShapes;
+
+    // Triangle data and the BVH read from the cache file of triangle mesh shapes
+    btTriangleMesh* triangleMesh{ nullptr };
+    btOptimizedBvh* serializedBvh{ nullptr };
+    void* serializedBvhBuffer{ nullptr };
+
+    int referenceCount{ 0 };
+};
+
+// Collision shapes built from meshes are shared between the collision components using the same mesh, scaling and shape type
+// Triangle mesh BVHs are built once per mesh, scaled instances wrap them with btScaledBvhTriangleMeshShape
+// BVHs and simplified convex hulls are written to cache files so that they are not built again on the next runs
+class GOKNAR_API PhysicsShapeCache
+{
+public:
+    PhysicsShapeCache();
+    ~PhysicsShapeCache();
+
+    // Static triangle mesh shape, acquired shapes must be released with ReleaseShape
+    btCollisionShape* AcquireTriangleMeshShape(const MeshUnit* mesh, const Vector3& scaling);
+
+    // Simplified convex hull of the mesh or a compound of the convex hulls of its parts if convex decomposition is enabled
+    // Acquired shapes must be released with ReleaseShape
+    btCollisionShape* AcquireConvexHullShape(const MeshUnit* mesh, const Vector3& scaling, const ConvexHullSettings& convexHullSettings = ConvexHullSettings());
+
+    void ReleaseShape(btCollisionShape* collisionShape);
+
+    // Frees the convex hulls built from the mesh before its data is evicted, shapes acquired from it stay valid since they copy their points
+    void ReleaseMeshData(const MeshUnit* mesh);
+
+    int GetShapeCount() const
+    {
+        return (int)shapeEntries_.size();
+    }
+
+    // Reads and writes the cache files of BVHs and convex hulls
+    void SetIsSerializationEnabled(bool isSerializationEnabled)
+    {
+        isSerializationEnabled_ = isSerializationEnabled;
+    }
+
+    bool GetIsSerializationEnabled() const
+    {
+        return isSerializationEnabled_;
+    }
+
+    void SetCacheDirectory(const std::string& cacheDirectory)
+    {
+        cacheDirectory_ = cacheDirectory;
+    }
+
+    const std::string& GetCacheDirectory() const
+    {
+        return cacheDirectory_;
+    }
+
+private:
+    btCollisionShape* AcquireShape(const PhysicsShapeKey& shapeKey);
+    void CreateShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry);
+    void CreateTriangleMeshShape(const MeshUnit* mesh, PhysicsShapeCacheEntry& shapeEntry);
+    void CreateConvexHullShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry);
+    const std::vector<ConvexDecomposition::PointArray>& GetConvexHulls(const MeshUnit* mesh, const ConvexHullSettings& convexHullSettings);
+    void DestroyShape(const PhysicsShapeKey& shapeKey, PhysicsShapeCacheEntry& shapeEntry);
+
+    bool ReadBvh(const std::string& bvhCacheFilePath, uint64_t triangleMeshHash, PhysicsShapeCacheEntry& shapeEntry);
+    void WriteBvh(const std::string& bvhCacheFilePath, uint64_t triangleMeshHash, const btBvhTriangleMeshShape* triangleMeshShape);
+
+    bool ReadConvexHulls(const std::string& convexHullCacheFilePath, uint64_t convexHullHash, std::vector<ConvexDecomposition::PointArray>& outConvexHulls);
+    void WriteConvexHulls(const std::string& convexHullCacheFilePath, uint64_t convexHullHash, const std::vector<ConvexDecomposition::PointArray>& convexHulls);
+
+    std::string GetCacheFilePath(uint64_t hash, const char* extension) const;
+
+    std::map<PhysicsShapeKey, PhysicsShapeCacheEntry> shapeEntries_;
+    std::unordered_map<const btCollisionShape*, PhysicsShapeKey> shapeKeys_;
+
+    // Hull points by mesh content and settings hash, shared by every scaling of a mesh
+    std::unordered_map<uint64_t, std::vector<ConvexDecomposition::PointArray>> convexHulls_;
+    // Hashes of the hulls each mesh used, hashes cannot be computed again once the data of the mesh is evicted
+    std::unordered_map<const MeshUnit*, std::vector<uint64_t>> meshConvexHullHashes_;
+
+    std::string cacheDirectory_;
+
+    bool isSerializationEnabled_{ true };
+};
+
+#endif
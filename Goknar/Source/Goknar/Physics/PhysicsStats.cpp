@@ -0,0 +1,205 @@
+#include "pch.h"
+
+#include "PhysicsStats.h"
+
+#include <cstring>
+
+#include "LinearMath/btQuickprof.h"
+
+#include "GoknarAssert.h"
+#include "Log.h"
+
+#ifndef BT_NO_PROFILE
+// Nodes matching a phase are not descended into so that nested scopes of the phase are not counted twice
+static void AccumulateBulletProfileDurations(CProfileIterator* profileIterator, PhysicsStepStats& stepStats)
+{
+	// Entering a child resets the iteration of the parent, so children are visited by index
+	for (int childIndex = 0; ; ++childIndex)
+	{
+		profileIterator->First();
+		for (int skippedChildIndex = 0; skippedChildIndex < childIndex && !profileIterator->Is_Done(); ++skippedChildIndex)
+		{
+			profileIterator->Next();
+		}
+
+		if (profileIterator->Is_Done())
+		{
+			break;
+		}
+
+		const char* name = profileIterator->Get_Current_Name();
+		const float duration = profileIterator->Get_Current_Total_Time();
+
+		if (!strcmp(name, "updateAabbs") || !strcmp(name, "calculateOverlappingPairs"))
+		{
+			stepStats.broadphaseDuration += duration;
+		}
+		else if (!strcmp(name, "dispatchAllCollisionPairs"))
+		{
+			stepStats.narrowphaseDuration += duration;
+		}
+		else if (!strcmp(name, "calculateSimulationIslands") || !strcmp(name, "solveConstraints"))
+		{
+			stepStats.solverDuration += duration;
+		}
+		else if (!strcmp(name, "predictUnconstraintMotion") || !strcmp(name, "integrateTransforms"))
+		{
+			stepStats.integrateDuration += duration;
+		}
+		else if (!strcmp(name, "synchronizeMotionStates"))
+		{
+			stepStats.syncDuration += duration;
+		}
+		else
+		{
+			profileIterator->Enter_Child(childIndex);
+			AccumulateBulletProfileDurations(profileIterator, stepStats);
+			profileIterator->Enter_Parent();
+		}
+	}
+}
+#endif
+
+PhysicsStats::PhysicsStats()
+{
+	samples_.resize(capacity_);
+}
+
+PhysicsStats::~PhysicsStats()
+{
+}
+
+void PhysicsStats::SetCapacity(int capacity)
+{
+	GOKNAR_CORE_ASSERT(0 < capacity, "Physics stats capacity must be positive");
+
+	capacity_ = capacity;
+	samples_.clear();
+	samples_.resize(capacity_);
+
+	nextSampleIndex_ = 0;
+	sampleCount_ = 0;
+}
+
+const PhysicsStepStats& PhysicsStats::GetSample(int index) const
+{
+	GOKNAR_CORE_ASSERT(0 <= index && index < sampleCount_);
+
+	return samples_[(nextSampleIndex_ - sampleCount_ + index + capacity_) % capacity_];
+}
+
+const PhysicsStepStats& PhysicsStats::GetLatestSample() const
+{
+	return GetSample(sampleCount_ - 1);
+}
+
+void PhysicsStats::AddSample(const PhysicsStepStats& stepStats)
+{
+	samples_[nextSampleIndex_] = stepStats;
+	nextSampleIndex_ = (nextSampleIndex_ + 1) % capacity_;
+
+	if (sampleCount_ < capacity_)
+	{
+		++sampleCount_;
+	}
+}
+
+void PhysicsStats::Clear()
+{
+	nextSampleIndex_ = 0;
+	sampleCount_ = 0;
+}
+
+bool PhysicsStats::SaveToCSV(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file.is_open())
+	{
+		GOKNAR_CORE_WARN("Physics stats could not be saved to {}", path);
+		return false;
+	}
+
+	file << "stepIndex,stepDuration,broadphaseDuration,narrowphaseDuration,solverDuration,integrateDuration,syncDuration,"
+		"rigidBodyCount,activeRigidBodyCount,movedRigidBodyCount,islandCount,overlappingPairCount,manifoldCount,contactPointCount,contactPairCount\n";
+
+	for (int sampleIndex = 0; sampleIndex < sampleCount_; ++sampleIndex)
+	{
+		const PhysicsStepStats& stepStats = GetSample(sampleIndex);
+		file <<
+			stepStats.stepIndex << "," <<
+			stepStats.stepDuration << "," <<
+			stepStats.broadphaseDuration << "," <<
+			stepStats.narrowphaseDuration << "," <<
+			stepStats.solverDuration << "," <<
+			stepStats.integrateDuration << "," <<
+			stepStats.syncDuration << "," <<
+			stepStats.rigidBodyCount << "," <<
+			stepStats.activeRigidBodyCount << "," <<
+			stepStats.movedRigidBodyCount << "," <<
+			stepStats.islandCount << "," <<
+			stepStats.overlappingPairCount << "," <<
+			stepStats.manifoldCount << "," <<
+			stepStats.contactPointCount << "," <<
+			stepStats.contactPairCount << "\n";
+	}
+
+	return true;
+}
+
+bool PhysicsStats::SaveToJSON(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file.is_open())
+	{
+		GOKNAR_CORE_WARN("Physics stats could not be saved to {}", path);
+		return false;
+	}
+
+	file << "{\n\t\"samples\": [";
+
+	for (int sampleIndex = 0; sampleIndex < sampleCount_; ++sampleIndex)
+	{
+		const PhysicsStepStats& stepStats = GetSample(sampleIndex);
+		file << (sampleIndex == 0 ? "\n" : ",\n") <<
+			"\t\t{ " <<
+			"\"stepIndex\": " << stepStats.stepIndex << ", " <<
+			"\"stepDuration\": " << stepStats.stepDuration << ", " <<
+			"\"broadphaseDuration\": " << stepStats.broadphaseDuration << ", " <<
+			"\"narrowphaseDuration\": " << stepStats.narrowphaseDuration << ", " <<
+			"\"solverDuration\": " << stepStats.solverDuration << ", " <<
+			"\"integrateDuration\": " << stepStats.integrateDuration << ", " <<
+			"\"syncDuration\": " << stepStats.syncDuration << ", " <<
+			"\"rigidBodyCount\": " << stepStats.rigidBodyCount << ", " <<
+			"\"activeRigidBodyCount\": " << stepStats.activeRigidBodyCount << ", " <<
+			"\"movedRigidBodyCount\": " << stepStats.movedRigidBodyCount << ", " <<
+			"\"islandCount\": " << stepStats.islandCount << ", " <<
+			"\"overlappingPairCount\": " << stepStats.overlappingPairCount << ", " <<
+			"\"manifoldCount\": " << stepStats.manifoldCount << ", " <<
+			"\"contactPointCount\": " << stepStats.contactPointCount << ", " <<
+			"\"contactPairCount\": " << stepStats.contactPairCount <<
+			" }";
+	}
+
+	file << "\n\t]\n}\n";
+
+	return true;
+}
+
+void PhysicsStats::BeginBulletProfile()
+{
+#ifndef BT_NO_PROFILE
+	CProfileManager::Reset();
+#endif
+}
+
+void PhysicsStats::ReadBulletProfile(PhysicsStepStats& stepStats)
+{
+#ifndef BT_NO_PROFILE
+	CProfileIterator* profileIterator = CProfileManager::Get_Iterator();
+	if (profileIterator)
+	{
+		AccumulateBulletProfileDurations(profileIterator, stepStats);
+		CProfileManager::Release_Iterator(profileIterator);
+	}
+#endif
+}
@@ -0,0 +1,88 @@
+#ifndef __PHYSICSSTATS_H__
+#define __PHYSICSSTATS_H__
+
+#include "Core.h"
+
+#include <string>
+#include <vector>
+
+// Timings and counters of a single simulation step, durations are in milliseconds
+struct GOKNAR_API PhysicsStepStats
+{
+    unsigned long long stepIndex{ 0 };
+
+    float stepDuration{ 0.f };
+    float broadphaseDuration{ 0.f };
+    float narrowphaseDuration{ 0.f };
+    float solverDuration{ 0.f };
+    float integrateDuration{ 0.f };
+
+    // Motion state updates and the engine side work after the step(contact events, physics ticks etc.)
+    float syncDuration{ 0.f };
+
+    int rigidBodyCount{ 0 };
+    int activeRigidBodyCount{ 0 };
+    int movedRigidBodyCount{ 0 };
+    int islandCount{ 0 };
+    int overlappingPairCount{ 0 };
+    int manifoldCount{ 0 };
+    int contactPointCount{ 0 };
+    int contactPairCount{ 0 };
+};
+
+// Keeps the stats of the last steps in a ring buffer
+// Phase durations are read from Bullet's CProfileManager, they are left as 0 when Bullet is built with BT_NO_PROFILE
+class GOKNAR_API PhysicsStats
+{
+public:
+    PhysicsStats();
+    ~PhysicsStats();
+
+    void SetIsEnabled(bool isEnabled)
+    {
+        isEnabled_ = isEnabled;
+    }
+
+    bool GetIsEnabled() const
+    {
+        return isEnabled_;
+    }
+
+    // Changing the capacity clears the samples
+    void SetCapacity(int capacity);
+
+    int GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    int GetSampleCount() const
+    {
+        return sampleCount_;
+    }
+
+    // Samples are indexed from the oldest one
+    const PhysicsStepStats& GetSample(int index) const;
+    const PhysicsStepStats& GetLatestSample() const;
+
+    void AddSample(const PhysicsStepStats& stepStats);
+    void Clear();
+
+    bool SaveToCSV(const std::string& path) const;
+    bool SaveToJSON(const std::string& path) const;
+
+    // Bullet's profiler is reset before a sampled step and its phase durations are read after it
+    static void BeginBulletProfile();
+    static void ReadBulletProfile(PhysicsStepStats& stepStats);
+
+private:
+    std::vector<PhysicsStepStats> samples_;
+
+    int capacity_{ 600 };
+    int nextSampleIndex_{ 0 };
+    int sampleCount_{ 0 };
+
+    bool isEnabled_{ false };
+};
+
+#endif
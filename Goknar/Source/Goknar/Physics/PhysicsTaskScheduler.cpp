@@ -0,0 +1,84 @@
+#include "pch.h"
+
+#include "PhysicsTaskScheduler.h"
+
+#include "Managers/JobManager.h"
+
+PhysicsTaskScheduler::PhysicsTaskScheduler(JobManager* jobManager) :
+	btITaskScheduler("GoknarJobManager"),
+	jobManager_(jobManager)
+{
+	workerThreadCount_ = jobManager_->GetWorkerThreadCount();
+
+	// Worker threads and the calling thread
+	maxThreadCount_ = workerThreadCount_ + 1 < BT_MAX_THREAD_COUNT ? workerThreadCount_ + 1 : BT_MAX_THREAD_COUNT;
+	threadCount_ = maxThreadCount_;
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const
+{
+	return maxThreadCount_;
+}
+
+void PhysicsTaskScheduler::setNumThreads(int threadCount)
+{
+	const int maxThreadCount = getMaxNumThreads();
+	threadCount_ = threadCount < 1 ? 1 : (maxThreadCount < threadCount ? maxThreadCount : threadCount);
+}
+
+bool PhysicsTaskScheduler::GetIsWorkerThreadCountChanged() const
+{
+	return jobManager_->GetWorkerThreadCount() != workerThreadCount_;
+}
+
+int PhysicsTaskScheduler::GetBatchSize(int count, int grainSize) const
+{
+	const int batchSizePerThread = (count + threadCount_ - 1) / threadCount_;
+	return grainSize < batchSizePerThread ? batchSizePerThread : grainSize;
+}
+
+void PhysicsTaskScheduler::parallelFor(int beginIndex, int endIndex, int grainSize, const btIParallelForBody& body)
+{
+	const int count = endIndex - beginIndex;
+	if (threadCount_ <= 1 || count <= grainSize || GetIsWorkerThreadCountChanged())
+	{
+		body.forLoop(beginIndex, endIndex);
+		return;
+	}
+
+	jobManager_->ParallelFor(count, GetBatchSize(count, grainSize),
+		[&body, beginIndex](int batchBeginIndex, int batchEndIndex)
+		{
+			body.forLoop(beginIndex + batchBeginIndex, beginIndex + batchEndIndex);
+		});
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int beginIndex, int endIndex, int grainSize, const btIParallelSumBody& body)
+{
+	const int count = endIndex - beginIndex;
+	if (threadCount_ <= 1 || count <= grainSize || GetIsWorkerThreadCountChanged())
+	{
+		return body.sumLoop(beginIndex, endIndex);
+	}
+
+	const int batchSize = GetBatchSize(count, grainSize);
+	const int batchCount = (count + batchSize - 1) / batchSize;
+
+	// There are at most threadCount batches
+	// Batch sums are added in batch order so the result does not depend on thread timing
+	btScalar batchSums[BT_MAX_THREAD_COUNT];
+
+	jobManager_->ParallelFor(count, batchSize,
+		[&body, &batchSums, beginIndex, batchSize](int batchBeginIndex, int batchEndIndex)
+		{
+			batchSums[batchBeginIndex / batchSize] = body.sumLoop(beginIndex + batchBeginIndex, beginIndex + batchEndIndex);
+		});
+
+	btScalar sum = btScalar(0);
+	for (int batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+	{
+		sum += batchSums[batchIndex];
+	}
+
+	return sum;
+}
@@ -0,0 +1,43 @@
+#ifndef __PHYSICSTASKSCHEDULER_H__
+#define __PHYSICSTASKSCHEDULER_H__
+
+#include "Core.h"
+
+#include "LinearMath/btThreads.h"
+
+class JobManager;
+
+// Runs Bullet's parallel loops on the engine's JobManager
+// Loops are split into at most threadCount batches and the calling thread takes batches as well
+// Bullet gives each new thread a new index, so loops run on the calling thread only once the JobManager's workers are restarted
+class GOKNAR_API PhysicsTaskScheduler : public btITaskScheduler
+{
+public:
+    PhysicsTaskScheduler(JobManager* jobManager);
+    virtual ~PhysicsTaskScheduler() = default;
+
+    virtual int getMaxNumThreads() const override;
+    virtual int getNumThreads() const override
+    {
+        return threadCount_;
+    }
+
+    virtual void setNumThreads(int threadCount) override;
+
+    virtual void parallelFor(int beginIndex, int endIndex, int grainSize, const btIParallelForBody& body) override;
+    virtual btScalar parallelSum(int beginIndex, int endIndex, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    int GetBatchSize(int count, int grainSize) const;
+
+    bool GetIsWorkerThreadCountChanged() const;
+
+    JobManager* jobManager_{ nullptr };
+    int threadCount_{ 1 };
+
+    // Per-thread arrays of Bullet are sized for the worker threads running when the scheduler is created
+    int maxThreadCount_{ 1 };
+    int workerThreadCount_{ 0 };
+};
+
+#endif
@@ -1,15 +1,27 @@
 #include "pch.h"
 
+#include <atomic>
+
 #include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
 #include "BulletDynamics/Character/btKinematicCharacterController.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
 
 #include "Engine.h"
 #include "Log.h"
+#include "Managers/JobManager.h"
+#include "CharacterCrowd.h"
 #include "PhysicsDebugger.h"
+#include "PhysicsShapeCache.h"
+#include "PhysicsStats.h"
+#include "PhysicsTaskScheduler.h"
 #include "PhysicsUtils.h"
 #include "PhysicsWorld.h"
 #include "RigidBody.h"
+#include "RigidBodyMotionState.h"
 #include "Character.h"
 #include "Components/PhysicsMovementComponent.h"
 #include "Components/CollisionComponent.h"
@@ -18,6 +30,9 @@
 PhysicsWorld::PhysicsWorld()
 {
 	physicsDebugger_ = new PhysicsDebugger();
+	shapeCache_ = new PhysicsShapeCache();
+	stats_ = new PhysicsStats();
+	characterCrowd_ = new CharacterCrowd();
 }
 
 PhysicsWorld::~PhysicsWorld()
@@ -28,6 +43,9 @@ PhysicsWorld::~PhysicsWorld()
 	delete solver_;
 	solver_ = nullptr;
 
+	delete largeIslandSolver_;
+	largeIslandSolver_ = nullptr;
+
 	delete broadphase_;
 	broadphase_ = nullptr;
 
@@ -45,6 +63,23 @@ PhysicsWorld::~PhysicsWorld()
 
 	delete physicsDebugger_;
 	physicsDebugger_ = nullptr;
+
+	delete shapeCache_;
+	shapeCache_ = nullptr;
+
+	delete stats_;
+	stats_ = nullptr;
+
+	delete characterCrowd_;
+	characterCrowd_ = nullptr;
+
+	if (taskScheduler_)
+	{
+		btSetTaskScheduler(btGetSequentialTaskScheduler());
+
+		delete taskScheduler_;
+		taskScheduler_ = nullptr;
+	}
 }
 
 bool OverlappingDestroyedCallback(void* userPersistentData)
@@ -52,51 +87,74 @@ bool OverlappingDestroyedCallback(void* userPersistentData)
 	return true;
 }
 
-bool OverlappingProcessedCallback(btManifoldPoint& manifoldPoint, void* body0, void* body1)
+// Called after every internal step, right after Bullet updates its actions
+void CharacterCrowdTickCallback(btDynamicsWorld* dynamicsWorld, btScalar timeStep)
 {
-	engine->GetPhysicsWorld()->OnOverlappingCollisionContinue(manifoldPoint, static_cast<const btCollisionObject*>(body0), static_cast<const btCollisionObject*>(body1));
-	return true;
+	((PhysicsWorld*)dynamicsWorld->getWorldUserInfo())->GetCharacterCrowd()->Update(dynamicsWorld, timeStep);
 }
 
-void OverlappingStartedCallback(btPersistentManifold* const& manifold)
+void PhysicsWorld::PreInit()
 {
-	engine->GetPhysicsWorld()->OnOverlappingCollisionBegin(manifold);
-}
+	if (isMultithreaded_)
+	{
+		taskScheduler_ = new PhysicsTaskScheduler(engine->GetJobManager());
+		btSetTaskScheduler(taskScheduler_);
 
-void OverlappingEndedCallback(btPersistentManifold* const& manifold)
-{
-	engine->GetPhysicsWorld()->OnOverlappingCollisionEnd(manifold);
-}
+		// Per-thread arrays of the dispatcher and the world are sized by the thread count when they are constructed,
+		// and batches can run on any worker, so they are sized for every thread and the thread count is applied afterwards
+		taskScheduler_->setNumThreads(taskScheduler_->getMaxNumThreads());
 
-void PhysicsWorld::PreInit()
-{
-	///collision configuration contains default setup for memory, collision setup
-	collisionConfiguration_ = new btDefaultCollisionConfiguration();
-	//m_collisionConfiguration->setConvexConvexMultipointIterations();
+		// Memory pools are shared between the threads, they are made large enough to not fall back to the heap while dispatching
+		btDefaultCollisionConstructionInfo collisionConstructionInfo;
+		collisionConstructionInfo.m_defaultMaxPersistentManifoldPoolSize = 80000;
+		collisionConstructionInfo.m_defaultMaxCollisionAlgorithmPoolSize = 80000;
+		collisionConfiguration_ = new btDefaultCollisionConfiguration(collisionConstructionInfo);
 
-	///use the default collision dispatcher. For parallel processing you can use a diffent dispatcher (see Extras/BulletMultiThreaded)
-	dispatcher_ = new btCollisionDispatcher(collisionConfiguration_);
-	//dispatcher_->setNearCallback(&NearCallback);
+		dispatcher_ = new btCollisionDispatcherMt(collisionConfiguration_, 40);
+	}
+	else
+	{
+		///collision configuration contains default setup for memory, collision setup
+		collisionConfiguration_ = new btDefaultCollisionConfiguration();
+		//m_collisionConfiguration->setConvexConvexMultipointIterations();
+
+		///use the default collision dispatcher
+		dispatcher_ = new btCollisionDispatcher(collisionConfiguration_);
+		//dispatcher_->setNearCallback(&NearCallback);
+	}
 
 	ghostPairCallback_ = new btGhostPairCallback();
 
 	broadphase_ = new btDbvtBroadphase();
 	broadphase_->getOverlappingPairCache()->setInternalGhostPairCallback(ghostPairCallback_);
 
-	///the default constraint solver. For parallel processing you can use a different solver (see Extras/BulletMultiThreaded)
-	btSequentialImpulseConstraintSolver* solver = new btSequentialImpulseConstraintSolver;
-	solver_ = solver;
+	if (isMultithreaded_)
+	{
+		// Islands are solved in parallel by a pool of solvers, islands too large to be split are solved by the multithreaded solver
+		btConstraintSolverPoolMt* solverPool = new btConstraintSolverPoolMt(taskScheduler_->getMaxNumThreads());
+		solver_ = solverPool;
+		largeIslandSolver_ = new btSequentialImpulseConstraintSolverMt();
+
+		dynamicsWorld_ = new btDiscreteDynamicsWorldMt(dispatcher_, broadphase_, solverPool, largeIslandSolver_, collisionConfiguration_);
+
+		SetThreadCount(threadCount_);
+	}
+	else
+	{
+		///the default constraint solver
+		btSequentialImpulseConstraintSolver* solver = new btSequentialImpulseConstraintSolver;
+		solver_ = solver;
 
-	dynamicsWorld_ = new btDiscreteDynamicsWorld(dispatcher_, broadphase_, solver_, collisionConfiguration_);
+		dynamicsWorld_ = new btDiscreteDynamicsWorld(dispatcher_, broadphase_, solver_, collisionConfiguration_);
+	}
 	dynamicsWorld_->setGravity(PhysicsUtils::FromVector3ToBtVector3(gravity_));
 	dynamicsWorld_->setDebugDrawer(physicsDebugger_);
 
 	//dynamicsWorld_->getDispatchInfo().m_allowedCcdPenetration = 0.04f;
 
+	dynamicsWorld_->setInternalTickCallback(CharacterCrowdTickCallback, this);
+
 	gContactDestroyedCallback = OverlappingDestroyedCallback;
-	gContactProcessedCallback = OverlappingProcessedCallback;
-	gContactStartedCallback = OverlappingStartedCallback;
-	gContactEndedCallback = OverlappingEndedCallback;
 }
 
 void PhysicsWorld::Init()
@@ -107,15 +165,128 @@ void PhysicsWorld::PostInit()
 {
 }
 
+void PhysicsWorld::SetThreadCount(int threadCount)
+{
+	threadCount_ = threadCount;
+
+	if (taskScheduler_)
+	{
+		taskScheduler_->setNumThreads(threadCount_ <= 0 ? taskScheduler_->getMaxNumThreads() : threadCount_);
+	}
+}
+
+int PhysicsWorld::GetThreadCount() const
+{
+	return taskScheduler_ ? taskScheduler_->getNumThreads() : 1;
+}
+
+void PhysicsWorld::SetIsFixedTimeStepEnabled(bool isFixedTimeStepEnabled)
+{
+	isFixedTimeStepEnabled_ = isFixedTimeStepEnabled;
+
+	timeStepAccumulator_ = 0.f;
+	interpolationAlpha_ = 1.f;
+
+	for (RigidBody* rigidBody : interpolatedRigidBodies_)
+	{
+		rigidBody->InterpolatePhysicsState(1.f);
+	}
+	interpolatedRigidBodies_.clear();
+
+	for (RigidBody* rigidBody : rigidBodies_)
+	{
+		rigidBody->SavePhysicsState();
+	}
+}
+
 void PhysicsWorld::PhysicsTick(float deltaTime)
 {
-	dynamicsWorld_->stepSimulation(deltaTime);
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	if (isFixedTimeStepEnabled_)
+	{
+		timeStepAccumulator_ += deltaTime;
+
+		int stepCount = (int)(timeStepAccumulator_ / fixedTimeStep_);
+		if (maxSubStepCount_ < stepCount)
+		{
+			// Only the fraction of a step is kept so the following frames do not try to catch up either
+			const float keptTime = timeStepAccumulator_ - stepCount * fixedTimeStep_;
+			droppedTime_ += timeStepAccumulator_ - keptTime - maxSubStepCount_ * fixedTimeStep_;
+			timeStepAccumulator_ = keptTime + maxSubStepCount_ * fixedTimeStep_;
+			stepCount = maxSubStepCount_;
+		}
+
+		for (int stepIndex = 0; stepIndex < stepCount; ++stepIndex)
+		{
+			StepSimulation(fixedTimeStep_, 0);
+			timeStepAccumulator_ -= fixedTimeStep_;
+		}
+
+		if (0 < stepCount)
+		{
+			// Bodies that did not move in the last step are left at their final state and no longer interpolated
+			for (RigidBody* rigidBody : interpolatedRigidBodies_)
+			{
+				if (rigidBody->GetMotionState()->GetLastMovedStep() != totalStepCount_)
+				{
+					rigidBody->InterpolatePhysicsState(1.f);
+				}
+			}
+
+			interpolatedRigidBodies_.swap(movedRigidBodies_);
+		}
+
+		lastFrameStepCount_ = stepCount;
+		interpolationAlpha_ = GoknarMath::Clamp(timeStepAccumulator_ / fixedTimeStep_, 0.f, 1.f);
+
+		for (RigidBody* rigidBody : interpolatedRigidBodies_)
+		{
+			rigidBody->InterpolatePhysicsState(interpolationAlpha_);
+		}
+	}
+	else
+	{
+		StepSimulation(deltaTime, 1);
+		lastFrameStepCount_ = 1;
+
+		// Motion states are already interpolated by Bullet in the variable step mode
+		for (RigidBody* rigidBody : movedRigidBodies_)
+		{
+			rigidBody->InterpolatePhysicsState(1.f);
+		}
+	}
+
+	lastFrameStepsDuration_ = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+}
+
+void PhysicsWorld::StepSimulation(float stepDeltaTime, int maxSubSteps)
+{
+	const bool isSamplingStats = stats_->GetIsEnabled();
+	if (isSamplingStats)
+	{
+		PhysicsStats::BeginBulletProfile();
+	}
+
+	const std::chrono::steady_clock::time_point stepStartTimePoint = std::chrono::steady_clock::now();
+
+	isSteppingSimulation_ = true;
+	dynamicsWorld_->stepSimulation(stepDeltaTime, maxSubSteps, fixedTimeStep_);
+	isSteppingSimulation_ = false;
+
+	const std::chrono::steady_clock::time_point syncStartTimePoint = std::chrono::steady_clock::now();
+
+	++totalStepCount_;
+	GatherMovedRigidBodies();
+
+	GatherContactEvents();
+	DispatchContactEvents();
 
 	for (PhysicsObject* physicsObject : physicsObjects_)
 	{
 		if (physicsObject->GetIsActive() && physicsObject->GetPhysicsTickEnabled())
 		{
-			physicsObject->PhysicsTick(deltaTime);
+			physicsObject->PhysicsTick(stepDeltaTime);
 		}
 	}
 
@@ -123,67 +294,200 @@ void PhysicsWorld::PhysicsTick(float deltaTime)
 	{
 		physicsMovementComponent->UpdateOwnerTransformation();
 	}
+
+	if (isSamplingStats)
+	{
+		const std::chrono::steady_clock::time_point syncEndTimePoint = std::chrono::steady_clock::now();
+		SampleStepStats(
+			std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(syncEndTimePoint - stepStartTimePoint).count(),
+			std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(syncEndTimePoint - syncStartTimePoint).count());
+	}
 }
 
-void PhysicsWorld::OnOverlappingCollisionBegin(btPersistentManifold* const& monifoldPointPtr)
+void PhysicsWorld::SampleStepStats(float stepDuration, float syncDuration)
 {
-	const btCollisionObject* ghostObject1 = monifoldPointPtr->getBody0();
-	const btCollisionObject* ghostObject2 = monifoldPointPtr->getBody1();
+	PhysicsStepStats stepStats;
+	stepStats.stepIndex = totalStepCount_;
+	stepStats.stepDuration = stepDuration;
 
-	PhysicsObject* collisionObject1 = (PhysicsObject*)ghostObject1->getUserPointer();
-	PhysicsObject* collisionObject2 = (PhysicsObject*)ghostObject2->getUserPointer();
+	PhysicsStats::ReadBulletProfile(stepStats);
+	stepStats.syncDuration += syncDuration;
 
-	GOKNAR_CORE_ASSERT(collisionObject1 && collisionObject2, "Neither of the colliding bodies can be nullptr!");
-	
-	CollisionComponent* collisionComponent1 = collisionObject1->GetCollisionComponent();
-	CollisionComponent* collisionComponent2 = collisionObject2->GetCollisionComponent();
-
-	GOKNAR_CORE_ASSERT(collisionComponent1 && collisionComponent2);
-
-	if (!collisionComponent1->GetIsActive() || !collisionComponent2->GetIsActive())
+	stepStats.rigidBodyCount = (int)rigidBodies_.size();
+	for (const RigidBody* rigidBody : rigidBodies_)
 	{
-		return;
+		if (rigidBody->GetBulletRigidBody()->isActive())
+		{
+			++stepStats.activeRigidBodyCount;
+		}
 	}
+	stepStats.movedRigidBodyCount = (int)movedRigidBodies_.size();
+
+	// Islands are sorted by their ids after the step, static objects are left out as each of them is a separate element
+	const btCollisionObjectArray& collisionObjects = dynamicsWorld_->getCollisionObjectArray();
+	btUnionFind& unionFind = dynamicsWorld_->getSimulationIslandManager()->getUnionFind();
+	const int elementCount = unionFind.getNumElements();
+	int lastIslandId = -1;
+	for (int elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+	{
+		const btElement& element = unionFind.getElement(elementIndex);
+		if (collisionObjects.size() <= element.m_sz || collisionObjects[element.m_sz]->isStaticOrKinematicObject())
+		{
+			continue;
+		}
 
-	Vector3 worldPositionOnA = PhysicsUtils::FromBtVector3ToVector3(monifoldPointPtr->getContactPoint(0).getPositionWorldOnA());
-	Vector3 hitNormal = PhysicsUtils::FromBtVector3ToVector3(monifoldPointPtr->getContactPoint(0).m_normalWorldOnB);
+		if (element.m_id != lastIslandId)
+		{
+			lastIslandId = element.m_id;
+			++stepStats.islandCount;
+		}
+	}
 
-	Vector3 worldPositionOnB = PhysicsUtils::FromBtVector3ToVector3(monifoldPointPtr->getContactPoint(0).getPositionWorldOnB());
+	stepStats.overlappingPairCount = broadphase_->getOverlappingPairCache()->getNumOverlappingPairs();
+	stepStats.manifoldCount = dispatcher_->getNumManifolds();
+	stepStats.contactPointCount = lastStepContactPointCount_;
+	stepStats.contactPairCount = (int)previousContactPairs_.size();
 
-	collisionComponent1->OverlapBegin(collisionObject2, collisionComponent2, worldPositionOnA, hitNormal);
-	collisionComponent2->OverlapBegin(collisionObject1, collisionComponent1, worldPositionOnB, hitNormal);
+	stats_->AddSample(stepStats);
 }
 
-void PhysicsWorld::OnOverlappingCollisionContinue(btManifoldPoint& monifoldPoint, const btCollisionObject* ghostObject1, const btCollisionObject* ghostObject2)
+void PhysicsWorld::OnRigidBodyMoved(RigidBody* rigidBody)
 {
-	PhysicsObject* collisionObject1 = (PhysicsObject*)ghostObject1->getUserPointer();
-	PhysicsObject* collisionObject2 = (PhysicsObject*)ghostObject2->getUserPointer();
+	threadMovedRigidBodies_[btGetCurrentThreadIndex()].push_back(rigidBody);
+}
 
-	GOKNAR_CORE_ASSERT(collisionObject1 && collisionObject2, "Neither of the colliding bodies can be nullptr!");
+void PhysicsWorld::GatherMovedRigidBodies()
+{
+	movedRigidBodies_.clear();
+	for (RigidBodyVector& threadMovedRigidBodies : threadMovedRigidBodies_)
+	{
+		for (RigidBody* rigidBody : threadMovedRigidBodies)
+		{
+			rigidBody->GetMotionState()->SetLastMovedStep(totalStepCount_);
+		}
 
-	CollisionComponent* collisionComponent1 = collisionObject1->GetCollisionComponent();
-	CollisionComponent* collisionComponent2 = collisionObject2->GetCollisionComponent();
+		movedRigidBodies_.insert(movedRigidBodies_.end(), threadMovedRigidBodies.begin(), threadMovedRigidBodies.end());
+		threadMovedRigidBodies.clear();
+	}
+}
 
-	GOKNAR_CORE_ASSERT(collisionComponent1 && collisionComponent2);
+void PhysicsWorld::GatherContactEvents()
+{
+	currentContactPairs_.clear();
+	lastStepContactPointCount_ = 0;
 
-	if (!collisionComponent1->GetIsActive() || !collisionComponent2->GetIsActive())
+	// Manifolds are only read after the step, so contacts found on the worker threads of the multithreaded world need no synchronization
+	const int manifoldCount = dispatcher_->getNumManifolds();
+	for (int manifoldIndex = 0; manifoldIndex < manifoldCount; ++manifoldIndex)
 	{
-		return;
+		const btPersistentManifold* manifold = dispatcher_->getManifoldByIndexInternal(manifoldIndex);
+
+		const int contactPointCount = manifold->getNumContacts();
+		if (contactPointCount == 0)
+		{
+			continue;
+		}
+
+		lastStepContactPointCount_ += contactPointCount;
+
+		const btCollisionObject* collisionObject1 = manifold->getBody0();
+		const btCollisionObject* collisionObject2 = manifold->getBody1();
+
+		const PhysicsObject* physicsObject1 = (const PhysicsObject*)collisionObject1->getUserPointer();
+		const PhysicsObject* physicsObject2 = (const PhysicsObject*)collisionObject2->getUserPointer();
+
+		// Bullet objects that are not created through the engine(benchmarks, tools etc.) do not have user pointers
+		if (!physicsObject1 || !physicsObject2)
+		{
+			continue;
+		}
+
+		btVector3 worldPositionOnA{ 0.f, 0.f, 0.f };
+		btVector3 worldPositionOnB{ 0.f, 0.f, 0.f };
+		btVector3 hitNormal{ 0.f, 0.f, 0.f };
+		for (int contactPointIndex = 0; contactPointIndex < contactPointCount; ++contactPointIndex)
+		{
+			const btManifoldPoint& manifoldPoint = manifold->getContactPoint(contactPointIndex);
+			worldPositionOnA += manifoldPoint.getPositionWorldOnA();
+			worldPositionOnB += manifoldPoint.getPositionWorldOnB();
+			hitNormal += manifoldPoint.m_normalWorldOnB;
+		}
+
+		// Compound shapes can have several manifolds for the same pair, all of them are added to a single event
+		if (physicsObject2->GetGUID() < physicsObject1->GetGUID())
+		{
+			std::swap(collisionObject1, collisionObject2);
+			std::swap(worldPositionOnA, worldPositionOnB);
+			hitNormal = -hitNormal;
+		}
+
+		PhysicsContactEvent& contactEvent = currentContactPairs_[PhysicsContactPair(collisionObject1, collisionObject2)];
+		contactEvent.collisionObject1 = collisionObject1;
+		contactEvent.collisionObject2 = collisionObject2;
+		contactEvent.worldPositionOnA += worldPositionOnA;
+		contactEvent.worldPositionOnB += worldPositionOnB;
+		contactEvent.hitNormal += hitNormal;
+		contactEvent.contactPointCount += contactPointCount;
 	}
 
-	Vector3 worldPositionOnA = PhysicsUtils::FromBtVector3ToVector3(monifoldPoint.getPositionWorldOnA());
-	Vector3 hitNormal = PhysicsUtils::FromBtVector3ToVector3(monifoldPoint.m_normalWorldOnB);
+	contactEvents_.clear();
+
+	for (PhysicsContactPairMap::value_type& contactPair : currentContactPairs_)
+	{
+		PhysicsContactEvent& contactEvent = contactPair.second;
 
-	Vector3 worldPositionOnB = PhysicsUtils::FromBtVector3ToVector3(monifoldPoint.getPositionWorldOnB());
+		const btScalar inverseContactPointCount = btScalar(1.f) / contactEvent.contactPointCount;
+		contactEvent.worldPositionOnA *= inverseContactPointCount;
+		contactEvent.worldPositionOnB *= inverseContactPointCount;
+		contactEvent.hitNormal.safeNormalize();
 
-	collisionComponent1->OverlapContinue(collisionObject2, collisionComponent2, worldPositionOnA, hitNormal);
-	collisionComponent2->OverlapContinue(collisionObject1, collisionComponent1, worldPositionOnB, hitNormal);
+		contactEvent.type = previousContactPairs_.find(contactPair.first) == previousContactPairs_.end() ? PhysicsContactEventType::Begin : PhysicsContactEventType::Continue;
+		contactEvents_.push_back(contactEvent);
+	}
+
+	for (const PhysicsContactPairMap::value_type& contactPair : previousContactPairs_)
+	{
+		if (currentContactPairs_.find(contactPair.first) == currentContactPairs_.end())
+		{
+			contactEvents_.push_back(contactPair.second);
+			contactEvents_.back().type = PhysicsContactEventType::End;
+		}
+	}
+
+	previousContactPairs_.swap(currentContactPairs_);
 }
 
-void PhysicsWorld::OnOverlappingCollisionEnd(btPersistentManifold* const& manifold)
+void PhysicsWorld::DispatchContactEvents()
 {
-	PhysicsObject* collisionObject1 = (PhysicsObject*)manifold->getBody0()->getUserPointer();
-	PhysicsObject* collisionObject2 = (PhysicsObject*)manifold->getBody1()->getUserPointer();
+	// Pairs are unique in a step and ordered by GUID, sorting them dispatches the events in the same order every run
+	std::sort(contactEvents_.begin(), contactEvents_.end(),
+		[](const PhysicsContactEvent& lhs, const PhysicsContactEvent& rhs)
+		{
+			const PhysicsObject* lhsObject1 = (const PhysicsObject*)lhs.collisionObject1->getUserPointer();
+			const PhysicsObject* lhsObject2 = (const PhysicsObject*)lhs.collisionObject2->getUserPointer();
+			const PhysicsObject* rhsObject1 = (const PhysicsObject*)rhs.collisionObject1->getUserPointer();
+			const PhysicsObject* rhsObject2 = (const PhysicsObject*)rhs.collisionObject2->getUserPointer();
+
+			if (lhsObject1->GetGUID() != rhsObject1->GetGUID())
+			{
+				return lhsObject1->GetGUID() < rhsObject1->GetGUID();
+			}
+
+			return lhsObject2->GetGUID() < rhsObject2->GetGUID();
+		});
+
+	for (const PhysicsContactEvent& contactEvent : contactEvents_)
+	{
+		HandleContactEvent(contactEvent);
+	}
+
+	contactEvents_.clear();
+}
+
+void PhysicsWorld::HandleContactEvent(const PhysicsContactEvent& contactEvent)
+{
+	PhysicsObject* collisionObject1 = (PhysicsObject*)contactEvent.collisionObject1->getUserPointer();
+	PhysicsObject* collisionObject2 = (PhysicsObject*)contactEvent.collisionObject2->getUserPointer();
 
 	GOKNAR_CORE_ASSERT(collisionObject1 && collisionObject2, "Neither of the colliding bodies can be nullptr!");
 
@@ -197,9 +501,61 @@ void PhysicsWorld::OnOverlappingCollisionEnd(btPersistentManifold* const& manifo
 		return;
 	}
 
-	collisionComponent1->OverlapEnd(collisionObject2, collisionComponent2);
-	collisionComponent2->OverlapEnd(collisionObject1, collisionComponent1);
-};
+	switch (contactEvent.type)
+	{
+		case PhysicsContactEventType::Begin:
+		case PhysicsContactEventType::Continue:
+		{
+			const Vector3 worldPositionOnA = PhysicsUtils::FromBtVector3ToVector3(contactEvent.worldPositionOnA);
+			const Vector3 worldPositionOnB = PhysicsUtils::FromBtVector3ToVector3(contactEvent.worldPositionOnB);
+			const Vector3 hitNormal = PhysicsUtils::FromBtVector3ToVector3(contactEvent.hitNormal);
+
+			if (contactEvent.type == PhysicsContactEventType::Begin)
+			{
+				collisionComponent1->OverlapBegin(collisionObject2, collisionComponent2, worldPositionOnA, hitNormal);
+				collisionComponent2->OverlapBegin(collisionObject1, collisionComponent1, worldPositionOnB, hitNormal);
+			}
+			else
+			{
+				collisionComponent1->OverlapContinue(collisionObject2, collisionComponent2, worldPositionOnA, hitNormal);
+				collisionComponent2->OverlapContinue(collisionObject1, collisionComponent1, worldPositionOnB, hitNormal);
+			}
+			break;
+		}
+		case PhysicsContactEventType::End:
+		{
+			collisionComponent1->OverlapEnd(collisionObject2, collisionComponent2);
+			collisionComponent2->OverlapEnd(collisionObject1, collisionComponent1);
+			break;
+		}
+	}
+}
+
+void PhysicsWorld::EndContactPairs(const btCollisionObject* collisionObject)
+{
+	// Removed objects are not in the next step, their contacts end right away
+	std::vector<PhysicsContactEvent> endedContactEvents;
+
+	PhysicsContactPairMap::iterator contactPairIterator = previousContactPairs_.begin();
+	while (contactPairIterator != previousContactPairs_.end())
+	{
+		if (contactPairIterator->first.first == collisionObject || contactPairIterator->first.second == collisionObject)
+		{
+			endedContactEvents.push_back(contactPairIterator->second);
+			endedContactEvents.back().type = PhysicsContactEventType::End;
+			contactPairIterator = previousContactPairs_.erase(contactPairIterator);
+		}
+		else
+		{
+			++contactPairIterator;
+		}
+	}
+
+	for (const PhysicsContactEvent& contactEvent : endedContactEvents)
+	{
+		HandleContactEvent(contactEvent);
+	}
+}
 
 void PhysicsWorld::AddRigidBody(RigidBody* rigidBody)
 {
@@ -207,6 +563,9 @@ void PhysicsWorld::AddRigidBody(RigidBody* rigidBody)
 
 	dynamicsWorld_->addRigidBody(bulletRigidBody, (int)rigidBody->GetCollisionGroup(), (int)rigidBody->GetCollisionMask());
 	physicsObjects_.push_back(rigidBody);
+	rigidBodies_.push_back(rigidBody);
+
+	rigidBody->SavePhysicsState();
 }
 
 void PhysicsWorld::RemoveRigidBody(RigidBody* rigidBody)
@@ -230,7 +589,17 @@ void PhysicsWorld::RemoveRigidBody(RigidBody* rigidBody)
 		++physicsObjectIterator;
 	}
 
+	for (RigidBodyVector* rigidBodyVector : { &rigidBodies_, &movedRigidBodies_, &interpolatedRigidBodies_ })
+	{
+		decltype(rigidBodyVector->begin()) rigidBodyIterator = std::find(rigidBodyVector->begin(), rigidBodyVector->end(), rigidBody);
+		if (rigidBodyIterator != rigidBodyVector->end())
+		{
+			rigidBodyVector->erase(rigidBodyIterator);
+		}
+	}
+
 	dynamicsWorld_->removeRigidBody(bulletRigidBody);
+	EndContactPairs(bulletRigidBody);
 }
 
 void PhysicsWorld::AddPhysicsObject(PhysicsObject* physicsObject)
@@ -261,12 +630,21 @@ void PhysicsWorld::RemovePhysicsObject(PhysicsObject* physicsObject)
 	}
 
 	dynamicsWorld_->removeCollisionObject(bulletCollisionObject);
+	EndContactPairs(bulletCollisionObject);
 }
 
 void PhysicsWorld::AddPhysicsMovementComponent(PhysicsMovementComponent* physicsMovementComponent)
 {
 	physicsMovementComponents_.push_back(physicsMovementComponent);
-	dynamicsWorld_->addAction(physicsMovementComponent->GetBulletKinematicCharacterController());
+
+	if (physicsMovementComponent->GetIsInCrowd())
+	{
+		characterCrowd_->AddMember(physicsMovementComponent);
+	}
+	else
+	{
+		dynamicsWorld_->addAction(physicsMovementComponent->GetBulletKinematicCharacterController());
+	}
 }
 
 void PhysicsWorld::RemovePhysicsMovementComponent(PhysicsMovementComponent* physicsMovementComponent)
@@ -288,7 +666,14 @@ void PhysicsWorld::RemovePhysicsMovementComponent(PhysicsMovementComponent* phys
 		++physicsMovementComponentIterator;
 	}
 
-	dynamicsWorld_->removeAction(physicsMovementComponent->GetBulletKinematicCharacterController());
+	if (physicsMovementComponent->GetIsInCrowd())
+	{
+		characterCrowd_->RemoveMember(physicsMovementComponent);
+	}
+	else
+	{
+		dynamicsWorld_->removeAction(physicsMovementComponent->GetBulletKinematicCharacterController());
+	}
 }
 
 bool PhysicsWorld::RaycastClosest(const RaycastData& raycastData, RaycastSingleResult& raycastClosest)
@@ -379,4 +764,159 @@ bool PhysicsWorld::SweepClosest(const SweepData& sweepData, RaycastSingleResult&
 	}
 	
 	return false;
-}
\ No newline at end of file
+}
+
+int PhysicsWorld::RaycastClosestBatch(const RaycastData* raycastData, int raycastCount, RaycastSingleResult* results)
+{
+	GOKNAR_CORE_ASSERT(!isSteppingSimulation_, "Batched queries cannot be run while the simulation is stepping");
+
+	std::atomic<int> hitCount{ 0 };
+
+	engine->GetJobManager()->ParallelFor(raycastCount, PHYSICS_QUERY_BATCH_SIZE,
+		[this, raycastData, results, &hitCount](int beginIndex, int endIndex)
+		{
+			// A single callback is reset for every query of the batch
+			btCollisionWorld::ClosestRayResultCallback closestRayResultCallback(btVector3(0.f, 0.f, 0.f), btVector3(0.f, 0.f, 0.f));
+
+			int batchHitCount = 0;
+			for (int raycastIndex = beginIndex; raycastIndex < endIndex; ++raycastIndex)
+			{
+				const RaycastData& currentRaycastData = raycastData[raycastIndex];
+
+				closestRayResultCallback.m_rayFromWorld = PhysicsUtils::FromVector3ToBtVector3(currentRaycastData.from);
+				closestRayResultCallback.m_rayToWorld = PhysicsUtils::FromVector3ToBtVector3(currentRaycastData.to);
+				closestRayResultCallback.m_closestHitFraction = 1.f;
+				closestRayResultCallback.m_collisionObject = nullptr;
+				closestRayResultCallback.m_collisionFilterGroup = (int)currentRaycastData.collisionGroup;
+				closestRayResultCallback.m_collisionFilterMask = (int)currentRaycastData.collisionMask;
+
+				dynamicsWorld_->rayTest(closestRayResultCallback.m_rayFromWorld, closestRayResultCallback.m_rayToWorld, closestRayResultCallback);
+
+				RaycastSingleResult& result = results[raycastIndex];
+				if (closestRayResultCallback.hasHit())
+				{
+					result.hitObject = (PhysicsObject*)closestRayResultCallback.m_collisionObject->getUserPointer();
+					result.hitFraction = closestRayResultCallback.m_closestHitFraction;
+					result.hitPosition = PhysicsUtils::FromBtVector3ToVector3(closestRayResultCallback.m_hitPointWorld);
+					result.hitNormal = PhysicsUtils::FromBtVector3ToVector3(closestRayResultCallback.m_hitNormalWorld);
+					++batchHitCount;
+				}
+				else
+				{
+					result = RaycastSingleResult();
+				}
+			}
+
+			hitCount += batchHitCount;
+		});
+
+	return hitCount;
+}
+
+int PhysicsWorld::RaycastAllBatch(const RaycastData* raycastData, int raycastCount, RaycastAllResult* results)
+{
+	GOKNAR_CORE_ASSERT(!isSteppingSimulation_, "Batched queries cannot be run while the simulation is stepping");
+
+	std::atomic<int> hitCount{ 0 };
+
+	engine->GetJobManager()->ParallelFor(raycastCount, PHYSICS_QUERY_BATCH_SIZE,
+		[this, raycastData, results, &hitCount](int beginIndex, int endIndex)
+		{
+			// A single callback is reset for every query of the batch, its hit arrays keep their capacity
+			btCollisionWorld::AllHitsRayResultCallback allHitsRayResultCallback(btVector3(0.f, 0.f, 0.f), btVector3(0.f, 0.f, 0.f));
+
+			int batchHitCount = 0;
+			for (int raycastIndex = beginIndex; raycastIndex < endIndex; ++raycastIndex)
+			{
+				const RaycastData& currentRaycastData = raycastData[raycastIndex];
+
+				allHitsRayResultCallback.m_rayFromWorld = PhysicsUtils::FromVector3ToBtVector3(currentRaycastData.from);
+				allHitsRayResultCallback.m_rayToWorld = PhysicsUtils::FromVector3ToBtVector3(currentRaycastData.to);
+				allHitsRayResultCallback.m_closestHitFraction = 1.f;
+				allHitsRayResultCallback.m_collisionObject = nullptr;
+				allHitsRayResultCallback.m_collisionObjects.resize(0);
+				allHitsRayResultCallback.m_hitNormalWorld.resize(0);
+				allHitsRayResultCallback.m_hitPointWorld.resize(0);
+				allHitsRayResultCallback.m_hitFractions.resize(0);
+				allHitsRayResultCallback.m_collisionFilterGroup = (int)currentRaycastData.collisionGroup;
+				allHitsRayResultCallback.m_collisionFilterMask = (int)currentRaycastData.collisionMask;
+
+				dynamicsWorld_->rayTest(allHitsRayResultCallback.m_rayFromWorld, allHitsRayResultCallback.m_rayToWorld, allHitsRayResultCallback);
+
+				std::vector<RaycastSingleResult>& hitResults = results[raycastIndex].hitResults;
+				hitResults.clear();
+
+				if (allHitsRayResultCallback.hasHit())
+				{
+					const int resultHitCount = allHitsRayResultCallback.m_collisionObjects.size();
+					for (int hitIndex = 0; hitIndex < resultHitCount; hitIndex++)
+					{
+						hitResults.emplace_back(
+							(PhysicsObject*)allHitsRayResultCallback.m_collisionObjects[hitIndex]->getUserPointer(),
+							PhysicsUtils::FromBtVector3ToVector3(allHitsRayResultCallback.m_hitPointWorld[hitIndex]),
+							PhysicsUtils::FromBtVector3ToVector3(allHitsRayResultCallback.m_hitNormalWorld[hitIndex]),
+							allHitsRayResultCallback.m_hitFractions[hitIndex]
+						);
+					}
+					++batchHitCount;
+				}
+			}
+
+			hitCount += batchHitCount;
+		});
+
+	return hitCount;
+}
+
+int PhysicsWorld::SweepClosestBatch(const SweepData* sweepData, int sweepCount, RaycastSingleResult* results)
+{
+	GOKNAR_CORE_ASSERT(!isSteppingSimulation_, "Batched queries cannot be run while the simulation is stepping");
+
+	std::atomic<int> hitCount{ 0 };
+
+	engine->GetJobManager()->ParallelFor(sweepCount, PHYSICS_QUERY_BATCH_SIZE,
+		[this, sweepData, results, &hitCount](int beginIndex, int endIndex)
+		{
+			// A single callback is reset for every query of the batch
+			btCollisionWorld::ClosestConvexResultCallback closestResultCallback(btVector3(0.f, 0.f, 0.f), btVector3(0.f, 0.f, 0.f));
+
+			int batchHitCount = 0;
+			for (int sweepIndex = beginIndex; sweepIndex < endIndex; ++sweepIndex)
+			{
+				const SweepData& currentSweepData = sweepData[sweepIndex];
+
+				GOKNAR_CORE_ASSERT(currentSweepData.collisionComponent->GetBulletCollisionShape()->isConvex());
+				btConvexShape* bulletcollisionShape = (btConvexShape*)currentSweepData.collisionComponent->GetBulletCollisionShape();
+
+				const btTransform bulletFromTransform = PhysicsUtils::GetBulletTransform(currentSweepData.fromRotation, currentSweepData.fromPosition);
+				const btTransform bulletToTransform = PhysicsUtils::GetBulletTransform(currentSweepData.toRotation, currentSweepData.toPosition);
+
+				closestResultCallback.m_convexFromWorld = bulletFromTransform.getOrigin();
+				closestResultCallback.m_convexToWorld = bulletToTransform.getOrigin();
+				closestResultCallback.m_closestHitFraction = 1.f;
+				closestResultCallback.m_hitCollisionObject = nullptr;
+				closestResultCallback.m_collisionFilterGroup = (int)currentSweepData.collisionGroup;
+				closestResultCallback.m_collisionFilterMask = (int)currentSweepData.collisionMask;
+
+				dynamicsWorld_->convexSweepTest(bulletcollisionShape, bulletFromTransform, bulletToTransform, closestResultCallback, currentSweepData.ccdPenetration);
+
+				RaycastSingleResult& result = results[sweepIndex];
+				if (closestResultCallback.hasHit())
+				{
+					result.hitObject = (PhysicsObject*)closestResultCallback.m_hitCollisionObject->getUserPointer();
+					result.hitFraction = closestResultCallback.m_closestHitFraction;
+					result.hitPosition = PhysicsUtils::FromBtVector3ToVector3(closestResultCallback.m_hitPointWorld);
+					result.hitNormal = PhysicsUtils::FromBtVector3ToVector3(closestResultCallback.m_hitNormalWorld);
+					++batchHitCount;
+				}
+				else
+				{
+					result = RaycastSingleResult();
+				}
+			}
+
+			hitCount += batchHitCount;
+		});
+
+	return hitCount;
+}
@@ -1,23 +1,33 @@
 #ifndef __IPHYSICSWORLD_H__
 #define __IPHYSICSWORLD_H__
 
+#include <unordered_map>
+
 #include "Core.h"
 #include "Math/GoknarMath.h"
 #include "Physics/PhysicsTypes.h"
 
 #include "btBulletDynamicsCommon.h"
+#include "LinearMath/btThreads.h"
 
 class btGhostObject;
 class btGhostPairCallback;
 
 class Character;
+class CharacterCrowd;
 class CollisionComponent;
 class PhysicsMovementComponent;
 class OverlappingCollisionPairCallback;
 class PhysicsDebugger;
 class PhysicsObject;
+class PhysicsShapeCache;
+class PhysicsStats;
+class PhysicsTaskScheduler;
 class RigidBody;
 
+// Number of queries a worker takes at once in batched queries
+constexpr int PHYSICS_QUERY_BATCH_SIZE = 64;
+
 struct GOKNAR_API RaycastData
 {
     Vector3 from;
@@ -63,6 +73,37 @@ struct GOKNAR_API RaycastAllResult
     std::vector<RaycastSingleResult> hitResults;
 };
 
+enum class GOKNAR_API PhysicsContactEventType : unsigned char
+{
+    Begin = 0,
+    Continue,
+    End
+};
+
+// Contact of a pair of collision objects in a step, every contact point of the pair is coalesced into
+// an averaged contact point and normal
+struct GOKNAR_API PhysicsContactEvent
+{
+    const btCollisionObject* collisionObject1{ nullptr };
+    const btCollisionObject* collisionObject2{ nullptr };
+    btVector3 worldPositionOnA{ 0.f, 0.f, 0.f };
+    btVector3 worldPositionOnB{ 0.f, 0.f, 0.f };
+    btVector3 hitNormal{ 0.f, 0.f, 0.f };
+    int contactPointCount{ 0 };
+    PhysicsContactEventType type{ PhysicsContactEventType::Begin };
+};
+
+// Collision objects of a contact pair, in GUID order of their physics objects
+typedef std::pair<const btCollisionObject*, const btCollisionObject*> PhysicsContactPair;
+
+struct GOKNAR_API PhysicsContactPairHash
+{
+    size_t operator()(const PhysicsContactPair& contactPair) const
+    {
+        return std::hash<const void*>()(contactPair.first) ^ (std::hash<const void*>()(contactPair.second) * 31);
+    }
+};
+
 class GOKNAR_API PhysicsWorld
 {
 public:
@@ -80,6 +121,11 @@ public:
 
     virtual void AddPhysicsObject(PhysicsObject* physicsObject);
     virtual void RemovePhysicsObject(PhysicsObject* physicsObject);
+
+    void ReservePhysicsObjects(int additionalPhysicsObjectCount)
+    {
+        physicsObjects_.reserve(physicsObjects_.size() + additionalPhysicsObjectCount);
+    }
     
     virtual void AddPhysicsMovementComponent(PhysicsMovementComponent* physicsMovementComponent);
     virtual void RemovePhysicsMovementComponent(PhysicsMovementComponent* physicsMovementComponent);
@@ -88,6 +134,13 @@ public:
     virtual bool RaycastAll(const RaycastData& raycastData, RaycastAllResult& raycastClosest);
     virtual bool SweepClosest(const SweepData& sweepData, RaycastSingleResult& result);
 
+    // Batched queries run in parallel on the JobManager's workers and write the result of each query to the same index,
+    // results of missed queries have no hit object and the hit count is returned
+    // Queries only read the broadphase, so they must not be run while the simulation is stepping
+    int RaycastClosestBatch(const RaycastData* raycastData, int raycastCount, RaycastSingleResult* results);
+    int RaycastAllBatch(const RaycastData* raycastData, int raycastCount, RaycastAllResult* results);
+    int SweepClosestBatch(const SweepData* sweepData, int sweepCount, RaycastSingleResult* results);
+
     const Vector3& GetGravity() const
     {
         return gravity_;
@@ -98,9 +151,95 @@ public:
         gravity_ = gravity;
     }
 
-    void OnOverlappingCollisionBegin(btPersistentManifold* const& manifold);
-    void OnOverlappingCollisionContinue(btManifoldPoint& monifoldPoint, const btCollisionObject* ghostObject1, const btCollisionObject* ghostObject2);
-    void OnOverlappingCollisionEnd(btPersistentManifold* const& manifold);
+    // Uses Bullet's multithreaded world running on the engine's JobManager, has to be set before PreInit
+    void SetIsMultithreaded(bool isMultithreaded)
+    {
+        isMultithreaded_ = isMultithreaded;
+    }
+
+    bool GetIsMultithreaded() const
+    {
+        return isMultithreaded_;
+    }
+
+    // Thread count of the multithreaded world, clamped to the JobManager's worker count + 1 when the world is initialized
+    // 0 uses every available thread
+    void SetThreadCount(int threadCount);
+    int GetThreadCount() const;
+
+    // Simulation is advanced in fixedTimeStep sized steps, time left over is carried to the next frame
+    // and rigid bodies are rendered interpolated between their last two physics states
+    void SetIsFixedTimeStepEnabled(bool isFixedTimeStepEnabled);
+
+    bool GetIsFixedTimeStepEnabled() const
+    {
+        return isFixedTimeStepEnabled_;
+    }
+
+    void SetFixedTimeStep(float fixedTimeStep)
+    {
+        fixedTimeStep_ = fixedTimeStep;
+    }
+
+    float GetFixedTimeStep() const
+    {
+        return fixedTimeStep_;
+    }
+
+    // Steps taken in a single frame are limited so that a slow frame does not make the next ones even slower,
+    // time exceeding the budget is dropped and the simulation slows down instead
+    void SetMaxSubStepCount(int maxSubStepCount)
+    {
+        maxSubStepCount_ = maxSubStepCount;
+    }
+
+    int GetMaxSubStepCount() const
+    {
+        return maxSubStepCount_;
+    }
+
+    // Fraction of a fixed step between the last physics state and the next one
+    float GetInterpolationAlpha() const
+    {
+        return interpolationAlpha_;
+    }
+
+    int GetLastFrameStepCount() const
+    {
+        return lastFrameStepCount_;
+    }
+
+    // Wall time spent on a single step in the last frame, in seconds
+    float GetLastStepDuration() const
+    {
+        return 0 < lastFrameStepCount_ ? lastFrameStepsDuration_ / lastFrameStepCount_ : 0.f;
+    }
+
+    // Wall time spent on all steps in the last frame, in seconds
+    float GetLastFrameStepsDuration() const
+    {
+        return lastFrameStepsDuration_;
+    }
+
+    unsigned long long GetTotalStepCount() const
+    {
+        return totalStepCount_;
+    }
+
+    // Simulation time dropped because of the sub step budget, in seconds
+    float GetDroppedTime() const
+    {
+        return droppedTime_;
+    }
+
+    // Contact pairs found in the last step
+    int GetContactPairCount() const
+    {
+        return (int)previousContactPairs_.size();
+    }
+
+    // Called by the motion states of awake rigid bodies at the end of a step
+    void OnRigidBodyMoved(RigidBody* rigidBody);
 
     btDiscreteDynamicsWorld* GetBulletPhysicsWorld() const
     {
@@ -112,6 +251,23 @@ public:
         return physicsDebugger_;
     }
 
+    PhysicsShapeCache* GetShapeCache() const
+    {
+        return shapeCache_;
+    }
+
+    // Per step timings and counters are sampled while the stats are enabled
+    PhysicsStats* GetStats() const
+    {
+        return stats_;
+    }
+
+    // Movement components in the crowd are moved together after every internal step instead of as Bullet actions
+    CharacterCrowd* GetCharacterCrowd() const
+    {
+        return characterCrowd_;
+    }
+
 protected:
     typedef std::vector<PhysicsObject*> PhysicsObjectVector;
     PhysicsObjectVector physicsObjects_;
@@ -119,19 +275,66 @@ protected:
     typedef std::vector<PhysicsMovementComponent*> PhysicsMovementComponentVector;
     PhysicsMovementComponentVector physicsMovementComponents_;
 
+    typedef std::vector<RigidBody*> RigidBodyVector;
+    RigidBodyVector rigidBodies_;
+
 private:
+    void StepSimulation(float stepDeltaTime, int maxSubSteps);
+    void GatherMovedRigidBodies();
+    void SampleStepStats(float stepDuration, float syncDuration);
+    void GatherContactEvents();
+    void DispatchContactEvents();
+    void HandleContactEvent(const PhysicsContactEvent& contactEvent);
+    void EndContactPairs(const btCollisionObject* collisionObject);
+
     Vector3 gravity_{ Vector3{0.f, 0.f, -10.f} };
 
+    // Contacts are read from the manifolds once per step instead of Bullet's per point callbacks,
+    // pairs that are not in the previous step begin and the ones that are missing end
+    typedef std::unordered_map<PhysicsContactPair, PhysicsContactEvent, PhysicsContactPairHash> PhysicsContactPairMap;
+    PhysicsContactPairMap currentContactPairs_;
+    PhysicsContactPairMap previousContactPairs_;
+    std::vector<PhysicsContactEvent> contactEvents_;
+
+    // Rigid bodies moved in the last step, sleeping bodies are never visited
+    RigidBodyVector threadMovedRigidBodies_[BT_MAX_THREAD_COUNT];
+    RigidBodyVector movedRigidBodies_;
+
+    // Rigid bodies moved in the last fixed step, interpolated every frame until the next step
+    RigidBodyVector interpolatedRigidBodies_;
+
     PhysicsDebugger* physicsDebugger_{ nullptr };
+    PhysicsShapeCache* shapeCache_{ nullptr };
+    PhysicsStats* stats_{ nullptr };
+    CharacterCrowd* characterCrowd_{ nullptr };
 
     btGhostPairCallback* ghostPairCallback_{ nullptr };
     btBroadphaseInterface* broadphase_{ nullptr };
     btCollisionDispatcher* dispatcher_{ nullptr };
     btDispatcherInfo* dispatcherInfo_{ nullptr };
     btConstraintSolver* solver_{ nullptr };
+    btConstraintSolver* largeIslandSolver_{ nullptr };
     btDefaultCollisionConfiguration* collisionConfiguration_{ nullptr };
     btDiscreteDynamicsWorld* dynamicsWorld_{ nullptr };
     OverlappingCollisionPairCallback* overlappingCollisionPairCallback_{ nullptr };
+    PhysicsTaskScheduler* taskScheduler_{ nullptr };
+
+    float fixedTimeStep_{ 1.f / 60.f };
+    float timeStepAccumulator_{ 0.f };
+    float interpolationAlpha_{ 1.f };
+    float lastFrameStepsDuration_{ 0.f };
+    float droppedTime_{ 0.f };
+    unsigned long long totalStepCount_{ 0 };
+
+    int maxSubStepCount_{ 4 };
+    int lastFrameStepCount_{ 0 };
+    int threadCount_{ 0 };
+    int lastStepContactPointCount_{ 0 };
+
+    bool isFixedTimeStepEnabled_{ false };
+
+    bool isMultithreaded_{ false };
+    bool isSteppingSimulation_{ false };
 };
 
 #endif
\ No newline at end of file
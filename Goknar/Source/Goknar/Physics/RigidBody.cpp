@@ -6,6 +6,7 @@
 #include "Components/CollisionComponent.h"
 #include "Physics/PhysicsWorld.h"
 #include "Physics/PhysicsUtils.h"
+#include "Physics/RigidBodyMotionState.h"
 
 #include "btBulletDynamicsCommon.h"
 #include "Bullet3Common/b3Vector3.h"
@@ -45,7 +46,7 @@ void RigidBody::Init()
     bulletTransform.setOrigin(PhysicsUtils::FromVector3ToBtVector3(worldPosition_));
     bulletTransform.setRotation(PhysicsUtils::FromQuaternionToBtQuaternion(worldRotation_));
 
-    bulletMotionState_ = new btDefaultMotionState(bulletTransform);
+    bulletMotionState_ = new RigidBodyMotionState(this, bulletTransform);
     btRigidBody::btRigidBodyConstructionInfo rigidBodyInfo(mass_, bulletMotionState_, bulletCollisionShape, rigidBodyInitializationData_->localInertia);
 
     if (0.f <= rigidBodyInitializationData_->linearSleepingThreshold)
@@ -100,9 +101,30 @@ void RigidBody::Tick(float deltaTime)
 
 void RigidBody::PhysicsTick(float deltaTime)
 {
-    const btVector3& bulletWorldPosition = bulletRigidBody_->getCenterOfMassPosition();
-    const btQuaternion& bulletWorldRotation = bulletRigidBody_->getOrientation();
+    // Transformation is synced by the physics world for the bodies that moved in the step
+}
+
+void RigidBody::SavePhysicsState()
+{
+    bulletMotionState_->ResetWorldTransform(bulletRigidBody_->getCenterOfMassTransform());
+}
+
+void RigidBody::InterpolatePhysicsState(float alpha)
+{
+    const btTransform& bulletWorldTransform = bulletMotionState_->GetWorldTransform();
+
+    btVector3 bulletWorldPosition = bulletWorldTransform.getOrigin();
+    btQuaternion bulletWorldRotation = bulletWorldTransform.getRotation();
 
+    if (alpha < 1.f)
+    {
+        const btTransform& bulletPreviousWorldTransform = bulletMotionState_->GetPreviousWorldTransform();
+
+        bulletWorldPosition = bulletPreviousWorldTransform.getOrigin().lerp(bulletWorldPosition, alpha);
+        bulletWorldRotation = bulletPreviousWorldTransform.getRotation().slerp(bulletWorldRotation, alpha);
+    }
+
+    // Single world transformation matrix update for both position and rotation
     PhysicsObject::SetWorldPosition(PhysicsUtils::FromBtVector3ToVector3(bulletWorldPosition), false);
     PhysicsObject::SetWorldRotation(PhysicsUtils::FromBtQuaternionToQuaternion(bulletWorldRotation));
 }
@@ -207,6 +229,9 @@ void RigidBody::SetWorldPosition(const Vector3& worldPosition, bool updateWorldT
     btTransform newBulletTransform = bulletRigidBody_->getCenterOfMassTransform();
     newBulletTransform.setOrigin(PhysicsUtils::FromVector3ToBtVector3(worldPosition));
     bulletRigidBody_->setCenterOfMassTransform(newBulletTransform);
+
+    // Motion state is kept in sync so that teleports are not interpolated and kinematic bodies keep the new transform
+    SavePhysicsState();
 }
 
 void RigidBody::SetWorldRotation(const Quaternion& worldRotation, bool updateWorldTransformationMatrix)
@@ -222,6 +247,9 @@ void RigidBody::SetWorldRotation(const Quaternion& worldRotation, bool updateWor
     btTransform newBulletTransform = bulletRigidBody_->getCenterOfMassTransform();
     newBulletTransform.setRotation(PhysicsUtils::FromQuaternionToBtQuaternion(worldRotation));
     bulletRigidBody_->setCenterOfMassTransform(newBulletTransform);
+
+    // Motion state is kept in sync so that teleports are not interpolated and kinematic bodies keep the new transform
+    SavePhysicsState();
 }
 
 void RigidBody::SetIsActive(bool isActive)
@@ -9,8 +9,8 @@
 
 #include "LinearMath/btVector3.h"
 
-class btDefaultMotionState;
 class btRigidBody;
+class RigidBodyMotionState;
 
 struct GOKNAR_API RigidBodyInitializationData : public PhysicsObjectInitializationData
 {
@@ -94,11 +94,22 @@ public:
 		return bulletRigidBody_;
 	}
 
+	RigidBodyMotionState* GetMotionState() const
+	{
+		return bulletMotionState_;
+	}
+
+	// Makes the current physics state the one rendered transforms are interpolated from
+	void SavePhysicsState();
+
+	// Sets the world position and rotation between the physics state before the last step(0.f) and the current one(1.f)
+	void InterpolatePhysicsState(float alpha);
+
 protected:
 	virtual void DestroyInner() override;
 
 	btRigidBody* bulletRigidBody_{ nullptr };
-	btDefaultMotionState* bulletMotionState_{ nullptr };
+	RigidBodyMotionState* bulletMotionState_{ nullptr };
 
 private:
 	RigidBodyInitializationData* rigidBodyInitializationData_{ nullptr };
@@ -0,0 +1,32 @@
+#include "pch.h"
+
+#include "RigidBodyMotionState.h"
+
+#include "Engine.h"
+#include "Physics/PhysicsWorld.h"
+
+RigidBodyMotionState::RigidBodyMotionState(RigidBody* rigidBody, const btTransform& worldTransform) :
+	worldTransform_(worldTransform),
+	previousWorldTransform_(worldTransform),
+	rigidBody_(rigidBody)
+{
+}
+
+void RigidBodyMotionState::getWorldTransform(btTransform& worldTransform) const
+{
+	worldTransform = worldTransform_;
+}
+
+void RigidBodyMotionState::setWorldTransform(const btTransform& worldTransform)
+{
+	previousWorldTransform_ = worldTransform_;
+	worldTransform_ = worldTransform;
+
+	engine->GetPhysicsWorld()->OnRigidBodyMoved(rigidBody_);
+}
+
+void RigidBodyMotionState::ResetWorldTransform(const btTransform& worldTransform)
+{
+	worldTransform_ = worldTransform;
+	previousWorldTransform_ = worldTransform;
+}
@@ -0,0 +1,55 @@
+#ifndef __RIGIDBODYMOTIONSTATE_H__
+#define __RIGIDBODYMOTIONSTATE_H__
+
+#include "Core.h"
+
+#include "LinearMath/btMotionState.h"
+#include "LinearMath/btTransform.h"
+
+class RigidBody;
+
+// Bullet only writes the motion states of awake bodies after a step,
+// moved rigid bodies are reported to the physics world so that only they are synced back to the engine
+class GOKNAR_API RigidBodyMotionState : public btMotionState
+{
+public:
+	RigidBodyMotionState(RigidBody* rigidBody, const btTransform& worldTransform);
+	virtual ~RigidBodyMotionState() = default;
+
+	virtual void getWorldTransform(btTransform& worldTransform) const override;
+	virtual void setWorldTransform(const btTransform& worldTransform) override;
+
+	// Sets both the current and the previous transforms, used when the body is moved outside of the simulation
+	void ResetWorldTransform(const btTransform& worldTransform);
+
+	const btTransform& GetWorldTransform() const
+	{
+		return worldTransform_;
+	}
+
+	// Transform before the last step the body moved in
+	const btTransform& GetPreviousWorldTransform() const
+	{
+		return previousWorldTransform_;
+	}
+
+	unsigned long long GetLastMovedStep() const
+	{
+		return lastMovedStep_;
+	}
+
+	void SetLastMovedStep(unsigned long long lastMovedStep)
+	{
+		lastMovedStep_ = lastMovedStep;
+	}
+
+private:
+	btTransform worldTransform_;
+	btTransform previousWorldTransform_;
+
+	RigidBody* rigidBody_{ nullptr };
+
+	unsigned long long lastMovedStep_{ 0 };
+};
+
+#endif
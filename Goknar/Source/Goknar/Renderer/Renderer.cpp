@@ -2,12 +2,16 @@
 
 #include "Renderer.h"
 
+#include <cstring>
+
 #include "Texture.h"
 #include "Framebuffer.h"
 #include "RenderBuffer.h"
 
 #include "Goknar/Application.h"
+#include "Goknar/Camera.h"
 #include "Goknar/Engine.h"
+#include "Goknar/Contents/Image.h"
 #include "Goknar/Scene.h"
 #include "Goknar/Log.h"
 
@@ -38,6 +42,7 @@
 #include "Goknar/Renderer/Shader.h"
 #include "Goknar/Renderer/ShaderBuilderNew.h"
 #include "Goknar/Renderer/PostProcessing.h"
+#include "Goknar/Renderer/TextureStreamer.h"
 
 #define VERTEX_COLOR_LOCATION 0
 #define VERTEX_POSITION_LOCATION 1
@@ -65,12 +70,15 @@ Renderer::Renderer() :
 	lightManager_(nullptr),
 	removeStaticDataFromMemoryAfterTransferingToGPU_(false)
 {
+	// Created before PreInit since textures of the contents register themselves while the resource manager is initialized
+	textureStreamer_ = new TextureStreamer();
 }
 
 Renderer::~Renderer()
 {
 	delete lightManager_;
 	delete deferredRenderingData_;
+	delete textureStreamer_;
 
 	EXIT_ON_GL_ERROR("Renderer::~Renderer");
 
@@ -151,6 +159,12 @@ void Renderer::PreInit()
 	lightManager_ = new LightManager();
 	lightManager_->PreInit();
 
+	// Submitted with the startup materials so that it is compiled along with them
+	fallbackMaterial_ = new Material();
+	fallbackMaterial_->SetName("FallbackMaterial");
+	fallbackMaterial_->Build(nullptr);
+	fallbackMaterial_->PreInit();
+
 	if (mainRenderType_ == RenderPassType::Deferred)
 	{
 		deferredRenderingData_ = new DeferredRenderingData();
@@ -161,16 +175,17 @@ void Renderer::PreInit()
 	glEnable(GL_DEPTH_TEST);
 	glDepthFunc(GL_LEQUAL);
 
+	// Counts are used instead of the arrays since cooked meshes keep their data in mapped files
 	for (StaticMesh* staticMesh : staticMeshes_)
 	{
-		totalStaticMeshVertexSize_ += (unsigned int)staticMesh->GetVerticesPointer()->size();
-		totalStaticMeshFaceSize_ += (unsigned int)staticMesh->GetFacesPointer()->size();
+		totalStaticMeshVertexSize_ += staticMesh->GetVertexCount();
+		totalStaticMeshFaceSize_ += staticMesh->GetFaceCount();
 	}
 
 	for (SkeletalMesh* skeletalMesh : skeletalMeshes_)
 	{
-		totalSkeletalMeshVertexSize_ += (unsigned int)skeletalMesh->GetVerticesPointer()->size();
-		totalSkeletalMeshFaceSize_ += (unsigned int)skeletalMesh->GetFacesPointer()->size();
+		totalSkeletalMeshVertexSize_ += skeletalMesh->GetVertexCount();
+		totalSkeletalMeshFaceSize_ += skeletalMesh->GetFaceCount();
 	}
 
 	for (DynamicMesh* dynamicMesh : dynamicMeshes_)
@@ -185,11 +200,16 @@ void Renderer::PreInit()
 void Renderer::Init()
 {
 	lightManager_->Init();
+
+	fallbackMaterial_->WaitForShaderPrograms();
+	fallbackMaterial_->Init();
 }
 
 void Renderer::PostInit()
 {
 	lightManager_->PostInit();
+
+	fallbackMaterial_->PostInit();
 }
 
 void Renderer::SetStaticBufferData()
@@ -201,14 +221,16 @@ void Renderer::SetStaticBufferData()
 
 	glGenBuffers(1, &staticVertexBufferId_);
 	glBindBuffer(GL_ARRAY_BUFFER, staticVertexBufferId_);
-	glBufferData(GL_ARRAY_BUFFER, totalStaticMeshVertexSize_ * sizeOfVertexData, nullptr, GL_STATIC_DRAW);
+	staticVertexBufferCapacity_ = totalStaticMeshVertexSize_ * sizeOfVertexData;
+	glBufferData(GL_ARRAY_BUFFER, staticVertexBufferCapacity_, nullptr, GL_STATIC_DRAW);
 
 	/*
 		Index buffer
 	*/
 	glGenBuffers(1, &staticIndexBufferId_);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, staticIndexBufferId_);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalStaticMeshFaceSize_ * sizeof(Face), nullptr, GL_STATIC_DRAW);
+	staticIndexBufferCapacity_ = totalStaticMeshFaceSize_ * sizeof(Face);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, staticIndexBufferCapacity_, nullptr, GL_STATIC_DRAW);
 
 	/*
 		Buffer Sub-Data
@@ -223,13 +245,18 @@ void Renderer::SetStaticBufferData()
 		staticMesh->SetBaseVertex(baseVertex);
 		staticMesh->SetVertexStartingIndex(vertexStartingIndex);
 
-		const VertexArray* vertexArrayPtr = staticMesh->GetVerticesPointer();
-		int vertexSizeInBytes = (int)vertexArrayPtr->size() * sizeof(vertexArrayPtr->at(0));
-		glBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexSizeInBytes, &vertexArrayPtr->at(0));
+		// Cooked meshes are uploaded straight from their mapped files
+		int vertexSizeInBytes = (int)(staticMesh->GetVertexCount() * sizeof(VertexData));
+		if (0 < vertexSizeInBytes)
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexSizeInBytes, staticMesh->GetVertexData());
+		}
 
-		const FaceArray* faceArrayPtr = staticMesh->GetFacesPointer();
-		int faceSizeInBytes = (int)faceArrayPtr->size() * sizeof(faceArrayPtr->at(0));
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, &faceArrayPtr->at(0));
+		int faceSizeInBytes = (int)(staticMesh->GetFaceCount() * sizeof(Face));
+		if (0 < faceSizeInBytes)
+		{
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, staticMesh->GetFaceData());
+		}
 
 		vertexOffset += vertexSizeInBytes;
 		faceOffset += faceSizeInBytes;
@@ -254,14 +281,16 @@ void Renderer::SetSkeletalBufferData()
 
 	glGenBuffers(1, &skeletalVertexBufferId_);
 	glBindBuffer(GL_ARRAY_BUFFER, skeletalVertexBufferId_);
-	glBufferData(GL_ARRAY_BUFFER, totalSkeletalMeshVertexSize_ * sizeOfSkeletalMeshVertexData, nullptr, GL_STATIC_DRAW);
+	skeletalVertexBufferCapacity_ = totalSkeletalMeshVertexSize_ * sizeOfSkeletalMeshVertexData;
+	glBufferData(GL_ARRAY_BUFFER, skeletalVertexBufferCapacity_, nullptr, GL_STATIC_DRAW);
 
 	/*
 		Index buffer
 	*/
 	glGenBuffers(1, &skeletalIndexBufferId_);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, skeletalIndexBufferId_);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalSkeletalMeshFaceSize_ * sizeof(Face), nullptr, GL_STATIC_DRAW);
+	skeletalIndexBufferCapacity_ = totalSkeletalMeshFaceSize_ * sizeof(Face);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, skeletalIndexBufferCapacity_, nullptr, GL_STATIC_DRAW);
 
 	/*
 		Buffer Sub-Data
@@ -269,37 +298,42 @@ void Renderer::SetSkeletalBufferData()
 	unsigned int baseVertex = 0;
 	unsigned int vertexStartingIndex = 0;
 
-	int vertexOffset = 0;
+	// Bone data is interleaved with the vertices on the GPU, so vertices are written to the mapped buffer once instead of two calls per vertex
+	unsigned char* mappedVertexBuffer = nullptr;
+	if (0 < totalSkeletalMeshVertexSize_)
+	{
+		mappedVertexBuffer = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSkeletalMeshVertexSize_ * sizeOfSkeletalMeshVertexData, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+
+	unsigned long long vertexOffset = 0;
 	int faceOffset = 0;
 	for (SkeletalMesh* skeletalMesh : skeletalMeshes_)
 	{
 		skeletalMesh->SetBaseVertex(baseVertex);
 		skeletalMesh->SetVertexStartingIndex(vertexStartingIndex);
 
-		const VertexArray* vertexArrayPtr = skeletalMesh->GetVerticesPointer();
-
-		unsigned int vertexArrayPtrSize = vertexArrayPtr->size();
-		if (vertexArrayPtrSize == 0)
+		const unsigned int vertexCount = skeletalMesh->GetVertexCount();
+		if (vertexCount == 0)
 		{
 			continue;
 		}
 
-		GLintptr vertexSizeInBytes = sizeof(vertexArrayPtr->at(0));
-
-		const VertexBoneDataArray* vertexBoneDataArray = skeletalMesh->GetVertexBoneDataArray();
-		int vertexBoneDataArraySizeInBytes = sizeof(vertexBoneDataArray->at(0));
-		for (unsigned int i = 0; i < vertexArrayPtrSize; ++i)
+		const VertexData* vertexData = skeletalMesh->GetVertexData();
+		const VertexBoneData* vertexBoneData = skeletalMesh->GetVertexBoneData();
+		for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
 		{
-			glBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexSizeInBytes, &vertexArrayPtr->at(i));
-			vertexOffset += vertexSizeInBytes;
+			memcpy(mappedVertexBuffer + vertexOffset, &vertexData[vertexIndex], sizeof(VertexData));
+			vertexOffset += sizeof(VertexData);
 
-			glBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexBoneDataArraySizeInBytes, &vertexBoneDataArray->at(i));
-			vertexOffset += vertexBoneDataArraySizeInBytes;
+			memcpy(mappedVertexBuffer + vertexOffset, &vertexBoneData[vertexIndex], sizeof(VertexBoneData));
+			vertexOffset += sizeof(VertexBoneData);
 		}
 
-		const FaceArray* faceArrayPtr = skeletalMesh->GetFacesPointer();
-		int faceSizeInBytes = (int)faceArrayPtr->size() * sizeof(faceArrayPtr->at(0));
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, &faceArrayPtr->at(0));
+		int faceSizeInBytes = (int)(skeletalMesh->GetFaceCount() * sizeof(Face));
+		if (0 < faceSizeInBytes)
+		{
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, skeletalMesh->GetFaceData());
+		}
 		faceOffset += faceSizeInBytes;
 
 		baseVertex += skeletalMesh->GetVertexCount();
@@ -310,6 +344,12 @@ void Renderer::SetSkeletalBufferData()
 			skeletalMesh->ClearDataFromMemory();
 		}
 	}
+
+	if (mappedVertexBuffer)
+	{
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
 	SetAttribPointersForSkeletalMesh();
 }
 
@@ -368,10 +408,200 @@ void Renderer::SetBufferData()
 	if (0 < totalStaticMeshCount_) SetStaticBufferData();
 	if (0 < totalSkeletalMeshCount_) SetSkeletalBufferData();
 	if (0 < totalDynamicMeshCount_) SetDynamicBufferData();
+
+	areBuffersSet_ = true;
+}
+
+// Reallocates the buffer with the new size and keeps its old content by copying it on the GPU
+static void ResizeBuffer(GEenum target, GEuint& bufferId, GEsizeiptr oldSize, GEsizeiptr newSize)
+{
+	GEuint newBufferId = 0;
+	glGenBuffers(1, &newBufferId);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBufferId);
+	glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+
+	if (bufferId != 0)
+	{
+		if (0 < oldSize)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, bufferId);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+		}
+		glDeleteBuffers(1, &bufferId);
+	}
+
+	bufferId = newBufferId;
+	glBindBuffer(target, bufferId);
+}
+
+// Binds the buffer, growing it to at least twice its capacity if the required size does not fit so that appending meshes stays linear
+static void ReserveBuffer(GEenum target, GEuint& bufferId, GEsizeiptr& capacity, GEsizeiptr usedSize, GEsizeiptr requiredSize)
+{
+	if (requiredSize <= capacity)
+	{
+		glBindBuffer(target, bufferId);
+		return;
+	}
+
+	const GEsizeiptr newCapacity = requiredSize < 2 * capacity ? 2 * capacity : requiredSize;
+	ResizeBuffer(target, bufferId, usedSize, newCapacity);
+	capacity = newCapacity;
+}
+
+void Renderer::AppendStaticMeshToBuffers(StaticMesh* staticMesh)
+{
+	const unsigned int vertexCount = staticMesh->GetVertexCount();
+	const unsigned int faceCount = staticMesh->GetFaceCount();
+
+	staticMesh->SetBaseVertex(totalStaticMeshVertexSize_);
+	staticMesh->SetVertexStartingIndex(totalStaticMeshFaceSize_ * 3 * (int)sizeof(Face::vertexIndices[0]));
+
+	const GEsizeiptr vertexOffset = totalStaticMeshVertexSize_ * sizeof(VertexData);
+	const GEsizeiptr faceOffset = totalStaticMeshFaceSize_ * sizeof(Face);
+	const GEsizeiptr vertexSizeInBytes = vertexCount * sizeof(VertexData);
+	const GEsizeiptr faceSizeInBytes = faceCount * sizeof(Face);
+
+	if (0 < vertexSizeInBytes)
+	{
+		ReserveBuffer(GL_ARRAY_BUFFER, staticVertexBufferId_, staticVertexBufferCapacity_, vertexOffset, vertexOffset + vertexSizeInBytes);
+		glBufferSubData(GL_ARRAY_BUFFER, vertexOffset, vertexSizeInBytes, staticMesh->GetVertexData());
+	}
+
+	if (0 < faceSizeInBytes)
+	{
+		ReserveBuffer(GL_ELEMENT_ARRAY_BUFFER, staticIndexBufferId_, staticIndexBufferCapacity_, faceOffset, faceOffset + faceSizeInBytes);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, staticMesh->GetFaceData());
+	}
+
+	totalStaticMeshVertexSize_ += vertexCount;
+	totalStaticMeshFaceSize_ += faceCount;
+
+	if (removeStaticDataFromMemoryAfterTransferingToGPU_)
+	{
+		staticMesh->ClearDataFromMemory();
+	}
+}
+
+void Renderer::AppendSkeletalMeshToBuffers(SkeletalMesh* skeletalMesh)
+{
+	const unsigned int vertexCount = skeletalMesh->GetVertexCount();
+	const unsigned int faceCount = skeletalMesh->GetFaceCount();
+
+	skeletalMesh->SetBaseVertex(totalSkeletalMeshVertexSize_);
+	skeletalMesh->SetVertexStartingIndex(totalSkeletalMeshFaceSize_ * 3 * (int)sizeof(Face::vertexIndices[0]));
+
+	const GEsizeiptr sizeOfSkeletalMeshVertexData = sizeof(VertexData) + sizeof(VertexBoneData);
+	const GEsizeiptr vertexOffset = totalSkeletalMeshVertexSize_ * sizeOfSkeletalMeshVertexData;
+	const GEsizeiptr faceOffset = totalSkeletalMeshFaceSize_ * sizeof(Face);
+	const GEsizeiptr vertexSizeInBytes = vertexCount * sizeOfSkeletalMeshVertexData;
+	const GEsizeiptr faceSizeInBytes = faceCount * sizeof(Face);
+
+	if (0 < vertexSizeInBytes)
+	{
+		ReserveBuffer(GL_ARRAY_BUFFER, skeletalVertexBufferId_, skeletalVertexBufferCapacity_, vertexOffset, vertexOffset + vertexSizeInBytes);
+
+		unsigned char* mappedVertexBuffer = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, vertexOffset, vertexSizeInBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+
+		const VertexData* vertexData = skeletalMesh->GetVertexData();
+		const VertexBoneData* vertexBoneData = skeletalMesh->GetVertexBoneData();
+		for (unsigned int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			memcpy(mappedVertexBuffer, &vertexData[vertexIndex], sizeof(VertexData));
+			mappedVertexBuffer += sizeof(VertexData);
+
+			memcpy(mappedVertexBuffer, &vertexBoneData[vertexIndex], sizeof(VertexBoneData));
+			mappedVertexBuffer += sizeof(VertexBoneData);
+		}
+
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
+	if (0 < faceSizeInBytes)
+	{
+		ReserveBuffer(GL_ELEMENT_ARRAY_BUFFER, skeletalIndexBufferId_, skeletalIndexBufferCapacity_, faceOffset, faceOffset + faceSizeInBytes);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, faceOffset, faceSizeInBytes, skeletalMesh->GetFaceData());
+	}
+
+	totalSkeletalMeshVertexSize_ += vertexCount;
+	totalSkeletalMeshFaceSize_ += faceCount;
+
+	if (removeStaticDataFromMemoryAfterTransferingToGPU_)
+	{
+		skeletalMesh->ClearDataFromMemory();
+	}
+}
+
+template<class MeshInstanceType>
+static void RequestTextureMipLevelsOfMeshInstances(const std::vector<MeshInstanceType*>& meshInstances, const Vector3& cameraPosition, float pixelsPerUnitAtUnitDistance)
+{
+	for (MeshInstanceType* meshInstance : meshInstances)
+	{
+		if (!meshInstance->GetIsRendered())
+		{
+			continue;
+		}
+
+		const std::vector<const Image*>* textureImages = meshInstance->GetMaterial()->GetTextureImages();
+		if (textureImages->empty())
+		{
+			continue;
+		}
+
+		const RenderComponent* parentComponent = meshInstance->GetParentComponent();
+		const Vector3& worldScaling = parentComponent->GetWorldScaling();
+		const Vector3& meshSize = meshInstance->GetMesh()->GetAABB().GetSize();
+
+		// Largest world extent of the instance is assumed to be covered by its textures once
+		const float worldSize = std::max({ meshSize.x * std::abs(worldScaling.x), meshSize.y * std::abs(worldScaling.y), meshSize.z * std::abs(worldScaling.z) });
+		const float distance = std::max((parentComponent->GetWorldPosition() - cameraPosition).Length(), 0.001f);
+		const float projectedSize = std::max(worldSize * pixelsPerUnitAtUnitDistance / distance, 1.f);
+
+		for (const Image* textureImage : *textureImages)
+		{
+			Texture* texture = textureImage->GetGeneratedTexture();
+			if (!texture || !texture->GetIsStreamed())
+			{
+				continue;
+			}
+
+			const float textureSize = (float)std::max(texture->GetWidth(), texture->GetHeight());
+			texture->RequestMipLevel(std::max((int)std::log2(textureSize / projectedSize), 0));
+		}
+	}
+}
+
+void Renderer::RequestTextureMipLevels()
+{
+	const Camera* activeCamera = engine->GetCameraManager()->GetActiveCamera();
+	if (!activeCamera || textureStreamer_->GetStreamedTextureCount() == 0)
+	{
+		return;
+	}
+
+	const Vector4& nearPlane = activeCamera->GetNearPlane();
+	const float nearPlaneHeight = nearPlane.w - nearPlane.z;
+	const float pixelsPerUnitAtUnitDistance = activeCamera->GetProjection() == CameraProjection::Perspective && 0.f < nearPlaneHeight ?
+		activeCamera->GetImageHeight() * activeCamera->GetNearDistance() / nearPlaneHeight :
+		std::numeric_limits<float>::max();
+
+	const Vector3 cameraPosition = activeCamera->GetPosition();
+
+	RequestTextureMipLevelsOfMeshInstances(opaqueStaticMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
+	RequestTextureMipLevelsOfMeshInstances(maskedStaticMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
+	RequestTextureMipLevelsOfMeshInstances(transparentStaticMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
+
+	RequestTextureMipLevelsOfMeshInstances(opaqueSkeletalMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
+	RequestTextureMipLevelsOfMeshInstances(maskedSkeletalMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
+	RequestTextureMipLevelsOfMeshInstances(transparentSkeletalMeshInstances_, cameraPosition, pixelsPerUnitAtUnitDistance);
 }
 
 void Renderer::RenderCurrentFrame()
 {
+	UpdatePendingMaterials();
+
+	RequestTextureMipLevels();
+	textureStreamer_->Update();
+
 	PrepareSkeletalMeshInstancesForTheCurrentFrame();
 
 	GetLightManager()->RenderShadowMaps();
@@ -395,6 +625,26 @@ void Renderer::RenderCurrentFrame()
 	PrepareSkeletalMeshInstancesForTheNextFrame();
 }
 
+void Renderer::UpdatePendingMaterials()
+{
+	int pendingMaterialCount = (int)pendingMaterials_.size();
+	for (int pendingMaterialIndex = 0; pendingMaterialIndex < pendingMaterialCount;)
+	{
+		Material* pendingMaterial = pendingMaterials_[pendingMaterialIndex];
+		if (!pendingMaterial->GetAreShaderProgramsReady())
+		{
+			++pendingMaterialIndex;
+			continue;
+		}
+
+		pendingMaterial->CompleteDeferredInitialization();
+
+		pendingMaterials_[pendingMaterialIndex] = pendingMaterials_[pendingMaterialCount - 1];
+		pendingMaterials_.pop_back();
+		--pendingMaterialCount;
+	}
+}
+
 void Renderer::Render(RenderPassType renderPassType)
 {
 	switch (renderPassType)
@@ -620,6 +870,11 @@ void Renderer::AddStaticMeshToRenderer(StaticMesh* staticMesh)
 {
 	staticMeshes_.push_back(staticMesh);
 	totalStaticMeshCount_++;
+
+	if (areBuffersSet_)
+	{
+		AppendStaticMeshToBuffers(staticMesh);
+	}
 }
 
 void Renderer::AddStaticMeshInstance(StaticMeshInstance* meshInstance)
@@ -691,10 +946,33 @@ void Renderer::RemoveStaticMeshInstance(StaticMeshInstance* staticMeshInstance)
 	}
 }
 
+void Renderer::ReserveStaticMeshInstances(MaterialBlendModel blendModel, int additionalInstanceCount)
+{
+	switch (blendModel)
+	{
+	case MaterialBlendModel::Opaque:
+		opaqueStaticMeshInstances_.reserve(opaqueStaticMeshInstances_.size() + additionalInstanceCount);
+		break;
+	case MaterialBlendModel::Masked:
+		maskedStaticMeshInstances_.reserve(maskedStaticMeshInstances_.size() + additionalInstanceCount);
+		break;
+	case MaterialBlendModel::Transparent:
+		transparentStaticMeshInstances_.reserve(transparentStaticMeshInstances_.size() + additionalInstanceCount);
+		break;
+	default:
+		break;
+	}
+}
+
 void Renderer::AddSkeletalMeshToRenderer(SkeletalMesh* skeletalMesh)
 {
 	skeletalMeshes_.push_back(skeletalMesh);
 	totalSkeletalMeshCount_++;
+
+	if (areBuffersSet_)
+	{
+		AppendSkeletalMeshToBuffers(skeletalMesh);
+	}
 }
 
 void Renderer::AddSkeletalMeshInstance(SkeletalMeshInstance* skeletalMeshInstance)
@@ -766,6 +1044,24 @@ void Renderer::RemoveSkeletalMeshInstance(SkeletalMeshInstance* skeletalMeshInst
 	}
 }
 
+void Renderer::ReserveSkeletalMeshInstances(MaterialBlendModel blendModel, int additionalInstanceCount)
+{
+	switch (blendModel)
+	{
+	case MaterialBlendModel::Opaque:
+		opaqueSkeletalMeshInstances_.reserve(opaqueSkeletalMeshInstances_.size() + additionalInstanceCount);
+		break;
+	case MaterialBlendModel::Masked:
+		maskedSkeletalMeshInstances_.reserve(maskedSkeletalMeshInstances_.size() + additionalInstanceCount);
+		break;
+	case MaterialBlendModel::Transparent:
+		transparentSkeletalMeshInstances_.reserve(transparentSkeletalMeshInstances_.size() + additionalInstanceCount);
+		break;
+	default:
+		break;
+	}
+}
+
 void Renderer::AddDynamicMeshToRenderer(DynamicMesh* dynamicMesh)
 {
 	dynamicMeshes_.push_back(dynamicMesh);
@@ -1356,8 +1652,9 @@ void DeferredRenderingData::OnWindowSizeChange(int x, int y)
 	decltype(materials.begin()) materialIteration = materials.begin();
 	for (; materialIteration < materials.end(); ++materialIteration)
 	{
+		// Pending materials bind the textures when they are initialized
 		Shader* shader = (*materialIteration)->GetShader(RenderPassType::GeometryBuffer);
-		if(shader)
+		if(shader && shader->GetIsInitialized())
 		{
 			BindGeometryBufferTextures(shader);
 		}
@@ -8,14 +8,17 @@
 
 #include "glad/glad.h"
 
+#include <algorithm>
 #include <vector>
 
 class DynamicMesh;
 class StaticMesh;
 class SkeletalMesh;
 class LightManager;
+class Material;
 
 class Texture;
+class TextureStreamer;
 class FrameBuffer;
 class Shader;
 
@@ -25,6 +28,8 @@ class SkeletalMeshInstance;
 
 class PostProcessingEffect;
 
+enum class MaterialBlendModel;
+
 enum class GOKNAR_API RenderPassType : unsigned int
 {
 	None = 0b00000000,
@@ -112,10 +117,12 @@ public:
 	void AddStaticMeshToRenderer(StaticMesh* object);
 	void AddStaticMeshInstance(StaticMeshInstance* object);
 	void RemoveStaticMeshInstance(StaticMeshInstance* object);
+	void ReserveStaticMeshInstances(MaterialBlendModel blendModel, int additionalInstanceCount);
 
 	void AddSkeletalMeshToRenderer(SkeletalMesh* object);
 	void AddSkeletalMeshInstance(SkeletalMeshInstance* object);
 	void RemoveSkeletalMeshInstance(SkeletalMeshInstance* object);
+	void ReserveSkeletalMeshInstances(MaterialBlendModel blendModel, int additionalInstanceCount);
 
 	void AddDynamicMeshToRenderer(DynamicMesh* object);
 	void AddDynamicMeshInstance(DynamicMeshInstance* object);
@@ -131,6 +138,26 @@ public:
 		return lightManager_;
 	}
 
+	TextureStreamer* GetTextureStreamer() const
+	{
+		return textureStreamer_;
+	}
+
+	// Meshes of the material are rendered with the fallback material until the renderer initializes it
+	// Materials shared by several meshes are added only once
+	void AddPendingMaterial(Material* material)
+	{
+		if (std::find(pendingMaterials_.begin(), pendingMaterials_.end(), material) == pendingMaterials_.end())
+		{
+			pendingMaterials_.push_back(material);
+		}
+	}
+
+	const Material* GetFallbackMaterial() const
+	{
+		return fallbackMaterial_;
+	}
+
 	void BindShadowTextures(Shader* shader);
 	void BindGeometryBufferTextures(Shader* shader);
 	void SetLightUniforms(Shader* shader);
@@ -177,8 +204,18 @@ private:
 	void SetAttribPointers();
 	void SetAttribPointersForSkeletalMesh();
 
+	// Meshes added after the buffers are set(asynchronously loaded content) are appended to the shared buffers
+	void AppendStaticMeshToBuffers(StaticMesh* staticMesh);
+	void AppendSkeletalMeshToBuffers(SkeletalMesh* skeletalMesh);
+
 	void SortTransparentInstances();
 
+	// Requests the mip levels of the streamed textures from the projected sizes of the rendered mesh instances
+	void RequestTextureMipLevels();
+
+	// Initializes the pending materials whose programs are linked
+	void UpdatePendingMaterials();
+
 	std::vector<StaticMesh*> staticMeshes_;
 	std::vector<SkeletalMesh*> skeletalMeshes_;
 	std::vector<DynamicMesh*> dynamicMeshes_;
@@ -200,6 +237,14 @@ private:
 
 	LightManager* lightManager_{ nullptr };
 
+	// Materials whose programs are still compiled by the driver
+	std::vector<Material*> pendingMaterials_;
+
+	// Default material whose programs are waited for, owned by the resource manager like the other materials
+	Material* fallbackMaterial_{ nullptr };
+
+	TextureStreamer* textureStreamer_{ nullptr };
+
 	DeferredRenderingData* deferredRenderingData_{ nullptr };
 
 	std::vector<const PostProcessingEffect*> postProcessingEffects_;
@@ -226,9 +271,17 @@ private:
 	GEuint dynamicVertexBufferId_;
 	GEuint dynamicIndexBufferId_;
 
+	// Allocated sizes in bytes, meshes added after the buffers are set grow them geometrically
+	GEsizeiptr staticVertexBufferCapacity_{ 0 };
+	GEsizeiptr staticIndexBufferCapacity_{ 0 };
+	GEsizeiptr skeletalVertexBufferCapacity_{ 0 };
+	GEsizeiptr skeletalIndexBufferCapacity_{ 0 };
+
 	RenderPassType mainRenderType_{ RenderPassType::Deferred };
 
 	unsigned char removeStaticDataFromMemoryAfterTransferingToGPU_ : 1;
+
+	bool areBuffersSet_{ false };
 };
 
 #endif
@@ -0,0 +1,23 @@
+#include "pch.h"
+
+#include "RendererUtils.h"
+
+#include <cstring>
+
+#include "glad/glad.h"
+
+bool RendererUtils::GetIsExtensionSupported(const char* extensionName)
+{
+	GLint extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+	for (GLint extensionIndex = 0; extensionIndex < extensionCount; ++extensionIndex)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, extensionIndex);
+		if (extension && std::strcmp(extension, extensionName) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,15 @@
+#ifndef __RENDERERUTILS_H__
+#define __RENDERERUTILS_H__
+
+#include "Goknar/Core.h"
+
+class GOKNAR_API RendererUtils
+{
+public:
+	RendererUtils() = delete;
+
+	// Needs a current OpenGL context
+	static bool GetIsExtensionSupported(const char* extensionName);
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "Shader.h"
 
 #include "ShaderBuilder.h"
+#include "ShaderProgramCache.h"
 
 #include "Goknar/Application.h"
 #include "Goknar/Engine.h"
@@ -17,6 +18,7 @@
 #include "Goknar/Renderer/Renderer.h"
 #include "Goknar/Renderer/Texture.h"
 
+#include <chrono>
 #include <string>
 
 #include <glad/glad.h>
@@ -70,7 +72,10 @@ Shader::Shader()
 
 Shader::~Shader()
 {
-	glDeleteProgram(programId_);
+	if (programId_ != 0)
+	{
+		ShaderProgramCache::GetInstance()->ReleaseProgram(programId_);
+	}
 	//engine->GetApplication()->GetMainScene()->RemoveShader(this);
 }
 
@@ -86,8 +91,6 @@ void Shader::SetMVP(const Matrix& worldAndRelativeTransformationMatrix) const
 
 void Shader::PreInit()
 {
-	programId_ = glCreateProgram();
-
 	// TODO: Change custom shader creation
 	if (shaderType_ == ShaderType::Dependent || shaderType_ == ShaderType::SelfContained)
 	{
@@ -112,48 +115,92 @@ void Shader::PreInit()
 	}
 	//////////////////////////////////////
 
-	const GEchar* vertexSource = (const GEchar*)vertexShaderScript_.c_str();
-	GEuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShaderId, 1, &vertexSource, 0);
-	glCompileShader(vertexShaderId);
-	ExitOnShaderIsNotCompiled(vertexShaderId, (std::string("Vertex shader compilation error!(" + vertexShaderPath_ + ").")).c_str());
+	ShaderProgramCache* shaderProgramCache = ShaderProgramCache::GetInstance();
 
-	glAttachShader(programId_, vertexShaderId);
+	// Materials with the same settings generate the same sources
+	const uint64_t sourceHash = ShaderProgramCache::GetSourceHash(vertexShaderScript_, fragmentShaderScript_, geometryShaderScript_);
+	const uint64_t programKey = ShaderProgramCache::GetProgramKey(sourceHash, textures_);
 
-	const GEchar* fragmentSource = (const GEchar*)fragmentShaderScript_.c_str();
-	GEuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShaderId, 1, &fragmentSource, 0);
-	glCompileShader(fragmentShaderId);
-	ExitOnShaderIsNotCompiled(fragmentShaderId, (std::string("Fragment shader compilation error!(") + fragmentShaderPath_ + ").").c_str());
+	programId_ = shaderProgramCache->AcquireProgram(programKey);
+	if (programId_ != 0)
+	{
+		return;
+	}
 
-	glAttachShader(programId_, fragmentShaderId);
+	programId_ = glCreateProgram();
 
-	GEuint geometryShaderId = 0;
-	bool containsGeometryShader = !geometryShaderScript_.empty();
-	if (containsGeometryShader)
+	if (shaderProgramCache->ReadProgramBinary(programId_, sourceHash))
 	{
-		const GEchar* geometrySource = (const GEchar*)geometryShaderScript_.c_str();
-		geometryShaderId = glCreateShader(GL_GEOMETRY_SHADER);
-		glShaderSource(geometryShaderId, 1, &geometrySource, 0);
-		glCompileShader(geometryShaderId);
-		ExitOnShaderIsNotCompiled(geometryShaderId, (std::string("Geometry shader compilation error!(") + geometryShaderPath_ + ").").c_str());
+		shaderProgramCache->AddProgram(programKey, programId_);
+		return;
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	shaderProgramCache->PrepareProgram(programId_);
 
-		glAttachShader(programId_, geometryShaderId);
+	// Statuses are checked in Init so that the driver compiles the programs of every material at once
+	ShaderProgramCacheEntry programEntry;
+	programEntry.programId = programId_;
+	programEntry.sourceHash = sourceHash;
+	programEntry.vertexShaderId = SubmitShader(GL_VERTEX_SHADER, vertexShaderScript_);
+	programEntry.fragmentShaderId = SubmitShader(GL_FRAGMENT_SHADER, fragmentShaderScript_);
+	if (!geometryShaderScript_.empty())
+	{
+		programEntry.geometryShaderId = SubmitShader(GL_GEOMETRY_SHADER, geometryShaderScript_);
 	}
 
 	glLinkProgram(programId_);
-	ExitOnProgramError(programId_, "Shader program link error!");
 
-	glDetachShader(programId_, vertexShaderId);
-	glDetachShader(programId_, fragmentShaderId);
-	if (containsGeometryShader)
+	programEntry.submissionTime = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+	shaderProgramCache->AddPendingProgram(programKey, programEntry);
+}
+
+GEuint Shader::SubmitShader(GEenum shaderType, const std::string& shaderScript)
+{
+	const GEchar* source = (const GEchar*)shaderScript.c_str();
+	GEuint shaderId = glCreateShader(shaderType);
+	glShaderSource(shaderId, 1, &source, 0);
+	glCompileShader(shaderId);
+
+	glAttachShader(programId_, shaderId);
+	return shaderId;
+}
+
+bool Shader::GetIsProgramReady() const
+{
+	return ShaderProgramCache::GetInstance()->GetIsProgramReady(programId_);
+}
+
+void Shader::WaitForProgram()
+{
+	ShaderProgramCache* shaderProgramCache = ShaderProgramCache::GetInstance();
+
+	// Shaders sharing the program check it once
+	const ShaderProgramCacheEntry* programEntry = shaderProgramCache->GetPendingProgram(programId_);
+	if (!programEntry)
 	{
-		glDetachShader(programId_, geometryShaderId);
+		return;
 	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	ExitOnShaderIsNotCompiled(programEntry->vertexShaderId, (std::string("Vertex shader compilation error!(" + vertexShaderPath_ + ").")).c_str());
+	ExitOnShaderIsNotCompiled(programEntry->fragmentShaderId, (std::string("Fragment shader compilation error!(") + fragmentShaderPath_ + ").").c_str());
+	if (programEntry->geometryShaderId != 0)
+	{
+		ExitOnShaderIsNotCompiled(programEntry->geometryShaderId, (std::string("Geometry shader compilation error!(") + geometryShaderPath_ + ").").c_str());
+	}
+
+	ExitOnProgramError(programId_, "Shader program link error!");
+
+	shaderProgramCache->CompletePendingProgram(programId_, std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count());
 }
 
 void Shader::Init()
 {
+	WaitForProgram();
+
 	Bind();
 
 	int textureSize = (int)textures_.size();
@@ -165,6 +212,8 @@ void Shader::Init()
 	ExitOnProgramError(programId_, "Shader error on binding texture!");
 
 	Unbind();
+
+	isInitialized_ = true;
 }
 
 void Shader::PostInit()
@@ -99,10 +99,23 @@ public:
 		return programId_;
 	}
 
+	// Submits the program to the driver without waiting for its compilation
 	void PreInit();
+	// Waits for the program and checks its compile and link statuses
 	void Init();
 	void PostInit();
 
+	// Program can be used without blocking on its compilation
+	bool GetIsProgramReady() const;
+
+	// Blocks until the program is linked
+	void WaitForProgram();
+
+	bool GetIsInitialized() const
+	{
+		return isInitialized_;
+	}
+
 	void Bind() const;
 
 	void Unbind() const;
@@ -122,6 +135,8 @@ public:
 protected:
 
 private:
+	GEuint SubmitShader(GEenum shaderType, const std::string& shaderScript);
+
 	std::vector<const Texture*> textures_;
 
 	std::string vertexShaderPath_{ "" };
@@ -135,6 +150,8 @@ private:
 	GEuint programId_{ 0 };
 
 	ShaderType shaderType_{ ShaderType::Scene };
+
+	bool isInitialized_{ false };
 };
 
 #endif
\ No newline at end of file
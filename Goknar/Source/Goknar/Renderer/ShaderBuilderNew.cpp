@@ -775,32 +775,50 @@ std::string ShaderBuilderNew::General_FS_GetShaderTextureUniforms(MaterialInitia
 	while (textureIterator != textures->cend())
 	{
 		const Texture* texture = *textureIterator;
+		const std::string textureCoordinate = General_FS_GetTextureCoordinate(texture);
 
 		switch (texture->GetTextureUsage())
 		{
 		case TextureUsage::Diffuse:
 			if (initializationData && initializationData->baseColor.result.empty())
 			{
-				initializationData->baseColor.result = General_FS_GetDiffuseTextureSampling(texture->GetName());
+				initializationData->baseColor.result = General_FS_GetDiffuseTextureSampling(texture->GetName(), textureCoordinate);
 			}
 			break;
 		case TextureUsage::Normal:
 			if (initializationData && initializationData->fragmentNormal.result.empty())
 			{
-				initializationData->fragmentNormal.result = General_FS_GetNormalTextureSampling(texture->GetName());
+				// BC5 normal maps only store the first two components
+				initializationData->fragmentNormal.result =
+					texture->GetTextureCompressionFormat() == TextureCompressionFormat::BC5 ?
+					General_FS_GetTwoChannelNormalTextureSampling(texture->GetName(), textureCoordinate) :
+					General_FS_GetNormalTextureSampling(texture->GetName(), textureCoordinate);
 			}
 			break;
 		case TextureUsage::Emmisive:
 			if (initializationData && initializationData->fragmentNormal.result.empty())
 			{
-				initializationData->emmisiveColor.result = General_FS_GetEmmisiveTextureSampling(texture->GetName());
+				initializationData->emmisiveColor.result = General_FS_GetEmmisiveTextureSampling(texture->GetName(), textureCoordinate);
 			}
 			break;
 		default:
 			break;
 		}
 
-		uniforms += "uniform sampler2D " + texture->GetName() + ";\n";
+		switch (texture->GetPackingType())
+		{
+		case TexturePackingType::Atlas:
+			uniforms += "uniform sampler2D " + texture->GetName() + ";\n";
+			uniforms += "uniform vec4 " + texture->GetPackedUniformName() + ";\n";
+			break;
+		case TexturePackingType::Array:
+			uniforms += "uniform sampler2DArray " + texture->GetName() + ";\n";
+			uniforms += "uniform float " + texture->GetPackedUniformName() + ";\n";
+			break;
+		default:
+			uniforms += "uniform sampler2D " + texture->GetName() + ";\n";
+			break;
+		}
 
 		++textureIterator;
 	}
@@ -808,19 +826,44 @@ std::string ShaderBuilderNew::General_FS_GetShaderTextureUniforms(MaterialInitia
 	return uniforms;
 }
 
-std::string ShaderBuilderNew::General_FS_GetDiffuseTextureSampling(const std::string& textureName) const
+std::string ShaderBuilderNew::General_FS_GetTextureCoordinate(const Texture* texture) const
+{
+	const std::string uv = SHADER_VARIABLE_NAMES::TEXTURE::UV;
+
+	switch (texture->GetPackingType())
+	{
+	case TexturePackingType::Atlas:
+	{
+		// Only clamped images are packed into atlases
+		const std::string& uvTransform = texture->GetPackedUniformName();
+		return "(clamp(" + uv + ", 0.f, 1.f) * " + uvTransform + ".xy + " + uvTransform + ".zw)";
+	}
+	case TexturePackingType::Array:
+		return "vec3(" + uv + ", " + texture->GetPackedUniformName() + ")";
+	default:
+		return uv;
+	}
+}
+
+std::string ShaderBuilderNew::General_FS_GetDiffuseTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const
+{
+	return std::string("texture(" + textureName + ", " + textureCoordinate + "); ");
+}
+
+std::string ShaderBuilderNew::General_FS_GetNormalTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const
 {
-	return std::string("texture(" + textureName + ", " + SHADER_VARIABLE_NAMES::TEXTURE::UV + "); ");
+	return std::string("texture(" + textureName + ", " + textureCoordinate + ") * 0.5f + vec4(0.5f); ");
 }
 
-std::string ShaderBuilderNew::General_FS_GetNormalTextureSampling(const std::string& textureName) const
+std::string ShaderBuilderNew::General_FS_GetTwoChannelNormalTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const
 {
-	return std::string("texture(" + textureName + ", " + SHADER_VARIABLE_NAMES::TEXTURE::UV + ") * 0.5f + vec4(0.5f); ");
+	const std::string normalXY = "(texture(" + textureName + ", " + textureCoordinate + ").xy * 2.f - vec2(1.f))";
+	return std::string("vec4(" + normalXY + ", sqrt(max(1.f - dot(" + normalXY + ", " + normalXY + "), 0.f)), 1.f) * 0.25f + vec4(0.75f); ");
 }
 
-std::string ShaderBuilderNew::General_FS_GetEmmisiveTextureSampling(const std::string& textureName) const
+std::string ShaderBuilderNew::General_FS_GetEmmisiveTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const
 {
-	return std::string("texture(" + textureName + ", " + SHADER_VARIABLE_NAMES::TEXTURE::UV + ").xyz; ");
+	return std::string("texture(" + textureName + ", " + textureCoordinate + ").xyz; ");
 }
 
 std::string ShaderBuilderNew::FS_GetLightCalculationIterators() const
@@ -9,6 +9,7 @@
 class Engine;
 class MaterialInitializationData;
 class Shader;
+class Texture;
 
 class GOKNAR_API ShaderBuilderNew
 {
@@ -89,9 +90,13 @@ private:
 
 	std::string General_FS_GetMaterialVariables(const FragmentShaderInitializationData& fragmentShaderInitializationData) const;
 	std::string General_FS_GetShaderTextureUniforms(MaterialInitializationData* initializationData, const Shader* shader) const;
-	std::string General_FS_GetDiffuseTextureSampling(const std::string& textureName) const;
-	std::string General_FS_GetNormalTextureSampling(const std::string& textureName) const;
-	std::string General_FS_GetEmmisiveTextureSampling(const std::string& textureName) const;
+	// Texture coordinate expression that maps the UVs into the region of a packed texture's image
+	std::string General_FS_GetTextureCoordinate(const Texture* texture) const;
+	std::string General_FS_GetDiffuseTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const;
+	std::string General_FS_GetNormalTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const;
+	// Reconstructs the third component of the normal maps with two channels
+	std::string General_FS_GetTwoChannelNormalTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const;
+	std::string General_FS_GetEmmisiveTextureSampling(const std::string& textureName, const std::string& textureCoordinate) const;
 
 	std::string FS_GetLightCalculationIterators() const;
 
@@ -0,0 +1,398 @@
+#include "pch.h"
+
+#include "ShaderProgramCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <glad/glad.h>
+#include "GLFW/glfw3.h"
+
+#include "Goknar/Log.h"
+#include "Goknar/Renderer/RendererUtils.h"
+
+struct ShaderProgramCacheFileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t driverHash;
+	uint64_t sourceHash;
+	uint32_t binaryFormat;
+	uint32_t binarySize;
+};
+
+// "GSPB"
+constexpr uint32_t SHADER_PROGRAM_CACHE_FILE_MAGIC = 0x42505347;
+constexpr uint32_t SHADER_PROGRAM_CACHE_FILE_VERSION = 1;
+
+// GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile share the enums, GLAD is not generated with them
+constexpr GLenum MAX_SHADER_COMPILER_THREADS_ENUM = 0x91B0;
+constexpr GLenum COMPLETION_STATUS_ENUM = 0x91B1;
+constexpr GLuint SHADER_COMPILER_THREAD_COUNT_UNLIMITED = 0xFFFFFFFF;
+
+typedef void (APIENTRYP MaxShaderCompilerThreadsFunction)(GLuint count);
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// FNV-1a
+static void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t byteIndex = 0; byteIndex < size; ++byteIndex)
+	{
+		hash = (hash ^ bytes[byteIndex]) * FNV_PRIME;
+	}
+}
+
+// Sizes are hashed too so that moving text from one stage to another changes the hash
+static void HashString(uint64_t& hash, const std::string& text)
+{
+	const uint64_t size = text.size();
+	HashBytes(hash, &size, sizeof(uint64_t));
+	HashBytes(hash, text.data(), text.size());
+}
+
+static void HashGLString(uint64_t& hash, GLenum name)
+{
+	const char* text = (const char*)glGetString(name);
+	HashString(hash, text ? text : "");
+}
+
+static void DeleteShaders(const ShaderProgramCacheEntry& programEntry)
+{
+	glDetachShader(programEntry.programId, programEntry.vertexShaderId);
+	glDeleteShader(programEntry.vertexShaderId);
+
+	glDetachShader(programEntry.programId, programEntry.fragmentShaderId);
+	glDeleteShader(programEntry.fragmentShaderId);
+
+	if (programEntry.geometryShaderId != 0)
+	{
+		glDetachShader(programEntry.programId, programEntry.geometryShaderId);
+		glDeleteShader(programEntry.geometryShaderId);
+	}
+}
+
+ShaderProgramCache* ShaderProgramCache::instance_ = nullptr;
+
+ShaderProgramCache::ShaderProgramCache() :
+	cacheDirectory_(ContentDir + "Cache/Shaders/")
+{
+}
+
+ShaderProgramCache::~ShaderProgramCache()
+{
+	// Programs are owned by the shaders, only the leaked ones are left here
+	for (const std::pair<const uint64_t, ShaderProgramCacheEntry>& programEntryPair : programEntries_)
+	{
+		if (programEntryPair.second.isPending)
+		{
+			DeleteShaders(programEntryPair.second);
+		}
+
+		glDeleteProgram(programEntryPair.second.programId);
+	}
+
+	instance_ = nullptr;
+}
+
+uint64_t ShaderProgramCache::GetSourceHash(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource)
+{
+	uint64_t hash = FNV_OFFSET_BASIS;
+	HashString(hash, vertexSource);
+	HashString(hash, fragmentSource);
+	HashString(hash, geometrySource);
+	return hash;
+}
+
+uint64_t ShaderProgramCache::GetProgramKey(uint64_t sourceHash, const std::vector<const Texture*>& textures)
+{
+	uint64_t hash = sourceHash;
+	for (const Texture* texture : textures)
+	{
+		HashBytes(hash, &texture, sizeof(const Texture*));
+	}
+	return hash;
+}
+
+GEuint ShaderProgramCache::AcquireProgram(uint64_t programKey)
+{
+	std::unordered_map<uint64_t, ShaderProgramCacheEntry>::iterator programEntryIterator = programEntries_.find(programKey);
+	if (programEntryIterator == programEntries_.end())
+	{
+		return 0;
+	}
+
+	++programEntryIterator->second.referenceCount;
+	++sharedProgramCount_;
+	return programEntryIterator->second.programId;
+}
+
+void ShaderProgramCache::AddProgram(uint64_t programKey, GEuint programId)
+{
+	ShaderProgramCacheEntry& programEntry = programEntries_[programKey];
+	programEntry.programId = programId;
+	programEntry.referenceCount = 1;
+
+	programKeys_[programId] = programKey;
+}
+
+void ShaderProgramCache::AddPendingProgram(uint64_t programKey, const ShaderProgramCacheEntry& programEntry)
+{
+	ShaderProgramCacheEntry& addedProgramEntry = programEntries_[programKey];
+	addedProgramEntry = programEntry;
+	addedProgramEntry.referenceCount = 1;
+	addedProgramEntry.isPending = true;
+
+	programKeys_[programEntry.programId] = programKey;
+}
+
+const ShaderProgramCacheEntry* ShaderProgramCache::GetPendingProgram(GEuint programId) const
+{
+	std::unordered_map<GEuint, uint64_t>::const_iterator programKeyIterator = programKeys_.find(programId);
+	if (programKeyIterator == programKeys_.end())
+	{
+		return nullptr;
+	}
+
+	const ShaderProgramCacheEntry& programEntry = programEntries_.at(programKeyIterator->second);
+	return programEntry.isPending ? &programEntry : nullptr;
+}
+
+bool ShaderProgramCache::GetIsProgramReady(GEuint programId) const
+{
+	if (!isParallelShaderCompileSupported_ || !GetPendingProgram(programId))
+	{
+		return true;
+	}
+
+	GEint isCompleted = GL_FALSE;
+	glGetProgramiv(programId, COMPLETION_STATUS_ENUM, &isCompleted);
+	return isCompleted == GL_TRUE;
+}
+
+void ShaderProgramCache::CompletePendingProgram(GEuint programId, float waitTime)
+{
+	ShaderProgramCacheEntry& programEntry = programEntries_.at(programKeys_.at(programId));
+
+	DeleteShaders(programEntry);
+	programEntry.vertexShaderId = 0;
+	programEntry.fragmentShaderId = 0;
+	programEntry.geometryShaderId = 0;
+	programEntry.isPending = false;
+
+	++compiledProgramCount_;
+	programCreationTime_ += programEntry.submissionTime + waitTime;
+
+	WriteProgramBinary(programId, programEntry.sourceHash);
+}
+
+void ShaderProgramCache::ReleaseProgram(GEuint programId)
+{
+	std::unordered_map<GEuint, uint64_t>::iterator programKeyIterator = programKeys_.find(programId);
+	if (programKeyIterator == programKeys_.end())
+	{
+		glDeleteProgram(programId);
+		return;
+	}
+
+	std::unordered_map<uint64_t, ShaderProgramCacheEntry>::iterator programEntryIterator = programEntries_.find(programKeyIterator->second);
+	if (0 < --programEntryIterator->second.referenceCount)
+	{
+		return;
+	}
+
+	if (programEntryIterator->second.isPending)
+	{
+		DeleteShaders(programEntryIterator->second);
+	}
+	glDeleteProgram(programId);
+
+	programEntries_.erase(programEntryIterator);
+	programKeys_.erase(programKeyIterator);
+}
+
+void ShaderProgramCache::PrepareProgram(GEuint programId)
+{
+	InitializeDriverFeatures();
+
+	if (isSerializationEnabled_ && isProgramBinarySupported_)
+	{
+		glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+}
+
+bool ShaderProgramCache::ReadProgramBinary(GEuint programId, uint64_t sourceHash)
+{
+	InitializeDriverFeatures();
+
+	if (!isSerializationEnabled_ || !isProgramBinarySupported_)
+	{
+		return false;
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	const std::string cacheFilePath = GetCacheFilePath(sourceHash);
+	std::ifstream cacheFile(cacheFilePath, std::ios::binary);
+	if (!cacheFile.is_open())
+	{
+		return false;
+	}
+
+	ShaderProgramCacheFileHeader header;
+	cacheFile.read((char*)&header, sizeof(ShaderProgramCacheFileHeader));
+
+	if (!cacheFile ||
+		header.magic != SHADER_PROGRAM_CACHE_FILE_MAGIC ||
+		header.version != SHADER_PROGRAM_CACHE_FILE_VERSION ||
+		header.driverHash != driverHash_ ||
+		header.sourceHash != sourceHash)
+	{
+		GOKNAR_CORE_INFO("Shader program cache file {} is out of date, program is compiled.", cacheFilePath);
+		return false;
+	}
+
+	// Size in the header must match the rest of the file, a truncated or corrupt file is a cache miss
+	const std::streamoff headerEndPosition = cacheFile.tellg();
+	cacheFile.seekg(0, std::ios::end);
+	const std::streamoff fileSize = cacheFile.tellg();
+	cacheFile.seekg(headerEndPosition, std::ios::beg);
+	if (header.binarySize == 0 || fileSize < headerEndPosition || (unsigned long long)(fileSize - headerEndPosition) != header.binarySize)
+	{
+		GOKNAR_CORE_WARN("Shader program cache file {} has an invalid binary size, program is compiled.", cacheFilePath);
+		return false;
+	}
+
+	std::vector<char> binary(header.binarySize);
+	cacheFile.read(binary.data(), header.binarySize);
+	if (!cacheFile)
+	{
+		GOKNAR_CORE_WARN("Shader program cache file {} could not be read, program is compiled.", cacheFilePath);
+		return false;
+	}
+
+	glProgramBinary(programId, header.binaryFormat, binary.data(), header.binarySize);
+
+	// Drivers can reject binaries even if they report the same version, e.g. after a change in the hardware
+	GEint isLinked = GL_FALSE;
+	glGetProgramiv(programId, GL_LINK_STATUS, &isLinked);
+	if (isLinked == GL_FALSE)
+	{
+		GOKNAR_CORE_WARN("Shader program cache file {} is rejected by the driver, program is compiled.", cacheFilePath);
+		return false;
+	}
+
+	++readProgramCount_;
+	programCreationTime_ += std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+	return true;
+}
+
+void ShaderProgramCache::WriteProgramBinary(GEuint programId, uint64_t sourceHash)
+{
+	if (!isSerializationEnabled_ || !isProgramBinarySupported_)
+	{
+		return;
+	}
+
+	GEint binarySize = 0;
+	glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+	if (binarySize <= 0)
+	{
+		return;
+	}
+
+	std::vector<char> binary(binarySize);
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(programId, binarySize, &binarySize, &binaryFormat, binary.data());
+
+	ShaderProgramCacheFileHeader header;
+	header.magic = SHADER_PROGRAM_CACHE_FILE_MAGIC;
+	header.version = SHADER_PROGRAM_CACHE_FILE_VERSION;
+	header.driverHash = driverHash_;
+	header.sourceHash = sourceHash;
+	header.binaryFormat = binaryFormat;
+	header.binarySize = binarySize;
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(cacheDirectory_, errorCode);
+
+	const std::string cacheFilePath = GetCacheFilePath(sourceHash);
+	std::ofstream cacheFile(cacheFilePath, std::ios::binary);
+	if (cacheFile.is_open())
+	{
+		cacheFile.write((const char*)&header, sizeof(ShaderProgramCacheFileHeader));
+		cacheFile.write(binary.data(), binarySize);
+	}
+	else
+	{
+		GOKNAR_CORE_WARN("Shader program cache file {} could not be written.", cacheFilePath);
+	}
+}
+
+void ShaderProgramCache::LogStatistics() const
+{
+	GOKNAR_CORE_INFO("Shader programs: {} compiled, {} read from the cache files, {} shared, created in {:.1f}ms.",
+		compiledProgramCount_, readProgramCount_, sharedProgramCount_, programCreationTime_ * 1000.f);
+}
+
+void ShaderProgramCache::InitializeDriverFeatures()
+{
+	if (isDriverFeaturesInitialized_)
+	{
+		return;
+	}
+	isDriverFeaturesInitialized_ = true;
+
+	driverHash_ = FNV_OFFSET_BASIS;
+	HashGLString(driverHash_, GL_VENDOR);
+	HashGLString(driverHash_, GL_RENDERER);
+	HashGLString(driverHash_, GL_VERSION);
+	HashGLString(driverHash_, GL_SHADING_LANGUAGE_VERSION);
+
+	// Program binaries are core since OpenGL 4.1, drivers can still support no binary formats
+	GEint binaryFormatCount = 0;
+	if (GLAD_GL_VERSION_4_1)
+	{
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+	}
+	isProgramBinarySupported_ = 0 < binaryFormatCount;
+
+	if (!isProgramBinarySupported_)
+	{
+		GOKNAR_CORE_INFO("Driver does not support program binaries, shader program cache files are disabled.");
+	}
+
+	MaxShaderCompilerThreadsFunction maxShaderCompilerThreads = nullptr;
+	if (RendererUtils::GetIsExtensionSupported("GL_KHR_parallel_shader_compile"))
+	{
+		maxShaderCompilerThreads = (MaxShaderCompilerThreadsFunction)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+	}
+	else if (RendererUtils::GetIsExtensionSupported("GL_ARB_parallel_shader_compile"))
+	{
+		maxShaderCompilerThreads = (MaxShaderCompilerThreadsFunction)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+	}
+
+	isParallelShaderCompileSupported_ = maxShaderCompilerThreads != nullptr;
+	if (isParallelShaderCompileSupported_)
+	{
+		// Lets the driver pick its own thread count
+		maxShaderCompilerThreads(SHADER_COMPILER_THREAD_COUNT_UNLIMITED);
+
+		GEint compilerThreadCount = 0;
+		glGetIntegerv(MAX_SHADER_COMPILER_THREADS_ENUM, &compilerThreadCount);
+		GOKNAR_CORE_INFO("Parallel shader compilation is enabled with {} compiler threads.", (unsigned int)compilerThreadCount);
+	}
+}
+
+std::string ShaderProgramCache::GetCacheFilePath(uint64_t sourceHash) const
+{
+	char hashText[17];
+	std::snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)sourceHash);
+
+	return cacheDirectory_ + hashText + ".gkprogram";
+}
@@ -0,0 +1,158 @@
+#ifndef __SHADERPROGRAMCACHE_H__
+#define __SHADERPROGRAMCACHE_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Renderer/Types.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Engine;
+class Texture;
+
+struct GOKNAR_API ShaderProgramCacheEntry
+{
+	GEuint programId{ 0 };
+
+	// Shaders stay attached until the compile and link statuses of a pending program are checked
+	GEuint vertexShaderId{ 0 };
+	GEuint fragmentShaderId{ 0 };
+	GEuint geometryShaderId{ 0 };
+
+	uint64_t sourceHash{ 0 };
+
+	// Time in seconds spent submitting the shaders of a pending program
+	float submissionTime{ 0.f };
+
+	int referenceCount{ 0 };
+
+	bool isPending{ false };
+};
+
+// Linked shader programs are shared between the shaders with identical sources and textures, since materials often generate the same sources
+// Program binaries are written to cache files keyed by the hash of the sources so that the programs are not compiled again on the next runs
+// Cache files written by another driver(vendor, renderer or version) are ignored and rewritten
+// Compile and link statuses are checked only when a program is first used so that the driver can compile the programs in parallel
+class GOKNAR_API ShaderProgramCache
+{
+	friend Engine;
+
+public:
+	static ShaderProgramCache* GetInstance()
+	{
+		if (instance_ == nullptr)
+		{
+			instance_ = new ShaderProgramCache();
+		}
+
+		return instance_;
+	}
+
+	static uint64_t GetSourceHash(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource);
+
+	// Sampler uniforms are set once per program, so a program is only shared between the shaders binding the same textures
+	static uint64_t GetProgramKey(uint64_t sourceHash, const std::vector<const Texture*>& textures);
+
+	// Program linked for the key, 0 if there is none. Acquired programs must be released with ReleaseProgram
+	GEuint AcquireProgram(uint64_t programKey);
+
+	// Adds a program linked from a cache file under the key as acquired once
+	void AddProgram(uint64_t programKey, GEuint programId);
+
+	// Adds a program whose shaders are still compiled and linked by the driver under the key as acquired once
+	void AddPendingProgram(uint64_t programKey, const ShaderProgramCacheEntry& programEntry);
+
+	// Entry of the program if its compile and link statuses are not checked yet, nullptr otherwise
+	const ShaderProgramCacheEntry* GetPendingProgram(GEuint programId) const;
+
+	// Queried without blocking if the driver supports parallel shader compilation, otherwise programs are always ready and checking them blocks
+	bool GetIsProgramReady(GEuint programId) const;
+
+	// Deletes the shaders of the checked program and writes its binary, wait time is the time spent blocked on its compilation
+	void CompletePendingProgram(GEuint programId, float waitTime);
+
+	// Deletes the program when it is released by every shader using it
+	void ReleaseProgram(GEuint programId);
+
+	// Must be called before the program is linked so that its binary can be retrieved
+	void PrepareProgram(GEuint programId);
+
+	// Links the program from the cache file of the sources, returns false if there is no valid cache file
+	bool ReadProgramBinary(GEuint programId, uint64_t sourceHash);
+	void WriteProgramBinary(GEuint programId, uint64_t sourceHash);
+
+	void SetIsSerializationEnabled(bool isSerializationEnabled)
+	{
+		isSerializationEnabled_ = isSerializationEnabled;
+	}
+
+	bool GetIsSerializationEnabled() const
+	{
+		return isSerializationEnabled_;
+	}
+
+	void SetCacheDirectory(const std::string& cacheDirectory)
+	{
+		cacheDirectory_ = cacheDirectory;
+	}
+
+	const std::string& GetCacheDirectory() const
+	{
+		return cacheDirectory_;
+	}
+
+	int GetCompiledProgramCount() const
+	{
+		return compiledProgramCount_;
+	}
+
+	int GetReadProgramCount() const
+	{
+		return readProgramCount_;
+	}
+
+	int GetSharedProgramCount() const
+	{
+		return sharedProgramCount_;
+	}
+
+	// Time in seconds the main thread spent compiling, linking and reading programs
+	float GetProgramCreationTime() const
+	{
+		return programCreationTime_;
+	}
+
+	void LogStatistics() const;
+
+private:
+	ShaderProgramCache();
+	~ShaderProgramCache();
+
+	// Queries the driver once a context exists
+	void InitializeDriverFeatures();
+
+	std::string GetCacheFilePath(uint64_t sourceHash) const;
+
+	static ShaderProgramCache* instance_;
+
+	std::unordered_map<uint64_t, ShaderProgramCacheEntry> programEntries_;
+	std::unordered_map<GEuint, uint64_t> programKeys_;
+
+	std::string cacheDirectory_;
+
+	uint64_t driverHash_{ 0 };
+
+	int compiledProgramCount_{ 0 };
+	int readProgramCount_{ 0 };
+	int sharedProgramCount_{ 0 };
+	float programCreationTime_{ 0.f };
+
+	bool isSerializationEnabled_{ true };
+	bool isDriverFeaturesInitialized_{ false };
+	bool isProgramBinarySupported_{ false };
+	bool isParallelShaderCompileSupported_{ false };
+};
+
+#endif
@@ -123,6 +123,9 @@ inline namespace SHADER_VARIABLE_NAMES
 		const char* METALLIC = "metallicTexture";
 		const char* SPECULAR = "specularTexture";
 		const char* ROUGHNESS = "roughnessTexture";
+
+		const char* ATLAS_UV_TRANSFORM_SUFFIX = "UVTransform";
+		const char* ARRAY_LAYER_SUFFIX = "Layer";
 	}
 
 	inline namespace POSITIONING
@@ -129,6 +129,10 @@ inline namespace SHADER_VARIABLE_NAMES
 		extern const char* METALLIC;
 		extern const char* SPECULAR;
 		extern const char* ROUGHNESS;
+
+		// Appended to the names of the packed textures
+		extern const char* ATLAS_UV_TRANSFORM_SUFFIX;
+		extern const char* ARRAY_LAYER_SUFFIX;
 	}
 
 	inline namespace POSITIONING
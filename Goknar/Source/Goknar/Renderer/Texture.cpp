@@ -10,10 +10,18 @@
 #include <GL/gl.h>
 #endif
 
+#include "Goknar/Engine.h"
 #include "Goknar/Contents/Image.h"
 #include "Goknar/IO/IOManager.h"
 #include "Goknar/Log.h"
+#include "Goknar/Renderer/Renderer.h"
 #include "Goknar/Renderer/Shader.h"
+#include "Goknar/Renderer/ShaderTypes.h"
+#include "Goknar/Renderer/TextureCompression.h"
+#include "Goknar/Renderer/TextureStreamer.h"
+
+// Mip levels of streamed textures with both dimensions up to this size are uploaded in PreInit
+constexpr int TEXTURE_STREAMING_RESIDENT_MIP_SIZE = 64;
 
 Texture::Texture()
 {
@@ -28,27 +36,217 @@ Texture::Texture(std::string imagePath) : Texture()
 
 Texture::Texture(Image* image) :
 	Texture()
+{
+	const std::string& imageName = image->GetName();
+	if (!imageName.empty())
+	{
+		name_ = imageName;
+	}
+
+	SetImageData(image);
+}
+
+Texture::~Texture()
+{
+	if (isStreamed_ && engine->GetRenderer())
+	{
+		engine->GetRenderer()->GetTextureStreamer()->RemoveTexture(this);
+	}
+
+	glDeleteTextures(1, &rendererTextureId_);
+
+	ReleaseMipLevelBuffers();
+	delete[] buffer_;
+}
+
+void Texture::SetImageData(const Image* image)
 {
 	buffer_ = image->GetBuffer();
 	width_ = image->GetWidth();
 	height_ = image->GetHeight();
 	channels_ = image->GetChannels();
 	textureUsage_ = image->GetTextureUsage();
+	textureCompressionFormat_ = image->GetCompressionFormat();
 	textureWrappingR_ = image->GetTextureWrappingR();
 	textureWrappingT_ = image->GetTextureWrappingT();
 	textureWrappingS_ = image->GetTextureWrappingS();
 
-	const std::string& imageName = image->GetName();
-	if (!imageName.empty())
+	// Precomputed mip levels are streamed instead of being generated on the GPU
+	const std::vector<unsigned char*>& imageMipmapBuffers = image->GetMipmapBuffers();
+	if (!imageMipmapBuffers.empty())
 	{
-		name_ = imageName;
+		mipLevelBuffers_.reserve(imageMipmapBuffers.size() + 1);
+		mipLevelBuffers_.push_back(buffer_);
+		mipLevelBuffers_.insert(mipLevelBuffers_.end(), imageMipmapBuffers.begin(), imageMipmapBuffers.end());
 	}
 }
 
-Texture::~Texture()
+void Texture::Release()
 {
-	glDeleteTextures(1, &rendererTextureId_);
-	delete[] buffer_;
+	if (!isInitialized_)
+	{
+		return;
+	}
+
+	if (isStreamed_ && engine->GetRenderer())
+	{
+		engine->GetRenderer()->GetTextureStreamer()->RemoveTexture(this);
+	}
+
+	// The name and its unit are kept since shaders bind textures and set their samplers only once,
+	// only the storage of the mip levels is freed
+	const int textureBindTargetInt = (int)textureBindTarget_;
+	glActiveTexture(GL_TEXTURE0 + rendererTextureId_);
+	glBindTexture(textureBindTargetInt, rendererTextureId_);
+
+	const int faceCount = textureImageTarget_ == TextureImageTarget::TEXTURE_CUBE_MAP_POSITIVE_X ? 6 : 1;
+	for (int mipLevel = 0; (width_ >> mipLevel) || (height_ >> mipLevel); ++mipLevel)
+	{
+		for (int faceIndex = 0; faceIndex < faceCount; ++faceIndex)
+		{
+			glTexImage2D((int)textureImageTarget_ + faceIndex, mipLevel, (int)textureInternalFormat_, 0, 0, 0, (int)textureFormat_, (int)textureType_, nullptr);
+		}
+	}
+
+	glTexParameteri(textureBindTargetInt, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(textureBindTargetInt, GL_TEXTURE_MAX_LEVEL, 1000);
+
+	EXIT_ON_GL_ERROR("Texture::Release");
+
+	ReleaseMipLevelBuffers();
+
+	residentMipLevel_ = 0;
+	requestedMipLevel_ = 0;
+	isStreamed_ = false;
+	isInitialized_ = false;
+}
+
+void Texture::SetPackingType(TexturePackingType packingType)
+{
+	packingType_ = packingType;
+
+	if (packingType_ == TexturePackingType::Atlas)
+	{
+		packedUniformName_ = name_ + SHADER_VARIABLE_NAMES::TEXTURE::ATLAS_UV_TRANSFORM_SUFFIX;
+	}
+	else if (packingType_ == TexturePackingType::Array)
+	{
+		packedUniformName_ = name_ + SHADER_VARIABLE_NAMES::TEXTURE::ARRAY_LAYER_SUFFIX;
+	}
+	else
+	{
+		packedUniformName_.clear();
+	}
+}
+
+void Texture::ReleaseMipLevelBuffers()
+{
+	// Base level is shared with buffer_ until the texture is initialized
+	for (const unsigned char* mipLevelBuffer : mipLevelBuffers_)
+	{
+		if (mipLevelBuffer != buffer_)
+		{
+			delete[] mipLevelBuffer;
+		}
+	}
+	mipLevelBuffers_.clear();
+}
+
+void Texture::SetStreamedMipLevels()
+{
+	const int mipLevelCount = (int)mipLevelBuffers_.size();
+
+	residentMipLevel_ = mipLevelCount - 1;
+	for (int mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+	{
+		const int mipLevelWidth = GetMipLevelWidth(mipLevel);
+		const int mipLevelHeight = GetMipLevelHeight(mipLevel);
+
+		// Coarse levels are uploaded right away so the texture is never sampled without data, finer levels are only allocated
+		const bool isResident = mipLevelWidth <= TEXTURE_STREAMING_RESIDENT_MIP_SIZE && mipLevelHeight <= TEXTURE_STREAMING_RESIDENT_MIP_SIZE;
+		if (isResident && mipLevel < residentMipLevel_)
+		{
+			residentMipLevel_ = mipLevel;
+		}
+
+		glTexImage2D(GL_TEXTURE_2D, mipLevel, (int)textureInternalFormat_, mipLevelWidth, mipLevelHeight, 0, (int)textureFormat_, (int)textureType_, isResident ? mipLevelBuffers_[mipLevel] : nullptr);
+
+		if (isResident)
+		{
+			delete[] mipLevelBuffers_[mipLevel];
+			mipLevelBuffers_[mipLevel] = nullptr;
+		}
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, residentMipLevel_);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevelCount - 1);
+
+	requestedMipLevel_ = residentMipLevel_;
+	isStreamed_ = 0 < residentMipLevel_;
+
+	// Base level is owned by mipLevelBuffers_ from now on
+	buffer_ = nullptr;
+}
+
+void Texture::SetCompressedMipLevels()
+{
+	if (mipLevelBuffers_.empty())
+	{
+		mipLevelBuffers_.push_back(buffer_);
+	}
+
+	const int mipLevelCount = (int)mipLevelBuffers_.size();
+
+	const bool isCompressionSupported = TextureCompression::GetIsFormatSupported(textureCompressionFormat_);
+	if (isCompressionSupported)
+	{
+		textureInternalFormat_ = TextureCompression::GetTextureInternalFormat(textureCompressionFormat_);
+	}
+	else
+	{
+		GOKNAR_CORE_WARN("Texture compression format of {0} is not supported, it is decompressed.", name_);
+
+		channels_ = TextureCompression::GetChannelCount(textureCompressionFormat_);
+		if (channels_ == 2)
+		{
+			textureFormat_ = TextureFormat::RG;
+			textureInternalFormat_ = TextureInternalFormat::RG;
+		}
+		else if (channels_ == 3)
+		{
+			textureFormat_ = TextureFormat::RGB;
+			textureInternalFormat_ = TextureInternalFormat::RGB;
+		}
+		else
+		{
+			textureFormat_ = TextureFormat::RGBA;
+			textureInternalFormat_ = TextureInternalFormat::RGBA;
+		}
+	}
+
+	std::vector<unsigned char> decompressedBuffer;
+	for (int mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+	{
+		const int mipLevelWidth = GetMipLevelWidth(mipLevel);
+		const int mipLevelHeight = GetMipLevelHeight(mipLevel);
+
+		if (isCompressionSupported)
+		{
+			const GLsizei compressedByteSize = (GLsizei)TextureCompression::GetCompressedByteSize(textureCompressionFormat_, mipLevelWidth, mipLevelHeight);
+			glCompressedTexImage2D(GL_TEXTURE_2D, mipLevel, (int)textureInternalFormat_, mipLevelWidth, mipLevelHeight, 0, compressedByteSize, mipLevelBuffers_[mipLevel]);
+		}
+		else
+		{
+			decompressedBuffer.resize((size_t)mipLevelWidth * mipLevelHeight * channels_);
+			TextureCompression::Decompress(textureCompressionFormat_, mipLevelBuffers_[mipLevel], mipLevelWidth, mipLevelHeight, decompressedBuffer.data());
+			glTexImage2D(GL_TEXTURE_2D, mipLevel, (int)textureInternalFormat_, mipLevelWidth, mipLevelHeight, 0, (int)textureFormat_, GL_UNSIGNED_BYTE, decompressedBuffer.data());
+		}
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipLevelCount - 1);
+
+	ReleaseMipLevelBuffers();
 }
 
 void Texture::ReadFromFrameBuffer(GEuint framebuffer)
@@ -126,19 +324,48 @@ void Texture::PreInit()
 
 	int textureBindTargetInt = (int)textureBindTarget_;
 
-	glGenTextures(1, &rendererTextureId_);
+	// Released textures are uploaded again into the same name
+	const bool isRestored = rendererTextureId_ != 0;
+	if (!isRestored)
+	{
+		glGenTextures(1, &rendererTextureId_);
+	}
 	glActiveTexture(GL_TEXTURE0 + rendererTextureId_);
 	glBindTexture(textureBindTargetInt, rendererTextureId_);
 
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-	glTexImage2D((int)textureImageTarget_, 0, (int)textureInternalFormat_, width_, height_, 0, (int)textureFormat_, (int)textureType_, buffer_);
+	const bool isCompressed = textureCompressionFormat_ != TextureCompressionFormat::None;
+	const bool hasStreamedMipLevels =
+		!isCompressed &&
+		1 < mipLevelBuffers_.size() &&
+		textureImageTarget_ == TextureImageTarget::TEXTURE_2D &&
+		textureType_ == TextureType::UNSIGNED_BYTE;
 
-	if (textureImageTarget_ == TextureImageTarget::TEXTURE_CUBE_MAP_POSITIVE_X)
+	if (isCompressed)
 	{
-		for (int i = 1; i < 6; ++i)
+		SetCompressedMipLevels();
+	}
+	else if (hasStreamedMipLevels)
+	{
+		SetStreamedMipLevels();
+	}
+	else if (textureBindTarget_ == TextureBindTarget::TEXTURE_2D_ARRAY)
+	{
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, (int)textureInternalFormat_, width_, height_, layerCount_, 0, (int)textureFormat_, (int)textureType_, buffer_);
+	}
+	else
+	{
+		ReleaseMipLevelBuffers();
+
+		glTexImage2D((int)textureImageTarget_, 0, (int)textureInternalFormat_, width_, height_, 0, (int)textureFormat_, (int)textureType_, buffer_);
+
+		if (textureImageTarget_ == TextureImageTarget::TEXTURE_CUBE_MAP_POSITIVE_X)
 		{
-			glTexImage2D((int)textureImageTarget_ + i, 0, (int)textureInternalFormat_, width_, height_, 0, (int)textureFormat_, (int)textureType_, buffer_);
+			for (int i = 1; i < 6; ++i)
+			{
+				glTexImage2D((int)textureImageTarget_ + i, 0, (int)textureInternalFormat_, width_, height_, 0, (int)textureFormat_, (int)textureType_, buffer_);
+			}
 		}
 	}
 
@@ -156,17 +383,36 @@ void Texture::PreInit()
 	glTexParameteri(textureBindTargetInt, GL_TEXTURE_WRAP_T, (int)textureWrappingT_);
 	glTexParameteri(textureBindTargetInt, GL_TEXTURE_WRAP_R, (int)textureWrappingR_);
 
-	if (generateMipmap_ && textureFormat_ != TextureFormat::DEPTH && textureFormat_ != TextureFormat::DEPTH_STENCIL)
+	if (0 <= maxMipLevel_)
+	{
+		glTexParameteri(textureBindTargetInt, GL_TEXTURE_MAX_LEVEL, maxMipLevel_);
+	}
+
+	// Compressed textures come with their mip levels
+	if (!isCompressed && !hasStreamedMipLevels && generateMipmap_ && textureFormat_ != TextureFormat::DEPTH && textureFormat_ != TextureFormat::DEPTH_STENCIL)
 	{
 		glGenerateMipmap(textureBindTargetInt);
 	}
-	
-	glBindTexture(textureBindTargetInt, 0);
+
+	// Shaders bound the texture on its unit before it was released, so a restored texture stays bound there
+	if (!isRestored)
+	{
+		glBindTexture(textureBindTargetInt, 0);
+	}
 	
 	EXIT_ON_GL_ERROR("Texture::Init");
 
 	delete[] buffer_;
 	buffer_ = nullptr;
+
+	if (isStreamed_)
+	{
+		engine->GetRenderer()->GetTextureStreamer()->AddTexture(this);
+	}
+	else
+	{
+		ReleaseMipLevelBuffers();
+	}
 }
 
 void Texture::Init()
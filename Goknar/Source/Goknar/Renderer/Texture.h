@@ -6,9 +6,11 @@
 #include "Types.h"
 
 #include <string>
+#include <vector>
 
 class Shader;
 class Image;
+class TextureStreamer;
 
 enum class TextureBindTarget
 {
@@ -81,6 +83,15 @@ enum class TextureFormat
 	RGBA = GL_RGBA
 };
 
+// S3TC is an extension and its formats are not in the core profile headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 enum class TextureInternalFormat
 {
 	DEPTH = GL_DEPTH_COMPONENT,
@@ -98,6 +109,23 @@ enum class TextureInternalFormat
 	RGBA = GL_RGBA,
 	RGBA16F = GL_RGBA16F,
 	RGBA32F = GL_RGBA32F,
+	COMPRESSED_RGB_BC1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+	COMPRESSED_RGBA_BC3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+	COMPRESSED_RG_BC5 = GL_COMPRESSED_RG_RGTC2,
+	COMPRESSED_RGBA_BC7 = GL_COMPRESSED_RGBA_BPTC_UNORM
+};
+
+enum class TextureCompressionFormat : unsigned char
+{
+	None = 0,
+	// RGB, 8 bytes per 4x4 block
+	BC1,
+	// RGBA, 16 bytes per 4x4 block
+	BC3,
+	// Two channels for normal maps, the third component is reconstructed in the shader, 16 bytes per 4x4 block
+	BC5,
+	// RGBA with a higher quality than BC1 and BC3, 16 bytes per 4x4 block
+	BC7
 };
 
 enum class TextureType
@@ -148,6 +176,14 @@ enum class TextureDataType : unsigned char
 	DYNAMIC
 };
 
+// Packed textures are shared by several images, shaders select the image with a UV transform or a layer uniform
+enum class TexturePackingType : unsigned char
+{
+	None = 0,
+	Atlas,
+	Array
+};
+
 enum class TextureUsage : unsigned char
 {
 	None = 0,
@@ -164,6 +200,8 @@ enum class TextureUsage : unsigned char
 
 class GOKNAR_API Texture
 {
+	friend class TextureStreamer;
+
 public:
 	Texture();
 	Texture(std::string imagePath);
@@ -175,6 +213,13 @@ public:
 	void Init();
 	void PostInit();
 
+	// Takes the pixels and mip levels of the image, they are uploaded by the next PreInit
+	void SetImageData(const Image* image);
+
+	// Frees the storage of the texture on the GPU while keeping its name bound on its unit,
+	// the texture is uploaded again into the same name by PreInit after SetImageData
+	void Release();
+
 	void Bind(const Shader* shader = nullptr) const;
 	void Unbind();
 
@@ -397,6 +442,46 @@ public:
 		textureUsage_ = textureUsage;
 	}
 
+	TextureCompressionFormat GetTextureCompressionFormat() const
+	{
+		return textureCompressionFormat_;
+	}
+
+	TexturePackingType GetPackingType() const
+	{
+		return packingType_;
+	}
+
+	// Name of the UV transform(atlases) or the layer(arrays) uniform, the texture should be named before
+	void SetPackingType(TexturePackingType packingType);
+
+	const std::string& GetPackedUniformName() const
+	{
+		return packedUniformName_;
+	}
+
+	// Layers of 2D array textures, the buffer holds the layers one after another
+	void SetLayerCount(int layerCount)
+	{
+		layerCount_ = layerCount;
+	}
+
+	int GetLayerCount() const
+	{
+		return layerCount_;
+	}
+
+	// Negative values keep the OpenGL default
+	void SetMaxMipLevel(int maxMipLevel)
+	{
+		maxMipLevel_ = maxMipLevel;
+	}
+
+	int GetMaxMipLevel() const
+	{
+		return maxMipLevel_;
+	}
+
 	void SetChannels(int channels)
 	{
 		channels_ = channels;
@@ -427,16 +512,61 @@ public:
 		return generateMipmap_;
 	}
 
+	bool GetIsStreamed() const
+	{
+		return isStreamed_;
+	}
+
+	int GetResidentMipLevel() const
+	{
+		return residentMipLevel_;
+	}
+
+	// Streamed textures upload the mip levels finer than the resident one when they are requested, requests are reset every frame
+	void RequestMipLevel(int mipLevel)
+	{
+		if (mipLevel < requestedMipLevel_)
+		{
+			requestedMipLevel_ = mipLevel;
+		}
+	}
+
+	int GetMipLevelCount() const
+	{
+		return mipLevelBuffers_.empty() ? 1 : (int)mipLevelBuffers_.size();
+	}
+
+	int GetMipLevelWidth(int mipLevel) const
+	{
+		const int mipLevelWidth = width_ >> mipLevel;
+		return 0 < mipLevelWidth ? mipLevelWidth : 1;
+	}
+
+	int GetMipLevelHeight(int mipLevel) const
+	{
+		const int mipLevelHeight = height_ >> mipLevel;
+		return 0 < mipLevelHeight ? mipLevelHeight : 1;
+	}
+
 protected:
 
 private:
 	void UpdateSizeOnGPU();
 
+	void SetStreamedMipLevels();
+	// Uploads the block compressed mip levels, or decompresses them when the format is not supported by the GPU
+	void SetCompressedMipLevels();
+	void ReleaseMipLevelBuffers();
+
 	std::string name_{ "" };
 	std::string imagePath_{ "" };
+	std::string packedUniformName_{ "" };
 	const unsigned char* buffer_{ nullptr };
 	GEuint rendererTextureId_{ 0 };
 
+	// Precomputed mip levels, the base level included, levels are released once they are uploaded
+	std::vector<const unsigned char*> mipLevelBuffers_;
+
 	TextureBindTarget textureBindTarget_{ TextureBindTarget::TEXTURE_2D};
 	TextureImageTarget textureImageTarget_{ TextureImageTarget::TEXTURE_2D };
 	TextureWrapping textureWrappingS_{ TextureWrapping::REPEAT };
@@ -453,14 +583,23 @@ private:
 	TextureDataType textureDataType_{ TextureDataType::STATIC };
 
 	TextureUsage textureUsage_{ TextureUsage::Diffuse };
+	TextureCompressionFormat textureCompressionFormat_{ TextureCompressionFormat::None };
+	TexturePackingType packingType_{ TexturePackingType::None };
 
 	int GUID_{ 0 };
 	int width_{ 0 };
 	int height_{ 0 };
 	int channels_{ 0 };
+	int layerCount_{ 1 };
+	int maxMipLevel_{ -1 };
+
+	// Finest mip level on the GPU, finer levels are uploaded by the TextureStreamer
+	int residentMipLevel_{ 0 };
+	int requestedMipLevel_{ 0 };
 
 	bool isInitialized_{ false };
 	bool generateMipmap_{ true };
+	bool isStreamed_{ false };
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "pch.h"
+
+#include "TextureAtlas.h"
+
+#include <cstring>
+
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Renderer/Texture.h"
+
+static int AlignToGutter(int value)
+{
+	return (value + TEXTURE_ATLAS_GUTTER - 1) / TEXTURE_ATLAS_GUTTER * TEXTURE_ATLAS_GUTTER;
+}
+
+// Grey, grey alpha, RGB and RGBA sources are expanded to the destination channels
+static void ConvertPixel(const unsigned char* sourcePixel, int sourceChannels, unsigned char* destinationPixel, int destinationChannels)
+{
+	const bool isGrey = sourceChannels < 3;
+	destinationPixel[0] = sourcePixel[0];
+	destinationPixel[1] = isGrey ? sourcePixel[0] : sourcePixel[1];
+	destinationPixel[2] = isGrey ? sourcePixel[0] : sourcePixel[2];
+
+	if (destinationChannels == 4)
+	{
+		const bool hasAlpha = sourceChannels == 2 || sourceChannels == 4;
+		destinationPixel[3] = hasAlpha ? sourcePixel[sourceChannels - 1] : 255;
+	}
+}
+
+// Coordinates outside of the image are wrapped for repeating images and clamped otherwise
+static int GetSourceCoordinate(int coordinate, int size, bool isRepeating)
+{
+	if (isRepeating)
+	{
+		return ((coordinate % size) + size) % size;
+	}
+
+	return coordinate < 0 ? 0 : (size <= coordinate ? size - 1 : coordinate);
+}
+
+TextureAtlas::TextureAtlas(int width, int height, int channels) :
+	width_(width),
+	height_(height),
+	channels_(channels)
+{
+	skyline_.push_back({ 0, 0, width_ });
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	delete[] pixels_;
+}
+
+int TextureAtlas::GetFittingY(int nodeIndex, int width, int height) const
+{
+	if (width_ < skyline_[nodeIndex].x + width)
+	{
+		return -1;
+	}
+
+	int y = skyline_[nodeIndex].y;
+	int remainingWidth = width;
+	for (int currentNodeIndex = nodeIndex; 0 < remainingWidth; ++currentNodeIndex)
+	{
+		y = y < skyline_[currentNodeIndex].y ? skyline_[currentNodeIndex].y : y;
+		if (height_ < y + height)
+		{
+			return -1;
+		}
+
+		remainingWidth -= skyline_[currentNodeIndex].width;
+	}
+
+	return y;
+}
+
+void TextureAtlas::AddSkylineLevel(int nodeIndex, int x, int y, int width, int height)
+{
+	skyline_.insert(skyline_.begin() + nodeIndex, { x, y + height, width });
+
+	// Nodes under the new level are shrunk or removed
+	for (int currentNodeIndex = nodeIndex + 1; currentNodeIndex < (int)skyline_.size(); ++currentNodeIndex)
+	{
+		const SkylineNode& previousNode = skyline_[currentNodeIndex - 1];
+		SkylineNode& currentNode = skyline_[currentNodeIndex];
+
+		const int overlap = previousNode.x + previousNode.width - currentNode.x;
+		if (overlap <= 0)
+		{
+			break;
+		}
+
+		currentNode.x += overlap;
+		currentNode.width -= overlap;
+		if (0 < currentNode.width)
+		{
+			break;
+		}
+
+		skyline_.erase(skyline_.begin() + currentNodeIndex);
+		--currentNodeIndex;
+	}
+
+	for (int currentNodeIndex = 0; currentNodeIndex + 1 < (int)skyline_.size();)
+	{
+		if (skyline_[currentNodeIndex].y == skyline_[currentNodeIndex + 1].y)
+		{
+			skyline_[currentNodeIndex].width += skyline_[currentNodeIndex + 1].width;
+			skyline_.erase(skyline_.begin() + currentNodeIndex + 1);
+		}
+		else
+		{
+			++currentNodeIndex;
+		}
+	}
+}
+
+bool TextureAtlas::AddImage(Image* image)
+{
+	const int paddedWidth = AlignToGutter(image->GetWidth() + 2 * TEXTURE_ATLAS_GUTTER);
+	const int paddedHeight = AlignToGutter(image->GetHeight() + 2 * TEXTURE_ATLAS_GUTTER);
+
+	// Bottom left: the lowest top edge wins, the narrower node breaks the ties
+	int bestNodeIndex = -1;
+	int bestTop = height_ + 1;
+	int bestNodeWidth = width_ + 1;
+	int bestY = 0;
+	for (int nodeIndex = 0; nodeIndex < (int)skyline_.size(); ++nodeIndex)
+	{
+		const int y = GetFittingY(nodeIndex, paddedWidth, paddedHeight);
+		if (y < 0)
+		{
+			continue;
+		}
+
+		const int top = y + paddedHeight;
+		if (top < bestTop || (top == bestTop && skyline_[nodeIndex].width < bestNodeWidth))
+		{
+			bestNodeIndex = nodeIndex;
+			bestTop = top;
+			bestNodeWidth = skyline_[nodeIndex].width;
+			bestY = y;
+		}
+	}
+
+	if (bestNodeIndex < 0)
+	{
+		return false;
+	}
+
+	const int x = skyline_[bestNodeIndex].x;
+	AddSkylineLevel(bestNodeIndex, x, bestY, paddedWidth, paddedHeight);
+
+	packedImages_.push_back({ image, x, bestY, TextureAtlasRegion() });
+	return true;
+}
+
+float TextureAtlas::GetOccupancy() const
+{
+	unsigned long long imageArea = 0;
+	for (const PackedImage& packedImage : packedImages_)
+	{
+		imageArea += (unsigned long long)packedImage.image->GetWidth() * packedImage.image->GetHeight();
+	}
+
+	return (float)imageArea / ((float)width_ * height_);
+}
+
+void TextureAtlas::CopyImage(const PackedImage& packedImage)
+{
+	const Image* image = packedImage.image;
+	const unsigned char* imageBuffer = image->GetBuffer();
+	const int imageWidth = image->GetWidth();
+	const int imageHeight = image->GetHeight();
+	const int imageChannels = image->GetChannels();
+
+	const bool isRepeatingS = image->GetTextureWrappingS() == TextureWrapping::REPEAT || image->GetTextureWrappingS() == TextureWrapping::MIRRORED_REPEAT;
+	const bool isRepeatingT = image->GetTextureWrappingT() == TextureWrapping::REPEAT || image->GetTextureWrappingT() == TextureWrapping::MIRRORED_REPEAT;
+
+	for (int y = -TEXTURE_ATLAS_GUTTER; y < imageHeight + TEXTURE_ATLAS_GUTTER; ++y)
+	{
+		const int sourceY = GetSourceCoordinate(y, imageHeight, isRepeatingT);
+		unsigned char* destinationRow = pixels_ + ((size_t)(packedImage.y + TEXTURE_ATLAS_GUTTER + y) * width_ + packedImage.x + TEXTURE_ATLAS_GUTTER) * channels_;
+
+		for (int x = -TEXTURE_ATLAS_GUTTER; x < imageWidth + TEXTURE_ATLAS_GUTTER; ++x)
+		{
+			const int sourceX = GetSourceCoordinate(x, imageWidth, isRepeatingS);
+			ConvertPixel(imageBuffer + ((size_t)sourceY * imageWidth + sourceX) * imageChannels, imageChannels, destinationRow + x * channels_, channels_);
+		}
+	}
+}
+
+void TextureAtlas::BuildPixels()
+{
+	if (pixels_)
+	{
+		return;
+	}
+
+	int usedHeight = TEXTURE_ATLAS_GUTTER;
+	for (const SkylineNode& skylineNode : skyline_)
+	{
+		usedHeight = usedHeight < skylineNode.y ? skylineNode.y : usedHeight;
+	}
+	height_ = usedHeight;
+
+	const size_t pixelByteSize = (size_t)width_ * height_ * channels_;
+	pixels_ = new unsigned char[pixelByteSize];
+	memset(pixels_, 0, pixelByteSize);
+
+	for (PackedImage& packedImage : packedImages_)
+	{
+		CopyImage(packedImage);
+
+		packedImage.region.uvTransform = Vector4(
+			(float)packedImage.image->GetWidth() / width_,
+			(float)packedImage.image->GetHeight() / height_,
+			(float)(packedImage.x + TEXTURE_ATLAS_GUTTER) / width_,
+			(float)(packedImage.y + TEXTURE_ATLAS_GUTTER) / height_);
+	}
+}
+
+Texture* TextureAtlas::CreateTexture()
+{
+	BuildPixels();
+
+	const Image* firstImage = packedImages_[0].image;
+
+	Texture* texture = new Texture();
+	texture->SetSize(width_, height_);
+	texture->SetChannels(channels_);
+	texture->SetTextureUsage(firstImage->GetTextureUsage());
+	texture->SetTextureWrappingS(firstImage->GetTextureWrappingS());
+	texture->SetTextureWrappingT(firstImage->GetTextureWrappingT());
+	texture->SetMaxMipLevel(TEXTURE_ATLAS_MAX_MIP_LEVEL);
+	texture->SetPackingType(TexturePackingType::Atlas);
+
+	// Texture deletes the pixels once they are uploaded
+	texture->SetBuffer(pixels_);
+	pixels_ = nullptr;
+
+	return texture;
+}
+
+TextureArray::TextureArray(int width, int height, int channels, int maxLayerCount) :
+	width_(width),
+	height_(height),
+	channels_(channels),
+	maxLayerCount_(maxLayerCount)
+{
+}
+
+TextureArray::~TextureArray()
+{
+}
+
+int TextureArray::AddImage(Image* image)
+{
+	if (maxLayerCount_ <= (int)images_.size() || image->GetWidth() != width_ || image->GetHeight() != height_)
+	{
+		return -1;
+	}
+
+	images_.push_back(image);
+	return (int)images_.size() - 1;
+}
+
+Texture* TextureArray::CreateTexture()
+{
+	const size_t pixelCount = (size_t)width_ * height_;
+	const size_t layerByteSize = pixelCount * channels_;
+
+	unsigned char* pixels = new unsigned char[layerByteSize * images_.size()];
+	for (int layer = 0; layer < (int)images_.size(); ++layer)
+	{
+		const unsigned char* imageBuffer = images_[layer]->GetBuffer();
+		const int imageChannels = images_[layer]->GetChannels();
+
+		unsigned char* layerPixels = pixels + layer * layerByteSize;
+		if (imageChannels == channels_)
+		{
+			memcpy(layerPixels, imageBuffer, layerByteSize);
+			continue;
+		}
+
+		for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+		{
+			ConvertPixel(imageBuffer + pixelIndex * imageChannels, imageChannels, layerPixels + pixelIndex * channels_, channels_);
+		}
+	}
+
+	const Image* firstImage = images_[0];
+
+	Texture* texture = new Texture();
+	texture->SetSize(width_, height_);
+	texture->SetChannels(channels_);
+	texture->SetLayerCount((int)images_.size());
+	texture->SetTextureBindTarget(TextureBindTarget::TEXTURE_2D_ARRAY);
+	texture->SetTextureUsage(firstImage->GetTextureUsage());
+	texture->SetTextureWrappingS(firstImage->GetTextureWrappingS());
+	texture->SetTextureWrappingT(firstImage->GetTextureWrappingT());
+	texture->SetPackingType(TexturePackingType::Array);
+
+	// Texture deletes the pixels once they are uploaded
+	texture->SetBuffer(pixels);
+
+	return texture;
+}
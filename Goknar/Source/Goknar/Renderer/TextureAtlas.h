@@ -0,0 +1,147 @@
+#ifndef __TEXTUREATLAS_H__
+#define __TEXTUREATLAS_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Math/GoknarMath.h"
+
+#include <string>
+#include <vector>
+
+class Image;
+class Texture;
+
+// Pixels replicated around every packed image, image positions are aligned to it as well
+// so the first TEXTURE_ATLAS_MAX_MIP_LEVEL mip levels never blend neighbouring images
+constexpr int TEXTURE_ATLAS_GUTTER = 4;
+constexpr int TEXTURE_ATLAS_MAX_MIP_LEVEL = 2;
+
+// Place of an image in a shared texture, written into the material parameters of the materials that use the image
+struct GOKNAR_API TextureAtlasRegion
+{
+	// xy: scale, zw: offset of the texture coordinates in an atlas
+	Vector4 uvTransform{ 1.f, 1.f, 0.f, 0.f };
+
+	// Layer in an array texture
+	int layer{ 0 };
+};
+
+// Packs images into a single texture with the skyline bottom left heuristic
+// Images are converted to the channel count of the atlas, their gutters are wrapped or clamped by their wrapping modes
+class GOKNAR_API TextureAtlas
+{
+public:
+	TextureAtlas(int width, int height, int channels);
+	~TextureAtlas();
+
+	// False if the image does not fit into the remaining space
+	bool AddImage(Image* image);
+
+	// Copies the packed images into the atlas pixels, the height is shrunk to the used height
+	void BuildPixels();
+
+	// Builds the pixels if needed and hands them over to the created texture
+	Texture* CreateTexture();
+
+	const unsigned char* GetPixels() const
+	{
+		return pixels_;
+	}
+
+	int GetWidth() const
+	{
+		return width_;
+	}
+
+	int GetHeight() const
+	{
+		return height_;
+	}
+
+	int GetChannels() const
+	{
+		return channels_;
+	}
+
+	int GetImageCount() const
+	{
+		return (int)packedImages_.size();
+	}
+
+	Image* GetImage(int index) const
+	{
+		return packedImages_[index].image;
+	}
+
+	// Valid after BuildPixels
+	const TextureAtlasRegion& GetRegion(int index) const
+	{
+		return packedImages_[index].region;
+	}
+
+	// Ratio of the area covered by the images, gutters excluded
+	float GetOccupancy() const;
+
+private:
+	struct SkylineNode
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	struct PackedImage
+	{
+		Image* image;
+		int x;
+		int y;
+		TextureAtlasRegion region;
+	};
+
+	// Lowest y the rectangle fits at when placed on the node, -1 if it does not fit
+	int GetFittingY(int nodeIndex, int width, int height) const;
+	void AddSkylineLevel(int nodeIndex, int x, int y, int width, int height);
+
+	void CopyImage(const PackedImage& packedImage);
+
+	std::vector<SkylineNode> skyline_;
+	std::vector<PackedImage> packedImages_;
+
+	unsigned char* pixels_{ nullptr };
+
+	int width_{ 0 };
+	int height_{ 0 };
+	int channels_{ 0 };
+};
+
+// Stacks same size images into the layers of a 2D array texture
+class GOKNAR_API TextureArray
+{
+public:
+	TextureArray(int width, int height, int channels, int maxLayerCount);
+	~TextureArray();
+
+	// Layer of the image, -1 if the array is full or the image size differs
+	int AddImage(Image* image);
+
+	Texture* CreateTexture();
+
+	int GetLayerCount() const
+	{
+		return (int)images_.size();
+	}
+
+	Image* GetImage(int layer) const
+	{
+		return images_[layer];
+	}
+
+private:
+	std::vector<Image*> images_;
+
+	int width_{ 0 };
+	int height_{ 0 };
+	int channels_{ 0 };
+	int maxLayerCount_{ 0 };
+};
+
+#endif
@@ -0,0 +1,673 @@
+#include "pch.h"
+
+#include "TextureCompression.h"
+
+#include "glad/glad.h"
+
+#include "Goknar/Engine.h"
+#include "Goknar/Log.h"
+#include "Goknar/Renderer/RendererUtils.h"
+#include "Goknar/Managers/JobManager.h"
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+// Rows of blocks encoded or decoded by a single job
+constexpr int TEXTURE_COMPRESSION_BLOCK_ROW_BATCH_SIZE = 4;
+
+// Interpolation weights of the 4 bit BC7 indices, out of 64
+static const int BC7_INDEX_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Pixels outside of the image are clamped to its edges
+static void LoadBlock(const unsigned char* source, int width, int height, int channels, int blockX, int blockY, float pixels[16][4])
+{
+	for (int y = 0; y < 4; ++y)
+	{
+		const int sourceY = blockY * 4 + y < height ? blockY * 4 + y : height - 1;
+		for (int x = 0; x < 4; ++x)
+		{
+			const int sourceX = blockX * 4 + x < width ? blockX * 4 + x : width - 1;
+			const unsigned char* sourcePixel = source + ((size_t)sourceY * width + sourceX) * channels;
+
+			float* pixel = pixels[y * 4 + x];
+			pixel[0] = sourcePixel[0];
+			pixel[1] = 1 < channels ? sourcePixel[1] : sourcePixel[0];
+			pixel[2] = 2 < channels ? sourcePixel[2] : (channels == 1 ? sourcePixel[0] : 0.f);
+			pixel[3] = 3 < channels ? sourcePixel[3] : 255.f;
+		}
+	}
+}
+
+static void StoreBlock(const int pixels[16][4], int width, int height, int channels, int blockX, int blockY, unsigned char* destination)
+{
+	for (int y = 0; y < 4 && blockY * 4 + y < height; ++y)
+	{
+		for (int x = 0; x < 4 && blockX * 4 + x < width; ++x)
+		{
+			unsigned char* destinationPixel = destination + ((size_t)(blockY * 4 + y) * width + blockX * 4 + x) * channels;
+			for (int channel = 0; channel < channels; ++channel)
+			{
+				destinationPixel[channel] = (unsigned char)pixels[y * 4 + x][channel];
+			}
+		}
+	}
+}
+
+// Endpoints are the extremes of the block along the principal axis of its first componentCount components
+static void ComputeEndpoints(const float pixels[16][4], int componentCount, float startEndpoint[4], float endEndpoint[4])
+{
+	float mean[4] = { 0.f, 0.f, 0.f, 0.f };
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		for (int component = 0; component < componentCount; ++component)
+		{
+			mean[component] += pixels[pixelIndex][component];
+		}
+	}
+
+	for (int component = 0; component < componentCount; ++component)
+	{
+		mean[component] /= 16.f;
+	}
+
+	float covariance[4][4] = {};
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		for (int row = 0; row < componentCount; ++row)
+		{
+			for (int column = 0; column < componentCount; ++column)
+			{
+				covariance[row][column] += (pixels[pixelIndex][row] - mean[row]) * (pixels[pixelIndex][column] - mean[column]);
+			}
+		}
+	}
+
+	// Power iteration
+	float axis[4] = { 1.f, 1.f, 1.f, 1.f };
+	for (int iteration = 0; iteration < 8; ++iteration)
+	{
+		float nextAxis[4] = { 0.f, 0.f, 0.f, 0.f };
+		float largestComponent = 0.f;
+		for (int row = 0; row < componentCount; ++row)
+		{
+			for (int column = 0; column < componentCount; ++column)
+			{
+				nextAxis[row] += covariance[row][column] * axis[column];
+			}
+			largestComponent = std::fabs(nextAxis[row]) < largestComponent ? largestComponent : std::fabs(nextAxis[row]);
+		}
+
+		// Uniform block
+		if (largestComponent < FLT_EPSILON)
+		{
+			break;
+		}
+
+		for (int component = 0; component < componentCount; ++component)
+		{
+			axis[component] = nextAxis[component] / largestComponent;
+		}
+	}
+
+	float axisLengthSquared = 0.f;
+	for (int component = 0; component < componentCount; ++component)
+	{
+		axisLengthSquared += axis[component] * axis[component];
+	}
+
+	const float inverseAxisLength = 1.f / std::sqrt(axisLengthSquared);
+	for (int component = 0; component < componentCount; ++component)
+	{
+		axis[component] *= inverseAxisLength;
+	}
+
+	float minProjection = FLT_MAX;
+	float maxProjection = -FLT_MAX;
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		float projection = 0.f;
+		for (int component = 0; component < componentCount; ++component)
+		{
+			projection += (pixels[pixelIndex][component] - mean[component]) * axis[component];
+		}
+		minProjection = projection < minProjection ? projection : minProjection;
+		maxProjection = maxProjection < projection ? projection : maxProjection;
+	}
+
+	for (int component = 0; component < componentCount; ++component)
+	{
+		const float startValue = mean[component] + axis[component] * maxProjection;
+		const float endValue = mean[component] + axis[component] * minProjection;
+		startEndpoint[component] = startValue < 0.f ? 0.f : (255.f < startValue ? 255.f : startValue);
+		endEndpoint[component] = endValue < 0.f ? 0.f : (255.f < endValue ? 255.f : endValue);
+	}
+}
+
+template<typename PaletteType>
+static int FindNearestPaletteIndex(const float pixel[4], const PaletteType palette[][4], int paletteSize, int componentCount)
+{
+	int nearestIndex = 0;
+	float nearestDistance = FLT_MAX;
+	for (int paletteIndex = 0; paletteIndex < paletteSize; ++paletteIndex)
+	{
+		float distance = 0.f;
+		for (int component = 0; component < componentCount; ++component)
+		{
+			const float difference = pixel[component] - (float)palette[paletteIndex][component];
+			distance += difference * difference;
+		}
+
+		if (distance < nearestDistance)
+		{
+			nearestDistance = distance;
+			nearestIndex = paletteIndex;
+		}
+	}
+	return nearestIndex;
+}
+
+static unsigned short PackColor565(const float color[4])
+{
+	const int red = (int)(color[0] * 31.f / 255.f + 0.5f);
+	const int green = (int)(color[1] * 63.f / 255.f + 0.5f);
+	const int blue = (int)(color[2] * 31.f / 255.f + 0.5f);
+	return (unsigned short)((red << 11) | (green << 5) | blue);
+}
+
+static void UnpackColor565(unsigned short packedColor, int color[4])
+{
+	const int red = (packedColor >> 11) & 31;
+	const int green = (packedColor >> 5) & 63;
+	const int blue = packedColor & 31;
+	color[0] = (red << 3) | (red >> 2);
+	color[1] = (green << 2) | (green >> 4);
+	color[2] = (blue << 3) | (blue >> 2);
+	color[3] = 255;
+}
+
+static void BuildColorPalette(unsigned short color0, unsigned short color1, bool isAlwaysFourColors, int palette[4][4])
+{
+	UnpackColor565(color0, palette[0]);
+	UnpackColor565(color1, palette[1]);
+
+	if (isAlwaysFourColors || color1 < color0)
+	{
+		for (int component = 0; component < 3; ++component)
+		{
+			palette[2][component] = (2 * palette[0][component] + palette[1][component]) / 3;
+			palette[3][component] = (palette[0][component] + 2 * palette[1][component]) / 3;
+		}
+		palette[2][3] = 255;
+		palette[3][3] = 255;
+	}
+	else
+	{
+		for (int component = 0; component < 3; ++component)
+		{
+			palette[2][component] = (palette[0][component] + palette[1][component]) / 2;
+			palette[3][component] = 0;
+		}
+		palette[2][3] = 255;
+		palette[3][3] = 0;
+	}
+}
+
+// BC1 block, also the color half of BC3 blocks
+static void EncodeColorBlock(const float pixels[16][4], unsigned char* destination)
+{
+	float startEndpoint[4];
+	float endEndpoint[4];
+	ComputeEndpoints(pixels, 3, startEndpoint, endEndpoint);
+
+	unsigned short color0 = PackColor565(startEndpoint);
+	unsigned short color1 = PackColor565(endEndpoint);
+
+	// color0 > color1 selects the four color mode
+	if (color0 < color1)
+	{
+		const unsigned short temporaryColor = color0;
+		color0 = color1;
+		color1 = temporaryColor;
+	}
+
+	unsigned int indices = 0;
+	if (color0 != color1)
+	{
+		int palette[4][4];
+		BuildColorPalette(color0, color1, true, palette);
+		for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+		{
+			indices |= (unsigned int)FindNearestPaletteIndex(pixels[pixelIndex], palette, 4, 3) << (2 * pixelIndex);
+		}
+	}
+
+	destination[0] = (unsigned char)(color0 & 0xFF);
+	destination[1] = (unsigned char)(color0 >> 8);
+	destination[2] = (unsigned char)(color1 & 0xFF);
+	destination[3] = (unsigned char)(color1 >> 8);
+	for (int byteIndex = 0; byteIndex < 4; ++byteIndex)
+	{
+		destination[4 + byteIndex] = (unsigned char)((indices >> (8 * byteIndex)) & 0xFF);
+	}
+}
+
+static void DecodeColorBlock(const unsigned char* source, bool isAlwaysFourColors, int pixels[16][4])
+{
+	const unsigned short color0 = (unsigned short)(source[0] | (source[1] << 8));
+	const unsigned short color1 = (unsigned short)(source[2] | (source[3] << 8));
+	const unsigned int indices = source[4] | (source[5] << 8) | (source[6] << 16) | ((unsigned int)source[7] << 24);
+
+	int palette[4][4];
+	BuildColorPalette(color0, color1, isAlwaysFourColors, palette);
+
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		const int* color = palette[(indices >> (2 * pixelIndex)) & 3];
+		pixels[pixelIndex][0] = color[0];
+		pixels[pixelIndex][1] = color[1];
+		pixels[pixelIndex][2] = color[2];
+		pixels[pixelIndex][3] = color[3];
+	}
+}
+
+static void BuildSingleChannelPalette(int endpoint0, int endpoint1, int palette[8][4])
+{
+	palette[0][0] = endpoint0;
+	palette[1][0] = endpoint1;
+
+	if (endpoint1 < endpoint0)
+	{
+		for (int index = 1; index < 7; ++index)
+		{
+			palette[index + 1][0] = ((7 - index) * endpoint0 + index * endpoint1) / 7;
+		}
+	}
+	else
+	{
+		for (int index = 1; index < 5; ++index)
+		{
+			palette[index + 1][0] = ((5 - index) * endpoint0 + index * endpoint1) / 5;
+		}
+		palette[6][0] = 0;
+		palette[7][0] = 255;
+	}
+}
+
+// BC4 block, the alpha half of BC3 blocks and both halves of BC5 blocks
+static void EncodeSingleChannelBlock(const float pixels[16][4], int component, unsigned char* destination)
+{
+	float minValue = 255.f;
+	float maxValue = 0.f;
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		const float value = pixels[pixelIndex][component];
+		minValue = value < minValue ? value : minValue;
+		maxValue = maxValue < value ? value : maxValue;
+	}
+
+	// endpoint0 > endpoint1 selects the eight value mode
+	const int endpoint0 = (int)(maxValue + 0.5f);
+	const int endpoint1 = (int)(minValue + 0.5f);
+
+	unsigned long long indices = 0;
+	if (endpoint0 != endpoint1)
+	{
+		int palette[8][4];
+		BuildSingleChannelPalette(endpoint0, endpoint1, palette);
+		for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+		{
+			const float value[4] = { pixels[pixelIndex][component], 0.f, 0.f, 0.f };
+			indices |= (unsigned long long)FindNearestPaletteIndex(value, palette, 8, 1) << (3 * pixelIndex);
+		}
+	}
+
+	destination[0] = (unsigned char)endpoint0;
+	destination[1] = (unsigned char)endpoint1;
+	for (int byteIndex = 0; byteIndex < 6; ++byteIndex)
+	{
+		destination[2 + byteIndex] = (unsigned char)((indices >> (8 * byteIndex)) & 0xFF);
+	}
+}
+
+static void DecodeSingleChannelBlock(const unsigned char* source, int component, int pixels[16][4])
+{
+	int palette[8][4];
+	BuildSingleChannelPalette(source[0], source[1], palette);
+
+	unsigned long long indices = 0;
+	for (int byteIndex = 0; byteIndex < 6; ++byteIndex)
+	{
+		indices |= (unsigned long long)source[2 + byteIndex] << (8 * byteIndex);
+	}
+
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		pixels[pixelIndex][component] = palette[(indices >> (3 * pixelIndex)) & 7][0];
+	}
+}
+
+// Picks the parity bit that is shared by the components of a 7 bit BC7 mode 6 endpoint
+static void QuantizeBC7Endpoint(const float endpoint[4], int quantizedEndpoint[4], int& parityBit)
+{
+	float bestError = FLT_MAX;
+	for (int candidateParityBit = 0; candidateParityBit < 2; ++candidateParityBit)
+	{
+		int candidateEndpoint[4];
+		float error = 0.f;
+		for (int component = 0; component < 4; ++component)
+		{
+			int quantizedValue = (int)((endpoint[component] - candidateParityBit) * 0.5f + 0.5f);
+			quantizedValue = quantizedValue < 0 ? 0 : (127 < quantizedValue ? 127 : quantizedValue);
+			candidateEndpoint[component] = quantizedValue;
+
+			const float difference = (float)((quantizedValue << 1) | candidateParityBit) - endpoint[component];
+			error += difference * difference;
+		}
+
+		if (error < bestError)
+		{
+			bestError = error;
+			parityBit = candidateParityBit;
+			std::memcpy(quantizedEndpoint, candidateEndpoint, sizeof(candidateEndpoint));
+		}
+	}
+}
+
+static void BuildBC7Palette(const int endpoint0[4], const int endpoint1[4], int palette[16][4])
+{
+	for (int index = 0; index < 16; ++index)
+	{
+		const int weight = BC7_INDEX_WEIGHTS[index];
+		for (int component = 0; component < 4; ++component)
+		{
+			palette[index][component] = ((64 - weight) * endpoint0[component] + weight * endpoint1[component] + 32) >> 6;
+		}
+	}
+}
+
+static void WriteBits(unsigned long long bits[2], int& bitPosition, unsigned int value, int bitCount)
+{
+	for (int bitIndex = 0; bitIndex < bitCount; ++bitIndex, ++bitPosition)
+	{
+		if ((value >> bitIndex) & 1)
+		{
+			bits[bitPosition >> 6] |= 1ull << (bitPosition & 63);
+		}
+	}
+}
+
+static unsigned int ReadBits(const unsigned long long bits[2], int& bitPosition, int bitCount)
+{
+	unsigned int value = 0;
+	for (int bitIndex = 0; bitIndex < bitCount; ++bitIndex, ++bitPosition)
+	{
+		value |= (unsigned int)((bits[bitPosition >> 6] >> (bitPosition & 63)) & 1) << bitIndex;
+	}
+	return value;
+}
+
+// Mode 6: a single subset with 7 bit RGBA endpoints, a parity bit per endpoint and 4 bit indices
+static void EncodeBC7Block(const float pixels[16][4], unsigned char* destination)
+{
+	float startEndpoint[4];
+	float endEndpoint[4];
+	ComputeEndpoints(pixels, 4, startEndpoint, endEndpoint);
+
+	int quantizedEndpoints[2][4];
+	int parityBits[2];
+	QuantizeBC7Endpoint(startEndpoint, quantizedEndpoints[0], parityBits[0]);
+	QuantizeBC7Endpoint(endEndpoint, quantizedEndpoints[1], parityBits[1]);
+
+	int endpoints[2][4];
+	for (int component = 0; component < 4; ++component)
+	{
+		endpoints[0][component] = (quantizedEndpoints[0][component] << 1) | parityBits[0];
+		endpoints[1][component] = (quantizedEndpoints[1][component] << 1) | parityBits[1];
+	}
+
+	int palette[16][4];
+	BuildBC7Palette(endpoints[0], endpoints[1], palette);
+
+	int indices[16];
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		indices[pixelIndex] = FindNearestPaletteIndex(pixels[pixelIndex], palette, 16, 4);
+	}
+
+	// Most significant bit of the first index is implicitly zero, endpoints are swapped to keep it so
+	const bool isSwapped = 8 <= indices[0];
+
+	unsigned long long bits[2] = { 0, 0 };
+	int bitPosition = 0;
+	WriteBits(bits, bitPosition, 1 << 6, 7);
+	for (int component = 0; component < 4; ++component)
+	{
+		WriteBits(bits, bitPosition, quantizedEndpoints[isSwapped ? 1 : 0][component], 7);
+		WriteBits(bits, bitPosition, quantizedEndpoints[isSwapped ? 0 : 1][component], 7);
+	}
+	WriteBits(bits, bitPosition, parityBits[isSwapped ? 1 : 0], 1);
+	WriteBits(bits, bitPosition, parityBits[isSwapped ? 0 : 1], 1);
+
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		const int index = isSwapped ? 15 - indices[pixelIndex] : indices[pixelIndex];
+		WriteBits(bits, bitPosition, index, pixelIndex == 0 ? 3 : 4);
+	}
+
+	for (int byteIndex = 0; byteIndex < 16; ++byteIndex)
+	{
+		destination[byteIndex] = (unsigned char)((bits[byteIndex >> 3] >> (8 * (byteIndex & 7))) & 0xFF);
+	}
+}
+
+// Only mode 6 blocks are decoded, which are the only ones written by EncodeBC7Block
+static bool DecodeBC7Block(const unsigned char* source, int pixels[16][4])
+{
+	unsigned long long bits[2] = { 0, 0 };
+	for (int byteIndex = 0; byteIndex < 16; ++byteIndex)
+	{
+		bits[byteIndex >> 3] |= (unsigned long long)source[byteIndex] << (8 * (byteIndex & 7));
+	}
+
+	int bitPosition = 0;
+	if (ReadBits(bits, bitPosition, 7) != 1 << 6)
+	{
+		std::memset(pixels, 0, sizeof(int) * 16 * 4);
+		return false;
+	}
+
+	int endpoints[2][4];
+	for (int component = 0; component < 4; ++component)
+	{
+		endpoints[0][component] = ReadBits(bits, bitPosition, 7) << 1;
+		endpoints[1][component] = ReadBits(bits, bitPosition, 7) << 1;
+	}
+
+	const int parityBit0 = ReadBits(bits, bitPosition, 1);
+	const int parityBit1 = ReadBits(bits, bitPosition, 1);
+	for (int component = 0; component < 4; ++component)
+	{
+		endpoints[0][component] |= parityBit0;
+		endpoints[1][component] |= parityBit1;
+	}
+
+	int palette[16][4];
+	BuildBC7Palette(endpoints[0], endpoints[1], palette);
+
+	for (int pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		const int* color = palette[ReadBits(bits, bitPosition, pixelIndex == 0 ? 3 : 4)];
+		std::memcpy(pixels[pixelIndex], color, sizeof(int) * 4);
+	}
+	return true;
+}
+
+int TextureCompression::GetBlockByteSize(TextureCompressionFormat compressionFormat)
+{
+	switch (compressionFormat)
+	{
+	case TextureCompressionFormat::BC1:
+		return 8;
+	case TextureCompressionFormat::BC3:
+	case TextureCompressionFormat::BC5:
+	case TextureCompressionFormat::BC7:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+unsigned long long TextureCompression::GetCompressedByteSize(TextureCompressionFormat compressionFormat, int width, int height)
+{
+	return (unsigned long long)((width + 3) / 4) * ((height + 3) / 4) * GetBlockByteSize(compressionFormat);
+}
+
+int TextureCompression::GetChannelCount(TextureCompressionFormat compressionFormat)
+{
+	switch (compressionFormat)
+	{
+	case TextureCompressionFormat::BC1:
+		return 3;
+	case TextureCompressionFormat::BC5:
+		return 2;
+	default:
+		return 4;
+	}
+}
+
+TextureInternalFormat TextureCompression::GetTextureInternalFormat(TextureCompressionFormat compressionFormat)
+{
+	switch (compressionFormat)
+	{
+	case TextureCompressionFormat::BC1:
+		return TextureInternalFormat::COMPRESSED_RGB_BC1;
+	case TextureCompressionFormat::BC3:
+		return TextureInternalFormat::COMPRESSED_RGBA_BC3;
+	case TextureCompressionFormat::BC5:
+		return TextureInternalFormat::COMPRESSED_RG_BC5;
+	case TextureCompressionFormat::BC7:
+		return TextureInternalFormat::COMPRESSED_RGBA_BC7;
+	default:
+		return TextureInternalFormat::RGBA;
+	}
+}
+
+bool TextureCompression::GetIsFormatSupported(TextureCompressionFormat compressionFormat)
+{
+	switch (compressionFormat)
+	{
+	case TextureCompressionFormat::None:
+		return true;
+	case TextureCompressionFormat::BC1:
+	case TextureCompressionFormat::BC3:
+	{
+		static const bool isS3TCSupported = RendererUtils::GetIsExtensionSupported("GL_EXT_texture_compression_s3tc");
+		return isS3TCSupported;
+	}
+	case TextureCompressionFormat::BC5:
+		// RGTC is core since OpenGL 3.0
+		return GLAD_GL_VERSION_3_0 != 0;
+	case TextureCompressionFormat::BC7:
+	{
+		// BPTC is core since OpenGL 4.2
+		static const bool isBPTCSupported = GLAD_GL_VERSION_4_2 != 0 || RendererUtils::GetIsExtensionSupported("GL_ARB_texture_compression_bptc");
+		return isBPTCSupported;
+	}
+	default:
+		return false;
+	}
+}
+
+void TextureCompression::Compress(TextureCompressionFormat compressionFormat, const unsigned char* source, int width, int height, int channels, unsigned char* destination)
+{
+	const int blockCountX = (width + 3) / 4;
+	const int blockCountY = (height + 3) / 4;
+	const int blockByteSize = GetBlockByteSize(compressionFormat);
+
+	engine->GetJobManager()->ParallelFor(blockCountY, TEXTURE_COMPRESSION_BLOCK_ROW_BATCH_SIZE,
+		[&](int beginBlockY, int endBlockY)
+		{
+			float pixels[16][4];
+			for (int blockY = beginBlockY; blockY < endBlockY; ++blockY)
+			{
+				for (int blockX = 0; blockX < blockCountX; ++blockX)
+				{
+					LoadBlock(source, width, height, channels, blockX, blockY, pixels);
+
+					unsigned char* block = destination + ((size_t)blockY * blockCountX + blockX) * blockByteSize;
+					switch (compressionFormat)
+					{
+					case TextureCompressionFormat::BC1:
+						EncodeColorBlock(pixels, block);
+						break;
+					case TextureCompressionFormat::BC3:
+						EncodeSingleChannelBlock(pixels, 3, block);
+						EncodeColorBlock(pixels, block + 8);
+						break;
+					case TextureCompressionFormat::BC5:
+						EncodeSingleChannelBlock(pixels, 0, block);
+						EncodeSingleChannelBlock(pixels, 1, block + 8);
+						break;
+					case TextureCompressionFormat::BC7:
+						EncodeBC7Block(pixels, block);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		});
+}
+
+void TextureCompression::Decompress(TextureCompressionFormat compressionFormat, const unsigned char* source, int width, int height, unsigned char* destination)
+{
+	const int blockCountX = (width + 3) / 4;
+	const int blockCountY = (height + 3) / 4;
+	const int blockByteSize = GetBlockByteSize(compressionFormat);
+	const int channels = GetChannelCount(compressionFormat);
+
+	std::atomic<bool> hasUnsupportedBlocks{ false };
+	engine->GetJobManager()->ParallelFor(blockCountY, TEXTURE_COMPRESSION_BLOCK_ROW_BATCH_SIZE,
+		[&](int beginBlockY, int endBlockY)
+		{
+			int pixels[16][4];
+			for (int blockY = beginBlockY; blockY < endBlockY; ++blockY)
+			{
+				for (int blockX = 0; blockX < blockCountX; ++blockX)
+				{
+					const unsigned char* block = source + ((size_t)blockY * blockCountX + blockX) * blockByteSize;
+					switch (compressionFormat)
+					{
+					case TextureCompressionFormat::BC1:
+						DecodeColorBlock(block, false, pixels);
+						break;
+					case TextureCompressionFormat::BC3:
+						DecodeColorBlock(block + 8, true, pixels);
+						DecodeSingleChannelBlock(block, 3, pixels);
+						break;
+					case TextureCompressionFormat::BC5:
+						DecodeSingleChannelBlock(block, 0, pixels);
+						DecodeSingleChannelBlock(block + 8, 1, pixels);
+						break;
+					case TextureCompressionFormat::BC7:
+						if (!DecodeBC7Block(block, pixels))
+						{
+							hasUnsupportedBlocks = true;
+						}
+						break;
+					default:
+						break;
+					}
+
+					StoreBlock(pixels, width, height, channels, blockX, blockY, destination);
+				}
+			}
+		});
+
+	if (hasUnsupportedBlocks)
+	{
+		GOKNAR_CORE_WARN("BC7 blocks of a mode other than 6 cannot be decompressed and are left black.");
+	}
+}
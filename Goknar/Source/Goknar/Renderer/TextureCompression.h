@@ -0,0 +1,32 @@
+#ifndef __TEXTURECOMPRESSION_H__
+#define __TEXTURECOMPRESSION_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Renderer/Texture.h"
+
+// Block compression of 8 bit images into the BC1, BC3, BC5 and BC7 GPU formats and their decompression
+// Encoders favor speed over quality(range fit along the principal axis of each block), BC7 blocks are encoded with mode 6 only
+class GOKNAR_API TextureCompression
+{
+public:
+	TextureCompression() = delete;
+
+	static int GetBlockByteSize(TextureCompressionFormat compressionFormat);
+	static unsigned long long GetCompressedByteSize(TextureCompressionFormat compressionFormat, int width, int height);
+
+	// Channel count of the decompressed images
+	static int GetChannelCount(TextureCompressionFormat compressionFormat);
+
+	static TextureInternalFormat GetTextureInternalFormat(TextureCompressionFormat compressionFormat);
+
+	// Queries the GL context, must be called on the main thread
+	static bool GetIsFormatSupported(TextureCompressionFormat compressionFormat);
+
+	// Rows of blocks are encoded in parallel on the job manager, source images can have 1 to 4 channels
+	static void Compress(TextureCompressionFormat compressionFormat, const unsigned char* source, int width, int height, int channels, unsigned char* destination);
+
+	// Destination holds width * height * GetChannelCount(compressionFormat) bytes
+	static void Decompress(TextureCompressionFormat compressionFormat, const unsigned char* source, int width, int height, unsigned char* destination);
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include "pch.h"
+
+#include "TexturePacker.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+#include "Goknar/Application.h"
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Engine.h"
+#include "Goknar/Log.h"
+#include "Goknar/Renderer/Texture.h"
+#include "Goknar/Renderer/TextureAtlas.h"
+#include "Goknar/Scene.h"
+
+// Usage and channels
+using TexturePackingGroupKey = std::tuple<int, int>;
+
+// Usage, channels, whether the image repeats and the image size
+using TextureArrayGroupKey = std::tuple<int, int, bool, int, int>;
+
+static void InitializePackedTexture(Texture* texture)
+{
+	texture->PreInit();
+	engine->GetApplication()->GetMainScene()->AddTexture(texture);
+}
+
+static std::string GetNormalizedPath(const std::filesystem::path& path)
+{
+	return path.lexically_normal().generic_string();
+}
+
+bool PrebuiltTextureAtlases::LoadManifest(const std::string& manifestPath)
+{
+	std::ifstream manifest(manifestPath);
+	if (!manifest.is_open())
+	{
+		GOKNAR_CORE_WARN("Atlas manifest {} could not be opened.", manifestPath);
+		return false;
+	}
+
+	const std::filesystem::path manifestDirectory = std::filesystem::path(manifestPath).parent_path();
+
+	int atlasIndex = -1;
+	int imageCount = 0;
+	std::string line;
+	while (std::getline(manifest, line))
+	{
+		std::istringstream lineStream(line);
+		std::string type;
+		lineStream >> type;
+
+		if (type == "atlas")
+		{
+			int width = 0;
+			int height = 0;
+			std::string atlasFile;
+			lineStream >> width >> height >> std::ws;
+			std::getline(lineStream, atlasFile);
+			if (0 < width && 0 < height && !atlasFile.empty())
+			{
+				Atlas atlas;
+				atlas.path = GetNormalizedPath(manifestDirectory / atlasFile);
+				atlasIndex = (int)atlases_.size();
+				atlases_.push_back(atlas);
+				continue;
+			}
+		}
+		else if (type == "image" && 0 <= atlasIndex)
+		{
+			AtlasImage atlasImage;
+			atlasImage.atlasIndex = atlasIndex;
+			std::string imageFile;
+			lineStream >> atlasImage.width >> atlasImage.height >> atlasImage.uvTransform.x >> atlasImage.uvTransform.y >> atlasImage.uvTransform.z >> atlasImage.uvTransform.w;
+			const bool isImageRead = !lineStream.fail();
+			std::getline(lineStream >> std::ws, imageFile);
+			if (isImageRead && !imageFile.empty())
+			{
+				images_[GetNormalizedPath(manifestDirectory / imageFile)] = atlasImage;
+				++imageCount;
+				continue;
+			}
+		}
+		else if (type.empty())
+		{
+			continue;
+		}
+
+		GOKNAR_CORE_WARN("Atlas manifest {} has an invalid line: {}", manifestPath, line);
+	}
+
+	GOKNAR_CORE_INFO("Atlas manifest {} lists {} images.", manifestPath, imageCount);
+	return true;
+}
+
+bool PrebuiltTextureAtlases::PackImage(Image* image)
+{
+	std::unordered_map<std::string, AtlasImage>::const_iterator imageIterator = images_.find(GetNormalizedPath(image->GetPath()));
+	if (imageIterator == images_.end())
+	{
+		return false;
+	}
+
+	const AtlasImage& atlasImage = imageIterator->second;
+	if (atlasImage.width != image->GetWidth() || atlasImage.height != image->GetHeight())
+	{
+		GOKNAR_CORE_WARN("Image {} changed since its atlas was packed, it is packed at runtime.", image->GetPath());
+		return false;
+	}
+
+	Atlas& atlas = atlases_[atlasImage.atlasIndex];
+	Texture*& texture = atlas.usageTextures[(int)image->GetTextureUsage()];
+	if (!texture)
+	{
+		texture = new Texture();
+		texture->SetTextureImagePathAbsolute(atlas.path);
+		texture->SetTextureUsage(image->GetTextureUsage());
+		texture->SetTextureWrappingS(TextureWrapping::CLAMP_TO_EDGE);
+		texture->SetTextureWrappingT(TextureWrapping::CLAMP_TO_EDGE);
+		texture->SetMaxMipLevel(TEXTURE_ATLAS_MAX_MIP_LEVEL);
+		texture->SetPackingType(TexturePackingType::Atlas);
+		InitializePackedTexture(texture);
+	}
+
+	TextureAtlasRegion atlasRegion;
+	atlasRegion.uvTransform = atlasImage.uvTransform;
+	image->SetPackedTexture(texture, atlasRegion);
+
+	return true;
+}
+
+void TexturePacker::PackIntoAtlases(std::vector<Image*> images, int atlasSize, int channels, std::vector<TextureAtlas*>& atlases)
+{
+	std::stable_sort(images.begin(), images.end(),
+		[](const Image* first, const Image* second)
+		{
+			return second->GetHeight() < first->GetHeight() || (first->GetHeight() == second->GetHeight() && second->GetWidth() < first->GetWidth());
+		});
+
+	for (Image* image : images)
+	{
+		bool isPacked = false;
+		for (TextureAtlas* atlas : atlases)
+		{
+			if (atlas->AddImage(image))
+			{
+				isPacked = true;
+				break;
+			}
+		}
+
+		if (!isPacked)
+		{
+			TextureAtlas* atlas = new TextureAtlas(atlasSize, atlasSize, channels);
+			if (atlas->AddImage(image))
+			{
+				atlases.push_back(atlas);
+			}
+			else
+			{
+				GOKNAR_CORE_WARN("Image {} is too large for a {}x{} atlas.", image->GetPath(), atlasSize, atlasSize);
+				delete atlas;
+			}
+		}
+	}
+}
+
+void TexturePacker::PackImages(const std::vector<Image*>& images, PrebuiltTextureAtlases* prebuiltAtlases/* = nullptr*/)
+{
+	std::map<TexturePackingGroupKey, std::vector<Image*>> atlasGroups;
+	std::map<TextureArrayGroupKey, std::vector<Image*>> arrayGroups;
+
+	int prebuiltImageCount = 0;
+
+	for (Image* image : images)
+	{
+		if (!image->GetBuffer() || image->GetAtlasRegion() || image->GetGeneratedTexture() || image->GetCompressionFormat() != TextureCompressionFormat::None)
+		{
+			continue;
+		}
+
+		// Mirroring and mixed wrapping modes are not supported
+		const TextureWrapping wrappingS = image->GetTextureWrappingS();
+		const TextureWrapping wrappingT = image->GetTextureWrappingT();
+		const bool isRepeating = wrappingS == TextureWrapping::REPEAT;
+		if (wrappingS == TextureWrapping::MIRRORED_REPEAT || wrappingT == TextureWrapping::MIRRORED_REPEAT || isRepeating != (wrappingT == TextureWrapping::REPEAT))
+		{
+			continue;
+		}
+
+		// Prebuilt atlases are clamped like the ones packed at runtime
+		if (!isRepeating && prebuiltAtlases && prebuiltAtlases->PackImage(image))
+		{
+			++prebuiltImageCount;
+			continue;
+		}
+
+		const int imageChannels = image->GetChannels();
+		const int channels = imageChannels == 2 || imageChannels == 4 ? 4 : 3;
+
+		const int width = image->GetWidth();
+		const int height = image->GetHeight();
+		// Repeating an atlas region in the shader breaks the UV derivatives at every wrap and the seams sample the coarsest mip level,
+		// so repeating images are only packed into array textures, which the sampler repeats
+		if (!isRepeating && width <= TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE && height <= TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE)
+		{
+			atlasGroups[TexturePackingGroupKey((int)image->GetTextureUsage(), channels)].push_back(image);
+		}
+		else if (image->GetMipmapBuffers().empty())
+		{
+			arrayGroups[TextureArrayGroupKey((int)image->GetTextureUsage(), channels, isRepeating, width, height)].push_back(image);
+		}
+	}
+
+	int packedImageCount = 0;
+	int atlasCount = 0;
+	int arrayCount = 0;
+
+	for (const std::pair<const TexturePackingGroupKey, std::vector<Image*>>& atlasGroup : atlasGroups)
+	{
+		if (atlasGroup.second.size() < 2)
+		{
+			continue;
+		}
+
+		std::vector<TextureAtlas*> atlases;
+		PackIntoAtlases(atlasGroup.second, TEXTURE_PACKER_ATLAS_SIZE, std::get<1>(atlasGroup.first), atlases);
+
+		for (TextureAtlas* atlas : atlases)
+		{
+			const int imageCount = atlas->GetImageCount();
+			if (2 <= imageCount)
+			{
+				Texture* texture = atlas->CreateTexture();
+				InitializePackedTexture(texture);
+
+				for (int imageIndex = 0; imageIndex < imageCount; ++imageIndex)
+				{
+					atlas->GetImage(imageIndex)->SetPackedTexture(texture, atlas->GetRegion(imageIndex));
+				}
+
+				packedImageCount += imageCount;
+				++atlasCount;
+			}
+
+			delete atlas;
+		}
+	}
+
+	for (const std::pair<const TextureArrayGroupKey, std::vector<Image*>>& arrayGroup : arrayGroups)
+	{
+		const std::vector<Image*>& groupImages = arrayGroup.second;
+		for (int firstImageIndex = 0; firstImageIndex + 1 < (int)groupImages.size(); firstImageIndex += TEXTURE_PACKER_MAX_ARRAY_LAYER_COUNT)
+		{
+			TextureArray textureArray(std::get<3>(arrayGroup.first), std::get<4>(arrayGroup.first), std::get<1>(arrayGroup.first), TEXTURE_PACKER_MAX_ARRAY_LAYER_COUNT);
+			const int lastImageIndex = std::min(firstImageIndex + TEXTURE_PACKER_MAX_ARRAY_LAYER_COUNT, (int)groupImages.size());
+			for (int imageIndex = firstImageIndex; imageIndex < lastImageIndex; ++imageIndex)
+			{
+				textureArray.AddImage(groupImages[imageIndex]);
+			}
+
+			const int layerCount = textureArray.GetLayerCount();
+			if (layerCount < 2)
+			{
+				continue;
+			}
+
+			Texture* texture = textureArray.CreateTexture();
+			InitializePackedTexture(texture);
+
+			for (int layer = 0; layer < layerCount; ++layer)
+			{
+				TextureAtlasRegion atlasRegion;
+				atlasRegion.layer = layer;
+				textureArray.GetImage(layer)->SetPackedTexture(texture, atlasRegion);
+			}
+
+			packedImageCount += layerCount;
+			++arrayCount;
+		}
+	}
+
+	if (0 < packedImageCount || 0 < prebuiltImageCount)
+	{
+		GOKNAR_CORE_INFO("{} images are packed into {} atlases and {} array textures, {} images are drawn from prebuilt atlases.", packedImageCount, atlasCount, arrayCount, prebuiltImageCount);
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef __TEXTUREPACKER_H__
+#define __TEXTUREPACKER_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Math/GoknarMath.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Image;
+class Texture;
+class TextureAtlas;
+
+// Extension of the atlas manifests written by GoknarAtlasPacker
+#define TEXTURE_ATLAS_MANIFEST_EXTENSION "gkatlas"
+
+constexpr int TEXTURE_PACKER_ATLAS_SIZE = 2048;
+
+// Clamped images with both dimensions up to this size are packed into atlases, larger and repeating ones of the same size into array textures
+constexpr int TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE = 256;
+
+// Minimum of GL_MAX_ARRAY_TEXTURE_LAYERS in OpenGL 3.0
+constexpr int TEXTURE_PACKER_MAX_ARRAY_LAYER_COUNT = 256;
+
+// Atlases packed offline by GoknarAtlasPacker, images listed in their manifests are drawn from them instead of being packed at runtime
+// Manifest lines, paths are relative to the manifest:
+//	atlas <width> <height> <atlas file>
+//	image <width> <height> <scale u> <scale v> <offset u> <offset v> <image file>, for every image of the last atlas
+class GOKNAR_API PrebuiltTextureAtlases
+{
+public:
+	PrebuiltTextureAtlases() = default;
+	~PrebuiltTextureAtlases() = default;
+
+	bool LoadManifest(const std::string& manifestPath);
+
+	// Draws the image from the atlas listing it, false if no atlas lists it or the image changed since the atlas was packed
+	// Atlas textures are loaded on first use, one for every texture usage of their images
+	bool PackImage(Image* image);
+
+	int GetImageCount() const
+	{
+		return (int)images_.size();
+	}
+
+private:
+	struct Atlas
+	{
+		std::string path;
+		std::map<int, Texture*> usageTextures;
+	};
+
+	struct AtlasImage
+	{
+		Vector4 uvTransform{ 1.f, 1.f, 0.f, 0.f };
+		int atlasIndex{ 0 };
+		int width{ 0 };
+		int height{ 0 };
+	};
+
+	std::vector<Atlas> atlases_;
+	// Keys are the normalized image paths
+	std::unordered_map<std::string, AtlasImage> images_;
+};
+
+// Packs images into shared textures instead of generating a texture for every image
+class GOKNAR_API TexturePacker
+{
+public:
+	TexturePacker() = delete;
+
+	// Tallest images are packed first, a new atlas is started when an image does not fit into the previous ones
+	static void PackIntoAtlases(std::vector<Image*> images, int atlasSize, int channels, std::vector<TextureAtlas*>& atlases);
+
+	// Groups the images by their usage, channels and wrapping, packs the groups and initializes the shared textures
+	// Compressed images, images with precomputed mip levels that are too large for the atlases and single images of a group keep their own textures
+	// Must be called on the main thread before the images are initialized, the resource manager packs the images loaded asynchronously in batches
+	// Images found in the prebuilt atlases are drawn from them, the others are packed at runtime
+	static void PackImages(const std::vector<Image*>& images, PrebuiltTextureAtlases* prebuiltAtlases = nullptr);
+};
+
+#endif
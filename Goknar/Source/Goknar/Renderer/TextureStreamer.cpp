@@ -0,0 +1,220 @@
+#include "pch.h"
+
+#include "TextureStreamer.h"
+
+#include <cstring>
+
+#include "Goknar/GoknarAssert.h"
+#include "Goknar/Log.h"
+#include "Goknar/Renderer/Texture.h"
+
+TextureStreamer::TextureStreamer()
+{
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	DestroyStagingBuffer();
+}
+
+void TextureStreamer::AddTexture(Texture* texture)
+{
+	textures_.push_back(texture);
+
+	// Rows are never split, so a staging buffer whose segments cannot fit a row of the texture is created again with a larger size
+	const unsigned int rowSize = texture->GetMipLevelWidth(0) * texture->channels_;
+	if (maxRowSize_ < rowSize)
+	{
+		maxRowSize_ = rowSize;
+
+		if (stagingBufferId_ != 0 && stagingBufferSize_ / TEXTURE_STREAMER_SEGMENT_COUNT < maxRowSize_)
+		{
+			DestroyStagingBuffer();
+		}
+	}
+}
+
+void TextureStreamer::RemoveTexture(Texture* texture)
+{
+	std::vector<Texture*>::iterator textureIterator = std::find(textures_.begin(), textures_.end(), texture);
+	if (textureIterator != textures_.end())
+	{
+		textures_.erase(textureIterator);
+	}
+
+	if (uploadingTexture_ == texture)
+	{
+		uploadingTexture_ = nullptr;
+		uploadedRowCount_ = 0;
+	}
+}
+
+void TextureStreamer::CreateStagingBuffer()
+{
+	if (stagingBufferSize_ / TEXTURE_STREAMER_SEGMENT_COUNT < maxRowSize_)
+	{
+		stagingBufferSize_ = maxRowSize_ * TEXTURE_STREAMER_SEGMENT_COUNT;
+	}
+
+	const GEbitfield stagingBufferFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glGenBuffers(1, &stagingBufferId_);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBufferId_);
+	glBufferStorage(GL_PIXEL_UNPACK_BUFFER, stagingBufferSize_, nullptr, stagingBufferFlags);
+	mappedStagingBuffer_ = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, stagingBufferSize_, stagingBufferFlags);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	if (!mappedStagingBuffer_)
+	{
+		GOKNAR_CORE_ERROR("Texture streaming staging buffer could not be mapped.");
+	}
+}
+
+// Uploads in flight keep reading from the buffer since the driver deletes it once they are finished
+void TextureStreamer::DestroyStagingBuffer()
+{
+	for (GLsync& segmentFence : segmentFences_)
+	{
+		if (segmentFence)
+		{
+			glDeleteSync(segmentFence);
+			segmentFence = nullptr;
+		}
+	}
+
+	if (stagingBufferId_ != 0)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBufferId_);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		glDeleteBuffers(1, &stagingBufferId_);
+		stagingBufferId_ = 0;
+	}
+
+	mappedStagingBuffer_ = nullptr;
+	currentSegmentIndex_ = 0;
+}
+
+void TextureStreamer::Update()
+{
+	if (textures_.empty())
+	{
+		return;
+	}
+
+	const std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+	if (stagingBufferId_ == 0)
+	{
+		CreateStagingBuffer();
+	}
+
+	GLsync& segmentFence = segmentFences_[currentSegmentIndex_];
+	bool canUpload = mappedStagingBuffer_ != nullptr;
+	if (canUpload && segmentFence)
+	{
+		// Uploads are skipped this frame instead of stalling if the GPU still reads the segment
+		if (glClientWaitSync(segmentFence, 0, 0) == GL_TIMEOUT_EXPIRED)
+		{
+			canUpload = false;
+		}
+		else
+		{
+			glDeleteSync(segmentFence);
+			segmentFence = nullptr;
+		}
+	}
+
+	const unsigned int segmentSize = stagingBufferSize_ / TEXTURE_STREAMER_SEGMENT_COUNT;
+	const unsigned int segmentStartOffset = currentSegmentIndex_ * segmentSize;
+	const unsigned int segmentEndOffset = segmentStartOffset + segmentSize;
+	unsigned int segmentOffset = segmentStartOffset;
+
+	if (canUpload)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBufferId_);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		bool isSegmentFull = uploadingTexture_ && !UploadNextRows(uploadingTexture_, segmentEndOffset, segmentOffset);
+		for (Texture* texture : textures_)
+		{
+			if (isSegmentFull)
+			{
+				break;
+			}
+
+			if (texture->requestedMipLevel_ < texture->residentMipLevel_)
+			{
+				uploadingTexture_ = texture;
+				uploadedRowCount_ = 0;
+
+				isSegmentFull = !UploadNextRows(texture, segmentEndOffset, segmentOffset);
+			}
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (segmentOffset != segmentStartOffset)
+		{
+			segmentFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			currentSegmentIndex_ = (currentSegmentIndex_ + 1) % TEXTURE_STREAMER_SEGMENT_COUNT;
+		}
+	}
+
+	// Requests are made again every frame
+	for (Texture* texture : textures_)
+	{
+		texture->requestedMipLevel_ = texture->residentMipLevel_;
+	}
+
+	if (segmentOffset != segmentStartOffset)
+	{
+		uploadTime_ += std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - startTimePoint).count();
+	}
+}
+
+bool TextureStreamer::UploadNextRows(Texture* texture, unsigned int segmentEndOffset, unsigned int& segmentOffset)
+{
+	const int mipLevel = texture->residentMipLevel_ - 1;
+	const int mipLevelWidth = texture->GetMipLevelWidth(mipLevel);
+	const int mipLevelHeight = texture->GetMipLevelHeight(mipLevel);
+
+	const unsigned int rowSize = mipLevelWidth * texture->channels_;
+	const int fittingRowCount = (int)((segmentEndOffset - segmentOffset) / rowSize);
+	GOKNAR_CORE_ASSERT(rowSize <= stagingBufferSize_ / TEXTURE_STREAMER_SEGMENT_COUNT, "Staging buffer segments must fit a row of every streamed mip level");
+	const int rowCount = std::min(mipLevelHeight - uploadedRowCount_, fittingRowCount);
+	if (rowCount <= 0)
+	{
+		return false;
+	}
+
+	const unsigned int uploadSize = rowCount * rowSize;
+	memcpy(mappedStagingBuffer_ + segmentOffset, texture->mipLevelBuffers_[mipLevel] + uploadedRowCount_ * rowSize, uploadSize);
+
+	// Material textures are bound to their units once, so the texture is bound on its own unit and left bound like Texture::Bind does
+	glActiveTexture(GL_TEXTURE0 + texture->rendererTextureId_);
+	glBindTexture(GL_TEXTURE_2D, texture->rendererTextureId_);
+	glTexSubImage2D(GL_TEXTURE_2D, mipLevel, 0, uploadedRowCount_, mipLevelWidth, rowCount, (int)texture->textureFormat_, (int)texture->textureType_, (void*)(unsigned long long)segmentOffset);
+
+	segmentOffset += uploadSize;
+	uploadedByteCount_ += uploadSize;
+	uploadedRowCount_ += rowCount;
+
+	if (uploadedRowCount_ < mipLevelHeight)
+	{
+		return false;
+	}
+
+	// Level is complete, it is sampled from now on and its CPU copy is released
+	delete[] texture->mipLevelBuffers_[mipLevel];
+	texture->mipLevelBuffers_[mipLevel] = nullptr;
+
+	texture->residentMipLevel_ = mipLevel;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, mipLevel);
+
+	uploadingTexture_ = nullptr;
+	uploadedRowCount_ = 0;
+
+	return true;
+}
@@ -0,0 +1,92 @@
+#ifndef __TEXTURESTREAMER_H__
+#define __TEXTURESTREAMER_H__
+
+#include "Goknar/Core.h"
+#include "Goknar/Renderer/Types.h"
+
+#include "glad/glad.h"
+
+#include <vector>
+
+class Texture;
+
+// Number of frames that can have uploads in flight, each frame writes to its own segment of the staging buffer
+constexpr int TEXTURE_STREAMER_SEGMENT_COUNT = 3;
+
+// Uploads the precomputed mip levels of streamed textures through a persistently mapped pixel unpack buffer ring
+// Levels are uploaded coarse to fine as the renderer requests them, large levels are split into row chunks over multiple frames
+class GOKNAR_API TextureStreamer
+{
+public:
+	TextureStreamer();
+	~TextureStreamer();
+
+	void AddTexture(Texture* texture);
+	void RemoveTexture(Texture* texture);
+
+	// Uploads the requested mip levels without waiting for the GPU and resets the requests, called once per frame
+	void Update();
+
+	// Size of the staging buffer, every frame can upload up to stagingBufferSize / TEXTURE_STREAMER_SEGMENT_COUNT bytes
+	// Must be set before the first update, it is grown so that each segment fits a row of the largest mip level
+	void SetStagingBufferSize(unsigned int stagingBufferSize)
+	{
+		stagingBufferSize_ = stagingBufferSize;
+	}
+
+	unsigned int GetStagingBufferSize() const
+	{
+		return stagingBufferSize_;
+	}
+
+	int GetStreamedTextureCount() const
+	{
+		return (int)textures_.size();
+	}
+
+	unsigned long long GetUploadedByteCount() const
+	{
+		return uploadedByteCount_;
+	}
+
+	// Time spent on the CPU while copying to the staging buffer and issuing the uploads
+	float GetUploadTime() const
+	{
+		return uploadTime_;
+	}
+
+	// MB/s
+	float GetUploadRate() const
+	{
+		return 0.f < uploadTime_ ? uploadedByteCount_ / (uploadTime_ * 1000000.f) : 0.f;
+	}
+
+private:
+	void CreateStagingBuffer();
+	void DestroyStagingBuffer();
+
+	// Uploads the rows of the next mip level of the texture that fit in the segment, returns false if the segment is full
+	bool UploadNextRows(Texture* texture, unsigned int segmentEndOffset, unsigned int& segmentOffset);
+
+	std::vector<Texture*> textures_;
+
+	GLsync segmentFences_[TEXTURE_STREAMER_SEGMENT_COUNT]{};
+
+	unsigned char* mappedStagingBuffer_{ nullptr };
+	GEuint stagingBufferId_{ 0 };
+
+	unsigned int stagingBufferSize_{ 12 * 1024 * 1024 };
+
+	// Largest row size of the mip level 0 of the streamed textures
+	unsigned int maxRowSize_{ 0 };
+	int currentSegmentIndex_{ 0 };
+
+	// Rows of the next mip level uploaded so far, the texture being uploaded is always the first one needing a level
+	int uploadedRowCount_{ 0 };
+	Texture* uploadingTexture_{ nullptr };
+
+	unsigned long long uploadedByteCount_{ 0 };
+	float uploadTime_{ 0.f };
+};
+
+#endif
@@ -0,0 +1,11 @@
+#include "pch.h"
+
+#include "TickTypes.h"
+
+int TickThrottle::nextLoadSpreadBucket_ = 0;
+
+TickThrottle::TickThrottle() :
+	loadSpreadBucket_(nextLoadSpreadBucket_)
+{
+	nextLoadSpreadBucket_ = (nextLoadSpreadBucket_ + 1) % TICK_LOAD_SPREAD_BUCKET_COUNT;
+}
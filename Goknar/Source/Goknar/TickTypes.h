@@ -0,0 +1,104 @@
+#ifndef __TICKTYPES_H__
+#define __TICKTYPES_H__
+
+#include <vector>
+
+#include "Core.h"
+
+class Component;
+class ObjectBase;
+
+// Throttled entries are distributed round-robin to buckets which are spread over their tick interval
+// so that entries with the same interval do not tick on the same frame
+constexpr int TICK_LOAD_SPREAD_BUCKET_COUNT = 8;
+
+// Order of the groups is the order they are ticked in a frame
+enum class GOKNAR_API TickGroup : unsigned char
+{
+	// Before the physics step
+	PrePhysics = 0,
+	// Right after the physics step, before the application update, thread-safe entries run on the job system
+	DuringPhysics,
+	// After the physics step and the application update, default group
+	PostPhysics,
+	// After everything else including time dependent objects
+	PostUpdateWork,
+	Count
+};
+
+// Components in the same wave do not depend on each other
+// Wave n only depends on waves before it
+struct GOKNAR_API ComponentTickWave
+{
+	std::vector<Component*> parallelComponents;
+	std::vector<Component*> serialComponents;
+};
+
+// Hot arrays of a tick group, only contains initialized, active and tick enabled entries
+struct GOKNAR_API TickGroupData
+{
+	void Clear()
+	{
+		objects.clear();
+		componentWaves.clear();
+	}
+
+	std::vector<ObjectBase*> objects;
+	std::vector<ComponentTickWave> componentWaves;
+
+	// Duration of the last tick of the group in seconds
+	float lastTickDuration{ 0.f };
+};
+
+// Entries at least distance away from the active camera tick at most once per tickInterval seconds
+struct GOKNAR_API TickLODLevel
+{
+	float distance{ 0.f };
+	float tickInterval{ 0.f };
+};
+
+// Accumulates the delta time of a throttled tick entry between its ticks
+class GOKNAR_API TickThrottle
+{
+public:
+	TickThrottle();
+
+	// Returns true and the delta time accumulated since the last tick if the entry should tick this frame
+	bool Advance(float tickInterval, float deltaTime, float& outDeltaTime)
+	{
+		accumulatedDeltaTime_ += deltaTime;
+
+		if (tickInterval != tickInterval_)
+		{
+			tickInterval_ = tickInterval;
+			timeUntilNextTick_ = tickInterval * loadSpreadBucket_ / TICK_LOAD_SPREAD_BUCKET_COUNT;
+		}
+
+		timeUntilNextTick_ -= deltaTime;
+		if (0.f < timeUntilNextTick_)
+		{
+			return false;
+		}
+
+		timeUntilNextTick_ += tickInterval_;
+		if (timeUntilNextTick_ <= 0.f)
+		{
+			// Do not try to catch up after a long frame
+			timeUntilNextTick_ = tickInterval_;
+		}
+
+		outDeltaTime = accumulatedDeltaTime_;
+		accumulatedDeltaTime_ = 0.f;
+		return true;
+	}
+
+private:
+	float accumulatedDeltaTime_{ 0.f };
+	float timeUntilNextTick_{ 0.f };
+	float tickInterval_{ 0.f };
+	int loadSpreadBucket_{ 0 };
+
+	static int nextLoadSpreadBucket_;
+};
+
+#endif
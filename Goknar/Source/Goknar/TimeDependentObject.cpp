@@ -5,13 +5,21 @@
 #include "Application.h"
 #include "Engine.h"
 #include "Scene.h"
+#include "Managers/TimerManager.h"
 
-TimeDependentObject::TimeDependentObject()
+TimeDependentObject::TimeDependentObject(bool isTickedEveryFrame/* = true*/)
 {
-	engine->RegisterTimeDependentObject(this);
+	if (isTickedEveryFrame)
+	{
+		engine->GetTimerManager()->AddTimeDependentObject(this);
+	}
 }
 
 TimeDependentObject::~TimeDependentObject()
 {
-	engine->RemoveTimeDependentObject(this);
+	// Index is reset if the TimerManager is destroyed first
+	if (0 <= timeDependentObjectIndex_)
+	{
+		engine->GetTimerManager()->RemoveTimeDependentObject(this);
+	}
 }
\ No newline at end of file
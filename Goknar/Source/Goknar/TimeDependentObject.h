@@ -7,6 +7,8 @@
 
 class GOKNAR_API TimeDependentObject
 {
+	friend class TimerManager;
+
 public:
 	virtual ~TimeDependentObject();
 
@@ -23,9 +25,14 @@ public:
 	}
 
 protected:
-	TimeDependentObject();
+	// Objects that are not ticked every frame are responsible for their own scheduling(see Timer)
+	TimeDependentObject(bool isTickedEveryFrame = true);
 
 	bool isActive_{ true };
+
+private:
+	// Index in the TimerManager's dense array, -1 if not ticked every frame
+	int timeDependentObjectIndex_{ -1 };
 };
 
 #endif
\ No newline at end of file
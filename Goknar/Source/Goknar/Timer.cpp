@@ -2,26 +2,69 @@
 
 #include "Timer.h"
 
-Timer::Timer() : TimeDependentObject()
+#include "Engine.h"
+#include "Managers/TimerManager.h"
+
+Timer::Timer() : TimeDependentObject(false)
+{
+	engine->GetTimerManager()->ScheduleTimer(this, timeToRefreshTimeVariables_);
+}
+
+Timer::~Timer()
 {
+	// Timers are unlinked from the wheel if the TimerManager is destroyed first
+	if (scheduledListHead_)
+	{
+		engine->GetTimerManager()->CancelTimer(this);
+	}
+}
 
+void Timer::SetTicksPerSecond(float ticksPerSecond)
+{
+	SetTimeToTick(1.f / ticksPerSecond);
 }
 
-void Timer::Tick(float deltaSecond)
+void Timer::SetTimeToTick(float timeInSeconds)
 {
-	elapsedTime_ += deltaSecond;
-	if (timeToRefreshTimeVariables_ < elapsedTime_)
+	ticksPerSecond_ = 1.f / timeInSeconds;
+	timeToRefreshTimeVariables_ = timeInSeconds;
+
+	if (isActive_)
 	{
-		elapsedTime_ -= timeToRefreshTimeVariables_;
-		Operate();
+		Reset();
 	}
 }
 
+float Timer::GetRemainingTime() const
+{
+	if (!scheduledListHead_)
+	{
+		return 0.f;
+	}
+
+	return (float)(dueTime_ - engine->GetTimerManager()->GetCurrentTime());
+}
+
 void Timer::SetIsActive(bool isActive)
 {
 	TimeDependentObject::SetIsActive(isActive);
-	if (!isActive)
+	if (isActive)
 	{
-		elapsedTime_ = 0.f;
+		if (!scheduledListHead_)
+		{
+			Reset();
+		}
 	}
-}
\ No newline at end of file
+	else
+	{
+		engine->GetTimerManager()->CancelTimer(this);
+	}
+}
+
+void Timer::Reset()
+{
+	if (isActive_)
+	{
+		engine->GetTimerManager()->ScheduleTimer(this, timeToRefreshTimeVariables_);
+	}
+}
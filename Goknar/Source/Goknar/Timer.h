@@ -1,17 +1,25 @@
 #ifndef __TIMER_H__
 #define __TIMER_H__
 
+#include <cstdint>
+
 #include "TimeDependentObject.h"
 
 #include "Delegates/Delegate.h"
 
+// Repeating timer, sleeps on the TimerManager's timer wheel until it is due instead of being ticked every frame
 class GOKNAR_API Timer : public TimeDependentObject
 {
+	friend class TimerManager;
+
 public:
 	Timer();
-	virtual ~Timer() {}
+	virtual ~Timer();
 
-	virtual void Tick(float deltaSecond) override;
+	// Timers are fired by the TimerManager
+	virtual void Tick(float deltaSecond) override
+	{
+	}
 
 	void CallOnTick(const Delegate<void()>& function)
 	{
@@ -23,24 +31,26 @@ public:
 		return ticksPerSecond_;
 	}
 
-	void SetTicksPerSecond(float ticksPerSecond)
+	void SetTicksPerSecond(float ticksPerSecond);
+
+	float GetTimeToTick() const
 	{
-		ticksPerSecond_ = ticksPerSecond;
-		timeToRefreshTimeVariables_ = 1.f / ticksPerSecond;
+		return timeToRefreshTimeVariables_;
 	}
 
-	void SetTimeToTick(float timeInSeconds)
+	void SetTimeToTick(float timeInSeconds);
+
+	// Seconds left until the next tick
+	float GetRemainingTime() const;
+
+	bool GetIsScheduled() const
 	{
-		ticksPerSecond_ = 1.f / timeInSeconds;
-		timeToRefreshTimeVariables_ = timeInSeconds;
+		return scheduledListHead_ != nullptr;
 	}
 
 	virtual void SetIsActive(bool isActive) override;
 
-	virtual void Reset()
-	{
-		elapsedTime_ = 0.f;
-	}
+	virtual void Reset();
 
 protected:
 	virtual void Operate()
@@ -56,7 +66,13 @@ private:
 
 	float ticksPerSecond_{ 30.f };
 	float timeToRefreshTimeVariables_{ 1.f / ticksPerSecond_ };
-	float elapsedTime_{ 0.f };
+
+	// Timer wheel data, managed by the TimerManager
+	Timer* nextScheduledTimer_{ nullptr };
+	Timer* previousScheduledTimer_{ nullptr };
+	Timer** scheduledListHead_{ nullptr };
+	double dueTime_{ 0.0 };
+	uint64_t dueWheelTick_{ 0 };
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Goknar/Contents/Image.h"
+#include "Goknar/Engine.h"
+#include "Goknar/IO/IOManager.h"
+#include "Goknar/Renderer/Texture.h"
+#include "Goknar/Renderer/TextureAtlas.h"
+#include "Goknar/Renderer/TexturePacker.h"
+
+// Packs the given image files, or every image file under the given directories, into atlas PNG files
+// A manifest listing the atlases and the texture coordinate transform of every packed image is written next to them,
+// the resource manager draws the listed images from these atlases instead of packing them at runtime(see PrebuiltTextureAtlases)
+// Atlas regions are always clamped, so only images that do not repeat at runtime are drawn from the atlases
+// Usage: GoknarAtlasPacker [-o <output prefix>] [-s <atlas size>] <file or directory>...
+//	-o atlases are written to <output prefix>_<index>.png and the manifest to <output prefix>.gkatlas, Atlas by default
+//	   Atlas.gkatlas in the content directory is loaded automatically
+//	-s width and height of the atlases, 2048 by default
+
+static bool GetIsPackableImage(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	return extension == ".png" || extension == ".jpg";
+}
+
+static void CollectImages(const std::filesystem::path& path, std::vector<std::filesystem::path>& imagePaths)
+{
+	if (std::filesystem::is_directory(path))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file() && GetIsPackableImage(entry.path()))
+			{
+				imagePaths.push_back(entry.path());
+			}
+		}
+	}
+	else if (GetIsPackableImage(path))
+	{
+		imagePaths.push_back(path);
+	}
+	else
+	{
+		std::printf("Skipping %s, not an image file\n", path.string().c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string outputPrefix = "Atlas";
+	int atlasSize = TEXTURE_PACKER_ATLAS_SIZE;
+	std::vector<std::filesystem::path> imagePaths;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		const std::string argument = argv[argumentIndex];
+		if (argument == "-o" && argumentIndex + 1 < argc)
+		{
+			outputPrefix = argv[++argumentIndex];
+		}
+		else if (argument == "-s" && argumentIndex + 1 < argc)
+		{
+			atlasSize = std::atoi(argv[++argumentIndex]);
+		}
+		else
+		{
+			CollectImages(argument, imagePaths);
+		}
+	}
+
+	if (imagePaths.empty() || atlasSize <= 0)
+	{
+		std::printf("Usage: %s [-o <output prefix>] [-s <atlas size>] <file or directory>...\n", argv[0]);
+		return 1;
+	}
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* packerEngine = new Engine(true);
+
+	std::vector<Image*> images;
+	int channels = 3;
+	for (const std::filesystem::path& imagePath : imagePaths)
+	{
+		Image* image = IOManager::LoadImage(imagePath.string());
+		if (!image || !image->GetBuffer() || image->GetCompressionFormat() != TextureCompressionFormat::None)
+		{
+			std::printf("Skipping %s, not an uncompressed image\n", imagePath.string().c_str());
+			delete image;
+			continue;
+		}
+
+		// Larger images go to array textures at runtime
+		if (TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE < image->GetWidth() || TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE < image->GetHeight())
+		{
+			std::printf("Skipping %s, larger than %dx%d\n", imagePath.string().c_str(), TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE, TEXTURE_PACKER_MAX_ATLAS_IMAGE_SIZE);
+			delete image;
+			continue;
+		}
+
+		// Gutters are clamped like the atlas regions are in the shaders
+		image->SetTextureWrappingS(TextureWrapping::CLAMP_TO_EDGE);
+		image->SetTextureWrappingT(TextureWrapping::CLAMP_TO_EDGE);
+
+		// A single transparent image makes every atlas RGBA
+		if (image->GetChannels() == 2 || image->GetChannels() == 4)
+		{
+			channels = 4;
+		}
+
+		images.push_back(image);
+	}
+
+	const std::string manifestPath = outputPrefix + "." TEXTURE_ATLAS_MANIFEST_EXTENSION;
+	const std::filesystem::path manifestDirectory = std::filesystem::absolute(std::filesystem::path(manifestPath)).parent_path();
+	std::ofstream manifest(manifestPath);
+	if (!manifest.is_open())
+	{
+		std::printf("Failed to open %s\n", manifestPath.c_str());
+
+		for (Image* image : images)
+		{
+			delete image;
+		}
+		delete packerEngine;
+
+		return 1;
+	}
+
+	// Texture coordinates need more than the default 6 digits to stay on the texels of large atlases
+	manifest.precision(9);
+
+	std::vector<TextureAtlas*> atlases;
+	TexturePacker::PackIntoAtlases(images, atlasSize, channels, atlases);
+
+	int packedImageCount = 0;
+	int failedCount = 0;
+	for (int atlasIndex = 0; atlasIndex < (int)atlases.size(); ++atlasIndex)
+	{
+		TextureAtlas* atlas = atlases[atlasIndex];
+		atlas->BuildPixels();
+
+		const std::string atlasPath = outputPrefix + "_" + std::to_string(atlasIndex) + ".png";
+		if (!IOManager::WritePng(atlasPath.c_str(), atlas->GetWidth(), atlas->GetHeight(), atlas->GetChannels(), atlas->GetPixels()))
+		{
+			std::printf("Failed to write %s\n", atlasPath.c_str());
+			++failedCount;
+			continue;
+		}
+
+		// Paths are relative to the manifest and come last since they might contain spaces
+		manifest << "atlas " << atlas->GetWidth() << " " << atlas->GetHeight() << " " << std::filesystem::path(atlasPath).filename().generic_string() << "\n";
+		for (int imageIndex = 0; imageIndex < atlas->GetImageCount(); ++imageIndex)
+		{
+			const Image* image = atlas->GetImage(imageIndex);
+			const Vector4& uvTransform = atlas->GetRegion(imageIndex).uvTransform;
+			const std::string imageFile = std::filesystem::absolute(std::filesystem::path(image->GetPath())).lexically_relative(manifestDirectory).generic_string();
+			manifest << "image " << image->GetWidth() << " " << image->GetHeight() << " " << uvTransform.x << " " << uvTransform.y << " " << uvTransform.z << " " << uvTransform.w << " " << imageFile << "\n";
+		}
+
+		std::printf("Packed %d images into %s, %.1f%% occupied\n", atlas->GetImageCount(), atlasPath.c_str(), 100.f * atlas->GetOccupancy());
+		packedImageCount += atlas->GetImageCount();
+	}
+
+	std::printf("%d of %d images packed into %d atlases\n", packedImageCount, (int)imagePaths.size(), (int)atlases.size() - failedCount);
+
+	// Atlases do not own their images
+	for (TextureAtlas* atlas : atlases)
+	{
+		delete atlas;
+	}
+
+	for (Image* image : images)
+	{
+		delete image;
+	}
+
+	delete packerEngine;
+
+	return failedCount == 0 && packedImageCount == (int)imagePaths.size() ? 0 : 1;
+}
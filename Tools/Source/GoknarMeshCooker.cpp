@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Goknar/Engine.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/CookedMeshLoader.h"
+#include "Goknar/IO/IOManager.h"
+
+// Cooks the given model files, or every model file under the given directories, into sibling .gkmesh files
+// Texture paths are stored relative to the content directory, so the models should be cooked from inside it
+// Usage: GoknarMeshCooker [-f] <file or directory>...
+//	-f cooks the files even if their cooked files are up to date
+
+static bool GetIsCookableModel(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	return extension == ".fbx";
+}
+
+static void CollectModels(const std::filesystem::path& path, std::vector<std::filesystem::path>& modelPaths)
+{
+	if (std::filesystem::is_directory(path))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file() && GetIsCookableModel(entry.path()))
+			{
+				modelPaths.push_back(entry.path());
+			}
+		}
+	}
+	else if (GetIsCookableModel(path))
+	{
+		modelPaths.push_back(path);
+	}
+	else
+	{
+		std::printf("Skipping %s, not a model file\n", path.string().c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool isForced = false;
+	std::vector<std::filesystem::path> modelPaths;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		const std::string argument = argv[argumentIndex];
+		if (argument == "-f")
+		{
+			isForced = true;
+		}
+		else
+		{
+			CollectModels(argument, modelPaths);
+		}
+	}
+
+	if (modelPaths.empty())
+	{
+		std::printf("Usage: %s [-f] <file or directory>...\n", argv[0]);
+		return 1;
+	}
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* cookerEngine = new Engine(true);
+
+	int cookedCount = 0;
+	int failedCount = 0;
+	for (const std::filesystem::path& modelPath : modelPaths)
+	{
+		const std::string sourcePath = modelPath.string();
+		const std::string cookedPath = CookedMeshLoader::GetCookedPath(sourcePath);
+
+		if (!isForced && CookedFileUtils::GetIsCookedFileUpToDate(sourcePath, cookedPath))
+		{
+			continue;
+		}
+
+		if (IOManager::CookModel(sourcePath, cookedPath))
+		{
+			std::printf("Cooked %s\n", cookedPath.c_str());
+			++cookedCount;
+		}
+		else
+		{
+			std::printf("Failed to cook %s\n", sourcePath.c_str());
+			++failedCount;
+		}
+	}
+
+	std::printf("%d cooked, %d failed, %d up to date\n", cookedCount, failedCount, (int)modelPaths.size() - cookedCount - failedCount);
+
+	delete cookerEngine;
+
+	return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Goknar/Engine.h"
+#include "Goknar/Helpers/SceneParser.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/CookedSceneLoader.h"
+
+// Cooks the given scene XML files, or every XML file under the given directories, into sibling .gkscene files
+// Usage: GoknarSceneCooker [-f] <file or directory>...
+//	-f cooks the files even if their cooked files are up to date
+
+static bool GetIsSceneFile(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	return extension == ".xml";
+}
+
+static void CollectScenes(const std::filesystem::path& path, std::vector<std::filesystem::path>& scenePaths)
+{
+	if (std::filesystem::is_directory(path))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file() && GetIsSceneFile(entry.path()))
+			{
+				scenePaths.push_back(entry.path());
+			}
+		}
+	}
+	else if (GetIsSceneFile(path))
+	{
+		scenePaths.push_back(path);
+	}
+	else
+	{
+		std::printf("Skipping %s, not a scene file\n", path.string().c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool isForced = false;
+	std::vector<std::filesystem::path> scenePaths;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		const std::string argument = argv[argumentIndex];
+		if (argument == "-f")
+		{
+			isForced = true;
+		}
+		else
+		{
+			CollectScenes(argument, scenePaths);
+		}
+	}
+
+	if (scenePaths.empty())
+	{
+		std::printf("Usage: %s [-f] <file or directory>...\n", argv[0]);
+		return 1;
+	}
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* cookerEngine = new Engine(true);
+
+	int cookedCount = 0;
+	int failedCount = 0;
+	for (const std::filesystem::path& scenePath : scenePaths)
+	{
+		const std::string sourcePath = scenePath.string();
+		const std::string cookedPath = CookedSceneLoader::GetCookedPath(sourcePath);
+
+		if (!isForced && CookedFileUtils::GetIsCookedFileUpToDate(sourcePath, cookedPath))
+		{
+			continue;
+		}
+
+		if (SceneParser::CookScene(sourcePath, cookedPath))
+		{
+			std::printf("Cooked %s\n", cookedPath.c_str());
+			++cookedCount;
+		}
+		else
+		{
+			std::printf("Failed to cook %s\n", sourcePath.c_str());
+			++failedCount;
+		}
+	}
+
+	std::printf("%d cooked, %d failed, %d up to date\n", cookedCount, failedCount, (int)scenePaths.size() - cookedCount - failedCount);
+
+	delete cookerEngine;
+
+	return failedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Goknar/Engine.h"
+#include "Goknar/IO/CookedFileUtils.h"
+#include "Goknar/IO/CookedTextureLoader.h"
+#include "Goknar/IO/IOManager.h"
+#include "Goknar/Managers/JobManager.h"
+#include "Goknar/Renderer/Texture.h"
+
+// Cooks the given image files, or every image file under the given directories, into sibling .gktex files
+// Blocks of every mip level are compressed in parallel on the job manager
+// Color images are compressed to BC1, or to BC3 if they have transparent pixels, normal maps are compressed to BC5
+// Usage: GoknarTextureCooker [-f] [-q] [-n] <file or directory>...
+//	-f cooks the files even if their cooked files are up to date
+//	-q compresses the color images to BC7 for a higher quality
+//	-n treats every image as a normal map, otherwise only the images whose names end with _Normal or _N are
+
+static bool GetIsCookableImage(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	return extension == ".png" || extension == ".jpg";
+}
+
+static bool GetIsNormalMap(const std::filesystem::path& path)
+{
+	std::string stem = path.stem().string();
+	std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	const auto hasSuffix = [&stem](const std::string& suffix)
+		{
+			return suffix.size() < stem.size() && stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0;
+		};
+
+	return hasSuffix("_normal") || hasSuffix("_n");
+}
+
+static void CollectImages(const std::filesystem::path& path, std::vector<std::filesystem::path>& imagePaths)
+{
+	if (std::filesystem::is_directory(path))
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file() && GetIsCookableImage(entry.path()))
+			{
+				imagePaths.push_back(entry.path());
+			}
+		}
+	}
+	else if (GetIsCookableImage(path))
+	{
+		imagePaths.push_back(path);
+	}
+	else
+	{
+		std::printf("Skipping %s, not an image file\n", path.string().c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool isForced = false;
+	bool isHighQuality = false;
+	bool isNormalMap = false;
+	std::vector<std::filesystem::path> imagePaths;
+	for (int argumentIndex = 1; argumentIndex < argc; ++argumentIndex)
+	{
+		const std::string argument = argv[argumentIndex];
+		if (argument == "-f")
+		{
+			isForced = true;
+		}
+		else if (argument == "-q")
+		{
+			isHighQuality = true;
+		}
+		else if (argument == "-n")
+		{
+			isNormalMap = true;
+		}
+		else
+		{
+			CollectImages(argument, imagePaths);
+		}
+	}
+
+	if (imagePaths.empty())
+	{
+		std::printf("Usage: %s [-f] [-q] [-n] <file or directory>...\n", argv[0]);
+		return 1;
+	}
+
+	// Only the engine's managers are needed, no window or renderer is initialized
+	Engine* cookerEngine = new Engine(true);
+
+	const int hardwareThreadCount = (int)std::thread::hardware_concurrency();
+	cookerEngine->GetJobManager()->SetWorkerThreadCount(1 < hardwareThreadCount ? hardwareThreadCount - 1 : 1);
+
+	int cookedCount = 0;
+	int failedCount = 0;
+	for (const std::filesystem::path& imagePath : imagePaths)
+	{
+		const std::string sourcePath = imagePath.string();
+		const std::string cookedPath = CookedTextureLoader::GetCookedPath(sourcePath);
+
+		if (!isForced && CookedFileUtils::GetIsCookedFileUpToDate(sourcePath, cookedPath))
+		{
+			continue;
+		}
+
+		TextureCompressionFormat compressionFormat = TextureCompressionFormat::None;
+		if (isNormalMap || GetIsNormalMap(imagePath))
+		{
+			compressionFormat = TextureCompressionFormat::BC5;
+		}
+		else if (isHighQuality)
+		{
+			compressionFormat = TextureCompressionFormat::BC7;
+		}
+
+		if (IOManager::CookTexture(sourcePath, cookedPath, compressionFormat))
+		{
+			std::printf("Cooked %s\n", cookedPath.c_str());
+			++cookedCount;
+		}
+		else
+		{
+			std::printf("Failed to cook %s\n", sourcePath.c_str());
+			++failedCount;
+		}
+	}
+
+	std::printf("%d cooked, %d failed, %d up to date\n", cookedCount, failedCount, (int)imagePaths.size() - cookedCount - failedCount);
+
+	delete cookerEngine;
+
+	return failedCount == 0 ? 0 : 1;
+}